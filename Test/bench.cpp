@@ -0,0 +1,53 @@
+// 性能测试入口 : 不带参数时运行全部测试，否则只运行名字匹配的测试
+// 例如 ./stlbench heap
+
+#include <cstring>
+
+#include "hash_bench.h"
+#include "heap_bench.h"
+#include "hive_bench.h"
+#include "queue_bench.h"
+#include "slot_map_bench.h"
+#include "sort_bench.h"
+#include "tree_bench.h"
+
+namespace
+{
+
+struct bench_entry
+{
+  const char* name;
+  void      (*run)();
+};
+
+const bench_entry kBenches[] = {
+  { "heap",     mystl::test::heap_bench::heap_bench },
+  { "heap_cmp", mystl::test::heap_bench::heap_compare_bench },
+  { "radix",    mystl::test::heap_bench::radix_heap_bench },
+  { "mpmc",     mystl::test::queue_bench::mpmc_bench },
+  { "psort",    mystl::test::sort_bench::parallel_sort_bench },
+  { "hashmap",  mystl::test::hash_bench::flat_hash_map_bench },
+  { "hash",     mystl::test::hash_bench::hash_bytes_bench },
+  { "chmap",    mystl::test::hash_bench::concurrent_map_bench },
+  { "map",      mystl::test::tree_bench::ordered_map_bench },
+  { "slotmap",  mystl::test::slot_map_bench::slot_map_bench },
+  { "hive",     mystl::test::hive_bench::hive_bench },
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  for (const auto& b : kBenches)
+  {
+    bool selected = argc < 2;
+    for (int i = 1; i < argc; ++i)
+    {
+      if (std::strcmp(argv[i], b.name) == 0)
+        selected = true;
+    }
+    if (selected)
+      b.run();
+  }
+  return 0;
+}
@@ -0,0 +1,98 @@
+#ifndef MYTINYSTL_BENCH_H_
+#define MYTINYSTL_BENCH_H_
+
+// 性能测试用的公共工具 : 计时、数据规模与结果输出
+// 各个 *_bench.h 包含本文件，并在 bench.cpp 中按名字调用
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace mystl
+{
+namespace test
+{
+
+// 测试数据规模，可在编译时用 -D 覆盖
+#ifndef BENCH_LEN1
+#define BENCH_LEN1 1000000
+#endif
+#ifndef BENCH_LEN2
+#define BENCH_LEN2 10000000
+#endif
+#ifndef BENCH_LEN3
+#define BENCH_LEN3 100000000
+#endif
+
+// 缺省只跑前两档，打开 LARGER_TEST_DATA_ON 后加上最大一档
+#ifndef LARGER_TEST_DATA_ON
+#define LARGER_TEST_DATA_ON 0
+#endif
+
+inline size_t bench_len_count()
+{
+  return LARGER_TEST_DATA_ON ? 3 : 2;
+}
+
+inline size_t bench_len(size_t i)
+{
+  static const size_t lens[] = { BENCH_LEN1, BENCH_LEN2, BENCH_LEN3 };
+  return lens[i];
+}
+
+// 简单的计时器，以毫秒为单位
+class bench_timer
+{
+public:
+  bench_timer() :start_(std::chrono::steady_clock::now()) {}
+
+  void   reset() { start_ = std::chrono::steady_clock::now(); }
+  double ms() const
+  {
+    return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start_).count();
+  }
+
+private:
+  std::chrono::steady_clock::time_point start_;
+};
+
+// 线性同余随机数，保证各次测试的输入一致，且不依赖 rand() 的实现
+class bench_rng
+{
+public:
+  explicit bench_rng(unsigned long long seed = 20240601ULL) :state_(seed) {}
+
+  unsigned long long next()
+  {
+    state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+    return state_ >> 17;
+  }
+
+private:
+  unsigned long long state_;
+};
+
+// 防止编译器把测试结果优化掉
+template <class T>
+inline void bench_keep(const T& value)
+{
+  static volatile const T* sink;
+  sink = &value;
+  (void)sink;
+}
+
+inline void bench_header(const char* name)
+{
+  std::printf("[===============================================================]\n");
+  std::printf("[---------------- Run benchmark : %-28s]\n", name);
+}
+
+inline void bench_row(const char* what, size_t len, double ms)
+{
+  std::printf("| %-28s | %11zu | %12.2f ms |\n", what, len, ms);
+}
+
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_BENCH_H_
@@ -0,0 +1,73 @@
+// 行为测试入口 : 不带参数时运行全部测试，否则只运行名字匹配的测试
+// 例如 ./stlcheck queue hash ，有失败的检查或未知的名字时返回非零值
+
+#include <cstdio>
+#include <cstring>
+
+#include "concurrent_vector_test.h"
+#include "hash_test.h"
+#include "heap_test.h"
+#include "hive_test.h"
+#include "parallel_test.h"
+#include "pool_allocator_test.h"
+#include "queue_test.h"
+#include "slot_map_test.h"
+#include "thread_pool_test.h"
+#include "tree_test.h"
+
+namespace
+{
+
+struct check_entry
+{
+  const char* name;
+  void      (*run)();
+};
+
+const check_entry kChecks[] = {
+  { "heap",              mystl::test::heap_test::heap_test },
+  { "queue",             mystl::test::queue_test::queue_test },
+  { "thread_pool",       mystl::test::thread_pool_test::thread_pool_test },
+  { "parallel",          mystl::test::parallel_test::parallel_test },
+  { "concurrent_vector", mystl::test::concurrent_vector_test::concurrent_vector_test },
+  { "hash",              mystl::test::hash_test::hash_test },
+  { "pool_allocator",    mystl::test::pool_allocator_test::pool_allocator_test },
+  { "tree",              mystl::test::tree_test::tree_test },
+  { "slot_map",          mystl::test::slot_map_test::slot_map_test },
+  { "hive",              mystl::test::hive_test::hive_test },
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    bool known = false;
+    for (const auto& c : kChecks)
+    {
+      if (std::strcmp(argv[i], c.name) == 0)
+        known = true;
+    }
+    if (!known)
+    {
+      std::printf("unknown check : %s\n", argv[i]);
+      return 2;
+    }
+  }
+  for (const auto& c : kChecks)
+  {
+    bool selected = argc < 2;
+    for (int i = 1; i < argc; ++i)
+    {
+      if (std::strcmp(argv[i], c.name) == 0)
+        selected = true;
+    }
+    if (selected)
+      c.run();
+  }
+  const size_t failures = mystl::test::check_failures().load();
+  std::printf("[===============================================================]\n");
+  std::printf("%zu check(s) failed\n", failures);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+#ifndef MYTINYSTL_CHECK_H_
+#define MYTINYSTL_CHECK_H_
+
+// 行为测试用的公共工具 : 断言与计数
+// 各个 *_test.h 包含本文件，并在 check.cpp 中按名字调用；
+// 断言失败时打印位置并计数，不中断测试，stlcheck 在有失败时返回非零，供 ctest 判定
+// 多数测试把容器与标准库中对应的容器做同样的随机操作并逐步比较 (差分测试)，
+// 并发容器的测试用多个线程同时操作后检查每个元素恰好出现一次
+
+#include <atomic>
+#include <cstdio>
+
+#include "bench.h"
+
+namespace mystl
+{
+namespace test
+{
+
+inline std::atomic<size_t>& check_failures()
+{
+  static std::atomic<size_t> failures(0);
+  return failures;
+}
+
+inline void check_failed(const char* expr, const char* file, int line)
+{
+  // 同一处断言在循环中失败时只打印前几次
+  if (check_failures().fetch_add(1) < 16)
+    std::printf("  FAILED %s:%d : %s\n", file, line, expr);
+}
+
+inline void check_header(const char* name)
+{
+  std::printf("[===============================================================]\n");
+  std::printf("[------------------ Run check : %-31s]\n", name);
+}
+
+// 断言 expr 为真，可以在工作线程中使用
+#define CHECK(expr) \
+  do { if (!(expr)) mystl::test::check_failed(#expr, __FILE__, __LINE__); } while (0)
+
+// 断言 expr 抛出 Exception 类型的异常
+#define CHECK_THROW(expr, Exception)                                  \
+  do {                                                                \
+    bool check_thrown_ = false;                                       \
+    try { expr; } catch (const Exception&) { check_thrown_ = true; }  \
+    if (!check_thrown_)                                               \
+      mystl::test::check_failed(#expr " throws " #Exception,          \
+                                __FILE__, __LINE__);                  \
+  } while (0)
+
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_CHECK_H_
@@ -0,0 +1,182 @@
+#ifndef MYTINYSTL_CONCURRENT_VECTOR_TEST_H_
+#define MYTINYSTL_CONCURRENT_VECTOR_TEST_H_
+
+// concurrent vector test : concurrent_vector 的接口测试，多线程追加时元素地址不变、每个元素恰好追加一次，
+// 以及构造元素抛出异常时只析构已经构造的元素
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../algo.h"
+#include "../concurrent_vector.h"
+#include "../vector.h"
+#include "check.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace concurrent_vector_test
+{
+
+void api_check()
+{
+  mystl::concurrent_vector<int> a;
+  CHECK(a.empty() && a.capacity() == 0);
+  for (int i = 0; i < 1000; ++i)
+    CHECK(a.push_back(i) == i);
+  // 追加不移动已有元素
+  int* p5 = &a[5];
+  for (int i = 0; i < 100000; ++i)
+    a.push_back(i);
+  CHECK(p5 == &a[5] && a.size() == 101000);
+  for (int i = 0; i < 1000; ++i)
+    CHECK(a[i] == i);
+  auto it = a.grow_by(10, 7);
+  CHECK(it.index == 101000 && a[101009] == 7);
+
+  mystl::concurrent_vector<int> b(a);
+  CHECK(a == b);
+  b.push_back(1);
+  CHECK(a < b && a != b);
+  mystl::concurrent_vector<int> c{ 1, 2, 3 };
+  CHECK(c.size() == 3 && c.back() == 3);
+  c = mystl::move(b);
+  CHECK(c.size() == 101011 && b.empty());
+  c.grow_to_at_least(200000);
+  CHECK(c.size() == 200000 && c[199999] == 0);
+  CHECK(c.grow_to_at_least(5).index == 5);
+  c.clear();
+  CHECK(c.empty() && c.capacity() >= 200000);
+  c.shrink_to_fit();
+  CHECK(c.capacity() == 0);
+  c.reserve(100);
+  CHECK(c.capacity() >= 100);
+
+  mystl::concurrent_vector<std::string> s(5, "x");
+  s.push_back(std::string(100, 'y'));
+  CHECK(s[5].size() == 100);
+  mystl::vector<std::string> sv(3, "z");
+  auto g = s.grow_by(sv.begin(), sv.end());
+  CHECK(g.index == 6 && s.size() == 9 && s[8] == "z");
+
+  mystl::vector<int> v{ 1, 2, 3, 4 };
+  mystl::concurrent_vector<int> d(v.begin(), v.end());
+  CHECK(d.size() == 4 && d[3] == 4);
+  int sum = 0;
+  for (auto x : d)
+    sum += x;
+  CHECK(sum == 10);
+  mystl::sort(d.begin(), d.end(), mystl::greater<int>());
+  CHECK(d[0] == 4 && d[3] == 1);
+}
+
+// 各线程交替使用 push_back 与 grow_by，同时回读自己先前追加的元素
+void concurrent_check()
+{
+  const int threads = 4, n = 20000;
+  for (int round = 0; round < 3; ++round)
+  {
+    mystl::concurrent_vector<long> cv;
+    std::vector<std::vector<long*>> addrs(threads);
+    std::vector<std::thread> ts;
+    for (int t = 0; t < threads; ++t)
+    {
+      ts.push_back(std::thread([&, t]
+      {
+        for (int i = 0; i < n; ++i)
+        {
+          const long v = static_cast<long>(t) * n + i;
+          if (i % 100 == 0)
+            addrs[t].push_back(&*cv.grow_by(3, v));
+          else
+            addrs[t].push_back(&cv.push_back(v));
+          if (i % 10 == 0)
+            CHECK(*addrs[t][i / 2] / n == t);
+        }
+      }));
+    }
+    for (auto& t : ts)
+      t.join();
+    CHECK(cv.size() == static_cast<size_t>(threads) * n + threads * (n / 100) * 2);
+    std::vector<int> seen(threads * n, 0);
+    for (auto x : cv)
+    {
+      CHECK(x >= 0 && x < threads * n);
+      if (x >= 0 && x < threads * n)
+        ++seen[x];
+    }
+    for (int i = 0; i < threads * n; ++i)
+      CHECK(seen[i] == (i % n % 100 == 0 ? 3 : 1));
+    for (int t = 0; t < threads; ++t)
+    {
+      for (int i = 0; i < n; ++i)
+        CHECK(*addrs[t][i] == static_cast<long>(t) * n + i);
+    }
+  }
+}
+
+// 记录存活对象的个数，budget 用完后构造抛出异常
+struct tracked
+{
+  static int live;
+  static int budget;
+  std::string s;
+
+  tracked() :s(40, 'x') { take(); }
+  tracked(const tracked& rhs) :s(rhs.s) { take(); }
+  ~tracked() { --live; }
+
+  void take()
+  {
+    if (--budget < 0)
+      throw std::runtime_error("tracked");
+    ++live;
+  }
+};
+
+int tracked::live = 0;
+int tracked::budget = 0;
+
+void exception_check()
+{
+  tracked::budget = 1000000;
+  {
+    mystl::concurrent_vector<tracked> v;
+    for (int i = 0; i < 10; ++i)
+      v.emplace_back();
+    tracked::budget = 0;
+    CHECK_THROW(v.emplace_back(), std::runtime_error);
+    CHECK_THROW(v.grow_by(30), std::runtime_error);
+    // 部分元素构造成功后失败
+    tracked::budget = 3;
+    CHECK_THROW(v.grow_by(30), std::runtime_error);
+    tracked::budget = 1000000;
+    CHECK(tracked::live == 10);
+    v.clear();
+    CHECK(tracked::live == 0);
+    v.grow_by(100);
+    CHECK(tracked::live == 100 && v.size() == 100);
+  }
+  CHECK(tracked::live == 0);
+
+  tracked::budget = 5;
+  CHECK_THROW(mystl::concurrent_vector<tracked>(20), std::runtime_error);
+  CHECK(tracked::live == 0);
+  tracked::budget = 1000000;
+}
+
+void concurrent_vector_test()
+{
+  check_header("concurrent_vector");
+  api_check();
+  concurrent_check();
+  exception_check();
+}
+
+} // namespace concurrent_vector_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_CONCURRENT_VECTOR_TEST_H_
@@ -0,0 +1,289 @@
+#ifndef MYTINYSTL_HASH_BENCH_H_
+#define MYTINYSTL_HASH_BENCH_H_
+
+// hash map bench : 比较 flat_hash_map、mystl::unordered_map 与 std::unordered_map 在随机 64 位键上的
+// 插入、命中查找、未命中查找、删除的用时，以及每个元素占用的字节数
+// std::unordered_map 的内存用计数的分配器统计，flat_hash_map 的内存为槽与控制字节的总和，
+// mystl::unordered_map 的内存为节点与桶数组的总和，不含内存池中尚未切出的部分
+//
+// concurrent map bench : 在 1、4、16、64 个线程下比较 concurrent_hash_map 与一把 mutex 保护的
+// flat_hash_map 的吞吐量，表中预先有 65536 个键，每个线程的操作中 1/32 为 insert_or_assign，其余为查找
+//
+// hash bytes bench : 比较 mystl::hash_bytes 与 std::hash<std::string> 在不同长度的键上的吞吐量
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "../vector.h"
+#include "../concurrent_hash_map.h"
+#include "../flat_hash_map.h"
+#include "../unordered_map.h"
+#include "bench.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace hash_bench
+{
+
+// 各种类型的 counting_allocator 共用的已分配字节数
+inline size_t& allocated_bytes()
+{
+  static size_t n = 0;
+  return n;
+}
+
+// 统计已分配字节数的分配器
+template <class T>
+struct counting_allocator
+{
+  typedef T value_type;
+
+  counting_allocator() = default;
+  template <class U>
+  counting_allocator(const counting_allocator<U>&) {}
+
+  T* allocate(size_t n)
+  {
+    allocated_bytes() += n * sizeof(T);
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t n)
+  {
+    allocated_bytes() -= n * sizeof(T);
+    ::operator delete(p);
+  }
+
+  template <class U>
+  bool operator==(const counting_allocator<U>&) const { return true; }
+  template <class U>
+  bool operator!=(const counting_allocator<U>&) const { return false; }
+};
+
+typedef unsigned long long key_type;
+
+inline void make_keys(mystl::vector<key_type>& keys, size_t len, unsigned long long seed)
+{
+  keys.clear();
+  keys.reserve(len);
+  bench_rng rng(seed);
+  for (size_t i = 0; i < len; ++i)
+    keys.push_back(rng.next() * 2654435761ULL ^ rng.next());
+}
+
+template <class Map>
+void run_map(const char* what, Map& m, const mystl::vector<key_type>& keys,
+             const mystl::vector<key_type>& misses, size_t (*memory)(const Map&))
+{
+  char name[64];
+  const size_t len = keys.size();
+  bench_timer t;
+  for (size_t i = 0; i < len; ++i)
+    m[keys[i]] = i;
+  std::snprintf(name, sizeof(name), "%s insert", what);
+  bench_row(name, len, t.ms());
+  std::printf("| %-28s | %11zu | %12.2f B  |\n", "  bytes per element", len,
+              static_cast<double>(memory(m)) / static_cast<double>(len));
+
+  size_t found = 0;
+  t.reset();
+  for (size_t i = 0; i < len; ++i)
+    found += m.find(keys[i]) != m.end();
+  std::snprintf(name, sizeof(name), "%s find hit", what);
+  bench_row(name, len, t.ms());
+
+  t.reset();
+  for (size_t i = 0; i < len; ++i)
+    found += m.find(misses[i]) != m.end();
+  std::snprintf(name, sizeof(name), "%s find miss", what);
+  bench_row(name, len, t.ms());
+
+  t.reset();
+  for (size_t i = 0; i < len; ++i)
+    found += m.erase(keys[i]);
+  std::snprintf(name, sizeof(name), "%s erase", what);
+  bench_row(name, len, t.ms());
+  // 命中查找与删除各计数 len 次，结果不符说明表的实现有误
+  if (found != 2 * len)
+    std::printf("| %-28s | unexpected result %zu\n", what, found);
+}
+
+typedef mystl::flat_hash_map<key_type, size_t> flat_map_type;
+typedef mystl::unordered_map<key_type, size_t> node_map_type;
+typedef std::unordered_map<key_type, size_t, std::hash<key_type>, std::equal_to<key_type>,
+  counting_allocator<std::pair<const key_type, size_t>>> std_map_type;
+
+inline size_t flat_memory(const flat_map_type& m)
+{
+  return m.capacity() * (sizeof(flat_map_type::value_type) + 1) + mystl::swiss::group::width;
+}
+
+inline size_t node_memory(const node_map_type& m)
+{
+  return m.size() * sizeof(mystl::hashtable_node<node_map_type::value_type>) +
+    m.bucket_count() * sizeof(void*);
+}
+
+inline size_t std_memory(const std_map_type&)
+{
+  return allocated_bytes();
+}
+
+void flat_hash_map_bench()
+{
+  bench_header("flat_hash_map");
+  for (size_t i = 0; i < bench_len_count(); ++i)
+  {
+    const size_t len = bench_len(i);
+    mystl::vector<key_type> keys, misses;
+    make_keys(keys, len, 1);
+    make_keys(misses, len, 2);
+    {
+      flat_map_type m;
+      run_map("flat_hash_map", m, keys, misses, flat_memory);
+    }
+    {
+      node_map_type m;
+      run_map("unordered_map", m, keys, misses, node_memory);
+    }
+    {
+      std_map_type m;
+      run_map("std::unordered_map", m, keys, misses, std_memory);
+    }
+  }
+}
+
+// 对照组 : 一把锁保护的 flat_hash_map
+class locked_map
+{
+public:
+  bool find(key_type key, size_t& value)
+  {
+    std::lock_guard<std::mutex> lk(m_);
+    auto it = map_.find(key);
+    if (it == map_.end())
+      return false;
+    value = it->second;
+    return true;
+  }
+
+  void insert_or_assign(key_type key, size_t value)
+  {
+    std::lock_guard<std::mutex> lk(m_);
+    map_.insert_or_assign(key, value);
+  }
+
+private:
+  std::mutex    m_;
+  flat_map_type map_;
+};
+
+// 用 threads 个线程在 m 上共执行 len 次操作，返回毫秒数
+template <class Map>
+double run_concurrent_map(Map& m, size_t threads, size_t len)
+{
+  static const size_t key_count = 65536;
+  for (size_t k = 0; k < key_count; ++k)
+    m.insert_or_assign(k, k);
+  bench_timer t;
+  mystl::vector<std::thread> pool;
+  mystl::vector<size_t> found(threads, 0);
+  pool.reserve(threads);
+  for (size_t i = 0; i < threads; ++i)
+  {
+    const size_t n = len / threads + (i < len % threads ? 1 : 0);
+    size_t* hits = &found[i];
+    pool.push_back(std::thread([&m, i, n, hits]
+    {
+      bench_rng rng(i + 1);
+      size_t value = 0;
+      for (size_t j = 0; j < n; ++j)
+      {
+        const key_type key = rng.next() % (key_count * 2);
+        if ((j & 31) == 31)
+          m.insert_or_assign(key % key_count, j);
+        else
+          *hits += m.find(key, value) ? 1 : 0;
+      }
+    }));
+  }
+  for (size_t i = 0; i < pool.size(); ++i)
+    pool[i].join();
+  const double ms = t.ms();
+  bench_keep(found);
+  return ms;
+}
+
+inline void throughput_row(const char* what, size_t threads, size_t len, double ms)
+{
+  std::printf("| %-20s | %3zu threads | %11zu | %12.2f ms | %8.2f Mops/s |\n",
+              what, threads, len, ms, ms > 0 ? len / ms / 1000.0 : 0.0);
+}
+
+void concurrent_map_bench()
+{
+  bench_header("concurrent_hash_map");
+  static const size_t thread_counts[] = { 1, 4, 16, 64 };
+  const size_t len = bench_len(1);
+  for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); ++i)
+  {
+    const size_t threads = thread_counts[i];
+    {
+      mystl::concurrent_hash_map<key_type, size_t> m;
+      throughput_row("concurrent_hash_map", threads, len, run_concurrent_map(m, threads, len));
+    }
+    {
+      locked_map m;
+      throughput_row("mutex + flat_map", threads, len, run_concurrent_map(m, threads, len));
+    }
+  }
+}
+
+// 每档哈希总计约 len * 64 个字节，键长依次为 8、64、1024、16384
+void hash_bytes_bench()
+{
+  bench_header("hash_bytes");
+  static const size_t key_lens[] = { 8, 64, 1024, 16384 };
+  for (size_t i = 0; i < bench_len_count(); ++i)
+  {
+    const size_t total = bench_len(i) * 64;
+    for (size_t key_len : key_lens)
+    {
+      std::string key(key_len, '\0');
+      bench_rng rng(key_len);
+      for (auto& c : key)
+        c = static_cast<char>(rng.next());
+      const size_t rounds = total / key_len;
+      char name[64];
+
+      size_t acc = 0;
+      bench_timer t;
+      for (size_t r = 0; r < rounds; ++r)
+      {
+        key[0] = static_cast<char>(r);
+        acc += mystl::hash_bytes(key.data(), key.size());
+      }
+      std::snprintf(name, sizeof(name), "mystl::hash_bytes %zuB", key_len);
+      bench_row(name, rounds, t.ms());
+
+      t.reset();
+      std::hash<std::string> std_hash;
+      for (size_t r = 0; r < rounds; ++r)
+      {
+        key[0] = static_cast<char>(r);
+        acc += std_hash(key);
+      }
+      std::snprintf(name, sizeof(name), "std::hash %zuB", key_len);
+      bench_row(name, rounds, t.ms());
+      bench_keep(acc);
+    }
+  }
+}
+
+} // namespace hash_bench
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_HASH_BENCH_H_
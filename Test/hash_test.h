@@ -0,0 +1,482 @@
+#ifndef MYTINYSTL_HASH_TEST_H_
+#define MYTINYSTL_HASH_TEST_H_
+
+// hash test : flat_hash_map 与 std::unordered_map 的差分测试，
+// 包括很差的哈希函数与大量删除后的墓碑清理；
+// hash_bytes 在各种长度与对齐下的一致性，长键路径与标量参照实现相同，
+// hash_combine 与各个特化的一致性；
+// unordered_map / unordered_set 与 std::unordered_map 的差分测试，包括节点的取出与插回；
+// concurrent_hash_map 的接口测试与多线程读写压力测试
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../concurrent_hash_map.h"
+#include "../flat_hash_map.h"
+#include "../functional.h"
+#include "../unordered_map.h"
+#include "../unordered_set.h"
+#include "check.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace hash_test
+{
+
+// 只有低两位的哈希值，所有键挤在少数几个组里
+struct bad_hash
+{
+  size_t operator()(int x) const { return static_cast<size_t>(x) & 3; }
+};
+
+// countdown 为正时，使它减到 0 的那次复制抛出异常
+struct throwing_key
+{
+  static int countdown;
+  std::string s;
+
+  explicit throwing_key(int k) :s(std::to_string(k)) {}
+  throwing_key(const throwing_key& rhs) :s(rhs.s)
+  {
+    if (countdown > 0 && --countdown == 0)
+      throw std::runtime_error("throwing_key");
+  }
+
+  bool operator==(const throwing_key& rhs) const { return s == rhs.s; }
+};
+
+int throwing_key::countdown = 0;
+
+struct throwing_key_hash
+{
+  size_t operator()(const throwing_key& k) const { return mystl::hash<std::string>()(k.s); }
+};
+
+template <class Map, class Ref>
+void same_content(const Map& m, const Ref& ref)
+{
+  CHECK(m.size() == ref.size());
+  size_t n = 0;
+  for (auto it = m.begin(); it != m.end(); ++it, ++n)
+  {
+    auto r = ref.find(it->first);
+    CHECK(r != ref.end() && r->second == it->second);
+  }
+  CHECK(n == ref.size());
+}
+
+template <class Hash>
+void flat_hash_map_run(int range)
+{
+  bench_rng rng;
+  mystl::flat_hash_map<int, long, Hash> m;
+  std::unordered_map<int, long> ref;
+  for (int step = 0; step < 100000; ++step)
+  {
+    const int op = static_cast<int>(rng.next() % 10);
+    const int k = static_cast<int>(rng.next() % range);
+    if (op < 4)
+    {
+      auto r = m.insert(mystl::pair<const int, long>(k, step));
+      auto q = ref.insert(std::make_pair(k, static_cast<long>(step)));
+      CHECK(r.second == q.second && r.first->second == q.first->second);
+    }
+    else if (op < 6)
+    {
+      CHECK(m.erase(k) == ref.erase(k));
+    }
+    else if (op < 8)
+    {
+      auto it = m.find(k);
+      auto r = ref.find(k);
+      CHECK((it == m.end()) == (r == ref.end()));
+      if (r != ref.end() && it != m.end())
+        CHECK(it->second == r->second);
+    }
+    else if (op == 8)
+    {
+      m[k] += 1;
+      ref[k] += 1;
+    }
+    else
+    {
+      auto it = m.find(k);
+      if (it != m.end())
+      {
+        m.erase(it);
+        ref.erase(k);
+      }
+    }
+    if (step % 20000 == 0)
+      same_content(m, ref);
+    if (step == 50000)
+    {
+      auto c = m;
+      CHECK(c == m);
+      m.rehash(0);
+      same_content(m, ref);
+    }
+  }
+  same_content(m, ref);
+  for (auto it = m.begin(); it != m.end(); )
+    it = m.erase(it);
+  CHECK(m.empty() && m.begin() == m.end());
+}
+
+void flat_hash_map_check()
+{
+  flat_hash_map_run<mystl::hash<int>>(1000);
+  flat_hash_map_run<mystl::hash<int>>(20);
+  flat_hash_map_run<mystl::hash<int>>(100000);
+  flat_hash_map_run<bad_hash>(300);
+
+  mystl::flat_hash_map<std::string, int> s{ { "a", 1 }, { "b", 2 } };
+  CHECK(s.at("a") == 1 && s["c"] == 0 && s.size() == 3);
+  auto r = s.try_emplace("a", 9);
+  CHECK(!r.second && r.first->second == 1);
+  s.insert_or_assign("a", 5);
+  CHECK(s["a"] == 5);
+  CHECK_THROW(s.at("nope"), std::out_of_range);
+  auto s2 = mystl::move(s);
+  CHECK(s.empty() && s2.size() == 3);
+
+  // reserve 之后插入不再扩容
+  mystl::flat_hash_map<int, int> big;
+  big.reserve(1000);
+  const size_t cap = big.capacity();
+  for (int i = 0; i < 1000; ++i)
+    big[i] = i;
+  CHECK(big.capacity() == cap);
+
+  // 复制键抛出异常时表保持不变，包括扩容途中搬移元素时抛出：
+  // 每次插入依次让第 1, 2, 3... 次复制抛出异常，直到插入成功
+  mystl::flat_hash_map<throwing_key, int, throwing_key_hash> tk;
+  int thrown = 0;
+  for (int k = 0; k < 200; ++k)
+  {
+    const throwing_key key(k);
+    for (int c = 1; ; ++c)
+    {
+      throwing_key::countdown = c;
+      try
+      {
+        tk.try_emplace(key, k);
+        throwing_key::countdown = 0;
+        break;
+      }
+      catch (const std::runtime_error&)
+      {
+        ++thrown;
+      }
+      throwing_key::countdown = 0;
+      CHECK(tk.size() == static_cast<size_t>(k));
+      CHECK(tk.find(key) == tk.end());
+    }
+  }
+  CHECK(thrown > 200);
+  for (int k = 0; k < 200; ++k)
+  {
+    auto it = tk.find(throwing_key(k));
+    CHECK(it != tk.end() && it->second == k);
+  }
+
+  // 规模稳定的插入删除循环不会无限增长
+  mystl::flat_hash_map<int, int> t;
+  for (int i = 0; i < 300000; ++i)
+  {
+    t[i] = i;
+    if (i >= 100)
+      t.erase(i - 100);
+  }
+  CHECK(t.size() == 100 && t.capacity() < 1024);
+}
+
+// 长键路径中一条的标量参照实现 : acc[i] += data[i ^ 1] + lo32(d) * hi32(d)，其中 d = data[i] ^ key[i]
+inline void reference_stripe(uint64_t* acc, const unsigned char* p, const uint64_t* key)
+{
+  uint64_t data[8];
+  std::memcpy(data, p, sizeof(data));
+  for (size_t i = 0; i < 8; ++i)
+  {
+    const uint64_t dk = data[i] ^ key[i];
+    acc[i] += data[i ^ 1] + (dk & 0xFFFFFFFFULL) * (dk >> 32);
+  }
+}
+
+void hash_function_check()
+{
+  bench_rng rng;
+  // 相同的字节序列在任意对齐下哈希值相同 : 覆盖短键、中等长度与长键路径，以及不同长度的尾部
+  std::vector<unsigned char> src(5000);
+  for (auto& c : src)
+    c = static_cast<unsigned char>(rng.next());
+  std::vector<unsigned char> buf(5000 + 16);
+  const size_t lens[] = { 0, 1, 2, 3, 4, 7, 8, 9, 15, 16, 17, 31, 47, 48, 49, 95, 96, 1000,
+                          1023, 1024, 1025, 1087, 1088, 1536, 1599, 4096, 4999 };
+  for (size_t len : lens)
+  {
+    const size_t h = mystl::hash_bytes(src.data(), len);
+    CHECK(mystl::hash_bytes(src.data(), len, 1) != h || len == 0);
+    for (size_t offset = 1; offset < 16; ++offset)
+    {
+      std::memcpy(buf.data() + offset, src.data(), len);
+      CHECK(mystl::hash_bytes(buf.data() + offset, len) == h);
+    }
+    // 改变任意一个字节都会改变哈希值
+    if (len > 0)
+    {
+      const size_t pos = static_cast<size_t>(rng.next() % len);
+      std::memcpy(buf.data(), src.data(), len);
+      buf[pos] ^= 1;
+      CHECK(mystl::hash_bytes(buf.data(), len) != h);
+    }
+  }
+  std::string a(3000, 'a'), b(3000, 'a');
+  CHECK(mystl::hash<std::string>()(a) == mystl::hash<std::string>()(b));
+  b[2999] = 'b';
+  CHECK(mystl::hash<std::string>()(a) != mystl::hash<std::string>()(b));
+
+  // 长键路径 (有 SSE2 时一次处理两路) 与标量参照实现的结果相同
+  uint64_t acc[8], expect[8];
+  for (int round = 0; round < 100; ++round)
+  {
+    for (size_t i = 0; i < 8; ++i)
+      acc[i] = expect[i] = rng.next();
+    const size_t offset = static_cast<size_t>(rng.next() % 16);
+    for (size_t i = 0; i < 64; ++i)
+      buf[offset + i] = static_cast<unsigned char>(rng.next());
+    mystl::hash_detail::accumulate_stripe(acc, buf.data() + offset, mystl::hash_detail::bulk_secret);
+    reference_stripe(expect, buf.data() + offset, mystl::hash_detail::bulk_secret);
+    for (size_t i = 0; i < 8; ++i)
+      CHECK(acc[i] == expect[i]);
+  }
+
+  // hash_combine 与顺序有关
+  size_t s1 = 0, s2 = 0;
+  mystl::hash_combine(s1, 1);
+  mystl::hash_combine(s1, 2);
+  mystl::hash_combine(s2, 2);
+  mystl::hash_combine(s2, 1);
+  CHECK(s1 != s2);
+  size_t s3 = 0;
+  mystl::hash_combine(s3, 1);
+  mystl::hash_combine(s3, 2);
+  CHECK(s1 == s3);
+  typedef mystl::hash<mystl::pair<int, int>> pair_hash;
+  CHECK(pair_hash()(mystl::make_pair(1, 2)) != pair_hash()(mystl::make_pair(2, 1)));
+
+  // 各个特化之间的一致性
+  CHECK(mystl::hash<int>()(42) == mystl::hash_mix(42));
+  CHECK(mystl::hash<long>()(42L) == mystl::hash<unsigned long>()(42UL));
+  CHECK(mystl::hash<int>()(1) != mystl::hash<int>()(2));
+  CHECK(mystl::hash<double>()(0.0) == mystl::hash<double>()(-0.0));
+  CHECK(mystl::hash<float>()(0.0f) == mystl::hash<float>()(-0.0f));
+  CHECK(mystl::hash<long double>()(0.0L) == mystl::hash<long double>()(-0.0L));
+  CHECK(mystl::hash<double>()(1.5) == mystl::hash<double>()(1.5));
+  CHECK(mystl::hash<double>()(1.5) != mystl::hash<double>()(-1.5));
+  CHECK(mystl::hash<long double>()(2.5L) != mystl::hash<long double>()(5.0L));
+  int x = 0, y = 0;
+  CHECK(mystl::hash<int*>()(&x) == mystl::hash<const int*>()(&x));
+  CHECK(mystl::hash<int*>()(&x) != mystl::hash<int*>()(&y));
+  const mystl::pair<int, std::string> pr(7, "seven");
+  size_t seed = mystl::hash<int>()(7);
+  mystl::hash_combine(seed, std::string("seven"));
+  typedef mystl::hash<mystl::pair<int, std::string>> string_pair_hash;
+  CHECK(string_pair_hash()(pr) == seed);
+
+  // 声明 is_avalanching 的哈希函数
+  CHECK(mystl::hash_is_avalanching<mystl::hash<int>>::value);
+  CHECK(mystl::hash_is_avalanching<mystl::hash<std::string>>::value);
+  CHECK(mystl::hash_is_avalanching<pair_hash>::value);
+  CHECK(!mystl::hash_is_avalanching<bad_hash>::value);
+}
+
+void unordered_map_check()
+{
+  bench_rng rng;
+  mystl::unordered_map<int, std::string> m;
+  std::unordered_map<int, std::string> ref;
+  CHECK(m.begin() == m.end() && m.find(3) == m.end() && m.erase(3) == 0);
+  const std::string* stable = nullptr;
+  int stable_key = -1;
+  for (int step = 0; step < 100000; ++step)
+  {
+    const int k = static_cast<int>(rng.next() % 5000);
+    const int op = static_cast<int>(rng.next() % 6);
+    if (op < 3)
+    {
+      auto r = m.try_emplace(k, std::to_string(k));
+      auto q = ref.emplace(k, std::to_string(k));
+      CHECK(r.second == q.second);
+      if (stable == nullptr)
+      {
+        stable = &r.first->second;
+        stable_key = k;
+      }
+    }
+    else if (op == 3 && k != stable_key)
+    {
+      CHECK(m.erase(k) == ref.erase(k));
+    }
+    else if (op == 4)
+    {
+      auto a = m.find(k);
+      auto b = ref.find(k);
+      CHECK((a == m.end()) == (b == ref.end()));
+      if (a != m.end() && b != ref.end())
+        CHECK(a->second == b->second);
+    }
+    else if (op == 5 && k != stable_key)
+    {
+      // 取出节点改键后再插回
+      auto nh = m.extract(k);
+      CHECK(static_cast<bool>(nh) == (ref.count(k) == 1));
+      if (nh)
+      {
+        ref.erase(k);
+        nh.key() = k + 100000;
+        nh.mapped() = "x";
+        auto r = m.insert(mystl::move(nh));
+        CHECK(r.inserted == ref.emplace(k + 100000, "x").second);
+      }
+    }
+    CHECK(m.size() == ref.size());
+    CHECK(m.load_factor() <= m.max_load_factor());
+  }
+  // 节点式容器的引用在重新散列后仍然有效
+  m.rehash(m.bucket_count() * 4);
+  CHECK(&m.at(stable_key) == stable);
+  same_content(m, ref);
+  size_t in_buckets = 0;
+  for (size_t b = 0; b < m.bucket_count(); ++b)
+  {
+    for (auto li = m.begin(b); li != m.end(b); ++li)
+      CHECK(m.bucket(li->first) == b);
+    in_buckets += m.bucket_size(b);
+  }
+  CHECK(in_buckets == m.size());
+  CHECK_THROW(m.at(-7), std::out_of_range);
+
+  mystl::unordered_set<std::string> s{ "a", "b", "c", "a" };
+  CHECK(s.size() == 3 && s.contains("b"));
+  auto nh = s.extract("b");
+  CHECK(nh.value() == "b" && !s.contains("b"));
+  mystl::unordered_set<std::string> s2;
+  s2.insert(mystl::move(nh));
+  CHECK(s2.contains("b") && nh.empty());
+  CHECK(!s.insert(std::string("a")).second);
+  s.erase(s.begin(), s.end());
+  CHECK(s.empty());
+}
+
+void concurrent_hash_map_check()
+{
+  mystl::concurrent_hash_map<int, std::string> m(8);
+  CHECK(m.shard_count() == 8 && m.empty());
+  CHECK(m.insert_or_assign(1, std::string("a")));
+  CHECK(!m.insert_or_assign(1, std::string("b")));
+  std::string v;
+  CHECK(m.find(1, v) && v == "b");
+  CHECK(!m.find(2, v));
+  CHECK(m.try_emplace(2, 3, 'x'));
+  CHECK(!m.try_emplace(2, "no"));
+  m.visit(2, [](mystl::pair<const int, std::string>& p) { p.second += "y"; });
+  CHECK(m.find(2, v) && v == "xxxy");
+  CHECK(m.erase_if(2, [](const mystl::pair<const int, std::string>& p)
+  {
+    return p.second.size() == 1;
+  }) == 0);
+  CHECK(m.erase_if(2, [](const mystl::pair<const int, std::string>& p)
+  {
+    return p.second.size() == 4;
+  }) == 1);
+  CHECK(m.size() == 1);
+  // 用户函数抛出异常时锁被释放，之后可以继续访问
+  CHECK_THROW(m.visit(1, [](mystl::pair<const int, std::string>&)
+  {
+    throw std::runtime_error("visit");
+  }), std::runtime_error);
+  CHECK(m.insert_or_assign(1, std::string("c")) == false && m.find(1, v) && v == "c");
+  m.clear();
+  CHECK(m.empty());
+
+  // 写线程各自负责互不相交的键：计数器的最终值可以精确预测；
+  // 读线程同时查找，读到的值不能出现中间状态
+  const int writers = 4, keys = 1000, rounds = 20;
+  mystl::concurrent_hash_map<int, long> c;
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> threads;
+  for (int r = 0; r < 2; ++r)
+  {
+    threads.push_back(std::thread([&]
+    {
+      while (!stop.load())
+      {
+        for (int k = 0; k < writers * keys; ++k)
+        {
+          long x;
+          if (c.find(k, x))
+            CHECK(x >= 1 && x <= rounds);
+        }
+        std::this_thread::yield();
+      }
+    }));
+  }
+  std::vector<std::thread> writer_threads;
+  for (int w = 0; w < writers; ++w)
+  {
+    writer_threads.push_back(std::thread([&, w]
+    {
+      for (int round = 0; round < rounds; ++round)
+      {
+        for (int k = w * keys; k < (w + 1) * keys; ++k)
+        {
+          c.try_emplace_or_visit(k, [](mystl::pair<const int, long>& p) { ++p.second; }, 1L);
+        }
+        // 中途删除一部分键，之后的轮次重新插入，计数从 1 重新开始
+        if (round == rounds / 2)
+        {
+          for (int k = w * keys; k < (w + 1) * keys; k += 10)
+            c.erase(k);
+        }
+      }
+    }));
+  }
+  for (auto& t : writer_threads)
+    t.join();
+  stop.store(true);
+  for (auto& t : threads)
+    t.join();
+  CHECK(c.size() == static_cast<size_t>(writers * keys));
+  for (int k = 0; k < writers * keys; ++k)
+  {
+    long x = 0;
+    CHECK(c.find(k, x));
+    CHECK(x == (k % keys % 10 == 0 ? rounds - rounds / 2 - 1 : rounds));
+  }
+  long total = 0;
+  c.visit_all([&](const mystl::pair<const int, long>& p) { total += p.second; });
+  CHECK(total == static_cast<long>(writers) * (keys * rounds - keys / 10 * (rounds / 2 + 1)));
+}
+
+void hash_test()
+{
+  check_header("hash");
+  flat_hash_map_check();
+  hash_function_check();
+  unordered_map_check();
+  concurrent_hash_map_check();
+}
+
+} // namespace hash_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_HASH_TEST_H_
@@ -0,0 +1,263 @@
+#ifndef MYTINYSTL_HEAP_BENCH_H_
+#define MYTINYSTL_HEAP_BENCH_H_
+
+// heap bench : 比较 priority_queue 在不同叉数下与二叉堆 push_heap / pop_heap 的 push、pop 性能
+// heap compare bench : 统计自底向上(Floyd)下溯与经典自顶向下下溯在 heap sort、partial_sort 中的比较次数
+// radix heap bench   : 在单调的事件调度负载上比较 radix_heap 与二叉堆 / 4 叉堆的 priority_queue
+
+#include "../vector.h"
+#include "../queue.h"
+#include "../radix_heap.h"
+#include "bench.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace heap_bench
+{
+
+// 基准 : 直接在 vector 上调用二叉堆的 push_heap / pop_heap
+inline void run_binary_heap(const mystl::vector<unsigned>& input)
+{
+  mystl::vector<unsigned> c;
+  bench_timer t;
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    c.push_back(input[i]);
+    mystl::push_heap(c.begin(), c.end());
+  }
+  const double push_ms = t.ms();
+  t.reset();
+  unsigned long long sum = 0;
+  while (!c.empty())
+  {
+    sum += c.front();
+    mystl::pop_heap(c.begin(), c.end());
+    c.pop_back();
+  }
+  const double pop_ms = t.ms();
+  bench_keep(sum);
+  bench_row("binary push_heap", input.size(), push_ms);
+  bench_row("binary pop_heap", input.size(), pop_ms);
+}
+
+template <size_t Arity>
+void run_priority_queue(const mystl::vector<unsigned>& input)
+{
+  mystl::priority_queue<unsigned, mystl::vector<unsigned>,
+                        mystl::less<unsigned>, Arity> q;
+  bench_timer t;
+  for (size_t i = 0; i < input.size(); ++i)
+    q.push(input[i]);
+  const double push_ms = t.ms();
+  t.reset();
+  unsigned long long sum = 0;
+  while (!q.empty())
+  {
+    sum += q.top();
+    q.pop();
+  }
+  const double pop_ms = t.ms();
+  bench_keep(sum);
+  char name[64];
+  std::snprintf(name, sizeof(name), "priority_queue<%zu> push", Arity);
+  bench_row(name, input.size(), push_ms);
+  std::snprintf(name, sizeof(name), "priority_queue<%zu> pop", Arity);
+  bench_row(name, input.size(), pop_ms);
+}
+
+void heap_bench()
+{
+  bench_header("priority_queue");
+  for (size_t i = 0; i < bench_len_count(); ++i)
+  {
+    const size_t len = bench_len(i);
+    mystl::vector<unsigned> input;
+    input.reserve(len);
+    bench_rng rng;
+    for (size_t j = 0; j < len; ++j)
+      input.push_back(static_cast<unsigned>(rng.next()));
+    run_binary_heap(input);
+    run_priority_queue<2>(input);
+    run_priority_queue<4>(input);
+    run_priority_queue<8>(input);
+  }
+}
+
+// 计数比较器，记录 operator() 被调用的次数
+struct counting_less
+{
+  unsigned long long* count;
+
+  explicit counting_less(unsigned long long* c) :count(c) {}
+
+  bool operator()(unsigned lhs, unsigned rhs) const
+  {
+    ++*count;
+    return lhs < rhs;
+  }
+};
+
+// 作为对照的经典自顶向下下溯 : 每层先比较两个子节点，再与 value 比较
+template <class RandomIter, class Distance, class T, class Compared>
+void top_down_adjust_heap(RandomIter first, Distance holeIndex, Distance len, T value,
+                          Compared comp)
+{
+  auto child = 2 * holeIndex + 1;
+  while (child < len)
+  {
+    if (child + 1 < len && comp(*(first + child), *(first + child + 1)))
+      ++child;
+    if (!comp(value, *(first + child)))
+      break;
+    *(first + holeIndex) = mystl::move(*(first + child));
+    holeIndex = child;
+    child = 2 * holeIndex + 1;
+  }
+  *(first + holeIndex) = mystl::move(value);
+}
+
+template <class RandomIter, class Compared>
+void top_down_sort_heap(RandomIter first, RandomIter last, Compared comp)
+{
+  while (last - first > 1)
+  {
+    --last;
+    auto value = mystl::move(*last);
+    *last = mystl::move(*first);
+    top_down_adjust_heap(first, static_cast<ptrdiff_t>(0),
+                         static_cast<ptrdiff_t>(last - first), mystl::move(value), comp);
+  }
+}
+
+inline void compare_row(const char* what, size_t len, unsigned long long count, double ms)
+{
+  std::printf("| %-28s | %11zu | %14llu cmp | %12.2f ms |\n", what, len, count, ms);
+}
+
+void heap_compare_bench()
+{
+  bench_header("heap comparisons");
+  for (size_t i = 0; i < bench_len_count(); ++i)
+  {
+    const size_t len = bench_len(i);
+    mystl::vector<unsigned> input;
+    input.reserve(len);
+    bench_rng rng;
+    for (size_t j = 0; j < len; ++j)
+      input.push_back(static_cast<unsigned>(rng.next()));
+
+    unsigned long long count = 0;
+    mystl::vector<unsigned> v(input);
+    mystl::make_heap(v.begin(), v.end(), counting_less(&count));
+    count = 0;
+    bench_timer t;
+    mystl::sort_heap(v.begin(), v.end(), counting_less(&count));
+    compare_row("sort_heap bottom-up", len, count, t.ms());
+
+    count = 0;
+    v = input;
+    mystl::make_heap(v.begin(), v.end(), counting_less(&count));
+    count = 0;
+    t.reset();
+    top_down_sort_heap(v.begin(), v.end(), counting_less(&count));
+    compare_row("sort_heap top-down", len, count, t.ms());
+
+    count = 0;
+    v = input;
+    t.reset();
+    mystl::partial_sort(v.begin(), v.begin() + len / 100, v.end(), counting_less(&count));
+    compare_row("partial_sort 1% bottom-up", len, count, t.ms());
+  }
+}
+
+// 事件调度负载 : 先放入 len 个事件，然后反复取出最早的事件并在其之后安排一个新事件，最后全部取出
+struct bench_event
+{
+  unsigned long long time;
+  unsigned           id;
+};
+
+struct bench_event_later
+{
+  bool operator()(const bench_event& lhs, const bench_event& rhs) const
+  {
+    return lhs.time > rhs.time;
+  }
+};
+
+template <size_t Arity>
+void run_event_priority_queue(const mystl::vector<unsigned>& input)
+{
+  mystl::priority_queue<bench_event, mystl::vector<bench_event>,
+                        bench_event_later, Arity> q;
+  bench_timer t;
+  for (size_t i = 0; i < input.size(); ++i)
+    q.push(bench_event{ input[i] & 0xfffff, static_cast<unsigned>(i) });
+  unsigned long long sum = 0;
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    const auto e = q.top();
+    q.pop();
+    sum += e.id;
+    q.push(bench_event{ e.time + 1 + (input[i] >> 16), e.id });
+  }
+  while (!q.empty())
+  {
+    sum += q.top().id;
+    q.pop();
+  }
+  const double ms = t.ms();
+  bench_keep(sum);
+  char name[64];
+  std::snprintf(name, sizeof(name), "priority_queue<%zu> events", Arity);
+  bench_row(name, input.size(), ms);
+}
+
+inline void run_event_radix_heap(const mystl::vector<unsigned>& input)
+{
+  mystl::radix_heap<unsigned long long, unsigned> q;
+  bench_timer t;
+  for (size_t i = 0; i < input.size(); ++i)
+    q.push(input[i] & 0xfffff, static_cast<unsigned>(i));
+  unsigned long long sum = 0;
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    const auto time = q.top_key();
+    const auto id = q.top_value();
+    q.pop();
+    sum += id;
+    q.push(time + 1 + (input[i] >> 16), id);
+  }
+  while (!q.empty())
+  {
+    sum += q.top_value();
+    q.pop();
+  }
+  const double ms = t.ms();
+  bench_keep(sum);
+  bench_row("radix_heap events", input.size(), ms);
+}
+
+void radix_heap_bench()
+{
+  bench_header("radix_heap");
+  for (size_t i = 0; i < bench_len_count(); ++i)
+  {
+    const size_t len = bench_len(i);
+    mystl::vector<unsigned> input;
+    input.reserve(len);
+    bench_rng rng;
+    for (size_t j = 0; j < len; ++j)
+      input.push_back(static_cast<unsigned>(rng.next()));
+    run_event_priority_queue<2>(input);
+    run_event_priority_queue<4>(input);
+    run_event_radix_heap(input);
+  }
+}
+
+} // namespace heap_bench
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_HEAP_BENCH_H_
@@ -0,0 +1,330 @@
+#ifndef MYTINYSTL_HEAP_TEST_H_
+#define MYTINYSTL_HEAP_TEST_H_
+
+// heap test : priority_queue 与 std::priority_queue 的差分测试；
+// heap 算法与 std::sort / std::is_heap 的比较，自底向上下溯的比较次数，以及只移动元素；
+// indexed_priority_queue 与 std::map 的差分测试，包括负数的键；
+// minmax_priority_queue 与 std::multiset 的差分测试；
+// radix_heap 与 std::priority_queue 的差分测试
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <queue>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../algo.h"
+#include "../heap_algo.h"
+#include "../queue.h"
+#include "../radix_heap.h"
+#include "../vector.h"
+#include "check.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace heap_test
+{
+
+template <size_t Arity>
+void priority_queue_check()
+{
+  bench_rng rng;
+  mystl::priority_queue<int, mystl::vector<int>, mystl::less<int>, Arity> q;
+  std::priority_queue<int> ref;
+  for (int i = 0; i < 100000; ++i)
+  {
+    const int x = static_cast<int>(rng.next() % 1000);
+    if (x < 600 || ref.empty())
+    {
+      q.push(x);
+      ref.push(x);
+    }
+    else
+    {
+      CHECK(q.top() == ref.top());
+      q.pop();
+      ref.pop();
+    }
+    CHECK(q.size() == ref.size());
+  }
+  while (!ref.empty())
+  {
+    CHECK(q.top() == ref.top());
+    q.pop();
+    ref.pop();
+  }
+  CHECK(q.empty());
+
+  int a[] = { 3, 1, 4, 1, 5, 9, 2, 6 };
+  mystl::priority_queue<int, mystl::vector<int>, mystl::greater<int>, Arity> g(a, a + 8);
+  int prev = -1;
+  while (!g.empty())
+  {
+    CHECK(g.top() >= prev);
+    prev = g.top();
+    g.pop();
+  }
+}
+
+// 计数比较器
+struct counting_less
+{
+  size_t* count;
+
+  explicit counting_less(size_t* c) :count(c) {}
+
+  bool operator()(int lhs, int rhs) const
+  {
+    ++*count;
+    return lhs < rhs;
+  }
+};
+
+struct unique_less
+{
+  bool operator()(const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) const
+  { return *a < *b; }
+};
+
+void heap_algo_check()
+{
+  bench_rng rng;
+  for (size_t n : { 0, 1, 2, 3, 17, 1000, 100000 })
+  {
+    std::vector<int> ref(n);
+    for (auto& x : ref)
+      x = static_cast<int>(rng.next() % (n + 1));
+    mystl::vector<int> v(ref.data(), ref.data() + n);
+    std::sort(ref.begin(), ref.end());
+
+    mystl::make_heap(v.begin(), v.end());
+    CHECK(std::is_heap(v.begin(), v.end()));
+    if (n > 0)
+    {
+      // pop_heap 把最大值放到末尾，其余部分仍然是堆
+      mystl::pop_heap(v.begin(), v.end());
+      CHECK(v.back() == ref.back() && std::is_heap(v.begin(), v.end() - 1));
+      mystl::push_heap(v.begin(), v.end());
+      CHECK(std::is_heap(v.begin(), v.end()));
+    }
+    mystl::sort_heap(v.begin(), v.end());
+    CHECK(std::equal(v.begin(), v.end(), ref.begin()));
+
+    // 自底向上的下溯每层只比较两个子节点，总比较次数约为 n * log2(n)
+    size_t count = 0;
+    mystl::make_heap(v.begin(), v.end(), counting_less(&count));
+    count = 0;
+    mystl::sort_heap(v.begin(), v.end(), counting_less(&count));
+    CHECK(std::equal(v.begin(), v.end(), ref.begin()));
+    if (n >= 1000)
+      CHECK(static_cast<double>(count) < 1.2 * n * std::log2(static_cast<double>(n)));
+
+    const size_t k = n / 10;
+    mystl::vector<int> p(ref.data(), ref.data() + n);
+    mystl::reverse(p.begin(), p.end());
+    mystl::partial_sort(p.begin(), p.begin() + k, p.end());
+    CHECK(std::equal(p.begin(), p.begin() + k, ref.begin()));
+  }
+
+  // 元素只被移动
+  mystl::vector<std::unique_ptr<int>> u;
+  for (int i = 0; i < 1000; ++i)
+    u.push_back(std::unique_ptr<int>(new int(static_cast<int>(rng.next() % 100))));
+  mystl::make_heap(u.begin(), u.end(), unique_less());
+  mystl::sort_heap(u.begin(), u.end(), unique_less());
+  for (size_t i = 1; i < u.size(); ++i)
+    CHECK(*u[i - 1] <= *u[i]);
+}
+
+void minmax_priority_queue_check()
+{
+  bench_rng rng;
+  mystl::minmax_priority_queue<int> q;
+  std::multiset<int> ref;
+  for (int i = 0; i < 100000; ++i)
+  {
+    const int op = static_cast<int>(rng.next() % 4);
+    if (op < 2 || ref.empty())
+    {
+      const int x = static_cast<int>(rng.next() % 1000);
+      q.push(x);
+      ref.insert(x);
+    }
+    else if (op == 2)
+    {
+      CHECK(q.min() == *ref.begin());
+      q.pop_min();
+      ref.erase(ref.begin());
+    }
+    else
+    {
+      CHECK(q.max() == *ref.rbegin());
+      q.pop_max();
+      ref.erase(std::prev(ref.end()));
+    }
+    CHECK(q.size() == ref.size());
+  }
+
+  // 由区间建堆的各种规模
+  for (int n = 0; n < 100; ++n)
+  {
+    mystl::vector<int> v;
+    std::multiset<int> r;
+    for (int i = 0; i < n; ++i)
+    {
+      const int x = static_cast<int>(rng.next() % 50);
+      v.push_back(x);
+      r.insert(x);
+    }
+    mystl::minmax_priority_queue<int> h(v.begin(), v.end());
+    while (!r.empty())
+    {
+      CHECK(h.min() == *r.begin() && h.max() == *r.rbegin());
+      if (rng.next() % 2)
+      {
+        h.pop_max();
+        r.erase(std::prev(r.end()));
+      }
+      else
+      {
+        h.pop_min();
+        r.erase(r.begin());
+      }
+    }
+  }
+}
+
+void indexed_priority_queue_check()
+{
+  bench_rng rng;
+  mystl::indexed_priority_queue<int, long> q;
+  std::map<int, long> prio;
+  std::set<std::pair<long, int>> order;
+  for (int i = 0; i < 100000; ++i)
+  {
+    const int key = static_cast<int>(rng.next() % 2000);
+    const long p = static_cast<long>(rng.next() % 100000);
+    const int op = static_cast<int>(rng.next() % 6);
+    auto it = prio.find(key);
+    CHECK(q.contains(key) == (it != prio.end()));
+    if (op < 2)
+    {
+      q.push_or_update(key, p);
+      if (it != prio.end())
+        order.erase(std::make_pair(it->second, key));
+      prio[key] = p;
+      order.insert(std::make_pair(p, key));
+    }
+    else if (op == 2 && it != prio.end() && p <= it->second)
+    {
+      q.decrease_key(key, p);
+      order.erase(std::make_pair(it->second, key));
+      it->second = p;
+      order.insert(std::make_pair(p, key));
+    }
+    else if (op == 3 && it != prio.end() && p >= it->second)
+    {
+      q.increase_key(key, p);
+      order.erase(std::make_pair(it->second, key));
+      it->second = p;
+      order.insert(std::make_pair(p, key));
+    }
+    else if (op == 4)
+    {
+      CHECK(q.erase(key) == (it != prio.end()));
+      if (it != prio.end())
+      {
+        order.erase(std::make_pair(it->second, key));
+        prio.erase(it);
+      }
+    }
+    else if (!order.empty())
+    {
+      // 优先级相同的键之间没有规定顺序，只比较优先级
+      CHECK(q.top_priority() == order.begin()->first);
+      const int top = q.top_key();
+      CHECK(prio.count(top) == 1 && prio[top] == q.top_priority());
+      q.pop();
+      order.erase(std::make_pair(prio[top], top));
+      prio.erase(top);
+    }
+    CHECK(q.size() == prio.size());
+  }
+  for (const auto& kv : prio)
+    CHECK(q.priority(kv.first) == kv.second);
+
+  // 负数的键
+  CHECK(!q.contains(-1));
+  CHECK_THROW(q.push(-1, 0), std::out_of_range);
+  CHECK_THROW(q.push_or_update(-7, 0), std::out_of_range);
+  CHECK(q.size() == prio.size());
+  q.clear();
+  CHECK(q.empty() && !q.contains(0));
+}
+
+template <class Key>
+void radix_heap_run(Key start)
+{
+  typedef std::pair<Key, int> entry;
+  bench_rng rng;
+  mystl::radix_heap<Key, int> h;
+  std::priority_queue<entry, std::vector<entry>, std::greater<entry>> ref;
+  Key last = start;
+  for (int i = 0; i < 100000; ++i)
+  {
+    if (rng.next() % 2 && !ref.empty())
+    {
+      CHECK(h.top_key() == ref.top().first);
+      last = h.top_key();
+      h.pop();
+      ref.pop();
+    }
+    else
+    {
+      // 单调性 : 新键不小于最近弹出的键
+      const Key k = static_cast<Key>(last + static_cast<Key>(rng.next() % 1000));
+      h.push(k, i);
+      ref.push(entry(k, i));
+    }
+    CHECK(h.size() == ref.size());
+  }
+}
+
+void radix_heap_check()
+{
+  radix_heap_run<unsigned>(0);
+  radix_heap_run<int>(-100000);
+  radix_heap_run<long long>(-100000);
+
+  mystl::radix_heap<int, std::string> a;
+  a.push(-5, "x");
+  a.push(3, "y");
+  mystl::radix_heap<int, std::string> b(mystl::move(a));
+  CHECK(b.top_key() == -5 && b.top_value() == "x" && a.empty());
+}
+
+void heap_test()
+{
+  check_header("heap");
+  priority_queue_check<2>();
+  priority_queue_check<4>();
+  priority_queue_check<8>();
+  heap_algo_check();
+  indexed_priority_queue_check();
+  minmax_priority_queue_check();
+  radix_heap_check();
+}
+
+} // namespace heap_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_HEAP_TEST_H_
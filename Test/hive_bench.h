@@ -0,0 +1,43 @@
+#ifndef MYTINYSTL_HIVE_BENCH_H_
+#define MYTINYSTL_HIVE_BENCH_H_
+
+// hive bench : 在高频插入删除的对象池负载上比较 hive 与 list，两者的迭代器在删除其它元素后都保持有效，
+// 负载与 slot map bench 相同：插入、随机删除一半再插回 (churn)、按迭代器随机访问与遍历全部元素
+
+#include "../hive.h"
+#include "slot_map_bench.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace hive_bench
+{
+
+typedef slot_map_bench::entity entity;
+
+struct hive_policy
+{
+  typedef mystl::hive<entity>           table;
+  typedef mystl::hive<entity>::iterator handle;
+
+  static handle   add(table& t, unsigned i)          { return t.emplace(i); }
+  static void     remove(table& t, const handle& h)  { t.erase(h); }
+  static entity&  get(table&, const handle& h)       { return *h; }
+};
+
+void hive_bench()
+{
+  bench_header("hive");
+  for (size_t i = 0; i < bench_len_count(); ++i)
+  {
+    const size_t len = bench_len(i);
+    slot_map_bench::run_table<hive_policy>("hive", len);
+    slot_map_bench::run_table<slot_map_bench::list_policy>("list", len);
+  }
+}
+
+} // namespace hive_bench
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_HIVE_BENCH_H_
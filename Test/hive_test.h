@@ -0,0 +1,161 @@
+#ifndef MYTINYSTL_HIVE_TEST_H_
+#define MYTINYSTL_HIVE_TEST_H_
+
+// hive test : hive 的元素地址在插入删除中保持不变，正反向遍历与计数一致，
+// 以及构造元素抛出异常时 hive 不变
+
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include "../hive.h"
+#include "check.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace hive_test
+{
+
+// 正向、反向遍历的元素与地址都与 live 一致
+template <class Hive>
+void hive_verify(Hive& h, std::map<long, const std::string*>& live)
+{
+  CHECK(h.size() == live.size() && h.capacity() >= h.size());
+  std::set<long> seen;
+  size_t n = 0;
+  for (auto it = h.begin(); it != h.end(); ++it, ++n)
+  {
+    const long v = std::stol(*it);
+    CHECK(live.count(v) == 1 && live[v] == &*it);
+    CHECK(seen.insert(v).second);
+  }
+  CHECK(n == live.size());
+  size_t r = 0;
+  for (auto it = h.rbegin(); it != h.rend(); ++it)
+    ++r;
+  CHECK(r == n);
+}
+
+// countdown 为正时，使它减到 0 的那次构造抛出异常
+struct throwing_value
+{
+  static int countdown;
+  std::string s;
+
+  explicit throwing_value(int v) :s(std::to_string(v))
+  {
+    if (countdown > 0 && --countdown == 0)
+      throw std::runtime_error("throwing_value");
+  }
+};
+
+int throwing_value::countdown = 0;
+
+void hive_check()
+{
+  bench_rng rng;
+  mystl::hive<std::string> h;
+  std::map<long, const std::string*> live;
+  long next = 0;
+  for (int round = 0; round < 40000; ++round)
+  {
+    const int op = static_cast<int>(rng.next() % 10);
+    if (op < 5)
+    {
+      const int burst = static_cast<int>(rng.next() % 5) + 1;
+      for (int b = 0; b < burst; ++b, ++next)
+      {
+        auto it = h.insert(std::to_string(next));
+        CHECK(*it == std::to_string(next));
+        live[next] = &*it;
+      }
+    }
+    else if (op < 9 && !live.empty())
+    {
+      const int burst = static_cast<int>(rng.next() % 6) + 1;
+      for (int b = 0; b < burst && !live.empty(); ++b)
+      {
+        auto li = live.begin();
+        std::advance(li, rng.next() % live.size());
+        auto it = h.get_iterator(li->second);
+        CHECK(&*it == li->second);
+        auto nx = h.erase(it);
+        live.erase(li);
+        if (nx != h.end())
+          CHECK(live.count(std::stol(*nx)) == 1);
+      }
+    }
+    else if (op == 9 && !live.empty())
+    {
+      // 区间删除
+      auto f = h.begin();
+      for (int k = static_cast<int>(rng.next() % 4); k > 0 && f != h.end(); --k)
+        ++f;
+      auto l = f;
+      for (int k = static_cast<int>(rng.next() % 20); k > 0 && l != h.end(); --k)
+        ++l;
+      for (auto it = f; it != l; ++it)
+        live.erase(std::stol(*it));
+      h.erase(f, l);
+    }
+    if (rng.next() % 3000 == 0)
+    {
+      h.clear();
+      live.clear();
+    }
+    if (round % 37 == 0)
+      hive_verify(h, live);
+  }
+  hive_verify(h, live);
+
+  mystl::hive<std::string> c(h);
+  CHECK(c.size() == h.size());
+  mystl::hive<std::string> mv(mystl::move(c));
+  CHECK(c.empty() && mv.size() == h.size());
+  c = mv;
+  CHECK(c.size() == mv.size());
+  CHECK(h.get_iterator(nullptr) == h.end());
+
+  // 在有空位的 hive 中构造失败，空位与计数都保持不变
+  mystl::hive<throwing_value> t;
+  for (int i = 0; i < 100; ++i)
+    t.emplace(i);
+  int i = 0;
+  for (auto it = t.begin(); it != t.end(); )
+  {
+    if (i++ % 3 == 0)
+      it = t.erase(it);
+    else
+      ++it;
+  }
+  const size_t sz = t.size();
+  throwing_value::countdown = 1;
+  CHECK_THROW(t.emplace(5), std::runtime_error);
+  throwing_value::countdown = 0;
+  CHECK(t.size() == sz && static_cast<size_t>(mystl::distance(t.begin(), t.end())) == sz);
+  for (int k = 0; k < 100; ++k)
+    t.emplace(k);
+  CHECK(static_cast<size_t>(mystl::distance(t.begin(), t.end())) == t.size());
+
+  mystl::hive<int> il{ 1, 2, 3 };
+  int s = 0;
+  for (int x : il)
+    s += x;
+  CHECK(s == 6);
+  il.erase(il.begin(), il.end());
+  CHECK(il.empty() && il.begin() == il.end());
+}
+
+void hive_test()
+{
+  check_header("hive");
+  hive_check();
+}
+
+} // namespace hive_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_HIVE_TEST_H_
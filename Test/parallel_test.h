@@ -0,0 +1,265 @@
+#ifndef MYTINYSTL_PARALLEL_TEST_H_
+#define MYTINYSTL_PARALLEL_TEST_H_
+
+// parallel test : parallel_algo.h 中的并行算法与标准库的差分测试，
+// 覆盖不同的线程数、不超过与超过并行阈值的规模、vector 与 deque 的迭代器；
+// for_each / transform / count_if / find_if / all_of / any_of / none_of；
+// parallel_numeric.h 中的 reduce、transform_reduce 与扫描与串行版本的比较，
+// 包括原地扫描与不可交换的运算；
+// merge 与 inplace_merge 的结果与稳定性，并行的 inplace_merge 只移动不复制元素；
+// partition / partition_copy 与 nth_element
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "../deque.h"
+#include "../parallel_algo.h"
+#include "../parallel_numeric.h"
+#include "../vector.h"
+#include "check.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace parallel_test
+{
+
+const size_t kLens[] = { 0, 1, 1000, 20000, 100001 };
+
+// 0 : 随机，1 : 升序，2 : 大量重复，3 : 降序
+inline std::vector<int> make_input(bench_rng& rng, size_t n, int dist)
+{
+  std::vector<int> v(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    v[i] = dist == 0 ? static_cast<int>(rng.next() % 1000000)
+         : dist == 1 ? static_cast<int>(i)
+         : dist == 2 ? static_cast<int>(rng.next() % 4)
+         : static_cast<int>(n - i);
+  }
+  return v;
+}
+
+// 记录复制次数的元素
+struct counted
+{
+  static size_t copies;
+  std::string s;
+  int         key;
+
+  explicit counted(int k = 0) :s(16, static_cast<char>('a' + k % 26)), key(k) {}
+  counted(const counted& rhs) :s(rhs.s), key(rhs.key) { ++copies; }
+  counted(counted&& rhs) noexcept :s(mystl::move(rhs.s)), key(rhs.key) {}
+  counted& operator=(const counted& rhs) { s = rhs.s; key = rhs.key; ++copies; return *this; }
+  counted& operator=(counted&& rhs) noexcept { s = mystl::move(rhs.s); key = rhs.key; return *this; }
+};
+
+size_t counted::copies = 0;
+
+struct counted_less
+{
+  bool operator()(const counted& a, const counted& b) const { return a.key < b.key; }
+};
+
+void sort_check(mystl::thread_pool& pool)
+{
+  bench_rng rng;
+  const auto policy = mystl::par.on(pool);
+  for (size_t n : kLens)
+  {
+    for (int dist = 0; dist < 4; ++dist)
+    {
+      const std::vector<int> v = make_input(rng, n, dist);
+      std::vector<int> ref = v;
+      std::sort(ref.begin(), ref.end());
+
+      mystl::vector<int> a(v.data(), v.data() + n);
+      mystl::sort(policy, a.begin(), a.end());
+      CHECK(std::equal(a.begin(), a.end(), ref.begin()));
+
+      mystl::deque<int> d;
+      for (int x : v)
+        d.push_back(x);
+      mystl::sort(policy, d.begin(), d.end(), mystl::greater<int>());
+      CHECK(std::equal(d.begin(), d.end(), ref.rbegin()));
+
+      for (size_t k : { n / 3, n / 2, n == 0 ? 0 : n - 1 })
+      {
+        if (k >= n)
+          continue;
+        mystl::vector<int> b(v.data(), v.data() + n);
+        mystl::nth_element(policy, b.begin(), b.begin() + k, b.end());
+        CHECK(b[k] == ref[k]);
+        CHECK(std::all_of(b.begin(), b.begin() + k, [&](int x) { return x <= b[k]; }));
+        CHECK(std::all_of(b.begin() + k, b.end(), [&](int x) { return x >= b[k]; }));
+      }
+    }
+  }
+}
+
+void partition_check(mystl::thread_pool& pool)
+{
+  bench_rng rng;
+  const auto policy = mystl::par.on(pool);
+  auto pred = [](int x) { return x % 3 == 1; };
+  for (size_t n : kLens)
+  {
+    const std::vector<int> v = make_input(rng, n, 0);
+    mystl::vector<int> p(v.data(), v.data() + n);
+    auto cut = mystl::partition(policy, p.begin(), p.end(), pred);
+    CHECK(std::all_of(p.begin(), cut, pred));
+    CHECK(std::none_of(cut, p.end(), pred));
+    std::vector<int> sorted_p(p.begin(), p.end()), sorted_v = v;
+    std::sort(sorted_p.begin(), sorted_p.end());
+    std::sort(sorted_v.begin(), sorted_v.end());
+    CHECK(sorted_p == sorted_v);
+
+    // partition_copy 是稳定的
+    mystl::vector<int> t(n), f(n);
+    auto r = mystl::partition_copy(policy, p.begin(), p.end(), t.begin(), f.begin(), pred);
+    std::vector<int> rt, rf;
+    std::partition_copy(p.begin(), p.end(), std::back_inserter(rt), std::back_inserter(rf), pred);
+    CHECK(static_cast<size_t>(r.first - t.begin()) == rt.size());
+    CHECK(static_cast<size_t>(r.second - f.begin()) == rf.size());
+    CHECK(std::equal(rt.begin(), rt.end(), t.begin()));
+    CHECK(std::equal(rf.begin(), rf.end(), f.begin()));
+  }
+}
+
+void merge_check(mystl::thread_pool& pool)
+{
+  bench_rng rng;
+  const auto policy = mystl::par.on(pool);
+  for (size_t n : kLens)
+  {
+    const size_t m = n == 0 ? 0 : static_cast<size_t>(rng.next() % n);
+    std::vector<int> v = make_input(rng, n, 2);
+    std::sort(v.begin(), v.begin() + m);
+    std::sort(v.begin() + m, v.end());
+    std::vector<int> ref(n);
+    std::merge(v.begin(), v.begin() + m, v.begin() + m, v.end(), ref.begin());
+
+    mystl::vector<int> a(v.data(), v.data() + n), out(n);
+    CHECK(mystl::merge(policy, a.begin(), a.begin() + m, a.begin() + m, a.end(), out.begin())
+          == out.end());
+    CHECK(std::equal(out.begin(), out.end(), ref.begin()));
+    mystl::inplace_merge(policy, a.begin(), a.begin() + m, a.end());
+    CHECK(std::equal(a.begin(), a.end(), ref.begin()));
+
+    // 相等的元素保持前一段在前，且元素只被移动
+    mystl::vector<counted> c;
+    for (size_t i = 0; i < n; ++i)
+      c.push_back(counted(v[i]));
+    for (size_t i = 0; i < n; ++i)
+      c[i].s = std::to_string(i < m ? 0 : 1);
+    counted::copies = 0;
+    mystl::inplace_merge(policy, c.begin(), c.begin() + m, c.end(), counted_less());
+    if (pool.size() > 1 && n > mystl::kParallelGrain)
+      CHECK(counted::copies == 0);
+    for (size_t i = 0; i < n; ++i)
+    {
+      CHECK(c[i].key == ref[i]);
+      if (i > 0 && c[i].key == c[i - 1].key)
+        CHECK(c[i - 1].s <= c[i].s);
+    }
+  }
+}
+
+void for_each_check(mystl::thread_pool& pool)
+{
+  const auto policy = mystl::par.on(pool);
+  for (size_t n : kLens)
+  {
+    mystl::vector<int> v(n);
+    mystl::deque<int> d;
+    for (size_t i = 0; i < n; ++i)
+    {
+      v[i] = static_cast<int>(i);
+      d.push_back(static_cast<int>(i));
+    }
+    auto third = [](int x) { return x % 3 == 0; };
+    CHECK(static_cast<size_t>(mystl::count_if(policy, v.begin(), v.end(), third)) == (n + 2) / 3);
+    CHECK(static_cast<size_t>(mystl::count_if(policy, d.begin(), d.end(), third)) == (n + 2) / 3);
+    for (size_t target : { size_t(0), n / 3, n / 2, n })
+    {
+      auto pred = [target](int x) { return x >= static_cast<int>(target) && x % 7 == 0; };
+      CHECK(mystl::find_if(policy, v.begin(), v.end(), pred) - v.begin() ==
+            std::find_if(v.begin(), v.end(), pred) - v.begin());
+      CHECK(mystl::find_if(policy, d.begin(), d.end(), pred) - d.begin() ==
+            std::find_if(v.begin(), v.end(), pred) - v.begin());
+    }
+    CHECK(mystl::all_of(policy, v.begin(), v.end(), [](int x) { return x >= 0; }));
+    CHECK(!mystl::any_of(policy, v.begin(), v.end(), [](int x) { return x < 0; }));
+    CHECK(mystl::none_of(policy, v.begin(), v.end(), [](int x) { return x < 0; }));
+
+    mystl::for_each(policy, v.begin(), v.end(), [](int& x) { x *= 2; });
+    mystl::vector<long> out(n);
+    CHECK(mystl::transform(policy, v.begin(), v.end(), out.begin(),
+                           [](int x) { return static_cast<long>(x) + 1; }) == out.end());
+    for (size_t i = 0; i < n; ++i)
+      CHECK(out[i] == static_cast<long>(i) * 2 + 1);
+  }
+}
+
+void numeric_check(mystl::thread_pool& pool)
+{
+  bench_rng rng;
+  const auto policy = mystl::par.on(pool);
+  for (size_t n : kLens)
+  {
+    mystl::vector<long long> v(n);
+    for (auto& x : v)
+      x = static_cast<long long>(rng.next() % 1000) - 500;
+    mystl::deque<long long> d;
+    for (auto x : v)
+      d.push_back(x);
+
+    CHECK(mystl::reduce(policy, v.begin(), v.end()) == mystl::reduce(v.begin(), v.end()));
+    CHECK(mystl::reduce(policy, d.begin(), d.end(), 7LL) == mystl::reduce(v.begin(), v.end(), 7LL));
+    CHECK(mystl::transform_reduce(policy, v.begin(), v.end(), d.begin(), 3LL) ==
+          mystl::transform_reduce(v.begin(), v.end(), v.begin(), 3LL));
+
+    mystl::vector<long long> r1(n), r2(n);
+    mystl::inclusive_scan(v.begin(), v.end(), r1.begin());
+    CHECK(mystl::inclusive_scan(policy, v.begin(), v.end(), r2.begin()) == r2.end());
+    CHECK(r1 == r2);
+    mystl::exclusive_scan(v.begin(), v.end(), r1.begin(), 9LL);
+    mystl::exclusive_scan(policy, d.begin(), d.end(), r2.begin(), 9LL);
+    CHECK(r1 == r2);
+
+    // 原地扫描
+    mystl::vector<long long> w = v;
+    mystl::inclusive_scan(v.begin(), v.end(), r1.begin());
+    mystl::inclusive_scan(policy, w.begin(), w.end(), w.begin());
+    CHECK(r1 == w);
+
+    // 不可交换的运算也要保持顺序
+    mystl::vector<std::string> s(n % 5000);
+    for (size_t i = 0; i < s.size(); ++i)
+      s[i] = std::string(1, static_cast<char>('a' + i % 26));
+    auto cat = [](const std::string& a, const std::string& b) { return a + b; };
+    CHECK(mystl::reduce(policy, s.begin(), s.end(), std::string(), cat) ==
+          mystl::reduce(s.begin(), s.end(), std::string(), cat));
+  }
+}
+
+void parallel_test()
+{
+  check_header("parallel");
+  for (size_t threads : { 1, 2, 4 })
+  {
+    mystl::thread_pool pool(threads);
+    sort_check(pool);
+    for_each_check(pool);
+    numeric_check(pool);
+    merge_check(pool);
+    partition_check(pool);
+  }
+}
+
+} // namespace parallel_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_PARALLEL_TEST_H_
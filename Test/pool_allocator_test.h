@@ -0,0 +1,144 @@
+#ifndef MYTINYSTL_POOL_ALLOCATOR_TEST_H_
+#define MYTINYSTL_POOL_ALLOCATOR_TEST_H_
+
+// pool allocator test : 节点在一个线程分配、在另一个线程回收时经过全局链表回到分配的线程，
+// 反复进行后内存池不再申请新块；线程缓存析构之后回收的节点同样回到全局链表
+
+#include <atomic>
+#include <thread>
+
+#include "../map.h"
+#include "../mpmc_queue.h"
+#include "../pool_allocator.h"
+#include "check.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace pool_allocator_test
+{
+
+typedef mystl::map<int, int> int_map;
+
+inline int_map* make_map(int n)
+{
+  auto m = new int_map;
+  for (int i = 0; i < n; ++i)
+    (*m)[i] = i;
+  return m;
+}
+
+void basic_check()
+{
+  typedef mystl::pool_allocator<long> alloc;
+  long* p = alloc::allocate();
+  long* q = alloc::allocate(1);
+  CHECK(p != nullptr && q != nullptr && p != q);
+  CHECK(reinterpret_cast<size_t>(p) % alignof(long) == 0);
+  alloc::deallocate(p);
+  alloc::deallocate(q, 1);
+  // 再次分配得到刚回收的节点
+  long* r = alloc::allocate();
+  CHECK(r == q || r == p);
+  alloc::deallocate(r);
+  long* arr = alloc::allocate(100);
+  for (int i = 0; i < 100; ++i)
+    arr[i] = i;
+  alloc::deallocate(arr, 100);
+}
+
+// 每轮由一个新线程删除主线程建好的 map，线程退出时交还全部节点
+void short_lived_check()
+{
+  const int n = 50000;
+  void* warm = nullptr;
+  for (int round = 0; round < 12; ++round)
+  {
+    int_map* m = make_map(n);
+    std::thread t([m] { delete m; });
+    t.join();
+    if (round == 2)
+      warm = pool_detail::chunk_list().load();
+    if (round > 2)
+      CHECK(pool_detail::chunk_list().load() == warm);
+  }
+}
+
+// 长期存活的线程不断回收主线程分配的节点，超过两批的空闲节点交给全局链表
+void long_lived_check()
+{
+  const int n = 50000;
+  mystl::mpmc_queue<int_map*> q(4);
+  std::atomic<int> deleted(0);
+  std::thread worker([&]
+  {
+    int_map* m = nullptr;
+    for (;;)
+    {
+      q.pop(m);
+      if (m == nullptr)
+        break;
+      delete m;
+      deleted.fetch_add(1);
+    }
+  });
+  void* warm = nullptr;
+  for (int round = 0; round < 12; ++round)
+  {
+    q.push(make_map(n));
+    while (deleted.load() != round + 1)
+      std::this_thread::yield();
+    if (round == 2)
+      warm = pool_detail::chunk_list().load();
+    if (round > 2)
+      CHECK(pool_detail::chunk_list().load() == warm);
+  }
+  q.push(nullptr);
+  worker.join();
+}
+
+// 线程退出时 thread_local 对象按构造的逆序析构，
+// 先于内存池的线程缓存构造的对象在缓存析构之后才分配、回收节点
+struct exit_holder
+{
+  int_map* m = nullptr;
+  ~exit_holder()
+  {
+    (*m)[-1] = -1;
+    delete m;
+  }
+};
+
+void teardown_check()
+{
+  const int n = 50000;
+  void* warm = nullptr;
+  for (int round = 0; round < 12; ++round)
+  {
+    std::thread t([]
+    {
+      static thread_local exit_holder h;
+      h.m = make_map(n);
+    });
+    t.join();
+    if (round == 2)
+      warm = pool_detail::chunk_list().load();
+    if (round > 2)
+      CHECK(pool_detail::chunk_list().load() == warm);
+  }
+}
+
+void pool_allocator_test()
+{
+  check_header("pool_allocator");
+  basic_check();
+  short_lived_check();
+  long_lived_check();
+  teardown_check();
+}
+
+} // namespace pool_allocator_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_POOL_ALLOCATOR_TEST_H_
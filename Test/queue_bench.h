@@ -0,0 +1,134 @@
+#ifndef MYTINYSTL_QUEUE_BENCH_H_
+#define MYTINYSTL_QUEUE_BENCH_H_
+
+// mpmc bench : 在 1、4、16、64 个线程下比较 mpmc_queue 与 mutex 保护的 queue<T, deque<T>> 的吞吐量
+// 线程数为 1 时由同一个线程交替 push / pop，否则一半线程生产、一半线程消费
+
+#include <mutex>
+#include <thread>
+
+#include "../deque.h"
+#include "../queue.h"
+#include "../vector.h"
+#include "../mpmc_queue.h"
+#include "bench.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace queue_bench
+{
+
+// 对照组 : 一把锁保护的 queue，队列空时让出时间片
+class locked_queue
+{
+public:
+  void push(size_t v)
+  {
+    std::lock_guard<std::mutex> lk(m_);
+    q_.push(v);
+  }
+
+  void pop(size_t& v)
+  {
+    for (;;)
+    {
+      {
+        std::lock_guard<std::mutex> lk(m_);
+        if (!q_.empty())
+        {
+          v = q_.front();
+          q_.pop();
+          return;
+        }
+      }
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  std::mutex                                      m_;
+  mystl::queue<size_t, mystl::deque<size_t>>      q_;
+};
+
+// 用 threads 个线程在 q 上传递 len 个元素，返回毫秒数
+template <class Queue>
+double run_queue(Queue& q, size_t threads, size_t len)
+{
+  bench_timer t;
+  if (threads == 1)
+  {
+    size_t sum = 0, v = 0;
+    for (size_t i = 0; i < len; ++i)
+    {
+      q.push(i);
+      q.pop(v);
+      sum += v;
+    }
+    bench_keep(sum);
+    return t.ms();
+  }
+  const size_t producers = threads / 2;
+  const size_t consumers = threads - producers;
+  mystl::vector<std::thread> pool;
+  mystl::vector<size_t> sums(consumers, 0);
+  pool.reserve(threads);
+  for (size_t p = 0; p < producers; ++p)
+  {
+    pool.push_back(std::thread([&q, p, producers, len]
+    {
+      for (size_t i = p; i < len; i += producers)
+        q.push(i);
+    }));
+  }
+  for (size_t c = 0; c < consumers; ++c)
+  {
+    const size_t n = len / consumers + (c < len % consumers ? 1 : 0);
+    size_t* sum = &sums[c];
+    pool.push_back(std::thread([&q, n, sum]
+    {
+      size_t v = 0;
+      for (size_t i = 0; i < n; ++i)
+      {
+        q.pop(v);
+        *sum += v;
+      }
+    }));
+  }
+  for (size_t i = 0; i < pool.size(); ++i)
+    pool[i].join();
+  const double ms = t.ms();
+  bench_keep(sums);
+  return ms;
+}
+
+inline void throughput_row(const char* what, size_t threads, size_t len, double ms)
+{
+  std::printf("| %-20s | %3zu threads | %11zu | %12.2f ms | %8.2f Mops/s |\n",
+              what, threads, len, ms, ms > 0 ? len / ms / 1000.0 : 0.0);
+}
+
+void mpmc_bench()
+{
+  bench_header("mpmc_queue");
+  static const size_t thread_counts[] = { 1, 4, 16, 64 };
+  const size_t len = bench_len(0);
+  for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); ++i)
+  {
+    const size_t threads = thread_counts[i];
+    {
+      mystl::mpmc_queue<size_t> q(1024);
+      throughput_row("mpmc_queue", threads, len, run_queue(q, threads, len));
+    }
+    {
+      locked_queue q;
+      throughput_row("mutex + queue<deque>", threads, len, run_queue(q, threads, len));
+    }
+  }
+}
+
+} // namespace queue_bench
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_QUEUE_BENCH_H_
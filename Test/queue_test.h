@@ -0,0 +1,356 @@
+#ifndef MYTINYSTL_QUEUE_TEST_H_
+#define MYTINYSTL_QUEUE_TEST_H_
+
+// queue test : circular_buffer 与 std::deque 的差分测试，以及以它为底层容器的 queue / stack；
+// spsc_queue 的生产者 / 消费者测试 : 保持先进先出，构造元素抛出异常时队列不变；
+// mpmc_queue 的多线程压力测试 : 每个元素恰好被取出一次；
+// ws_deque 的 owner 与多个窃取线程的压力测试 : 每个元素恰好被一个线程取得
+
+#include <atomic>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../circular_buffer.h"
+#include "../mpmc_queue.h"
+#include "../queue.h"
+#include "../spsc_queue.h"
+#include "../stack.h"
+#include "../ws_deque.h"
+#include "check.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace queue_test
+{
+
+// countdown 为正时，使它减到 0 的那次复制抛出异常
+struct throwing_string
+{
+  static int countdown;
+  std::string s;
+
+  explicit throwing_string(const std::string& v) :s(v) {}
+  throwing_string(const throwing_string& rhs) :s(rhs.s)
+  {
+    if (countdown > 0 && --countdown == 0)
+      throw std::runtime_error("throwing_string");
+  }
+};
+
+int throwing_string::countdown = 0;
+
+void circular_buffer_check()
+{
+  bench_rng rng;
+  mystl::circular_buffer<std::string> c;
+  std::deque<std::string> ref;
+  for (int i = 0; i < 100000; ++i)
+  {
+    const int op = static_cast<int>(rng.next() % 6);
+    const std::string v = std::to_string(rng.next());
+    if (op == 0)
+    {
+      c.push_back(v);
+      ref.push_back(v);
+    }
+    else if (op == 1)
+    {
+      c.push_front(v);
+      ref.push_front(v);
+    }
+    else if (op == 2 && !ref.empty())
+    {
+      c.pop_front();
+      ref.pop_front();
+    }
+    else if (op == 3 && !ref.empty())
+    {
+      c.pop_back();
+      ref.pop_back();
+    }
+    else if (op == 4)
+    {
+      c.emplace_back(v);
+      ref.emplace_back(v);
+    }
+    CHECK(c.size() == ref.size());
+    if (!ref.empty())
+      CHECK(c.front() == ref.front() && c.back() == ref.back());
+    if (i % 10000 == 0)
+    {
+      for (size_t k = 0; k < ref.size(); ++k)
+        CHECK(c[k] == ref[k]);
+      c.shrink_to_fit();
+    }
+  }
+  size_t k = 0;
+  for (const auto& x : c)
+    CHECK(x == ref[k++]);
+
+  mystl::circular_buffer<std::string> d(c), e;
+  e = c;
+  CHECK(d == c && e == c);
+  mystl::circular_buffer<std::string> f(mystl::move(d));
+  CHECK(f == c && d.empty());
+
+  // 在满的容器两端插入引用容器中元素的参数
+  mystl::circular_buffer<std::string> full;
+  while (full.size() < full.capacity() || full.empty())
+    full.push_back(std::string(40, static_cast<char>('a' + full.size())));
+  const size_t cap = full.capacity();
+  full.push_back(full.front());
+  CHECK(full.capacity() == cap * 2 && full.back() == std::string(40, 'a'));
+  while (full.size() < full.capacity())
+    full.emplace_back(full[full.size() % 7]);
+  full.push_front(full.back());
+  CHECK(full.front() == full.back() && full.front().size() == 40);
+  mystl::queue<std::string> sq;
+  for (int i = 0; i < 16; ++i)
+    sq.push(std::string(40, static_cast<char>('a' + i)));
+  sq.push(sq.front());
+  CHECK(sq.back() == std::string(40, 'a'));
+
+  // 扩容时复制抛出异常，容器保持不变
+  mystl::circular_buffer<throwing_string> t;
+  while (t.size() < t.capacity() || t.empty())
+    t.push_back(throwing_string(std::to_string(t.size())));
+  const size_t tcap = t.capacity();
+  throwing_string extra("extra");
+  for (int countdown = 1; countdown <= 3; ++countdown)
+  {
+    throwing_string::countdown = countdown;
+    CHECK_THROW(t.push_back(extra), std::runtime_error);
+    throwing_string::countdown = countdown;
+    CHECK_THROW(t.push_front(extra), std::runtime_error);
+    throwing_string::countdown = 0;
+    CHECK(t.size() == tcap && t.capacity() == tcap);
+    for (size_t i = 0; i < t.size(); ++i)
+      CHECK(t[i].s == std::to_string(i));
+  }
+
+  mystl::queue<int> q;
+  for (int i = 0; i < 100; ++i)
+    q.push(i);
+  for (int i = 0; i < 50; ++i)
+    q.pop();
+  CHECK(q.front() == 50 && q.back() == 99);
+  mystl::stack<int> s{ 1, 2, 3 };
+  CHECK(s.top() == 3);
+}
+
+void spsc_queue_check()
+{
+  mystl::spsc_queue<std::string> q(1000);
+  CHECK(q.capacity() == 1024 && q.empty());
+
+  // 生产者与消费者交替使用单个与批量接口，消费者按顺序核对
+  const long n = 200000;
+  std::thread producer([&]
+  {
+    std::string buf[7];
+    long i = 0;
+    while (i < n)
+    {
+      if (i % 3 == 0)
+      {
+        long k = 0;
+        for (; k < 7 && i + k < n; ++k)
+          buf[k] = std::to_string(i + k);
+        i += static_cast<long>(q.try_push_n(buf, static_cast<size_t>(k)));
+      }
+      else if (q.try_push(std::to_string(i)))
+      {
+        ++i;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::string out[5];
+  long j = 0;
+  while (j < n)
+  {
+    size_t got = 0;
+    if (j % 2)
+    {
+      got = q.try_pop_n(out, 5);
+      for (size_t t = 0; t < got; ++t, ++j)
+        CHECK(out[t] == std::to_string(j));
+    }
+    else
+    {
+      std::string s;
+      if (q.try_pop(s))
+      {
+        CHECK(s == std::to_string(j));
+        ++j;
+        got = 1;
+      }
+    }
+    if (got == 0)
+      std::this_thread::yield();
+  }
+  producer.join();
+  CHECK(q.empty());
+
+  // 元素构造抛出异常时队列不变
+  mystl::spsc_queue<throwing_string> t(4);
+  throwing_string v("x");
+  CHECK(t.try_push(v));
+  throwing_string::countdown = 1;
+  CHECK_THROW(t.try_push(v), std::runtime_error);
+  CHECK(t.size() == 1);
+  throwing_string::countdown = 0;
+  CHECK(t.try_push(v) && t.size() == 2);
+}
+
+void mpmc_queue_run(int producers, int consumers)
+{
+  mystl::mpmc_queue<long> q(8);
+  const long n = 100000;
+  std::vector<std::atomic<int>> seen(n);
+  for (auto& s : seen)
+    s.store(0);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p)
+  {
+    threads.push_back(std::thread([&, p]
+    {
+      for (long i = p; i < n; i += producers)
+      {
+        // 交替使用阻塞与非阻塞接口
+        if (i & 1)
+          q.push(i);
+        else
+          while (!q.try_push(i))
+            std::this_thread::yield();
+      }
+    }));
+  }
+  const long per = n / consumers;
+  for (int c = 0; c < consumers; ++c)
+  {
+    threads.push_back(std::thread([&, c]
+    {
+      const long count = c == consumers - 1 ? n - per * (consumers - 1) : per;
+      for (long k = 0; k < count; ++k)
+      {
+        long v = -1;
+        if (k & 1)
+          q.pop(v);
+        else
+          while (!q.try_pop(v))
+            std::this_thread::yield();
+        CHECK(v >= 0 && v < n);
+        if (v >= 0 && v < n)
+          seen[v].fetch_add(1, std::memory_order_relaxed);
+      }
+    }));
+  }
+  for (auto& t : threads)
+    t.join();
+  CHECK(q.empty());
+  for (long i = 0; i < n; ++i)
+    CHECK(seen[i].load() == 1);
+}
+
+void mpmc_queue_check()
+{
+  mpmc_queue_run(1, 1);
+  mpmc_queue_run(2, 3);
+  mpmc_queue_run(4, 2);
+
+  mystl::mpmc_queue<std::string> q(3);
+  CHECK(q.capacity() == 4);
+  for (int i = 0; i < 4; ++i)
+    CHECK(q.try_push(std::to_string(i)));
+  CHECK(!q.try_push("full"));
+  std::string s;
+  CHECK(q.try_pop(s) && s == "0");
+
+  // 元素构造抛出异常时不占用槽位，队列绕过多圈之后仍然可用
+  const size_t too_long = s.max_size() + 1;
+  for (int i = 0; i < 20; ++i)
+  {
+    CHECK_THROW(q.try_emplace(too_long, 'x'), std::length_error);
+    CHECK_THROW(q.emplace(too_long, 'x'), std::length_error);
+    CHECK(q.try_push(std::to_string(i + 4)));
+    CHECK(q.try_pop(s) && s == std::to_string(i + 1));
+  }
+  CHECK(q.size() == 3);
+}
+
+// owner 成批压入再弹出一部分，thieves 个线程同时窃取，每个元素恰好被一个线程取得
+void ws_deque_run(int thieves)
+{
+  mystl::ws_deque<long> d(2);
+  const long n = 200000;
+  std::vector<std::atomic<int>> seen(n);
+  for (auto& s : seen)
+    s.store(0);
+  std::atomic<bool> done(false);
+  std::vector<std::thread> threads;
+  for (int k = 0; k < thieves; ++k)
+  {
+    threads.push_back(std::thread([&]
+    {
+      long v;
+      while (!done.load(std::memory_order_acquire))
+      {
+        if (d.steal(v))
+          seen[v].fetch_add(1, std::memory_order_relaxed);
+        else
+          std::this_thread::yield();
+      }
+    }));
+  }
+  long i = 0;
+  long v;
+  while (i < n)
+  {
+    const long burst = (i * 7) % 50 + 1;
+    for (long j = 0; j < burst && i < n; ++j)
+      d.push(i++);
+    for (long j = 0; j < burst / 3; ++j)
+    {
+      if (d.pop(v))
+        seen[v].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  while (d.pop(v))
+    seen[v].fetch_add(1, std::memory_order_relaxed);
+  done.store(true, std::memory_order_release);
+  for (auto& t : threads)
+    t.join();
+  CHECK(d.empty());
+  for (long x = 0; x < n; ++x)
+    CHECK(seen[x].load() == 1);
+}
+
+void ws_deque_check()
+{
+  ws_deque_run(0);
+  ws_deque_run(1);
+  ws_deque_run(3);
+}
+
+void queue_test()
+{
+  check_header("queue");
+  circular_buffer_check();
+  spsc_queue_check();
+  mpmc_queue_check();
+  ws_deque_check();
+}
+
+} // namespace queue_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_QUEUE_TEST_H_
@@ -0,0 +1,113 @@
+#ifndef MYTINYSTL_SLOT_MAP_BENCH_H_
+#define MYTINYSTL_SLOT_MAP_BENCH_H_
+
+// slot map bench : 在实体表负载上比较 slot_map 的句柄与以 list 迭代器作为句柄的做法，
+// 依次测插入、随机删除一半再插回 (churn)、按句柄随机访问与遍历全部元素的用时
+
+#include "../list.h"
+#include "../slot_map.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace slot_map_bench
+{
+
+// 32 字节的实体
+struct entity
+{
+  double   x;
+  double   y;
+  double   z;
+  unsigned id;
+
+  explicit entity(unsigned i = 0) :x(i), y(i * 0.5), z(i * 0.25), id(i) {}
+};
+
+// slot_map 的句柄就是 slot_map_key
+struct slot_map_policy
+{
+  typedef mystl::slot_map<entity> table;
+  typedef mystl::slot_map_key     handle;
+
+  static handle   add(table& t, unsigned i)          { return t.emplace(i); }
+  static void     remove(table& t, const handle& h)  { t.erase(h); }
+  static entity&  get(table& t, const handle& h)     { return t[h]; }
+};
+
+// list 的迭代器在删除其它元素后仍然有效，可以作为句柄，这里保存迭代器内的节点指针
+struct list_policy
+{
+  typedef mystl::list<entity>                     table;
+  typedef mystl::list<entity>::iterator           iterator;
+  typedef mystl::list<entity>::iterator::base_ptr handle;
+
+  static handle   add(table& t, unsigned i)          { return t.insert(t.end(), entity(i)).node_; }
+  static void     remove(table& t, const handle& h)  { t.erase(iterator(h)); }
+  static entity&  get(table&, const handle& h)       { return *iterator(h); }
+};
+
+template <class Policy>
+void run_table(const char* what, size_t len)
+{
+  char name[64];
+  typename Policy::table t;
+  mystl::vector<typename Policy::handle> handles;
+  handles.reserve(len);
+  bench_rng rng;
+
+  bench_timer timer;
+  for (size_t i = 0; i < len; ++i)
+    handles.push_back(Policy::add(t, static_cast<unsigned>(i)));
+  std::snprintf(name, sizeof(name), "%s insert", what);
+  bench_row(name, len, timer.ms());
+
+  // 随机删除一半再插回，之后 list 的节点在内存中是分散的
+  timer.reset();
+  for (size_t i = 0; i < len / 2; ++i)
+  {
+    const size_t k = static_cast<size_t>(rng.next() % handles.size());
+    Policy::remove(t, handles[k]);
+    handles[k] = handles.back();
+    handles.pop_back();
+  }
+  for (size_t i = 0; i < len / 2; ++i)
+    handles.push_back(Policy::add(t, static_cast<unsigned>(len + i)));
+  std::snprintf(name, sizeof(name), "%s churn", what);
+  bench_row(name, len, timer.ms());
+
+  timer.reset();
+  double sum = 0;
+  for (size_t i = 0; i < len; ++i)
+    sum += Policy::get(t, handles[static_cast<size_t>(rng.next() % handles.size())]).x;
+  bench_keep(sum);
+  std::snprintf(name, sizeof(name), "%s lookup", what);
+  bench_row(name, len, timer.ms());
+
+  timer.reset();
+  sum = 0;
+  for (auto it = t.begin(); it != t.end(); ++it)
+    sum += it->y;
+  bench_keep(sum);
+  std::snprintf(name, sizeof(name), "%s iterate", what);
+  bench_row(name, len, timer.ms());
+}
+
+void slot_map_bench()
+{
+  bench_header("slot map");
+  for (size_t i = 0; i < bench_len_count(); ++i)
+  {
+    const size_t len = bench_len(i);
+    run_table<slot_map_policy>("slot_map", len);
+    run_table<list_policy>("list", len);
+  }
+}
+
+} // namespace slot_map_bench
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_SLOT_MAP_BENCH_H_
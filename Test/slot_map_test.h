@@ -0,0 +1,101 @@
+#ifndef MYTINYSTL_SLOT_MAP_TEST_H_
+#define MYTINYSTL_SLOT_MAP_TEST_H_
+
+// slot map test : slot_map 的键在删除后失效且不会被复用，按迭代器删除时最后一个元素移到空出的位置
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../slot_map.h"
+#include "../unordered_map.h"
+#include "check.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace slot_map_test
+{
+
+void slot_map_check()
+{
+  bench_rng rng;
+  mystl::slot_map<std::string> m;
+  std::vector<std::pair<mystl::slot_map_key, std::string>> live, dead;
+  for (int round = 0; round < 20000; ++round)
+  {
+    const int op = static_cast<int>(rng.next() % 6);
+    if (op < 3 || live.empty())
+    {
+      const std::string v = std::to_string(rng.next());
+      const auto k = m.insert(v);
+      for (auto& d : dead)
+        CHECK(!(d.first == k));
+      live.push_back(std::make_pair(k, v));
+    }
+    else if (op == 3)
+    {
+      const size_t i = static_cast<size_t>(rng.next() % live.size());
+      CHECK(m.erase(live[i].first) == 1);
+      CHECK(m.erase(live[i].first) == 0);
+      dead.push_back(live[i]);
+      live[i] = live.back();
+      live.pop_back();
+    }
+    else if (op == 4)
+    {
+      // 按迭代器删除，最后一个元素被移到空出的位置
+      const size_t i = static_cast<size_t>(rng.next() % live.size());
+      auto it = m.find(live[i].first);
+      CHECK(it != m.end() && m.key_of(it) == live[i].first);
+      const auto pos = it - m.begin();
+      CHECK(m.erase(it) - m.begin() == pos);
+      dead.push_back(live[i]);
+      live[i] = live.back();
+      live.pop_back();
+    }
+    else if (rng.next() % 500 == 0)
+    {
+      m.clear();
+      for (auto& l : live)
+        dead.push_back(l);
+      live.clear();
+    }
+    if (dead.size() > 200)
+      dead.erase(dead.begin(), dead.begin() + 100);
+    CHECK(m.size() == live.size());
+    if (round % 50 == 0)
+    {
+      for (auto& l : live)
+        CHECK(m.contains(l.first) && m[l.first] == l.second && m.at(l.first) == l.second);
+      for (auto& d : dead)
+        CHECK(!m.contains(d.first) && m.find(d.first) == m.end());
+      for (auto it = m.begin(); it != m.end(); ++it)
+        CHECK(m[m.key_of(it)] == *it);
+    }
+  }
+  CHECK_THROW(m.at(mystl::slot_map_key{ 100000, 0 }), std::out_of_range);
+
+  auto m2 = m;
+  CHECK(m2.size() == m.size());
+  auto m3 = mystl::move(m2);
+  CHECK(m3.size() == m.size() && m2.empty());
+  const auto k = m2.emplace(3, 'x');
+  CHECK(m2[k] == "xxx");
+  mystl::unordered_map<mystl::slot_map_key, int> h;
+  h[k] = 1;
+  CHECK(h.count(k) == 1);
+}
+
+void slot_map_test()
+{
+  check_header("slot_map");
+  slot_map_check();
+}
+
+} // namespace slot_map_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_SLOT_MAP_TEST_H_
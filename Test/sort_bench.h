@@ -0,0 +1,86 @@
+#ifndef MYTINYSTL_SORT_BENCH_H_
+#define MYTINYSTL_SORT_BENCH_H_
+
+// parallel sort bench : 比较串行 sort 与 sort(par) 在 1 到 N 个线程上的用时
+// N 为硬件线程数，线程数取 1、2、4 ... 直到 N；数据分布为均匀随机、已排序、少量不同值
+
+#include <thread>
+
+#include "../vector.h"
+#include "../parallel_algo.h"
+#include "bench.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace sort_bench
+{
+
+enum sort_dist { dist_uniform, dist_sorted, dist_few_unique };
+
+inline const char* dist_name(sort_dist d)
+{
+  return d == dist_uniform ? "uniform" : d == dist_sorted ? "sorted" : "few-unique";
+}
+
+inline void make_input(mystl::vector<unsigned>& v, size_t len, sort_dist d)
+{
+  v.clear();
+  v.reserve(len);
+  bench_rng rng;
+  for (size_t i = 0; i < len; ++i)
+  {
+    if (d == dist_uniform)
+      v.push_back(static_cast<unsigned>(rng.next()));
+    else if (d == dist_sorted)
+      v.push_back(static_cast<unsigned>(i));
+    else
+      v.push_back(static_cast<unsigned>(rng.next() % 16));
+  }
+}
+
+void parallel_sort_bench()
+{
+  bench_header("parallel sort");
+  size_t hw = std::thread::hardware_concurrency();
+  if (hw == 0)
+    hw = 1;
+  mystl::vector<size_t> thread_counts;
+  for (size_t t = 1; t < hw; t *= 2)
+    thread_counts.push_back(t);
+  thread_counts.push_back(hw);
+
+  for (size_t i = 0; i < bench_len_count(); ++i)
+  {
+    const size_t len = bench_len(i);
+    for (int d = dist_uniform; d <= dist_few_unique; ++d)
+    {
+      const sort_dist dist = static_cast<sort_dist>(d);
+      mystl::vector<unsigned> input, v;
+      make_input(input, len, dist);
+      char name[64];
+
+      v = input;
+      bench_timer t;
+      mystl::sort(v.begin(), v.end());
+      std::snprintf(name, sizeof(name), "sort %s", dist_name(dist));
+      bench_row(name, len, t.ms());
+
+      for (size_t k = 0; k < thread_counts.size(); ++k)
+      {
+        mystl::thread_pool pool(thread_counts[k]);
+        v = input;
+        t.reset();
+        mystl::sort(mystl::par.on(pool), v.begin(), v.end());
+        std::snprintf(name, sizeof(name), "sort(par) %s %zut", dist_name(dist), thread_counts[k]);
+        bench_row(name, len, t.ms());
+      }
+    }
+  }
+}
+
+} // namespace sort_bench
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_SORT_BENCH_H_
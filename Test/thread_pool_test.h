@@ -0,0 +1,166 @@
+#ifndef MYTINYSTL_THREAD_POOL_TEST_H_
+#define MYTINYSTL_THREAD_POOL_TEST_H_
+
+// thread pool test : thread_pool、task_group、parallel_invoke 与 parallel_for 的行为测试，
+// 包括每个任务恰好执行一次、嵌套的 fork-join、异常在 wait 中重新抛出，
+// 以及在 wait 中休眠的线程被之后产生的任务唤醒
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../thread_pool.h"
+#include "check.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace thread_pool_test
+{
+
+// 递归的 fork-join，返回叶子个数
+inline long fork_join_count(mystl::thread_pool& pool, int depth)
+{
+  if (depth == 0)
+    return 1;
+  long left = 0, right = 0;
+  mystl::parallel_invoke(pool,
+    [&] { left = fork_join_count(pool, depth - 1); },
+    [&] { right = fork_join_count(pool, depth - 1); });
+  return left + right;
+}
+
+void task_check(size_t threads)
+{
+  mystl::thread_pool pool(threads);
+  CHECK(pool.size() == threads && !pool.in_worker());
+
+  // parallel_for 覆盖每个下标恰好一次
+  const size_t n = 100000;
+  std::vector<std::atomic<int>> hit(n);
+  for (auto& h : hit)
+    h.store(0);
+  mystl::parallel_for(pool, 0, n, 97, [&](size_t b, size_t e)
+  {
+    CHECK(e - b <= 97);
+    for (size_t i = b; i < e; ++i)
+      hit[i].fetch_add(1, std::memory_order_relaxed);
+  });
+  for (size_t i = 0; i < n; ++i)
+    CHECK(hit[i].load() == 1);
+  mystl::parallel_for(pool, 5, 5, 1, [&](size_t, size_t) { CHECK(false); });
+
+  CHECK(fork_join_count(pool, 12) == 4096);
+
+  // 同一个 task_group 在 wait 之后可以继续使用
+  std::atomic<long> sum(0);
+  mystl::task_group g(pool);
+  for (int round = 0; round < 3; ++round)
+  {
+    for (int i = 0; i < 1000; ++i)
+      g.run([&sum, i] { sum.fetch_add(i, std::memory_order_relaxed); });
+    g.wait();
+    CHECK(sum.load() == 499500L * (round + 1));
+  }
+
+  // 任务中再提交任务
+  std::atomic<int> inner(0);
+  mystl::task_group outer(pool);
+  for (int i = 0; i < 16; ++i)
+  {
+    outer.run([&]
+    {
+      mystl::task_group g2(pool);
+      for (int k = 0; k < 16; ++k)
+        g2.run([&] { inner.fetch_add(1); });
+      g2.wait();
+    });
+  }
+  outer.wait();
+  CHECK(inner.load() == 256);
+
+  // submit 的任务在析构前完成
+  std::atomic<int> submitted(0);
+  {
+    mystl::thread_pool p2(threads);
+    for (int i = 0; i < 1000; ++i)
+      p2.submit([&] { submitted.fetch_add(1); });
+  }
+  CHECK(submitted.load() == 1000);
+}
+
+void exception_check()
+{
+  mystl::thread_pool pool(2);
+
+  // 第一个异常在 wait 中重新抛出，其余任务照常完成
+  std::atomic<int> done(0);
+  mystl::task_group g(pool);
+  for (int i = 0; i < 100; ++i)
+  {
+    g.run([&done, i]
+    {
+      done.fetch_add(1);
+      if (i % 10 == 3)
+        throw std::runtime_error("task");
+    });
+  }
+  CHECK_THROW(g.wait(), std::runtime_error);
+  CHECK(done.load() == 100);
+  // 异常只抛出一次
+  g.run([] {});
+  g.wait();
+
+  CHECK_THROW(mystl::parallel_invoke(pool, [] {}, [] { throw std::logic_error("b"); }),
+              std::logic_error);
+  CHECK_THROW(mystl::parallel_invoke(pool, [] { throw std::logic_error("a"); }, [] {}),
+              std::logic_error);
+  CHECK_THROW(mystl::parallel_for(pool, 0, 1000, 10, [](size_t b, size_t)
+  {
+    if (b == 500)
+      throw std::out_of_range("for");
+  }), std::out_of_range);
+}
+
+// 外部线程在 wait 中休眠时，工作线程产生的任务也要能被它窃取执行：
+// 唯一的工作线程在任务中阻塞，直到另一个任务开始运行，只有等待者能执行后者
+void waiter_wakeup_check()
+{
+  mystl::thread_pool pool(1);
+  for (int round = 0; round < 20; ++round)
+  {
+    std::atomic<bool> started(false);
+    mystl::task_group g(pool);
+    g.run([&]
+    {
+      // 让外部线程先进入休眠
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      mystl::task_group inner(pool);
+      inner.run([&] { started.store(true); });
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (!started.load() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+      CHECK(started.load());
+      inner.wait();
+    });
+    g.wait();
+  }
+}
+
+void thread_pool_test()
+{
+  check_header("thread_pool");
+  task_check(1);
+  task_check(2);
+  task_check(4);
+  exception_check();
+  waiter_wakeup_check();
+}
+
+} // namespace thread_pool_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_THREAD_POOL_TEST_H_
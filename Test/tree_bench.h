@@ -0,0 +1,172 @@
+#ifndef MYTINYSTL_TREE_BENCH_H_
+#define MYTINYSTL_TREE_BENCH_H_
+
+// ordered map bench : 比较 mystl::map、mystl::btree_map 与 std::map 在 64 位键上的
+// 随机插入、顺序遍历、命中查找、lower_bound、删除、以 end() 为提示的有序插入与从有序区间构造的用时，
+// 以及每个元素占用的字节数
+// std::map 的内存用计数的分配器统计，map 的内存为节点的总和，btree_map 的内存为叶节点与内部节点的总和
+// flat_map 逐个随机插入为 O(n^2)，只比较从乱序区间构造、遍历与查找
+
+#include <map>
+
+#include "../algo.h"
+#include "../btree_map.h"
+#include "../flat_map.h"
+#include "../map.h"
+#include "../vector.h"
+#include "bench.h"
+#include "hash_bench.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace tree_bench
+{
+
+typedef unsigned long long key_type;
+typedef mystl::pair<key_type, size_t> mystl_value;
+typedef std::pair<key_type, size_t>   std_value;
+
+typedef mystl::map<key_type, size_t>       rb_map_type;
+typedef mystl::btree_map<key_type, size_t> btree_map_type;
+typedef mystl::flat_map<key_type, size_t> flat_map_type;
+typedef std::map<key_type, size_t, std::less<key_type>,
+  hash_bench::counting_allocator<std::pair<const key_type, size_t>>> std_map_type;
+
+inline size_t rb_memory(const rb_map_type& m)
+{
+  return m.size() * sizeof(mystl::rb_tree_node<rb_map_type::value_type>);
+}
+
+inline size_t btree_memory(const btree_map_type& m)
+{
+  return m.bytes_used();
+}
+
+inline size_t std_memory(const std_map_type&)
+{
+  return hash_bench::allocated_bytes();
+}
+
+// Value 为区间构造时使用的元素类型
+template <class Map, class Value>
+void run_ordered_map(const char* what, const mystl::vector<key_type>& keys,
+                     const mystl::vector<key_type>& sorted, size_t (*memory)(const Map&))
+{
+  char name[64];
+  const size_t len = keys.size();
+  size_t found = 0;
+  Map m;
+  bench_timer t;
+  for (size_t i = 0; i < len; ++i)
+    m[keys[i]] = i;
+  std::snprintf(name, sizeof(name), "%s insert", what);
+  bench_row(name, len, t.ms());
+  std::printf("| %-28s | %11zu | %12.2f B  |\n", "  bytes per element", len,
+              static_cast<double>(memory(m)) / static_cast<double>(len));
+
+  t.reset();
+  size_t sum = 0;
+  for (auto it = m.begin(); it != m.end(); ++it)
+    sum += it->second;
+  bench_keep(sum);
+  std::snprintf(name, sizeof(name), "%s scan", what);
+  bench_row(name, len, t.ms());
+
+  t.reset();
+  for (size_t i = 0; i < len; ++i)
+    found += m.find(keys[i]) != m.end();
+  std::snprintf(name, sizeof(name), "%s find", what);
+  bench_row(name, len, t.ms());
+
+  t.reset();
+  for (size_t i = 0; i < len; ++i)
+    found += m.lower_bound(keys[i] + 1) != m.end();
+  std::snprintf(name, sizeof(name), "%s lower_bound", what);
+  bench_row(name, len, t.ms());
+
+  t.reset();
+  for (size_t i = 0; i < len; ++i)
+    found += m.erase(keys[i]);
+  std::snprintf(name, sizeof(name), "%s erase", what);
+  bench_row(name, len, t.ms());
+
+  t.reset();
+  for (size_t i = 0; i < len; ++i)
+    m.emplace_hint(m.end(), sorted[i], i);
+  std::snprintf(name, sizeof(name), "%s hint end", what);
+  bench_row(name, len, t.ms());
+  found += m.size();
+
+  mystl::vector<Value> values;
+  values.reserve(len);
+  for (size_t i = 0; i < len; ++i)
+    values.push_back(Value(sorted[i], i));
+  t.reset();
+  {
+    Map built(values.begin(), values.end());
+    found += built.size();
+  }
+  std::snprintf(name, sizeof(name), "%s sorted range", what);
+  bench_row(name, len, t.ms());
+  // find 计数 len 次，erase、提示插入与区间构造各计数 len 次 (随机键近似不重复)
+  if (found < 4 * len)
+    std::printf("| %-28s | unexpected result %zu\n", what, found);
+}
+
+// 从乱序区间构造，再遍历、查找，Map 为 flat_map 时构造是一次排序加去重
+template <class Map, class Value>
+void run_build_scan_find(const char* what, const mystl::vector<key_type>& keys)
+{
+  char name[64];
+  const size_t len = keys.size();
+  size_t found = 0;
+  mystl::vector<Value> values;
+  values.reserve(len);
+  for (size_t i = 0; i < len; ++i)
+    values.push_back(Value(keys[i], i));
+  bench_timer t;
+  Map m(values.begin(), values.end());
+  std::snprintf(name, sizeof(name), "%s random range", what);
+  bench_row(name, len, t.ms());
+
+  t.reset();
+  size_t sum = 0;
+  for (auto it = m.begin(); it != m.end(); ++it)
+    sum += it->second;
+  bench_keep(sum);
+  std::snprintf(name, sizeof(name), "%s scan", what);
+  bench_row(name, len, t.ms());
+
+  t.reset();
+  for (size_t i = 0; i < len; ++i)
+    found += m.find(keys[i]) != m.end();
+  std::snprintf(name, sizeof(name), "%s find", what);
+  bench_row(name, len, t.ms());
+  if (found < len)
+    std::printf("| %-28s | unexpected result %zu\n", what, found);
+}
+
+void ordered_map_bench()
+{
+  bench_header("ordered map");
+  for (size_t i = 0; i < bench_len_count(); ++i)
+  {
+    const size_t len = bench_len(i);
+    mystl::vector<key_type> keys, sorted;
+    hash_bench::make_keys(keys, len, 1);
+    sorted = keys;
+    mystl::sort(sorted.begin(), sorted.end());
+    run_ordered_map<rb_map_type, mystl_value>("map", keys, sorted, rb_memory);
+    run_ordered_map<btree_map_type, mystl_value>("btree_map", keys, sorted, btree_memory);
+    run_ordered_map<std_map_type, std_value>("std::map", keys, sorted, std_memory);
+    run_build_scan_find<flat_map_type, mystl_value>("flat_map", keys);
+    run_build_scan_find<btree_map_type, mystl_value>("btree_map", keys);
+  }
+}
+
+} // namespace tree_bench
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_TREE_BENCH_H_
@@ -0,0 +1,457 @@
+#ifndef MYTINYSTL_TREE_TEST_H_
+#define MYTINYSTL_TREE_TEST_H_
+
+// tree test : 有序容器 map / set / multiset (红黑树) 与 std::map / std::multiset 的差分测试，
+// 并检查红黑树的结构性质；
+// btree_map / btree_set 与 std::map / std::set 的差分测试；
+// flat_map / flat_set 与 std::map / std::set 的差分测试，区间插入抛出异常时容器不变
+
+#include <iterator>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include "../btree_map.h"
+#include "../btree_set.h"
+#include "../flat_map.h"
+#include "../flat_set.h"
+#include "../map.h"
+#include "../set.h"
+#include "../vector.h"
+#include "check.h"
+
+namespace mystl
+{
+namespace test
+{
+namespace tree_test
+{
+
+// 返回黑高，并检查父指针与红色节点的子节点都是黑色
+inline int rb_black_height(mystl::rb_tree_node_base* x, mystl::rb_tree_node_base* parent)
+{
+  if (x == nullptr)
+    return 1;
+  CHECK(x->parent == parent);
+  if (x->color == mystl::rb_tree_red)
+  {
+    CHECK(x->left == nullptr || x->left->color == mystl::rb_tree_black);
+    CHECK(x->right == nullptr || x->right->color == mystl::rb_tree_black);
+  }
+  const int l = rb_black_height(x->left, x);
+  const int r = rb_black_height(x->right, x);
+  CHECK(l == r);
+  return l + (x->color == mystl::rb_tree_black ? 1 : 0);
+}
+
+// 通过 end() 得到 header，检查根、最左、最右节点与黑高
+template <class Container>
+void rb_validate(const Container& c)
+{
+  mystl::rb_tree_node_base* header = c.end().node;
+  mystl::rb_tree_node_base* root = header->parent;
+  if (c.empty())
+  {
+    CHECK(root == nullptr && c.begin() == c.end());
+    return;
+  }
+  CHECK(root->color == mystl::rb_tree_black && root->parent == header);
+  rb_black_height(root, header);
+  CHECK(header->left == mystl::rb_tree_min(root));
+  CHECK(header->right == mystl::rb_tree_max(root));
+  CHECK(static_cast<size_t>(mystl::distance(c.begin(), c.end())) == c.size());
+}
+
+template <class Map, class Ref>
+void same_map(const Map& m, const Ref& ref)
+{
+  CHECK(m.size() == ref.size());
+  auto it = m.begin();
+  for (auto r = ref.begin(); r != ref.end() && it != m.end(); ++r, ++it)
+    CHECK(it->first == r->first && it->second == r->second);
+  CHECK(it == m.end());
+}
+
+template <class Set, class Ref>
+void same_set(const Set& s, const Ref& ref)
+{
+  CHECK(s.size() == ref.size());
+  auto it = s.begin();
+  for (auto r = ref.begin(); r != ref.end() && it != s.end(); ++r, ++it)
+    CHECK(*it == *r);
+  CHECK(it == s.end());
+}
+
+void rb_tree_check()
+{
+  bench_rng rng;
+  for (int round = 0; round < 10; ++round)
+  {
+    mystl::map<int, int> m;
+    std::map<int, int> ref;
+    mystl::multiset<int> ms;
+    std::multiset<int> rms;
+    for (int i = 0; i < 3000; ++i)
+    {
+      const int k = static_cast<int>(rng.next() % 500);
+      const int op = static_cast<int>(rng.next() % 6);
+      if (op < 2)
+      {
+        CHECK(m.insert(mystl::make_pair(k, i)).second == ref.insert(std::make_pair(k, i)).second);
+      }
+      else if (op == 2)
+      {
+        CHECK(m.erase(k) == ref.erase(k));
+      }
+      else if (op == 3)
+      {
+        m[k] = i;
+        ref[k] = i;
+      }
+      else if (op == 4)
+      {
+        m.emplace_hint(m.lower_bound(k), k, i);
+        ref.emplace_hint(ref.lower_bound(k), k, i);
+      }
+      else
+      {
+        auto it = m.find(k);
+        if (it != m.end())
+        {
+          auto nh = m.extract(it);
+          nh.key() = k + 1000;
+          m.insert(mystl::move(nh));
+          const int v = ref[k];
+          ref.erase(k);
+          ref.insert(std::make_pair(k + 1000, v));
+        }
+      }
+      if (rng.next() % 2)
+      {
+        ms.insert(k);
+        rms.insert(k);
+      }
+      else
+      {
+        CHECK(ms.erase(k) == rms.erase(k));
+      }
+    }
+    rb_validate(m);
+    rb_validate(ms);
+    same_map(m, ref);
+    same_set(ms, rms);
+    for (int k = -5; k < 1600; ++k)
+    {
+      auto a = m.lower_bound(k);
+      auto b = ref.lower_bound(k);
+      CHECK((a == m.end()) == (b == ref.end()));
+      if (a != m.end() && b != ref.end())
+        CHECK(a->first == b->first);
+      CHECK(ms.count(k) == rms.count(k));
+    }
+  }
+
+  // 有序区间建树的各种规模
+  for (int n = 0; n < 200; ++n)
+  {
+    mystl::vector<int> v;
+    for (int i = 0; i < n; ++i)
+      v.push_back(i / 2);
+    mystl::set<int> s(v.begin(), v.end());
+    mystl::multiset<int> s2(v.begin(), v.end());
+    rb_validate(s);
+    rb_validate(s2);
+    CHECK(s.size() == static_cast<size_t>(n + 1) / 2 && s2.size() == static_cast<size_t>(n));
+    for (int i = 0; i < n; i += 3)
+      s.erase(i / 2);
+    rb_validate(s);
+  }
+
+  mystl::set<int> a{ 1, 3, 5, 7 }, b{ 2, 3, 4, 5 };
+  a.merge(b);
+  rb_validate(a);
+  rb_validate(b);
+  CHECK(a.size() == 6 && b.size() == 2 && b.contains(3) && b.contains(5));
+
+  mystl::map<std::string, int> c{ { "a", 1 }, { "b", 2 } };
+  CHECK_THROW(c.at("z"), std::out_of_range);
+  auto d = c;
+  d["c"] = 3;
+  CHECK(c != d && c < d);
+}
+
+// 记录复制次数的字符串键，移动不抛出异常
+struct counted_key
+{
+  static int copies;
+  std::string s;
+
+  explicit counted_key(const std::string& v) :s(v) {}
+  counted_key(const counted_key& rhs) :s(rhs.s) { ++copies; }
+  counted_key(counted_key&&) noexcept = default;
+  counted_key& operator=(const counted_key& rhs) { s = rhs.s; ++copies; return *this; }
+  counted_key& operator=(counted_key&&) noexcept = default;
+
+  bool operator<(const counted_key& rhs) const { return s < rhs.s; }
+};
+
+int counted_key::copies = 0;
+
+void btree_check()
+{
+  bench_rng rng;
+  for (int round = 0; round < 10; ++round)
+  {
+    mystl::btree_map<int, int> m;
+    std::map<int, int> ref;
+    const int range = round % 2 ? 300 : 5000;
+    for (int i = 0; i < 20000; ++i)
+    {
+      const int k = static_cast<int>(rng.next() % range);
+      const int op = static_cast<int>(rng.next() % 6);
+      if (op < 2)
+      {
+        auto r = m.insert(mystl::make_pair(k, i));
+        CHECK(r.second == ref.insert(std::make_pair(k, i)).second && r.first->first == k);
+      }
+      else if (op == 2)
+      {
+        CHECK(m.erase(k) == ref.erase(k));
+      }
+      else if (op == 3)
+      {
+        m[k] = i;
+        ref[k] = i;
+      }
+      else if (op == 4)
+      {
+        // 按迭代器删除，返回下一个元素
+        auto it = m.lower_bound(k);
+        auto rit = ref.lower_bound(k);
+        CHECK((it == m.end()) == (rit == ref.end()));
+        if (it != m.end() && rit != ref.end())
+        {
+          auto next = m.erase(it);
+          auto rnext = ref.erase(rit);
+          CHECK((next == m.end()) == (rnext == ref.end()));
+          if (next != m.end() && rnext != ref.end())
+            CHECK(next->first == rnext->first);
+        }
+      }
+      else
+      {
+        CHECK((m.find(k) == m.end()) == (ref.find(k) == ref.end()));
+      }
+    }
+    same_map(m, ref);
+    auto rit = m.rbegin();
+    for (auto r = ref.rbegin(); r != ref.rend() && rit != m.rend(); ++r, ++rit)
+      CHECK(rit->first == r->first);
+    for (int k = -2; k < range + 2; ++k)
+    {
+      auto a = m.upper_bound(k);
+      auto b = ref.upper_bound(k);
+      CHECK((a == m.end()) == (b == ref.end()));
+      if (a != m.end() && b != ref.end())
+        CHECK(a->first == b->first);
+    }
+    while (!m.empty())
+    {
+      auto next = m.erase(m.begin());
+      CHECK(next == m.begin());
+    }
+  }
+
+  // 有序区间批量建树与逐个追加得到相同的内容
+  mystl::btree_set<long> s;
+  mystl::vector<long> v;
+  for (long i = 0; i < 100000; ++i)
+  {
+    s.insert(s.end(), i);
+    v.push_back(i);
+  }
+  mystl::btree_set<long> bulk(v.begin(), v.end());
+  CHECK(s == bulk && s.size() == 100000);
+
+  mystl::btree_set<std::string> t;
+  std::set<std::string> rt;
+  for (int i = 0; i < 20000; ++i)
+  {
+    const std::string k = std::to_string(rng.next() % 3000) + "-key-with-heap-storage";
+    if (rng.next() % 3)
+    {
+      t.insert(k);
+      rt.insert(k);
+    }
+    else
+    {
+      CHECK(t.erase(k) == rt.erase(k));
+    }
+  }
+  same_set(t, rt);
+  mystl::btree_set<std::string> t2(t);
+  CHECK(t2 == t);
+  t2 = mystl::move(t);
+  CHECK(t.empty() && t2.size() == rt.size());
+
+  // 键为 std::string 的 btree_map：元素在节点间搬移时移动键值，只有分隔键需要复制
+  mystl::btree_map<std::string, std::string> sm;
+  std::map<std::string, std::string> rsm;
+  for (int i = 0; i < 20000; ++i)
+  {
+    const std::string k = std::to_string(rng.next() % 3000) + "-key-with-heap-storage";
+    if (rng.next() % 3)
+    {
+      sm[k] = k;
+      rsm[k] = k;
+    }
+    else
+    {
+      CHECK(sm.erase(k) == rsm.erase(k));
+    }
+  }
+  same_map(sm, rsm);
+
+  mystl::btree_map<counted_key, int> cm;
+  counted_key::copies = 0;
+  for (int i = 0; i < 20000; ++i)
+    cm.try_emplace(counted_key(std::to_string(rng.next())), i);
+  CHECK(cm.size() > 19000 && counted_key::copies < 10000);
+}
+
+// 第 countdown 次复制时抛出异常
+struct throwing_key
+{
+  static int countdown;
+  int key;
+
+  explicit throwing_key(int k = 0) :key(k) {}
+  throwing_key(const throwing_key& rhs) :key(rhs.key)
+  {
+    if (countdown > 0 && --countdown == 0)
+      throw std::runtime_error("throwing_key");
+  }
+  throwing_key& operator=(const throwing_key& rhs) { key = rhs.key; return *this; }
+
+  bool operator<(const throwing_key& rhs) const { return key < rhs.key; }
+  bool operator==(const throwing_key& rhs) const { return key == rhs.key; }
+};
+
+int throwing_key::countdown = 0;
+
+void flat_check()
+{
+  bench_rng rng;
+  mystl::flat_map<int, std::string> f;
+  std::map<int, std::string> ref;
+  mystl::flat_set<int> fs;
+  std::set<int> rs;
+  for (int round = 0; round < 3000; ++round)
+  {
+    const int op = static_cast<int>(rng.next() % 7);
+    const int k = static_cast<int>(rng.next() % 300);
+    const std::string v = std::to_string(rng.next() % 1000);
+    if (op == 0)
+    {
+      CHECK(f.insert(mystl::make_pair(k, v)).second == ref.insert(std::make_pair(k, v)).second);
+      CHECK(fs.insert(k).second == rs.insert(k).second);
+    }
+    else if (op == 1)
+    {
+      CHECK(f.erase(k) == ref.erase(k));
+      CHECK(fs.erase(k) == rs.erase(k));
+    }
+    else if (op == 2)
+    {
+      f[k] = v;
+      ref[k] = v;
+    }
+    else if (op == 3)
+    {
+      // 区间插入，已存在的键保持原值
+      const int n = static_cast<int>(rng.next() % 40);
+      mystl::vector<mystl::pair<int, std::string>> b;
+      mystl::vector<int> bk;
+      for (int i = 0; i < n; ++i)
+      {
+        const int kk = static_cast<int>(rng.next() % 400);
+        b.push_back(mystl::make_pair(kk, std::to_string(i)));
+        bk.push_back(kk);
+      }
+      f.insert(b.begin(), b.end());
+      for (auto& p : b)
+        ref.insert(std::make_pair(p.first, p.second));
+      fs.insert(bk.begin(), bk.end());
+      rs.insert(bk.begin(), bk.end());
+    }
+    else if (op == 4)
+    {
+      f.insert_or_assign(k, v);
+      ref[k] = v;
+    }
+    else if (op == 5)
+    {
+      auto it = f.find(k);
+      if (it != f.end())
+      {
+        auto next = f.erase(it);
+        ref.erase(k);
+        CHECK(next == f.end() || next->first > k);
+      }
+    }
+    else
+    {
+      const int b = k + static_cast<int>(rng.next() % 30);
+      f.erase(f.lower_bound(k), f.lower_bound(b));
+      ref.erase(ref.lower_bound(k), ref.lower_bound(b));
+      fs.erase(fs.lower_bound(k), fs.lower_bound(b));
+      rs.erase(rs.lower_bound(k), rs.lower_bound(b));
+    }
+    same_map(f, ref);
+    same_set(fs, rs);
+  }
+  CHECK_THROW(f.at(-5), std::out_of_range);
+
+  // 反向迭代器通过代理对象访问成员
+  auto rit = ref.rbegin();
+  for (auto it = f.rbegin(); it != f.rend() && rit != ref.rend(); ++it, ++rit)
+    CHECK(it->first == rit->first && it->second == rit->second);
+  if (!f.empty())
+  {
+    f.rbegin()->second = "last";
+    const mystl::flat_map<int, std::string>& cf = f;
+    CHECK(cf.rbegin()->first == ref.rbegin()->first && cf.crbegin()->second == "last");
+  }
+
+  // 区间插入在追加阶段抛出异常时容器不变
+  mystl::flat_set<throwing_key> t;
+  for (int i = 0; i < 10; ++i)
+    t.insert(throwing_key(i * 2));
+  mystl::vector<throwing_key> more;
+  for (int i = 0; i < 10; ++i)
+    more.push_back(throwing_key(i * 2 + 1));
+  throwing_key::countdown = 5;
+  CHECK_THROW(t.insert(more.begin(), more.end()), std::runtime_error);
+  throwing_key::countdown = 0;
+  CHECK(t.size() == 10);
+  int expect = 0;
+  for (const auto& x : t)
+  {
+    CHECK(x.key == expect);
+    expect += 2;
+  }
+}
+
+void tree_test()
+{
+  check_header("tree");
+  rb_tree_check();
+  btree_check();
+  flat_check();
+}
+
+} // namespace tree_test
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_TREE_TEST_H_
@@ -2039,7 +2039,7 @@ void partial_sort(RandomIter first, RandomIter middle,
   {
     if (*i < *first)
     {
-      mystl::pop_heap_aux(first, middle, i, *i, distance_type(first));
+      mystl::pop_heap_aux(first, middle, i, mystl::move(*i), distance_type(first));
     }
   }
   mystl::sort_heap(first, middle);
@@ -2055,7 +2055,7 @@ void partial_sort(RandomIter first, RandomIter middle,
   {
     if (comp(*i, *first))
     {
-      mystl::pop_heap_aux(first, middle, i, *i, distance_type(first), comp);
+      mystl::pop_heap_aux(first, middle, i, mystl::move(*i), distance_type(first), comp);
     }
   }
   mystl::sort_heap(first, middle, comp);
@@ -2271,7 +2271,9 @@ void unchecked_insertion_sort(RandomIter first, RandomIter last)
 {
   for (auto i = first; i != last; ++i)
   {
-    mystl::unchecked_linear_insert(i, *i);
+    // 先复制出来，*i 在插入过程中会被覆盖
+    auto value = *i;
+    mystl::unchecked_linear_insert(i, value);
   }
 }
 
@@ -2356,7 +2358,7 @@ void intro_sort(RandomIter first, RandomIter last,
       return;
     }
     --depth_limit;
-    auto mid = mystl::median(*(first), *(first + (last - first) / 2), *(last - 1));
+    auto mid = mystl::median(*(first), *(first + (last - first) / 2), *(last - 1), comp);
     auto cut = mystl::unchecked_partition(first, last, mid, comp);
     mystl::intro_sort(cut, last, depth_limit, comp);
     last = cut;
@@ -2385,7 +2387,8 @@ void unchecked_insertion_sort(RandomIter first, RandomIter last,
 {
   for (auto i = first; i != last; ++i)
   {
-    mystl::unchecked_linear_insert(i, *i, comp);
+    auto value = *i;
+    mystl::unchecked_linear_insert(i, value, comp);
   }
 }
 
@@ -2447,9 +2450,9 @@ void nth_element(RandomIter first, RandomIter nth,
     return;
   while (last - first > 3)
   {
-    auto cut = mystl::unchecked_partition(first, last, mystl::median(*first,
-										  *(first + (last - first) / 2),
-										  *(last - 1)));
+    // 枢轴需要复制一份，分割时元素会被交换
+    auto pivot = mystl::median(*first, *(first + (last - first) / 2), *(last - 1));
+    auto cut = mystl::unchecked_partition(first, last, pivot);
     if (cut <= nth)  // 如果 nth 位于右段
       first = cut;   // 对右段进行分割
     else
@@ -2467,9 +2470,8 @@ void nth_element(RandomIter first, RandomIter nth,
     return;
   while (last - first > 3)
   {
-    auto cut = mystl::unchecked_partition(first, last, mystl::median(*first, 
-										  *(first + (last - first) / 2),
-										  *(last - 1)), comp);
+    auto pivot = mystl::median(*first, *(first + (last - first) / 2), *(last - 1), comp);
+    auto cut = mystl::unchecked_partition(first, last, pivot, comp);
     if (cut <= nth)  // 如果 nth 位于右段
       first = cut;   // 对右段进行分割
     else
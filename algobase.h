@@ -76,8 +76,8 @@ OutPutIter uncheck_copy_cat(RandomAccessIter first,RandomAccessIter last,
 
 //上层封装
 template<class InputIter,class OutputIter>
-OutputIter uncheck_copy(InputIter first,InputIter last,OutputIter resulr){
-    return uncheck_copy_cat(first,last,iterator_category(first));
+OutputIter uncheck_copy(InputIter first,InputIter last,OutputIter result){
+    return uncheck_copy_cat(first,last,result,iterator_category(first));
 }
 
 //trivially_copy_assignable 类型提供特化版本
@@ -98,7 +98,7 @@ uncheck_copy(input* first,input* last,output* result){
 template <class InputIter, class OutputIter>
 OutputIter copy(InputIter first, InputIter last, OutputIter result)
 {
-  return unchecked_copy(first, last, result);
+  return uncheck_copy(first, last, result);
 }
 
 //copy_backward,将[first,last),拷贝到[result - (last - first), result),
@@ -119,7 +119,7 @@ template<class RandomAccessIter,class BidirectionalIter>
 BidirectionalIter unchecked_copy_backward_cat(RandomAccessIter first,RandomAccessIter last,
                                             BidirectionalIter result,mystl::random_access_iterator_tag)
 {
-    for(auto n=first-last;n>0;--n){
+    for(auto n=last-first;n>0;--n){
         *(--result)=*(--last);
     }
     return result;
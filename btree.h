@@ -0,0 +1,1398 @@
+#ifndef TINYSTL_BTREE_H_
+#define TINYSTL_BTREE_H_
+
+// 这个头文件包含一个模板类 btree
+// btree : 键值不重复的 B+ 树，作为 btree_map / btree_set 的底层实现
+//
+// 每个节点的大小为 NodeSize 字节 (缺省 256，即四条缓存行)，一次缓存缺失可以读到十几个键，
+// 而红黑树每个节点只有一个键，树高与内存都要大得多
+//   叶节点 : 按顺序存放元素，并用 prev / next 串成双向链表，区间遍历只需顺着链表前进
+//   内部节点 : 存放 count 个分隔键与 count + 1 个子节点，
+//              子节点 i 中的键都满足 keys[i - 1] <= key < keys[i]，分隔键是某个元素键值的副本
+// 节点内的查找 : 键为算术类型且比较方式为 less 时做无分支的线性计数，内部节点的键连续存放，
+//               编译器可以把它展开为 SIMD 比较；其它情况在节点内二分查找
+//
+// 向空树插入一个有序区间时 (例如有序的 mystl::vector) 直接逐层建树，叶节点几乎装满，O(n)
+// 在 end() 处按顺序插入时，最右边的节点分裂时把元素尽量留在左边，节点同样接近装满
+//
+// 插入、删除会在节点间搬移元素，所有迭代器、引用都会失效
+
+// 异常保证：
+// 元素与键值在节点间用移动构造搬移，要求它们的移动不抛出异常，insert / emplace 做强异常安全保证
+// (map 的元素在叶节点中以 pair<Key, T> 存放，搬移时移动键值而不是复制)
+
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "functional.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "utils.h"
+#include "vector.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// btree 节点的公共部分
+struct btree_node_base
+{
+  btree_node_base* parent;    // 父节点，根节点为 nullptr
+  uint16_t         position;  // 在父节点中是第几个子节点
+  uint16_t         count;     // 叶节点为元素个数，内部节点为分隔键个数
+  bool             leaf;
+};
+
+// 叶节点槽中搬移时使用的类型 : pair<const Key, T> 按 pair<Key, T> 搬移，键值可以移动，
+// 对外仍以 pair<const Key, T> 的形式访问
+template <class Value>
+struct btree_slot_type { typedef Value type; };
+
+template <class K, class T>
+struct btree_slot_type<mystl::pair<const K, T>> { typedef mystl::pair<K, T> type; };
+
+// 叶节点，元素存放在未初始化的槽中
+template <class Value, size_t Slots>
+struct btree_leaf_node : public btree_node_base
+{
+  typedef Value                                    value_type;
+  typedef typename btree_slot_type<Value>::type    slot_type;
+
+  btree_leaf_node* prev;
+  btree_leaf_node* next;
+  typename std::aligned_storage<sizeof(Value), alignof(Value)>::type slots[Slots];
+
+  Value*       value(size_t i)       noexcept { return reinterpret_cast<Value*>(&slots[i]); }
+  const Value* value(size_t i) const noexcept { return reinterpret_cast<const Value*>(&slots[i]); }
+  slot_type*   slot(size_t i)        noexcept { return reinterpret_cast<slot_type*>(&slots[i]); }
+};
+
+// 内部节点
+template <class Key, size_t Slots>
+struct btree_internal_node : public btree_node_base
+{
+  typename std::aligned_storage<sizeof(Key), alignof(Key)>::type keys[Slots];
+  btree_node_base* children[Slots + 1];
+
+  Key*       key(size_t i)       noexcept { return reinterpret_cast<Key*>(&keys[i]); }
+  const Key* key(size_t i) const noexcept { return reinterpret_cast<const Key*>(&keys[i]); }
+};
+
+// 根据节点字节数计算每种节点的槽数，至少为 3
+template <class Value, class Key, size_t NodeSize>
+struct btree_params
+{
+  static constexpr size_t leaf_header = sizeof(btree_node_base) + 2 * sizeof(void*);
+  static constexpr size_t leaf_fit =
+    NodeSize > leaf_header ? (NodeSize - leaf_header) / sizeof(Value) : 0;
+  static constexpr size_t internal_header = sizeof(btree_node_base) + sizeof(void*);
+  static constexpr size_t internal_fit =
+    NodeSize > internal_header ? (NodeSize - internal_header) / (sizeof(Key) + sizeof(void*)) : 0;
+
+  static constexpr size_t leaf_slots     = leaf_fit < 3 ? 3 : (leaf_fit > 65535 ? 65535 : leaf_fit);
+  static constexpr size_t internal_slots =
+    internal_fit < 3 ? 3 : (internal_fit > 65534 ? 65534 : internal_fit);
+};
+
+// 节点内是否使用线性查找 : 键为算术类型，比较方式为 less
+template <class Key, class Compare>
+struct btree_linear_search
+  : public m_bool_constant<std::is_arithmetic<Key>::value &&
+                           (std::is_same<Compare, mystl::less<Key>>::value ||
+                            std::is_same<Compare, std::less<Key>>::value)> {};
+
+// btree 的迭代器设计 : 指向某个叶节点中的某个位置，end 为最右叶节点的 count 位置
+template <class Leaf, class Ref, class Ptr>
+struct btree_iterator : public iterator<bidirectional_iterator_tag, typename Leaf::value_type>
+{
+  typedef typename Leaf::value_type                                 T;
+  typedef btree_iterator<Leaf, T&, T*>                              iterator;
+  typedef btree_iterator<Leaf, const T&, const T*>                  const_iterator;
+  typedef btree_iterator                                            self;
+
+  typedef T          value_type;
+  typedef Ptr        pointer;
+  typedef Ref        reference;
+  typedef size_t     size_type;
+  typedef ptrdiff_t  difference_type;
+
+  Leaf*  node;      // 当前叶节点，空树时为 nullptr
+  size_t position;  // 在叶节点中的位置
+
+  btree_iterator() noexcept
+    :node(nullptr), position(0) {}
+
+  btree_iterator(Leaf* n, size_t pos) noexcept
+    :node(n), position(pos) {}
+
+  btree_iterator(const iterator& rhs) noexcept
+    :node(rhs.node), position(rhs.position) {}
+
+  self& operator=(const iterator& rhs) noexcept
+  {
+    node = rhs.node;
+    position = rhs.position;
+    return *this;
+  }
+
+  reference operator*()  const { return *node->value(position); }
+  pointer   operator->() const { return node->value(position); }
+
+  self& operator++()
+  {
+    if (++position == node->count && node->next != nullptr)
+    {
+      node = node->next;
+      position = 0;
+    }
+    return *this;
+  }
+  self  operator++(int)
+  {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  self& operator--()
+  {
+    if (position == 0)
+    {
+      node = node->prev;
+      position = node->count;
+    }
+    --position;
+    return *this;
+  }
+  self  operator--(int)
+  {
+    self tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  bool operator==(const self& rhs) const { return node == rhs.node && position == rhs.position; }
+  bool operator!=(const self& rhs) const { return !(*this == rhs); }
+};
+
+// 模板类 btree
+// 参数一代表元素类型，参数二代表键值类型，参数三代表从元素中取出键值的函数对象，
+// 参数四代表键值比较类型，参数五代表节点的目标字节数
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize = 256>
+class btree
+{
+public:
+  // btree 的嵌套型别定义
+  typedef Key                                         key_type;
+  typedef Value                                       value_type;
+  typedef Compare                                     key_compare;
+
+  typedef btree_params<Value, Key, NodeSize>          params;
+  typedef btree_node_base                             base_type;
+  typedef btree_node_base*                            base_ptr;
+  typedef btree_leaf_node<Value, params::leaf_slots>  leaf_node;
+  typedef btree_internal_node<Key, params::internal_slots> internal_node;
+  typedef mystl::allocator<leaf_node>                 leaf_allocator;
+  typedef mystl::allocator<internal_node>             internal_allocator;
+
+  typedef mystl::allocator<Value>                     allocator_type;
+  typedef typename allocator_type::pointer            pointer;
+  typedef typename allocator_type::const_pointer      const_pointer;
+  typedef typename allocator_type::reference          reference;
+  typedef typename allocator_type::const_reference    const_reference;
+  typedef typename allocator_type::size_type          size_type;
+  typedef typename allocator_type::difference_type    difference_type;
+
+  typedef btree_iterator<leaf_node, Value&, Value*>             iterator;
+  typedef btree_iterator<leaf_node, const Value&, const Value*> const_iterator;
+  typedef mystl::reverse_iterator<iterator>                     reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>               const_reverse_iterator;
+
+  static constexpr size_type leaf_slots     = params::leaf_slots;
+  static constexpr size_type internal_slots = params::internal_slots;
+
+  static_assert(std::is_nothrow_move_constructible<typename leaf_node::slot_type>::value &&
+                std::is_nothrow_move_constructible<Key>::value &&
+                std::is_nothrow_move_assignable<Key>::value,
+                "btree requires nothrow move for its elements and keys");
+
+  allocator_type get_allocator() const { return allocator_type(); }
+  key_compare    key_comp()      const { return key_comp_; }
+
+private:
+  // 叶节点与内部节点元素个数的下限，低于下限时向兄弟节点借或与兄弟节点合并
+  static constexpr size_type min_leaf     = leaf_slots / 2;
+  static constexpr size_type min_internal = internal_slots / 2;
+
+  // 一次插入最多需要的新节点 : 一个叶节点和沿路径向上的每个内部节点，再加一个新的根
+  struct node_stock
+  {
+    leaf_node*     leaf;
+    internal_node* internals[64];
+    size_type      count;
+
+    node_stock() noexcept :leaf(nullptr), count(0) {}
+    ~node_stock()
+    {
+      if (leaf != nullptr)
+        leaf_allocator::deallocate(leaf);
+      while (count != 0)
+        internal_allocator::deallocate(internals[--count]);
+    }
+    internal_node* pop() noexcept { return internals[--count]; }
+  };
+
+private:
+  base_ptr    root_;       // 根节点，空树为 nullptr
+  leaf_node*  leftmost_;   // 最左边的叶节点
+  leaf_node*  rightmost_;  // 最右边的叶节点
+  size_type   size_;       // 元素个数
+  key_compare key_comp_;   // 键值比较的准则
+
+public:
+  // 构造、复制、析构函数
+  btree()
+    :root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), key_comp_()
+  {
+  }
+
+  explicit btree(const key_compare& comp)
+    :root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), key_comp_(comp)
+  {
+  }
+
+  // 元素已有序，直接逐层建树
+  btree(const btree& rhs)
+    :root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), key_comp_(rhs.key_comp_)
+  {
+    bulk_load(rhs.begin(), rhs.end(), rhs.size_);
+  }
+
+  btree(btree&& rhs) noexcept
+    :root_(rhs.root_), leftmost_(rhs.leftmost_), rightmost_(rhs.rightmost_),
+     size_(rhs.size_), key_comp_(rhs.key_comp_)
+  {
+    rhs.reset();
+  }
+
+  btree& operator=(const btree& rhs)
+  {
+    if (this != &rhs)
+    {
+      btree tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  btree& operator=(btree&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      clear();
+      root_ = rhs.root_;
+      leftmost_ = rhs.leftmost_;
+      rightmost_ = rhs.rightmost_;
+      size_ = rhs.size_;
+      key_comp_ = rhs.key_comp_;
+      rhs.reset();
+    }
+    return *this;
+  }
+
+  ~btree() { clear(); }
+
+public:
+  // 迭代器相关操作
+
+  iterator               begin()         noexcept
+  { return iterator(leftmost_, 0); }
+  const_iterator         begin()   const noexcept
+  { return const_iterator(leftmost_, 0); }
+  iterator               end()           noexcept
+  { return iterator(rightmost_, rightmost_ == nullptr ? 0 : rightmost_->count); }
+  const_iterator         end()     const noexcept
+  { return const_iterator(rightmost_, rightmost_ == nullptr ? 0 : rightmost_->count); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关操作
+
+  bool      empty()    const noexcept { return size_ == 0; }
+  size_type size()     const noexcept { return size_; }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(Value); }
+
+  // 树高与节点个数，用于观察内存占用
+  size_type height() const noexcept;
+  size_type leaf_count() const noexcept;
+  size_type internal_count() const noexcept;
+  size_type bytes_used() const noexcept
+  { return leaf_count() * sizeof(leaf_node) + internal_count() * sizeof(internal_node); }
+
+  // 插入删除相关操作
+
+  template <class ...Args>
+  mystl::pair<iterator, bool> emplace_unique(Args&& ...args)
+  {
+    value_type tmp(mystl::forward<Args>(args)...);
+    return insert_unique(mystl::move(tmp));
+  }
+
+  template <class ...Args>
+  iterator emplace_unique_use_hint(const_iterator hint, Args&& ...args)
+  {
+    value_type tmp(mystl::forward<Args>(args)...);
+    return insert_unique(hint, mystl::move(tmp));
+  }
+
+  // try_emplace，只用于 map，键不存在时才构造实值
+  template <class K, class ...Args>
+  mystl::pair<iterator, bool> try_emplace_unique(K&& key, Args&& ...args);
+
+  mystl::pair<iterator, bool> insert_unique(const value_type& value)
+  { return insert_value(value); }
+  mystl::pair<iterator, bool> insert_unique(value_type&& value)
+  { return insert_value(mystl::move(value)); }
+
+  iterator insert_unique(const_iterator hint, const value_type& value)
+  { return insert_value_hint(hint, value); }
+  iterator insert_unique(const_iterator hint, value_type&& value)
+  { return insert_value_hint(hint, mystl::move(value)); }
+
+  // 空树中插入有序的前向区间时 O(n) 建树，否则逐个在 end() 处带提示插入
+  template <class InputIter>
+  void     insert_unique(InputIter first, InputIter last)
+  { insert_range(first, last, iterator_category(first)); }
+
+  iterator  erase(const_iterator pos);
+  size_type erase_unique(const key_type& key);
+  iterator  erase(const_iterator first, const_iterator last);
+
+  void      clear() noexcept;
+
+  // 查找相关操作
+
+  iterator       find(const key_type& key)
+  {
+    iterator it = lower_bound(key);
+    return (it == end() || key_comp_(key, key_of(*it))) ? end() : it;
+  }
+  const_iterator find(const key_type& key) const
+  {
+    const_iterator it = lower_bound(key);
+    return (it == end() || key_comp_(key, key_of(*it))) ? end() : it;
+  }
+
+  size_type      count_unique(const key_type& key) const
+  { return find(key) != end() ? 1 : 0; }
+
+  iterator       lower_bound(const key_type& key)
+  { return bound(key, m_true_type()); }
+  const_iterator lower_bound(const key_type& key) const
+  { return const_cast<btree*>(this)->bound(key, m_true_type()); }
+
+  iterator       upper_bound(const key_type& key)
+  { return bound(key, m_false_type()); }
+  const_iterator upper_bound(const key_type& key) const
+  { return const_cast<btree*>(this)->bound(key, m_false_type()); }
+
+  mystl::pair<iterator, iterator>
+  equal_range_unique(const key_type& key)
+  {
+    iterator it = find(key);
+    iterator next = it;
+    return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
+  }
+  mystl::pair<const_iterator, const_iterator>
+  equal_range_unique(const key_type& key) const
+  {
+    const_iterator it = find(key);
+    const_iterator next = it;
+    return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
+  }
+
+  void      swap(btree& rhs) noexcept
+  {
+    mystl::swap(root_, rhs.root_);
+    mystl::swap(leftmost_, rhs.leftmost_);
+    mystl::swap(rightmost_, rhs.rightmost_);
+    mystl::swap(size_, rhs.size_);
+    mystl::swap(key_comp_, rhs.key_comp_);
+  }
+
+private:
+  // helper functions
+
+  static const key_type& key_of(const value_type& value) noexcept
+  { return ExtractKey()(value); }
+
+  static leaf_node*     as_leaf(base_ptr x) noexcept
+  { return static_cast<leaf_node*>(x); }
+  static internal_node* as_internal(base_ptr x) noexcept
+  { return static_cast<internal_node*>(x); }
+
+  void reset() noexcept
+  {
+    root_ = nullptr;
+    leftmost_ = nullptr;
+    rightmost_ = nullptr;
+    size_ = 0;
+  }
+
+  // 节点的分配与释放
+  static leaf_node*     init_leaf(leaf_node* x) noexcept;
+  static internal_node* init_internal(internal_node* x) noexcept;
+  static void           destroy_leaf(leaf_node* x) noexcept;
+  static void           destroy_internal(internal_node* x) noexcept;
+  static void           destroy_subtree(base_ptr x) noexcept;
+
+  // 元素与键的搬移 : 在 dst 处移动构造，再析构 src
+  template <class T>
+  static void relocate(T* dst, T* src) noexcept
+  {
+    mystl::construct(dst, mystl::move(*src));
+    mystl::destroy(src);
+  }
+  template <class T>
+  static void relocate_forward(T* dst, T* src, size_type n) noexcept
+  {
+    for (size_type i = 0; i < n; ++i)
+      relocate(dst + i, src + i);
+  }
+  template <class T>
+  static void relocate_backward(T* dst, T* src, size_type n) noexcept
+  {
+    while (n != 0)
+    {
+      --n;
+      relocate(dst + n, src + n);
+    }
+  }
+
+  // 节点内查找
+  size_type leaf_lower_bound(const leaf_node* x, const key_type& key) const;
+  size_type leaf_upper_bound(const leaf_node* x, const key_type& key) const;
+  size_type child_index(const internal_node* x, const key_type& key) const;
+  size_type leaf_lower_bound(const leaf_node* x, const key_type& key, m_true_type) const;
+  size_type leaf_lower_bound(const leaf_node* x, const key_type& key, m_false_type) const;
+  size_type leaf_upper_bound(const leaf_node* x, const key_type& key, m_true_type) const;
+  size_type leaf_upper_bound(const leaf_node* x, const key_type& key, m_false_type) const;
+  size_type child_index(const internal_node* x, const key_type& key, m_true_type) const;
+  size_type child_index(const internal_node* x, const key_type& key, m_false_type) const;
+
+  leaf_node* find_leaf(const key_type& key) const;
+  template <class Lower>
+  iterator   bound(const key_type& key, Lower lower);
+  iterator   normalize(leaf_node* x, size_type pos) noexcept;
+
+  // 插入
+  template <class V>
+  mystl::pair<iterator, bool> insert_value(V&& value);
+  template <class V>
+  iterator   insert_value_hint(const_iterator hint, V&& value);
+  template <class V>
+  iterator   insert_at(leaf_node* x, size_type pos, V&& value);
+  void       stock_nodes(leaf_node* x, node_stock& stock);
+  void       split_leaf(leaf_node*& x, size_type& pos, node_stock& stock);
+  void       insert_into_parent(base_ptr left, key_type&& sep, base_ptr right,
+                                bool append, node_stock& stock) noexcept;
+  static void insert_child(internal_node* p, size_type i, key_type&& sep,
+                           base_ptr right) noexcept;
+
+  template <class InputIter>
+  void       insert_range(InputIter first, InputIter last, input_iterator_tag);
+  template <class ForwardIter>
+  void       insert_range(ForwardIter first, ForwardIter last, forward_iterator_tag);
+  template <class ForwardIter>
+  void       bulk_load(ForwardIter first, ForwardIter last, size_type n);
+
+  // 删除
+  void       rebalance_leaf(leaf_node*& x, size_type& pos) noexcept;
+  void       rebalance_internal(internal_node* x) noexcept;
+  static void remove_child(internal_node* p, size_type i) noexcept;
+  static void fix_children(internal_node* p, size_type from) noexcept;
+};
+
+/*****************************************************************************************/
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+template <class K, class ...Args>
+mystl::pair<typename btree<Value, Key, ExtractKey, Compare, NodeSize>::iterator, bool>
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+try_emplace_unique(K&& key, Args&& ...args)
+{
+  typedef typename value_type::second_type mapped_type;
+  leaf_node* x = find_leaf(key);
+  size_type pos = 0;
+  if (x != nullptr)
+  {
+    pos = leaf_lower_bound(x, key);
+    if (pos < x->count && !key_comp_(key, key_of(*x->value(pos))))
+      return mystl::make_pair(iterator(x, pos), false);
+  }
+  // 以可修改键值的 pair 暂存，插入时移动键值
+  typename leaf_node::slot_type tmp(mystl::forward<K>(key), mapped_type(mystl::forward<Args>(args)...));
+  return mystl::make_pair(insert_at(x, pos, mystl::move(tmp)), true);
+}
+
+// 删除 pos 位置的元素，返回下一个元素的迭代器
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::iterator
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+erase(const_iterator it)
+{
+  MYSTL_DEBUG(it != end());
+  leaf_node* x = it.node;
+  size_type pos = it.position;
+  mystl::destroy(x->value(pos));
+  relocate_forward(x->slot(pos), x->slot(pos + 1), x->count - pos - 1);
+  --x->count;
+  --size_;
+  if (x->parent == nullptr)
+  { // 根为叶节点
+    if (x->count == 0)
+    {
+      destroy_leaf(x);
+      reset();
+      return end();
+    }
+  }
+  else if (x->count < min_leaf)
+  {
+    rebalance_leaf(x, pos);
+  }
+  return normalize(x, pos);
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::size_type
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+erase_unique(const key_type& key)
+{
+  iterator it = find(key);
+  if (it == end())
+    return 0;
+  erase(it);
+  return 1;
+}
+
+// 删除 [first, last)，每次删除都可能搬移元素，因此按个数删除
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::iterator
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+erase(const_iterator first, const_iterator last)
+{
+  if (first == begin() && last == end())
+  {
+    clear();
+    return end();
+  }
+  size_type n = static_cast<size_type>(mystl::distance(first, last));
+  iterator it(first.node, first.position);
+  while (n-- != 0)
+    it = erase(it);
+  return it;
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+clear() noexcept
+{
+  if (root_ != nullptr)
+  {
+    destroy_subtree(root_);
+    reset();
+  }
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::size_type
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+height() const noexcept
+{
+  size_type h = 0;
+  for (base_ptr x = root_; x != nullptr; ++h)
+    x = x->leaf ? nullptr : as_internal(x)->children[0];
+  return h;
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::size_type
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+leaf_count() const noexcept
+{
+  size_type n = 0;
+  for (leaf_node* x = leftmost_; x != nullptr; x = x->next)
+    ++n;
+  return n;
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::size_type
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+internal_count() const noexcept
+{
+  if (root_ == nullptr || root_->leaf)
+    return 0;
+  // 深度优先遍历，只访问内部节点
+  size_type n = 0;
+  mystl::vector<internal_node*> stack;
+  stack.push_back(as_internal(root_));
+  while (!stack.empty())
+  {
+    internal_node* x = stack.back();
+    stack.pop_back();
+    ++n;
+    if (!x->children[0]->leaf)
+    {
+      for (size_type i = 0; i <= x->count; ++i)
+        stack.push_back(as_internal(x->children[i]));
+    }
+  }
+  return n;
+}
+
+/*****************************************************************************************/
+// helper function
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::leaf_node*
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+init_leaf(leaf_node* x) noexcept
+{
+  x->parent = nullptr;
+  x->position = 0;
+  x->count = 0;
+  x->leaf = true;
+  x->prev = nullptr;
+  x->next = nullptr;
+  return x;
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::internal_node*
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+init_internal(internal_node* x) noexcept
+{
+  x->parent = nullptr;
+  x->position = 0;
+  x->count = 0;
+  x->leaf = false;
+  return x;
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+destroy_leaf(leaf_node* x) noexcept
+{
+  for (size_type i = 0; i < x->count; ++i)
+    mystl::destroy(x->value(i));
+  leaf_allocator::deallocate(x);
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+destroy_internal(internal_node* x) noexcept
+{
+  for (size_type i = 0; i < x->count; ++i)
+    mystl::destroy(x->key(i));
+  internal_allocator::deallocate(x);
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+destroy_subtree(base_ptr x) noexcept
+{
+  if (x->leaf)
+  {
+    destroy_leaf(as_leaf(x));
+    return;
+  }
+  internal_node* p = as_internal(x);
+  for (size_type i = 0; i <= p->count; ++i)
+    destroy_subtree(p->children[i]);
+  destroy_internal(p);
+}
+
+// 节点内查找 : 线性计数的版本没有分支，比较结果直接累加
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::size_type
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+leaf_lower_bound(const leaf_node* x, const key_type& key) const
+{
+  return leaf_lower_bound(x, key, btree_linear_search<Key, Compare>());
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::size_type
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+leaf_upper_bound(const leaf_node* x, const key_type& key) const
+{
+  return leaf_upper_bound(x, key, btree_linear_search<Key, Compare>());
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::size_type
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+child_index(const internal_node* x, const key_type& key) const
+{
+  return child_index(x, key, btree_linear_search<Key, Compare>());
+}
+
+// 第一个不小于 key 的元素 : 小于 key 的元素个数
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::size_type
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+leaf_lower_bound(const leaf_node* x, const key_type& key, m_true_type) const
+{
+  size_type n = 0;
+  const size_type count = x->count;
+  for (size_type i = 0; i < count; ++i)
+    n += key_of(*x->value(i)) < key;
+  return n;
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::size_type
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+leaf_lower_bound(const leaf_node* x, const key_type& key, m_false_type) const
+{
+  size_type lo = 0, hi = x->count;
+  while (lo < hi)
+  {
+    const size_type mid = (lo + hi) / 2;
+    if (key_comp_(key_of(*x->value(mid)), key))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+// 第一个大于 key 的元素 : 不大于 key 的元素个数
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::size_type
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+leaf_upper_bound(const leaf_node* x, const key_type& key, m_true_type) const
+{
+  size_type n = 0;
+  const size_type count = x->count;
+  for (size_type i = 0; i < count; ++i)
+    n += !(key < key_of(*x->value(i)));
+  return n;
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::size_type
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+leaf_upper_bound(const leaf_node* x, const key_type& key, m_false_type) const
+{
+  size_type lo = 0, hi = x->count;
+  while (lo < hi)
+  {
+    const size_type mid = (lo + hi) / 2;
+    if (key_comp_(key, key_of(*x->value(mid))))
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return lo;
+}
+
+// 内部节点中要进入的子节点 : 不大于 key 的分隔键个数
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::size_type
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+child_index(const internal_node* x, const key_type& key, m_true_type) const
+{
+  size_type n = 0;
+  const size_type count = x->count;
+  const key_type* keys = x->key(0);
+  for (size_type i = 0; i < count; ++i)
+    n += !(key < keys[i]);
+  return n;
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::size_type
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+child_index(const internal_node* x, const key_type& key, m_false_type) const
+{
+  size_type lo = 0, hi = x->count;
+  while (lo < hi)
+  {
+    const size_type mid = (lo + hi) / 2;
+    if (key_comp_(key, *x->key(mid)))
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return lo;
+}
+
+// 找到 key 所属的叶节点，空树返回 nullptr
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::leaf_node*
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+find_leaf(const key_type& key) const
+{
+  base_ptr x = root_;
+  if (x == nullptr)
+    return nullptr;
+  while (!x->leaf)
+  {
+    const internal_node* p = as_internal(x);
+    x = p->children[child_index(p, key)];
+  }
+  return as_leaf(x);
+}
+
+// lower 为 m_true_type 时求 lower_bound，否则求 upper_bound
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+template <class Lower>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::iterator
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+bound(const key_type& key, Lower)
+{
+  leaf_node* x = find_leaf(key);
+  if (x == nullptr)
+    return end();
+  const size_type pos = Lower::value ? leaf_lower_bound(x, key) : leaf_upper_bound(x, key);
+  return normalize(x, pos);
+}
+
+// 位置在叶节点末尾时移到下一个叶节点的开头，最右叶节点的末尾即为 end()
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::iterator
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+normalize(leaf_node* x, size_type pos) noexcept
+{
+  if (pos == x->count && x->next != nullptr)
+    return iterator(x->next, 0);
+  return iterator(x, pos);
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+template <class V>
+mystl::pair<typename btree<Value, Key, ExtractKey, Compare, NodeSize>::iterator, bool>
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+insert_value(V&& value)
+{
+  const key_type& key = key_of(value);
+  leaf_node* x = find_leaf(key);
+  size_type pos = 0;
+  if (x != nullptr)
+  {
+    pos = leaf_lower_bound(x, key);
+    if (pos < x->count && !key_comp_(key, key_of(*x->value(pos))))
+      return mystl::make_pair(iterator(x, pos), false);
+  }
+  return mystl::make_pair(insert_at(x, pos, mystl::forward<V>(value)), true);
+}
+
+// 带提示的插入 : 提示为 end() 且大于最大元素，或者提示与它的前驱在同一个叶节点且 key 位于两者之间时，
+// 不需要从根查找
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+template <class V>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::iterator
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+insert_value_hint(const_iterator hint, V&& value)
+{
+  const key_type& key = key_of(value);
+  leaf_node* x = hint.node;
+  const size_type pos = hint.position;
+  if (x != nullptr && pos != 0 && key_comp_(key_of(*x->value(pos - 1)), key) &&
+      (pos == x->count ? x->next == nullptr : key_comp_(key, key_of(*x->value(pos)))))
+  {
+    return insert_at(x, pos, mystl::forward<V>(value));
+  }
+  return insert_value(mystl::forward<V>(value)).first;
+}
+
+// 在叶节点 x 的 pos 位置插入元素，x 为 nullptr 时树为空
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+template <class V>
+typename btree<Value, Key, ExtractKey, Compare, NodeSize>::iterator
+btree<Value, Key, ExtractKey, Compare, NodeSize>::
+insert_at(leaf_node* x, size_type pos, V&& value)
+{
+  THROW_LENGTH_ERROR_IF(size_ == max_size(), "btree<T>'s size too big");
+  if (x == nullptr)
+  { // 空树
+    x = init_leaf(leaf_allocator::allocate());
+    try
+    {
+      mystl::construct(x->value(0), mystl::forward<V>(value));
+    }
+    catch (...)
+    {
+      leaf_allocator::deallocate(x);
+      throw;
+    }
+    x->count = 1;
+    root_ = x;
+    leftmost_ = x;
+    rightmost_ = x;
+    size_ = 1;
+    return iterator(x, 0);
+  }
+  if (x->count == leaf_slots)
+  {
+    node_stock stock;
+    stock_nodes(x, stock);
+    split_leaf(x, pos, stock);
+  }
+  relocate_backward(x->slot(pos + 1), x->slot(pos), x->count - pos);
+  try
+  {
+    mystl::construct(x->value(pos), mystl::forward<V>(value));
+  }
+  catch (...)
+  {
+    relocate_forward(x->slot(pos), x->slot(pos + 1), x->count - pos);
+    throw;
+  }
+  ++x->count;
+  ++size_;
+  return iterator(x, pos);
+}
+
+// 预先分配分裂所需的全部节点，分配失败时树没有被修改
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+stock_nodes(leaf_node* x, node_stock& stock)
+{
+  stock.leaf = init_leaf(leaf_allocator::allocate());
+  base_ptr p = x->parent;
+  while (p != nullptr && p->count == internal_slots)
+  {
+    stock.internals[stock.count] = init_internal(internal_allocator::allocate());
+    ++stock.count;
+    p = p->parent;
+  }
+  if (p == nullptr)
+  { // 一路分裂到根时需要一个新的根
+    stock.internals[stock.count] = init_internal(internal_allocator::allocate());
+    ++stock.count;
+  }
+}
+
+// 把满的叶节点 x 分成两半，x 与 pos 改为新元素应插入的叶节点与位置
+// 在最右边的叶节点末尾插入时只把最后一个元素分出去，按顺序插入时叶节点接近装满
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+split_leaf(leaf_node*& x, size_type& pos, node_stock& stock)
+{
+  const size_type count = x->count;
+  const bool append = pos == count && x->next == nullptr;
+  const size_type s = append ? count - 1 : count / 2;
+  key_type sep(key_of(*x->value(s)));  // 复制分隔键，之后的操作都不会抛出异常
+  leaf_node* y = stock.leaf;
+  stock.leaf = nullptr;
+  relocate_forward(y->slot(0), x->slot(s), count - s);
+  x->count = static_cast<uint16_t>(s);
+  y->count = static_cast<uint16_t>(count - s);
+  y->prev = x;
+  y->next = x->next;
+  if (x->next != nullptr)
+    x->next->prev = y;
+  else
+    rightmost_ = y;
+  x->next = y;
+  insert_into_parent(x, mystl::move(sep), y, append, stock);
+  if (pos > s)
+  {
+    x = y;
+    pos -= s;
+  }
+}
+
+// 在 left 之后插入分隔键 sep 与新的兄弟节点 right，父节点满时继续向上分裂
+// append 表示沿最右边的路径插入，此时分裂同样把键尽量留在左边
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+insert_into_parent(base_ptr left, key_type&& sep, base_ptr right, bool append,
+                   node_stock& stock) noexcept
+{
+  internal_node* p = as_internal(left->parent);
+  if (p == nullptr)
+  { // left 为根，树增高一层
+    internal_node* r = stock.pop();
+    mystl::construct(r->key(0), mystl::move(sep));
+    r->count = 1;
+    r->children[0] = left;
+    r->children[1] = right;
+    fix_children(r, 0);
+    root_ = r;
+    return;
+  }
+  const size_type i = left->position;
+  if (p->count < internal_slots)
+  {
+    insert_child(p, i, mystl::move(sep), right);
+    return;
+  }
+  // 父节点已满 : 左边保留 [0, s) 个键，键 s 上移，右边得到 [s + 1, n) 个键
+  const size_type n = p->count;
+  const size_type s = append ? n - 1 : n / 2;
+  internal_node* q = stock.pop();
+  relocate_forward(q->key(0), p->key(s + 1), n - s - 1);
+  for (size_type k = s + 1; k <= n; ++k)
+    q->children[k - s - 1] = p->children[k];
+  q->count = static_cast<uint16_t>(n - s - 1);
+  key_type up(mystl::move(*p->key(s)));
+  mystl::destroy(p->key(s));
+  p->count = static_cast<uint16_t>(s);
+  fix_children(q, 0);
+  if (i <= s)
+    insert_child(p, i, mystl::move(sep), right);
+  else
+    insert_child(q, i - s - 1, mystl::move(sep), right);
+  insert_into_parent(p, mystl::move(up), q, append, stock);
+}
+
+// 在未满的内部节点 p 中插入分隔键 i 与子节点 i + 1
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+insert_child(internal_node* p, size_type i, key_type&& sep, base_ptr right) noexcept
+{
+  const size_type n = p->count;
+  relocate_backward(p->key(i + 1), p->key(i), n - i);
+  mystl::construct(p->key(i), mystl::move(sep));
+  for (size_type k = n + 1; k > i + 1; --k)
+    p->children[k] = p->children[k - 1];
+  p->children[i + 1] = right;
+  p->count = static_cast<uint16_t>(n + 1);
+  fix_children(p, i + 1);
+}
+
+// 输入迭代器的区间逐个插入
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+template <class InputIter>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+insert_range(InputIter first, InputIter last, input_iterator_tag)
+{
+  for (; first != last; ++first)
+    insert_unique(end(), *first);
+}
+
+// 前向迭代器的区间 : 空树且区间有序时直接建树
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+template <class ForwardIter>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+insert_range(ForwardIter first, ForwardIter last, forward_iterator_tag)
+{
+  if (root_ == nullptr && first != last)
+  {
+    // 检查是否严格递增之外允许相等的相邻元素，相等的元素在建树时跳过
+    size_type n = 1;
+    bool sorted = true;
+    ForwardIter prev = first;
+    for (ForwardIter it = first; ++it != last; prev = it)
+    {
+      if (key_comp_(key_of(*it), key_of(*prev)))
+      {
+        sorted = false;
+        break;
+      }
+      if (key_comp_(key_of(*prev), key_of(*it)))
+        ++n;
+    }
+    if (sorted)
+    {
+      bulk_load(first, last, n);
+      return;
+    }
+  }
+  for (; first != last; ++first)
+    insert_unique(end(), *first);
+}
+
+// 用有序区间中 n 个不重复的元素逐层建树，相等的相邻元素只保留第一个
+// 叶节点按 n 平均分配元素，每一层的节点再平均分配下一层的节点，除根外都至少半满
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+template <class ForwardIter>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+bulk_load(ForwardIter first, ForwardIter last, size_type n)
+{
+  if (n == 0)
+    return;
+  MYSTL_DEBUG(root_ == nullptr);
+  // level 为当前一层的节点，lows 为每个节点中最小的键，作为上一层的分隔键
+  mystl::vector<base_ptr> level, upper;
+  mystl::vector<const key_type*> lows, upper_lows;
+  const size_type leaves = (n + leaf_slots - 1) / leaf_slots;
+  level.reserve(leaves);
+  lows.reserve(leaves);
+  try
+  {
+    leaf_node* prev = nullptr;
+    const value_type* last_value = nullptr;
+    for (size_type k = 0; k < leaves; ++k)
+    {
+      const size_type m = n / leaves + (k < n % leaves ? 1 : 0);
+      leaf_node* x = init_leaf(leaf_allocator::allocate());
+      level.push_back(x);
+      x->prev = prev;
+      if (prev != nullptr)
+        prev->next = x;
+      prev = x;
+      while (x->count < m)
+      {
+        MYSTL_DEBUG(first != last);
+        if (last_value == nullptr || key_comp_(key_of(*last_value), key_of(*first)))
+        {
+          mystl::construct(x->value(x->count), *first);
+          last_value = x->value(x->count);
+          ++x->count;
+        }
+        ++first;
+      }
+      lows.push_back(&key_of(*x->value(0)));
+    }
+    while (level.size() > 1)
+    {
+      const size_type nodes = level.size();
+      const size_type parents = (nodes + internal_slots) / (internal_slots + 1);
+      upper.clear();
+      upper_lows.clear();
+      upper.reserve(parents);
+      upper_lows.reserve(parents);
+      size_type c = 0;
+      for (size_type k = 0; k < parents; ++k)
+      {
+        const size_type m = nodes / parents + (k < nodes % parents ? 1 : 0);
+        internal_node* p = init_internal(internal_allocator::allocate());
+        upper.push_back(p);
+        upper_lows.push_back(lows[c]);
+        p->children[0] = level[c];
+        fix_children(p, 0);
+        for (size_type j = 1; j < m; ++j)
+        {
+          mystl::construct(p->key(j - 1), *lows[c + j]);
+          p->children[j] = level[c + j];
+          p->count = static_cast<uint16_t>(j);
+          fix_children(p, j);
+        }
+        c += m;
+      }
+      level.swap(upper);
+      lows.swap(upper_lows);
+    }
+  }
+  catch (...)
+  {
+    // upper 中的节点连同子树一起释放，level 中还没有父节点的节点单独释放
+    for (size_type k = 0; k < upper.size(); ++k)
+      destroy_subtree(upper[k]);
+    for (size_type k = 0; k < level.size(); ++k)
+    {
+      if (level[k]->parent == nullptr)
+        destroy_subtree(level[k]);
+    }
+    throw;
+  }
+  root_ = level[0];
+  root_->parent = nullptr;
+  leftmost_ = as_leaf(root_);
+  while (!leftmost_->leaf)
+    leftmost_ = as_leaf(as_internal(leftmost_)->children[0]);
+  rightmost_ = leftmost_;
+  while (rightmost_->next != nullptr)
+    rightmost_ = rightmost_->next;
+  size_ = n;
+}
+
+// 叶节点 x 的元素少于下限时，向兄弟节点借一个元素或与兄弟节点合并
+// pos 为 x 中要追踪的位置，返回时改为元素搬移后的叶节点与位置
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+rebalance_leaf(leaf_node*& x, size_type& pos) noexcept
+{
+  internal_node* p = as_internal(x->parent);
+  const size_type i = x->position;
+  if (i > 0)
+  {
+    leaf_node* l = as_leaf(p->children[i - 1]);
+    if (static_cast<size_type>(l->count + x->count) <= leaf_slots)
+    { // 把 x 合并到左兄弟
+      relocate_forward(l->slot(l->count), x->slot(0), x->count);
+      pos += l->count;
+      l->count = static_cast<uint16_t>(l->count + x->count);
+      x->count = 0;
+      l->next = x->next;
+      if (x->next != nullptr)
+        x->next->prev = l;
+      else
+        rightmost_ = l;
+      leaf_allocator::deallocate(x);
+      x = l;
+      remove_child(p, i - 1);
+      rebalance_internal(p);
+    }
+    else
+    { // 从左兄弟借最后一个元素
+      relocate_backward(x->slot(1), x->slot(0), x->count);
+      relocate(x->slot(0), l->slot(l->count - 1));
+      --l->count;
+      ++x->count;
+      ++pos;
+      *p->key(i - 1) = key_of(*x->value(0));
+    }
+    return;
+  }
+  leaf_node* r = as_leaf(p->children[1]);
+  if (static_cast<size_type>(x->count + r->count) <= leaf_slots)
+  { // 把右兄弟合并到 x
+    relocate_forward(x->slot(x->count), r->slot(0), r->count);
+    x->count = static_cast<uint16_t>(x->count + r->count);
+    r->count = 0;
+    x->next = r->next;
+    if (r->next != nullptr)
+      r->next->prev = x;
+    else
+      rightmost_ = x;
+    leaf_allocator::deallocate(r);
+    remove_child(p, 0);
+    rebalance_internal(p);
+  }
+  else
+  { // 从右兄弟借第一个元素
+    relocate(x->slot(x->count), r->slot(0));
+    relocate_forward(r->slot(0), r->slot(1), r->count - 1);
+    --r->count;
+    ++x->count;
+    *p->key(0) = key_of(*r->value(0));
+  }
+}
+
+// 内部节点 x 的分隔键少于下限时，经由父节点的分隔键向兄弟节点借一个子节点或与兄弟节点合并
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+rebalance_internal(internal_node* x) noexcept
+{
+  if (x->parent == nullptr)
+  { // 根只剩一个子节点时树降低一层
+    if (x->count == 0)
+    {
+      root_ = x->children[0];
+      root_->parent = nullptr;
+      root_->position = 0;
+      internal_allocator::deallocate(x);
+    }
+    return;
+  }
+  if (x->count >= min_internal)
+    return;
+  internal_node* p = as_internal(x->parent);
+  const size_type i = x->position;
+  internal_node* l = i > 0 ? as_internal(p->children[i - 1]) : x;
+  internal_node* r = i > 0 ? x : as_internal(p->children[1]);
+  const size_type j = l->position;  // l 与 r 之间的分隔键为 p->key(j)
+  if (static_cast<size_type>(l->count + r->count + 1) <= internal_slots)
+  { // 把 r 与分隔键合并到 l
+    const size_type n = l->count;
+    mystl::construct(l->key(n), mystl::move(*p->key(j)));
+    relocate_forward(l->key(n + 1), r->key(0), r->count);
+    for (size_type k = 0; k <= r->count; ++k)
+      l->children[n + 1 + k] = r->children[k];
+    l->count = static_cast<uint16_t>(n + 1 + r->count);
+    r->count = 0;
+    fix_children(l, n + 1);
+    internal_allocator::deallocate(r);
+    remove_child(p, j);
+    rebalance_internal(p);
+  }
+  else if (x == r)
+  { // 从左兄弟借最后一个子节点
+    const size_type n = r->count;
+    relocate_backward(r->key(1), r->key(0), n);
+    for (size_type k = n + 1; k > 0; --k)
+      r->children[k] = r->children[k - 1];
+    mystl::construct(r->key(0), mystl::move(*p->key(j)));
+    r->children[0] = l->children[l->count];
+    *p->key(j) = mystl::move(*l->key(l->count - 1));
+    mystl::destroy(l->key(l->count - 1));
+    --l->count;
+    r->count = static_cast<uint16_t>(n + 1);
+    fix_children(r, 0);
+  }
+  else
+  { // 从右兄弟借第一个子节点
+    const size_type n = l->count;
+    mystl::construct(l->key(n), mystl::move(*p->key(j)));
+    l->children[n + 1] = r->children[0];
+    l->count = static_cast<uint16_t>(n + 1);
+    fix_children(l, n + 1);
+    *p->key(j) = mystl::move(*r->key(0));
+    mystl::destroy(r->key(0));
+    relocate_forward(r->key(0), r->key(1), r->count - 1);
+    for (size_type k = 0; k < r->count; ++k)
+      r->children[k] = r->children[k + 1];
+    --r->count;
+    fix_children(r, 0);
+  }
+}
+
+// 删除内部节点 p 的分隔键 i 与子节点 i + 1
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+remove_child(internal_node* p, size_type i) noexcept
+{
+  const size_type n = p->count;
+  mystl::destroy(p->key(i));
+  relocate_forward(p->key(i), p->key(i + 1), n - i - 1);
+  for (size_type k = i + 1; k < n; ++k)
+    p->children[k] = p->children[k + 1];
+  p->count = static_cast<uint16_t>(n - 1);
+  fix_children(p, i + 1);
+}
+
+// 更新 p 中从 from 开始的子节点的 parent 与 position
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+void btree<Value, Key, ExtractKey, Compare, NodeSize>::
+fix_children(internal_node* p, size_type from) noexcept
+{
+  for (size_type k = from; k <= p->count; ++k)
+  {
+    p->children[k]->parent = p;
+    p->children[k]->position = static_cast<uint16_t>(k);
+  }
+}
+
+// 重载比较操作符
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+bool operator==(const btree<Value, Key, ExtractKey, Compare, NodeSize>& lhs,
+                const btree<Value, Key, ExtractKey, Compare, NodeSize>& rhs)
+{
+  return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class Value, class Key, class ExtractKey, class Compare, size_t NodeSize>
+bool operator<(const btree<Value, Key, ExtractKey, Compare, NodeSize>& lhs,
+               const btree<Value, Key, ExtractKey, Compare, NodeSize>& rhs)
+{
+  return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_BTREE_H_
@@ -0,0 +1,337 @@
+#ifndef TINYSTL_BTREE_MAP_H_
+#define TINYSTL_BTREE_MAP_H_
+
+// 这个头文件包含一个模板类 btree_map
+// btree_map : 映射，元素按键值有序排列，键值不允许重复，底层实现为 B+ 树
+// 与 map 相比每个节点存放十几个元素，内存更少、查找的缓存缺失更少，区间遍历沿叶节点链表进行，
+// 但插入、删除会搬移元素，所有迭代器与引用都会失效，也不支持节点句柄
+// 从有序区间 (例如有序的 mystl::vector) 构造时 O(n) 直接建树
+
+// 异常保证：
+// mystl::btree_map<Key, T> 要求键值与实值的移动不抛出异常，对 insert / emplace / try_emplace 做强异常安全保证
+
+#include "btree.h"
+
+namespace mystl
+{
+
+// 模板类 btree_map
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 mystl::less，
+// 参数四代表节点的目标字节数
+template <class Key, class T, class Compare = mystl::less<Key>, size_t NodeSize = 256>
+class btree_map
+{
+public:
+  // btree_map 的嵌套型别定义
+  typedef Key                        key_type;
+  typedef T                          mapped_type;
+  typedef mystl::pair<const Key, T>  value_type;
+  typedef Compare                    key_compare;
+
+  // 定义一个 functor，用来进行元素比较
+  class value_compare : public binary_function<value_type, value_type, bool>
+  {
+    friend class btree_map<Key, T, Compare, NodeSize>;
+  private:
+    Compare comp;
+    value_compare(Compare c) : comp(c) {}
+  public:
+    bool operator()(const value_type& lhs, const value_type& rhs) const
+    {
+      return comp(lhs.first, rhs.first);  // 比较键值的大小
+    }
+  };
+
+private:
+  // 以 mystl::btree 作为底层机制
+  typedef mystl::btree<value_type, key_type, mystl::selectfirst<value_type>,
+                       key_compare, NodeSize> base_type;
+  base_type tree_;
+
+public:
+  // 使用 btree 的型别
+  typedef typename base_type::allocator_type          allocator_type;
+  typedef typename base_type::pointer                 pointer;
+  typedef typename base_type::const_pointer           const_pointer;
+  typedef typename base_type::reference               reference;
+  typedef typename base_type::const_reference         const_reference;
+  typedef typename base_type::size_type               size_type;
+  typedef typename base_type::difference_type         difference_type;
+
+  typedef typename base_type::iterator                iterator;
+  typedef typename base_type::const_iterator          const_iterator;
+  typedef typename base_type::reverse_iterator        reverse_iterator;
+  typedef typename base_type::const_reverse_iterator  const_reverse_iterator;
+
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+  key_compare    key_comp()      const { return tree_.key_comp(); }
+  value_compare  value_comp()    const { return value_compare(tree_.key_comp()); }
+
+public:
+  // 构造、复制、移动、赋值函数
+  btree_map() = default;
+
+  explicit btree_map(const key_compare& comp)
+    :tree_(comp)
+  {
+  }
+
+  // 空容器中插入有序区间时 O(n) 建树
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  btree_map(InputIter first, InputIter last, const key_compare& comp = key_compare())
+    :tree_(comp)
+  {
+    tree_.insert_unique(first, last);
+  }
+
+  btree_map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+    :tree_(comp)
+  {
+    tree_.insert_unique(ilist.begin(), ilist.end());
+  }
+
+  btree_map(const btree_map& rhs)
+    :tree_(rhs.tree_)
+  {
+  }
+  btree_map(btree_map&& rhs) noexcept
+    :tree_(mystl::move(rhs.tree_))
+  {
+  }
+
+  btree_map& operator=(const btree_map& rhs)
+  {
+    tree_ = rhs.tree_;
+    return *this;
+  }
+  btree_map& operator=(btree_map&& rhs) noexcept
+  {
+    tree_ = mystl::move(rhs.tree_);
+    return *this;
+  }
+
+  btree_map& operator=(std::initializer_list<value_type> ilist)
+  {
+    btree_map tmp(ilist, tree_.key_comp());
+    swap(tmp);
+    return *this;
+  }
+
+  ~btree_map() = default;
+
+  // 迭代器相关
+  iterator               begin()         noexcept
+  { return tree_.begin(); }
+  const_iterator         begin()   const noexcept
+  { return tree_.begin(); }
+  iterator               end()           noexcept
+  { return tree_.end(); }
+  const_iterator         end()     const noexcept
+  { return tree_.end(); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return tree_.rbegin(); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return tree_.rbegin(); }
+  reverse_iterator       rend()          noexcept
+  { return tree_.rend(); }
+  const_reverse_iterator rend()    const noexcept
+  { return tree_.rend(); }
+
+  const_iterator         cbegin()  const noexcept
+  { return tree_.cbegin(); }
+  const_iterator         cend()    const noexcept
+  { return tree_.cend(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return tree_.crbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return tree_.crend(); }
+
+  // 容量相关
+  bool      empty()    const noexcept { return tree_.empty(); }
+  size_type size()     const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+
+  // 树高与全部节点占用的字节数
+  size_type height()     const noexcept { return tree_.height(); }
+  size_type bytes_used() const noexcept { return tree_.bytes_used(); }
+
+  // 访问元素相关
+
+  // 若键值不存在，at 会抛出一个异常
+  mapped_type&       at(const key_type& key)
+  {
+    iterator it = tree_.find(key);
+    THROW_OUT_OF_RANGE_IF(it == end(), "btree_map<Key, T> no such element exists");
+    return it->second;
+  }
+  const mapped_type& at(const key_type& key) const
+  {
+    const_iterator it = tree_.find(key);
+    THROW_OUT_OF_RANGE_IF(it == end(), "btree_map<Key, T> no such element exists");
+    return it->second;
+  }
+
+  mapped_type& operator[](const key_type& key)
+  { return tree_.try_emplace_unique(key).first->second; }
+  mapped_type& operator[](key_type&& key)
+  { return tree_.try_emplace_unique(mystl::move(key)).first->second; }
+
+  // 插入删除相关
+
+  // emplace / emplace_hint
+  template <class ...Args>
+  mystl::pair<iterator, bool> emplace(Args&& ...args)
+  { return tree_.emplace_unique(mystl::forward<Args>(args)...); }
+
+  // hint 为 end() 且键大于所有元素，或 hint 与其前驱在同一叶节点内时不需要从根查找
+  template <class ...Args>
+  iterator emplace_hint(const_iterator hint, Args&& ...args)
+  { return tree_.emplace_unique_use_hint(hint, mystl::forward<Args>(args)...); }
+
+  // try_emplace，键不存在时才用 args 构造实值
+  template <class ...Args>
+  mystl::pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+  { return tree_.try_emplace_unique(key, mystl::forward<Args>(args)...); }
+  template <class ...Args>
+  mystl::pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args)
+  { return tree_.try_emplace_unique(mystl::move(key), mystl::forward<Args>(args)...); }
+
+  template <class ...Args>
+  iterator try_emplace(const_iterator hint, const key_type& key, Args&& ...args)
+  { return tree_.try_emplace_unique_use_hint(hint, key, mystl::forward<Args>(args)...); }
+  template <class ...Args>
+  iterator try_emplace(const_iterator hint, key_type&& key, Args&& ...args)
+  {
+    return tree_.try_emplace_unique_use_hint(hint, mystl::move(key),
+                                             mystl::forward<Args>(args)...);
+  }
+
+  // insert
+  mystl::pair<iterator, bool> insert(const value_type& value)
+  { return tree_.insert_unique(value); }
+  mystl::pair<iterator, bool> insert(value_type&& value)
+  { return tree_.insert_unique(mystl::move(value)); }
+
+  iterator insert(const_iterator hint, const value_type& value)
+  { return tree_.insert_unique(hint, value); }
+  iterator insert(const_iterator hint, value_type&& value)
+  { return tree_.insert_unique(hint, mystl::move(value)); }
+
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  void insert(InputIter first, InputIter last)
+  { tree_.insert_unique(first, last); }
+  void insert(std::initializer_list<value_type> ilist)
+  { tree_.insert_unique(ilist.begin(), ilist.end()); }
+
+  // insert_or_assign
+  template <class M>
+  mystl::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+  {
+    auto r = tree_.try_emplace_unique(key, mystl::forward<M>(obj));
+    if (!r.second)
+      r.first->second = mystl::forward<M>(obj);
+    return r;
+  }
+  template <class M>
+  mystl::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+  {
+    auto r = tree_.try_emplace_unique(mystl::move(key), mystl::forward<M>(obj));
+    if (!r.second)
+      r.first->second = mystl::forward<M>(obj);
+    return r;
+  }
+
+  // erase / clear，删除后所有迭代器失效，erase 返回下一个元素的迭代器
+  iterator  erase(const_iterator position)
+  { return tree_.erase(position); }
+  iterator  erase(iterator position)
+  { return tree_.erase(position); }
+  size_type erase(const key_type& key)
+  { return tree_.erase_unique(key); }
+  iterator  erase(const_iterator first, const_iterator last)
+  { return tree_.erase(first, last); }
+
+  void      clear() noexcept
+  { tree_.clear(); }
+
+  void      swap(btree_map& rhs) noexcept
+  { tree_.swap(rhs.tree_); }
+
+  // btree_map 相关操作
+
+  iterator       find(const key_type& key)
+  { return tree_.find(key); }
+  const_iterator find(const key_type& key) const
+  { return tree_.find(key); }
+
+  size_type      count(const key_type& key) const
+  { return tree_.count_unique(key); }
+  bool           contains(const key_type& key) const
+  { return tree_.find(key) != tree_.end(); }
+
+  iterator       lower_bound(const key_type& key)
+  { return tree_.lower_bound(key); }
+  const_iterator lower_bound(const key_type& key) const
+  { return tree_.lower_bound(key); }
+
+  iterator       upper_bound(const key_type& key)
+  { return tree_.upper_bound(key); }
+  const_iterator upper_bound(const key_type& key) const
+  { return tree_.upper_bound(key); }
+
+  mystl::pair<iterator, iterator>
+  equal_range(const key_type& key)
+  { return tree_.equal_range_unique(key); }
+  mystl::pair<const_iterator, const_iterator>
+  equal_range(const key_type& key) const
+  { return tree_.equal_range_unique(key); }
+
+public:
+  friend bool operator==(const btree_map& lhs, const btree_map& rhs)
+  { return lhs.tree_ == rhs.tree_; }
+  friend bool operator< (const btree_map& lhs, const btree_map& rhs)
+  { return lhs.tree_ <  rhs.tree_; }
+};
+
+// 重载比较操作符
+template <class Key, class T, class Compare, size_t NodeSize>
+bool operator!=(const btree_map<Key, T, Compare, NodeSize>& lhs,
+                const btree_map<Key, T, Compare, NodeSize>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare, size_t NodeSize>
+bool operator>(const btree_map<Key, T, Compare, NodeSize>& lhs,
+               const btree_map<Key, T, Compare, NodeSize>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class Key, class T, class Compare, size_t NodeSize>
+bool operator<=(const btree_map<Key, T, Compare, NodeSize>& lhs,
+                const btree_map<Key, T, Compare, NodeSize>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare, size_t NodeSize>
+bool operator>=(const btree_map<Key, T, Compare, NodeSize>& lhs,
+                const btree_map<Key, T, Compare, NodeSize>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class Key, class T, class Compare, size_t NodeSize>
+void swap(btree_map<Key, T, Compare, NodeSize>& lhs,
+          btree_map<Key, T, Compare, NodeSize>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_BTREE_MAP_H_
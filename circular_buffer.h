@@ -0,0 +1,628 @@
+#ifndef TINYSTL_CIRCULAR_BUFFER_H_
+#define TINYSTL_CIRCULAR_BUFFER_H_
+
+// 这个头文件包含了一个模板类 circular_buffer
+// circular_buffer : 环形缓冲区，一段连续空间上的双端队列
+//
+// 容量总是 2 的幂，元素的逻辑下标 i 对应物理位置 (head_ + i) & (capacity - 1)，
+// 因此 front / back / pop_front / push_back 只需一次取址，不存在 deque 的 map/buffer 两级间接访问；
+// 空间不足时容量翻倍，并把元素按逻辑顺序搬到新空间的开头；
+// 在满的容器两端插入时先在新空间构造新元素再搬移旧元素，因此参数可以引用容器中的元素
+// 可以作为 queue 与 stack 的底层容器
+
+// 异常保证：
+// mystl::circular_buffer<T> 满足基本异常保证，并对以下等函数做强异常安全保证：
+//   * emplace_front
+//   * emplace_back
+//   * push_front
+//   * push_back
+// 扩容时元素的移动构造可能抛出异常则改为复制 (move_if_noexcept)，失败时原来的空间保持不变
+
+#include <initializer_list>
+#include <utility>
+
+#include "iterator.h"
+#include "memory.h"
+#include "utils.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+template <class T> class circular_buffer;
+
+// circular_buffer 的迭代器设计，保存所属容器与逻辑下标
+template <class T, class Ref, class Ptr>
+struct circular_buffer_iterator : public iterator<random_access_iterator_tag, T>
+{
+  typedef circular_buffer_iterator<T, T&, T*>             iterator;
+  typedef circular_buffer_iterator<T, const T&, const T*> const_iterator;
+  typedef circular_buffer_iterator                        self;
+
+  typedef T                   value_type;
+  typedef Ptr                 pointer;
+  typedef Ref                 reference;
+  typedef size_t              size_type;
+  typedef ptrdiff_t           difference_type;
+  typedef circular_buffer<T>  container_type;
+
+  const container_type* cb;     // 所属的容器
+  size_type             index;  // 逻辑下标
+
+  // 构造、复制函数
+  circular_buffer_iterator() noexcept
+    :cb(nullptr), index(0) {}
+
+  circular_buffer_iterator(const container_type* c, size_type i) noexcept
+    :cb(c), index(i) {}
+
+  circular_buffer_iterator(const iterator& rhs) noexcept
+    :cb(rhs.cb), index(rhs.index) {}
+
+  self& operator=(const iterator& rhs) noexcept
+  {
+    cb = rhs.cb;
+    index = rhs.index;
+    return *this;
+  }
+
+  // 重载运算符
+  reference operator*()  const { return const_cast<reference>((*cb)[index]); }
+  pointer   operator->() const { return &(operator*()); }
+
+  difference_type operator-(const self& x) const
+  {
+    return static_cast<difference_type>(index) - static_cast<difference_type>(x.index);
+  }
+
+  self& operator++()    { ++index; return *this; }
+  self  operator++(int) { self tmp = *this; ++index; return tmp; }
+  self& operator--()    { --index; return *this; }
+  self  operator--(int) { self tmp = *this; --index; return tmp; }
+
+  self& operator+=(difference_type n) { index += n; return *this; }
+  self  operator+(difference_type n) const { self tmp = *this; return tmp += n; }
+  self& operator-=(difference_type n) { index -= n; return *this; }
+  self  operator-(difference_type n) const { self tmp = *this; return tmp -= n; }
+
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  // 重载比较操作符
+  bool operator==(const self& rhs) const { return index == rhs.index; }
+  bool operator< (const self& rhs) const { return index < rhs.index; }
+  bool operator!=(const self& rhs) const { return !(*this == rhs); }
+  bool operator> (const self& rhs) const { return rhs < *this; }
+  bool operator<=(const self& rhs) const { return !(rhs < *this); }
+  bool operator>=(const self& rhs) const { return !(*this < rhs); }
+};
+
+// 模板类 circular_buffer
+// 模板参数代表数据类型
+template <class T>
+class circular_buffer
+{
+public:
+  // circular_buffer 的型别定义
+  typedef mystl::allocator<T>                      allocator_type;
+  typedef mystl::allocator<T>                      data_allocator;
+
+  typedef typename allocator_type::value_type      value_type;
+  typedef typename allocator_type::pointer         pointer;
+  typedef typename allocator_type::const_pointer   const_pointer;
+  typedef typename allocator_type::reference       reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::size_type       size_type;
+  typedef typename allocator_type::difference_type difference_type;
+
+  typedef circular_buffer_iterator<T, T&, T*>             iterator;
+  typedef circular_buffer_iterator<T, const T&, const T*> const_iterator;
+  typedef mystl::reverse_iterator<iterator>               reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>         const_reverse_iterator;
+
+  allocator_type get_allocator() { return allocator_type(); }
+
+  // 第一次分配时的最小容量
+  static constexpr size_type init_capacity = 16;
+
+private:
+  pointer   buf_;   // 指向存储空间
+  size_type cap_;   // 存储空间的大小，为 0 或 2 的幂
+  size_type head_;  // 第一个元素的物理位置
+  size_type size_;  // 元素个数
+
+public:
+  // 构造、复制、移动、析构函数
+  circular_buffer() noexcept
+    :buf_(nullptr), cap_(0), head_(0), size_(0)
+  {
+  }
+
+  explicit circular_buffer(size_type n)
+    :buf_(nullptr), cap_(0), head_(0), size_(0)
+  {
+    fill_init(n, value_type());
+  }
+
+  circular_buffer(size_type n, const value_type& value)
+    :buf_(nullptr), cap_(0), head_(0), size_(0)
+  {
+    fill_init(n, value);
+  }
+
+  template <class IIter, typename std::enable_if<
+    mystl::is_input_iterator<IIter>::value, int>::type = 0>
+  circular_buffer(IIter first, IIter last)
+    :buf_(nullptr), cap_(0), head_(0), size_(0)
+  {
+    copy_init(first, last);
+  }
+
+  circular_buffer(std::initializer_list<value_type> ilist)
+    :buf_(nullptr), cap_(0), head_(0), size_(0)
+  {
+    copy_init(ilist.begin(), ilist.end());
+  }
+
+  circular_buffer(const circular_buffer& rhs)
+    :buf_(nullptr), cap_(0), head_(0), size_(0)
+  {
+    copy_init(rhs.begin(), rhs.end());
+  }
+
+  circular_buffer(circular_buffer&& rhs) noexcept
+    :buf_(rhs.buf_), cap_(rhs.cap_), head_(rhs.head_), size_(rhs.size_)
+  {
+    rhs.buf_ = nullptr;
+    rhs.cap_ = 0;
+    rhs.head_ = 0;
+    rhs.size_ = 0;
+  }
+
+  circular_buffer& operator=(const circular_buffer& rhs)
+  {
+    if (this != &rhs)
+    {
+      circular_buffer tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  circular_buffer& operator=(circular_buffer&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      destroy_and_recover();
+      buf_ = rhs.buf_;
+      cap_ = rhs.cap_;
+      head_ = rhs.head_;
+      size_ = rhs.size_;
+      rhs.buf_ = nullptr;
+      rhs.cap_ = 0;
+      rhs.head_ = 0;
+      rhs.size_ = 0;
+    }
+    return *this;
+  }
+
+  circular_buffer& operator=(std::initializer_list<value_type> ilist)
+  {
+    circular_buffer tmp(ilist);
+    swap(tmp);
+    return *this;
+  }
+
+  ~circular_buffer()
+  {
+    destroy_and_recover();
+  }
+
+public:
+  // 迭代器相关操作
+  iterator               begin()         noexcept
+  { return iterator(this, 0); }
+  const_iterator         begin()   const noexcept
+  { return const_iterator(this, 0); }
+  iterator               end()           noexcept
+  { return iterator(this, size_); }
+  const_iterator         end()     const noexcept
+  { return const_iterator(this, size_); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关操作
+  bool      empty()    const noexcept { return size_ == 0; }
+  size_type size()     const noexcept { return size_; }
+  size_type capacity() const noexcept { return cap_; }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+  void      reserve(size_type n);
+  void      shrink_to_fit();
+
+  // 访问元素相关操作
+  reference       operator[](size_type n)
+  {
+    MYSTL_DEBUG(n < size());
+    return buf_[slot(n)];
+  }
+  const_reference operator[](size_type n) const
+  {
+    MYSTL_DEBUG(n < size());
+    return buf_[slot(n)];
+  }
+  reference       at(size_type n)
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size()), "circular_buffer<T>::at() subscript out of range");
+    return (*this)[n];
+  }
+  const_reference at(size_type n) const
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size()), "circular_buffer<T>::at() subscript out of range");
+    return (*this)[n];
+  }
+
+  reference       front()
+  {
+    MYSTL_DEBUG(!empty());
+    return buf_[head_];
+  }
+  const_reference front() const
+  {
+    MYSTL_DEBUG(!empty());
+    return buf_[head_];
+  }
+  reference       back()
+  {
+    MYSTL_DEBUG(!empty());
+    return buf_[slot(size_ - 1)];
+  }
+  const_reference back() const
+  {
+    MYSTL_DEBUG(!empty());
+    return buf_[slot(size_ - 1)];
+  }
+
+  // 修改容器相关操作
+
+  // emplace_front / emplace_back
+  template <class ...Args>
+  void emplace_front(Args&& ...args);
+  template <class ...Args>
+  void emplace_back(Args&& ...args);
+
+  // push_front / push_back
+  void push_front(const value_type& value) { emplace_front(value); }
+  void push_front(value_type&& value)      { emplace_front(mystl::move(value)); }
+  void push_back(const value_type& value)  { emplace_back(value); }
+  void push_back(value_type&& value)       { emplace_back(mystl::move(value)); }
+
+  // pop_front / pop_back
+  void pop_front()
+  {
+    MYSTL_DEBUG(!empty());
+    data_allocator::destroy(buf_ + head_);
+    head_ = (head_ + 1) & (cap_ - 1);
+    --size_;
+  }
+  void pop_back()
+  {
+    MYSTL_DEBUG(!empty());
+    data_allocator::destroy(buf_ + slot(size_ - 1));
+    --size_;
+  }
+
+  // clear
+  void clear();
+
+  // swap
+  void swap(circular_buffer& rhs) noexcept
+  {
+    mystl::swap(buf_, rhs.buf_);
+    mystl::swap(cap_, rhs.cap_);
+    mystl::swap(head_, rhs.head_);
+    mystl::swap(size_, rhs.size_);
+  }
+
+private:
+  // helper functions
+
+  // 逻辑下标转换为物理位置
+  size_type slot(size_type n) const noexcept { return (head_ + n) & (cap_ - 1); }
+
+  // initialize / destroy
+  void      fill_init(size_type n, const value_type& value);
+  template <class IIter>
+  void      copy_init(IIter first, IIter last);
+  void      destroy_and_recover() noexcept;
+
+  // reallocate
+  size_type round_up(size_type n) const;
+  void      reallocate(size_type new_cap);
+  template <class ...Args>
+  void      reallocate_emplace(bool front, Args&& ...args);
+  void      move_elements(pointer new_buf);
+};
+
+template <class T>
+constexpr typename circular_buffer<T>::size_type circular_buffer<T>::init_capacity;
+
+/*****************************************************************************************/
+
+// 预留空间大小，容量会被向上取整为 2 的幂
+template <class T>
+void circular_buffer<T>::reserve(size_type n)
+{
+  if (cap_ < n)
+  {
+    THROW_LENGTH_ERROR_IF(n > max_size(),
+                          "n can not larger than max_size() in circular_buffer<T>::reserve(n)");
+    reallocate(round_up(n));
+  }
+}
+
+// 把容量缩小到能容纳当前元素的最小的 2 的幂
+template <class T>
+void circular_buffer<T>::shrink_to_fit()
+{
+  if (size_ == 0)
+  {
+    destroy_and_recover();
+    return;
+  }
+  const auto new_cap = round_up(size_);
+  if (new_cap < cap_)
+    reallocate(new_cap);
+}
+
+// 在头部就地构建元素
+template <class T>
+template <class ...Args>
+void circular_buffer<T>::emplace_front(Args&& ...args)
+{
+  if (size_ == cap_)
+  {
+    reallocate_emplace(true, mystl::forward<Args>(args)...);
+    return;
+  }
+  const auto pos = (head_ + cap_ - 1) & (cap_ - 1);
+  data_allocator::construct(buf_ + pos, mystl::forward<Args>(args)...);
+  head_ = pos;
+  ++size_;
+}
+
+// 在尾部就地构建元素
+template <class T>
+template <class ...Args>
+void circular_buffer<T>::emplace_back(Args&& ...args)
+{
+  if (size_ == cap_)
+  {
+    reallocate_emplace(false, mystl::forward<Args>(args)...);
+    return;
+  }
+  data_allocator::construct(buf_ + slot(size_), mystl::forward<Args>(args)...);
+  ++size_;
+}
+
+// 清空容器，保留容量
+template <class T>
+void circular_buffer<T>::clear()
+{
+  for (size_type i = 0; i < size_; ++i)
+    data_allocator::destroy(buf_ + slot(i));
+  head_ = 0;
+  size_ = 0;
+}
+
+/*****************************************************************************************/
+// helper function
+
+// fill_init 函数
+template <class T>
+void circular_buffer<T>::fill_init(size_type n, const value_type& value)
+{
+  if (n == 0)
+    return;
+  const auto cap = round_up(n);
+  buf_ = data_allocator::allocate(cap);
+  cap_ = cap;
+  try
+  {
+    mystl::uninitialized_fill_n(buf_, n, value);
+  }
+  catch (...)
+  {
+    data_allocator::deallocate(buf_, cap_);
+    buf_ = nullptr;
+    cap_ = 0;
+    throw;
+  }
+  size_ = n;
+}
+
+// copy_init 函数
+template <class T>
+template <class IIter>
+void circular_buffer<T>::copy_init(IIter first, IIter last)
+{
+  try
+  {
+    for (; first != last; ++first)
+      emplace_back(*first);
+  }
+  catch (...)
+  {
+    destroy_and_recover();
+    throw;
+  }
+}
+
+// destroy_and_recover 函数
+template <class T>
+void circular_buffer<T>::destroy_and_recover() noexcept
+{
+  if (buf_ != nullptr)
+  {
+    clear();
+    data_allocator::deallocate(buf_, cap_);
+  }
+  buf_ = nullptr;
+  cap_ = 0;
+  head_ = 0;
+  size_ = 0;
+}
+
+// 向上取整为不小于 init_capacity 的 2 的幂
+template <class T>
+typename circular_buffer<T>::size_type
+circular_buffer<T>::round_up(size_type n) const
+{
+  size_type cap = init_capacity;
+  while (cap < n)
+  {
+    THROW_LENGTH_ERROR_IF(cap > max_size() / 2, "circular_buffer<T>'s size too big");
+    cap <<= 1;
+  }
+  return cap;
+}
+
+// 重新分配空间，元素按逻辑顺序放到新空间的开头
+template <class T>
+void circular_buffer<T>::reallocate(size_type new_cap)
+{
+  auto new_buf = data_allocator::allocate(new_cap);
+  try
+  {
+    move_elements(new_buf);
+  }
+  catch (...)
+  {
+    data_allocator::deallocate(new_buf, new_cap);
+    throw;
+  }
+  const auto old_size = size_;
+  destroy_and_recover();
+  buf_ = new_buf;
+  cap_ = new_cap;
+  size_ = old_size;
+}
+
+// 容器已满时重新分配空间并在头部 (front 为 true) 或尾部就地构造元素
+// 先在新空间的最终位置构造新元素，再搬移旧元素：args 引用容器中的元素时，构造时它仍然有效
+template <class T>
+template <class ...Args>
+void circular_buffer<T>::reallocate_emplace(bool front, Args&& ...args)
+{
+  const auto new_cap = round_up(size_ + 1);
+  auto new_buf = data_allocator::allocate(new_cap);
+  // 头部插入时新元素放在新空间的最后一个位置，旧元素仍从开头放起
+  const auto pos = front ? new_cap - 1 : size_;
+  try
+  {
+    data_allocator::construct(new_buf + pos, mystl::forward<Args>(args)...);
+  }
+  catch (...)
+  {
+    data_allocator::deallocate(new_buf, new_cap);
+    throw;
+  }
+  try
+  {
+    move_elements(new_buf);
+  }
+  catch (...)
+  {
+    data_allocator::destroy(new_buf + pos);
+    data_allocator::deallocate(new_buf, new_cap);
+    throw;
+  }
+  const auto old_size = size_;
+  destroy_and_recover();
+  buf_ = new_buf;
+  cap_ = new_cap;
+  head_ = front ? pos : 0;
+  size_ = old_size + 1;
+}
+
+// 把元素按逻辑顺序搬到 new_buf 的开头，移动构造可能抛出异常时改为复制
+// 失败时析构已经构造的元素后重新抛出，原来的元素保持不变
+template <class T>
+void circular_buffer<T>::move_elements(pointer new_buf)
+{
+  size_type n = 0;
+  try
+  {
+    for (; n < size_; ++n)
+      data_allocator::construct(new_buf + n, std::move_if_noexcept(buf_[slot(n)]));
+  }
+  catch (...)
+  {
+    data_allocator::destroy(new_buf, new_buf + n);
+    throw;
+  }
+}
+
+/*****************************************************************************************/
+// 重载比较操作符
+
+template <class T>
+bool operator==(const circular_buffer<T>& lhs, const circular_buffer<T>& rhs)
+{
+  return lhs.size() == rhs.size() &&
+    mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T>
+bool operator<(const circular_buffer<T>& lhs, const circular_buffer<T>& rhs)
+{
+  return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T>
+bool operator!=(const circular_buffer<T>& lhs, const circular_buffer<T>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class T>
+bool operator>(const circular_buffer<T>& lhs, const circular_buffer<T>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class T>
+bool operator<=(const circular_buffer<T>& lhs, const circular_buffer<T>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class T>
+bool operator>=(const circular_buffer<T>& lhs, const circular_buffer<T>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T>
+void swap(circular_buffer<T>& lhs, circular_buffer<T>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_CIRCULAR_BUFFER_H_
@@ -0,0 +1,170 @@
+#ifndef TINYSTL_CONCURRENCY_H_
+#define TINYSTL_CONCURRENCY_H_
+
+// 这个头文件包含并发容器共用的一些工具
+// cache_line_size : 缓存行大小，用于把不同线程频繁写入的数据隔开，避免伪共享
+// cpu_relax       : 自旋等待时提示 CPU 让出流水线资源
+// round_up_pow2   : 向上取整为 2 的幂
+// floor_log2      : 向下取整的以 2 为底的对数
+// shared_spin_lock : 读写自旋锁，临界区很短、读远多于写时使用
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace mystl
+{
+
+#ifndef MYSTL_CACHE_LINE_SIZE
+#define MYSTL_CACHE_LINE_SIZE 64
+#endif
+
+constexpr size_t cache_line_size = MYSTL_CACHE_LINE_SIZE;
+
+inline void cpu_relax() noexcept
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__arm__))
+  __asm__ __volatile__("yield");
+#endif
+}
+
+// 向上取整为 2 的幂，n 为 0 时返回 1
+inline size_t round_up_pow2(size_t n) noexcept
+{
+  size_t r = 1;
+  while (r < n)
+    r <<= 1;
+  return r;
+}
+
+// 向下取整的以 2 为底的对数，n 不能为 0
+inline size_t floor_log2(size_t n) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return sizeof(unsigned long long) * 8 - 1 - static_cast<size_t>(__builtin_clzll(n));
+#else
+  size_t r = 0;
+  while (n >>= 1)
+    ++r;
+  return r;
+#endif
+}
+
+// 读写自旋锁，写者优先
+// 状态字的最高位为写标志，其余位为读者个数：
+//   读者先把读者个数加一，发现写标志时再减回去，等写标志清除后重试
+//   写者先抢到写标志，阻止新的读者进入，再等待已经进入的读者离开
+// 读者进入只需一次原子加法，自旋一段时间后让出时间片
+class shared_spin_lock
+{
+private:
+  static constexpr uint32_t writer_bit = 1u << 31;
+  enum { spin_count = 64 };
+
+  std::atomic<uint32_t> state_;
+
+public:
+  shared_spin_lock() noexcept
+    :state_(0)
+  {
+  }
+
+  shared_spin_lock(const shared_spin_lock&) = delete;
+  shared_spin_lock& operator=(const shared_spin_lock&) = delete;
+
+  void lock() noexcept
+  {
+    for (unsigned spins = 0; ; backoff(spins))
+    {
+      uint32_t s = state_.load(std::memory_order_relaxed);
+      if ((s & writer_bit) == 0 &&
+          state_.compare_exchange_weak(s, s | writer_bit, std::memory_order_acquire,
+                                       std::memory_order_relaxed))
+        break;
+    }
+    for (unsigned spins = 0; state_.load(std::memory_order_acquire) != writer_bit; backoff(spins))
+    {
+    }
+  }
+
+  bool try_lock() noexcept
+  {
+    uint32_t s = 0;
+    return state_.compare_exchange_strong(s, writer_bit, std::memory_order_acquire,
+                                          std::memory_order_relaxed);
+  }
+
+  void unlock() noexcept
+  {
+    state_.fetch_and(~writer_bit, std::memory_order_release);
+  }
+
+  void lock_shared() noexcept
+  {
+    for (unsigned spins = 0; ; )
+    {
+      if ((state_.fetch_add(1, std::memory_order_acquire) & writer_bit) == 0)
+        return;
+      state_.fetch_sub(1, std::memory_order_relaxed);
+      while (state_.load(std::memory_order_relaxed) & writer_bit)
+        backoff(spins);
+    }
+  }
+
+  bool try_lock_shared() noexcept
+  {
+    if ((state_.fetch_add(1, std::memory_order_acquire) & writer_bit) == 0)
+      return true;
+    state_.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  void unlock_shared() noexcept
+  {
+    state_.fetch_sub(1, std::memory_order_release);
+  }
+
+private:
+  static void backoff(unsigned& spins) noexcept
+  {
+    if (++spins < spin_count)
+      cpu_relax();
+    else
+      std::this_thread::yield();
+  }
+};
+
+// 读锁的 RAII 封装，写锁使用 std::lock_guard
+template <class Lock>
+class shared_lock_guard
+{
+private:
+  Lock& lock_;
+
+public:
+  explicit shared_lock_guard(Lock& lock)
+    :lock_(lock)
+  {
+    lock_.lock_shared();
+  }
+
+  shared_lock_guard(const shared_lock_guard&) = delete;
+  shared_lock_guard& operator=(const shared_lock_guard&) = delete;
+
+  ~shared_lock_guard()
+  {
+    lock_.unlock_shared();
+  }
+};
+
+} // namespace mystl
+#endif // !MYTINYSTL_CONCURRENCY_H_
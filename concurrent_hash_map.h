@@ -0,0 +1,348 @@
+#ifndef TINYSTL_CONCURRENT_HASH_MAP_H_
+#define TINYSTL_CONCURRENT_HASH_MAP_H_
+
+// 这个头文件包含了一个模板类 concurrent_hash_map
+// concurrent_hash_map : 分片加锁的并发哈希表，适合读多写少、多线程同时查找的场景
+//
+// 表由 2^k 个分片组成，每个分片是一个 flat_hash_map 加一把 shared_spin_lock，各自占据独立的缓存行
+// 键的哈希值的高位选择分片，不同分片上的操作互不影响，同一分片上的查找可以并行
+// 查找只加读锁，插入、删除、修改加写锁，锁只在一次调用内持有
+//
+// 接口不返回迭代器或引用 : find 把实值复制出来，visit 在持锁期间把元素交给调用者的函数，
+// 函数返回后元素可能随时被其它线程修改或删除
+// 分片内部的 flat_hash_map 扩容时会移动元素，因此读者不能绕过锁做乐观读取
+// (seqlock 只适用于可以安全读到中间状态的平凡类型，且要求存储不会被释放)
+//
+// size / empty 逐个分片加锁统计，有并发修改时只是近似值
+// visit 的函数中不能再访问同一个表，否则可能在同一个分片上死锁
+
+// 异常保证：
+// 元素的构造与用户函数抛出的异常会传播给调用者，锁会被释放，表的状态与 flat_hash_map 的保证相同
+
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include "concurrency.h"
+#include "flat_hash_map.h"
+#include "functional.h"
+#include "utils.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 模板类 concurrent_hash_map
+// 参数一代表键值类型，参数二代表实值类型，参数三代表哈希函数，参数四代表键值的相等比较
+template <class Key, class T, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+class concurrent_hash_map
+{
+public:
+  // concurrent_hash_map 的型别定义
+  typedef Key                                      key_type;
+  typedef T                                        mapped_type;
+  typedef mystl::pair<const Key, T>                value_type;
+  typedef Hash                                     hasher;
+  typedef KeyEqual                                 key_equal;
+  typedef size_t                                   size_type;
+
+private:
+  typedef mystl::flat_hash_map<Key, T, Hash, KeyEqual> map_type;
+
+  struct alignas(cache_line_size) shard
+  {
+    mutable shared_spin_lock lock;
+    map_type                 map;
+
+    shard(const hasher& hash, const key_equal& equal)
+      :lock(), map(0, hash, equal)
+    {
+    }
+  };
+
+  typedef std::lock_guard<shared_spin_lock>        write_guard;
+  typedef shared_lock_guard<shared_spin_lock>      read_guard;
+
+private:
+  void*     raw_;     // 分配到的原始内存，shards_ 在其中按缓存行对齐
+  shard*    shards_;
+  size_type count_;   // 分片个数，为 2 的幂
+  size_type shift_;   // 哈希值右移 shift_ 位得到分片号
+  hasher    hash_;
+
+public:
+  // 构造、析构函数，分片个数向上取整为 2 的幂且至少为 2
+  concurrent_hash_map()
+    :concurrent_hash_map(default_shard_count())
+  {
+  }
+
+  explicit concurrent_hash_map(size_type shard_count,
+                               const hasher& hash = hasher(),
+                               const key_equal& equal = key_equal())
+    :raw_(nullptr), shards_(nullptr), count_(0), shift_(0), hash_(hash)
+  {
+    THROW_LENGTH_ERROR_IF(shard_count > (static_cast<size_type>(1) << 16),
+                          "concurrent_hash_map<Key, T>'s shard count too big");
+    const size_type n = mystl::round_up_pow2(shard_count < 2 ? 2 : shard_count);
+    raw_ = ::operator new(sizeof(shard) * n + cache_line_size);
+    shards_ = reinterpret_cast<shard*>(
+      (reinterpret_cast<uintptr_t>(raw_) + cache_line_size - 1) & ~(cache_line_size - 1));
+    try
+    {
+      for (; count_ < n; ++count_)
+        ::new (static_cast<void*>(shards_ + count_)) shard(hash, equal);
+    }
+    catch (...)
+    {
+      destroy_and_recover();
+      throw;
+    }
+    shift_ = sizeof(size_type) * 8 - mystl::floor_log2(n);
+  }
+
+  concurrent_hash_map(const concurrent_hash_map&) = delete;
+  concurrent_hash_map& operator=(const concurrent_hash_map&) = delete;
+
+  ~concurrent_hash_map()
+  {
+    destroy_and_recover();
+  }
+
+public:
+  // 容量相关操作
+  size_type shard_count() const noexcept { return count_; }
+
+  size_type size() const
+  {
+    size_type n = 0;
+    for (size_type i = 0; i < count_; ++i)
+    {
+      read_guard g(shards_[i].lock);
+      n += shards_[i].map.size();
+    }
+    return n;
+  }
+  bool      empty() const
+  {
+    for (size_type i = 0; i < count_; ++i)
+    {
+      read_guard g(shards_[i].lock);
+      if (!shards_[i].map.empty())
+        return false;
+    }
+    return true;
+  }
+
+  // 按元素均匀分布为每个分片预留空间
+  void      reserve(size_type count)
+  {
+    const size_type per_shard = count / count_ + (count % count_ != 0 ? 1 : 0);
+    for (size_type i = 0; i < count_; ++i)
+    {
+      write_guard g(shards_[i].lock);
+      shards_[i].map.reserve(per_shard);
+    }
+  }
+
+  hasher    hash_function() const { return hash_; }
+  key_equal key_eq()        const { return shards_[0].map.key_eq(); }
+
+  // 查找相关操作
+
+  // 找到时把实值复制到 result
+  bool      find(const key_type& key, mapped_type& result) const
+  {
+    const shard& s = shard_of(key);
+    read_guard g(s.lock);
+    auto it = s.map.find(key);
+    if (it == s.map.end())
+      return false;
+    result = it->second;
+    return true;
+  }
+
+  bool      contains(const key_type& key) const
+  {
+    const shard& s = shard_of(key);
+    read_guard g(s.lock);
+    return s.map.contains(key);
+  }
+  size_type count(const key_type& key) const
+  { return contains(key) ? 1 : 0; }
+
+  // visit，找到时在读锁内调用 fn(const value_type&)
+  template <class F>
+  bool      visit(const key_type& key, F&& fn) const
+  {
+    const shard& s = shard_of(key);
+    read_guard g(s.lock);
+    auto it = s.map.find(key);
+    if (it == s.map.end())
+      return false;
+    fn(*it);
+    return true;
+  }
+
+  // visit，找到时在写锁内调用 fn(value_type&)，可以修改实值
+  template <class F>
+  bool      visit(const key_type& key, F&& fn)
+  {
+    shard& s = shard_of(key);
+    write_guard g(s.lock);
+    auto it = s.map.find(key);
+    if (it == s.map.end())
+      return false;
+    fn(*it);
+    return true;
+  }
+
+  // visit_all，逐个分片加锁，对每个元素调用 fn
+  template <class F>
+  void      visit_all(F&& fn) const
+  {
+    for (size_type i = 0; i < count_; ++i)
+    {
+      read_guard g(shards_[i].lock);
+      for (const auto& value : shards_[i].map)
+        fn(value);
+    }
+  }
+  template <class F>
+  void      visit_all(F&& fn)
+  {
+    for (size_type i = 0; i < count_; ++i)
+    {
+      write_guard g(shards_[i].lock);
+      for (auto& value : shards_[i].map)
+        fn(value);
+    }
+  }
+
+  // 修改容器相关操作，返回值表示是否插入了新元素
+
+  bool      insert(const value_type& value)
+  {
+    shard& s = shard_of(value.first);
+    write_guard g(s.lock);
+    return s.map.insert(value).second;
+  }
+  bool      insert(value_type&& value)
+  {
+    shard& s = shard_of(value.first);
+    write_guard g(s.lock);
+    return s.map.insert(mystl::move(value)).second;
+  }
+
+  // try_emplace，键不存在时才用 args 构造实值
+  template <class ...Args>
+  bool      try_emplace(const key_type& key, Args&& ...args)
+  {
+    shard& s = shard_of(key);
+    write_guard g(s.lock);
+    return s.map.try_emplace(key, mystl::forward<Args>(args)...).second;
+  }
+  template <class ...Args>
+  bool      try_emplace(key_type&& key, Args&& ...args)
+  {
+    shard& s = shard_of(key);
+    write_guard g(s.lock);
+    return s.map.try_emplace(mystl::move(key), mystl::forward<Args>(args)...).second;
+  }
+
+  // insert_or_assign，键已存在时覆盖实值
+  template <class M>
+  bool      insert_or_assign(const key_type& key, M&& obj)
+  {
+    shard& s = shard_of(key);
+    write_guard g(s.lock);
+    return s.map.insert_or_assign(key, mystl::forward<M>(obj)).second;
+  }
+  template <class M>
+  bool      insert_or_assign(key_type&& key, M&& obj)
+  {
+    shard& s = shard_of(key);
+    write_guard g(s.lock);
+    auto r = s.map.try_emplace(mystl::move(key), mystl::forward<M>(obj));
+    if (!r.second)
+      r.first->second = mystl::forward<M>(obj);
+    return r.second;
+  }
+
+  // try_emplace_or_visit，键不存在时用 args 构造实值，否则在写锁内调用 fn(value_type&)
+  template <class F, class ...Args>
+  bool      try_emplace_or_visit(const key_type& key, F&& fn, Args&& ...args)
+  {
+    shard& s = shard_of(key);
+    write_guard g(s.lock);
+    auto r = s.map.try_emplace(key, mystl::forward<Args>(args)...);
+    if (!r.second)
+      fn(*r.first);
+    return r.second;
+  }
+
+  // erase / erase_if / clear
+  size_type erase(const key_type& key)
+  {
+    shard& s = shard_of(key);
+    write_guard g(s.lock);
+    return s.map.erase(key);
+  }
+
+  // 键存在且 pred(const value_type&) 为 true 时删除
+  template <class Pred>
+  size_type erase_if(const key_type& key, Pred&& pred)
+  {
+    shard& s = shard_of(key);
+    write_guard g(s.lock);
+    auto it = s.map.find(key);
+    if (it == s.map.end() || !pred(static_cast<const value_type&>(*it)))
+      return 0;
+    s.map.erase(it);
+    return 1;
+  }
+
+  void      clear()
+  {
+    for (size_type i = 0; i < count_; ++i)
+    {
+      write_guard g(shards_[i].lock);
+      shards_[i].map.clear();
+    }
+  }
+
+private:
+  // helper functions
+
+  static size_type default_shard_count() noexcept
+  {
+    const size_type threads = std::thread::hardware_concurrency();
+    return threads * 4 < 16 ? 16 : threads * 4;
+  }
+
+  size_type shard_index(const key_type& key) const
+  { return shard_index(key, mystl::hash_is_avalanching<hasher>()); }
+  size_type shard_index(const key_type& key, m_true_type) const
+  { return static_cast<size_type>(hash_(key)) >> shift_; }
+  size_type shard_index(const key_type& key, m_false_type) const
+  { return mystl::hash_mix(static_cast<uint64_t>(hash_(key))) >> shift_; }
+
+  shard&       shard_of(const key_type& key)
+  { return shards_[shard_index(key)]; }
+  const shard& shard_of(const key_type& key) const
+  { return shards_[shard_index(key)]; }
+
+  void destroy_and_recover() noexcept
+  {
+    for (size_type i = 0; i < count_; ++i)
+      shards_[i].~shard();
+    ::operator delete(raw_);
+    raw_ = nullptr;
+    shards_ = nullptr;
+    count_ = 0;
+  }
+};
+
+} // namespace mystl
+#endif // !MYTINYSTL_CONCURRENT_HASH_MAP_H_
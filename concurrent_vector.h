@@ -0,0 +1,695 @@
+#ifndef TINYSTL_CONCURRENT_VECTOR_H_
+#define TINYSTL_CONCURRENT_VECTOR_H_
+
+// 这个头文件包含了一个模板类 concurrent_vector
+// concurrent_vector : 可以被多个线程同时在尾部追加元素的分段数组，元素的地址永不改变
+//
+// 元素分布在大小按 2 的幂增长的段上，第 k 段容纳 first_segment_size << k 个元素，
+// 下标 i 所在的段为 floor_log2(i + first_segment_size) - log2(first_segment_size)，
+// 段表是固定长度的数组，因此扩容只需分配新的段，已有的元素从不搬动，引用与指针始终有效
+//
+// push_back / emplace_back / grow_by 用一次 fetch_add 占用下标，再在占用的位置上构造元素，
+// 缺少的段由需要它的线程分配并用 CAS 装入段表，竞争失败的一方释放自己分配的段，全程无锁
+// operator[] 只读取一次段指针，是无等待的
+//
+// 并发使用的约定：
+//   * push_back / emplace_back / grow_by / grow_to_at_least / reserve 与 operator[] / at 可以并发调用
+//   * size() 包含已经占用但可能还在构造中的元素，读取其他线程追加的元素前需要另外同步，
+//     例如通过 push_back 返回的引用或任务的完成
+//   * 其余修改容器的操作(clear / shrink_to_fit / swap / 赋值)以及迭代不能与任何操作并发
+
+// 元素不是平凡析构的类型时，每段的元素之后跟着同样个数的标记字节，元素构造完成后标记置 1，
+// clear 与析构只析构标记为 1 的元素，因此追加失败留下的空位不会被析构
+//
+// 异常保证：
+// 构造函数抛出异常时不会泄漏资源
+// 追加操作中元素的构造或段的分配抛出异常时，已经占用的下标无法归还，这些位置上没有元素，
+// 访问它们的行为未定义，但 clear / 析构只析构构造完成的元素，容器在 clear 后可以继续使用
+
+#include <atomic>
+#include <initializer_list>
+#include <type_traits>
+
+#include "concurrency.h"
+#include "iterator.h"
+#include "memory.h"
+#include "utils.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+template <class T> class concurrent_vector;
+
+// concurrent_vector 的迭代器设计，保存所属容器与下标
+template <class T, class Ref, class Ptr>
+struct concurrent_vector_iterator : public iterator<random_access_iterator_tag, T>
+{
+  typedef concurrent_vector_iterator<T, T&, T*>             iterator;
+  typedef concurrent_vector_iterator<T, const T&, const T*> const_iterator;
+  typedef concurrent_vector_iterator                        self;
+
+  typedef T                     value_type;
+  typedef Ptr                   pointer;
+  typedef Ref                   reference;
+  typedef size_t                size_type;
+  typedef ptrdiff_t             difference_type;
+  typedef concurrent_vector<T>  container_type;
+
+  const container_type* cv;     // 所属的容器
+  size_type             index;  // 下标
+
+  // 构造、复制函数
+  concurrent_vector_iterator() noexcept
+    :cv(nullptr), index(0) {}
+
+  concurrent_vector_iterator(const container_type* c, size_type i) noexcept
+    :cv(c), index(i) {}
+
+  concurrent_vector_iterator(const iterator& rhs) noexcept
+    :cv(rhs.cv), index(rhs.index) {}
+
+  self& operator=(const iterator& rhs) noexcept
+  {
+    cv = rhs.cv;
+    index = rhs.index;
+    return *this;
+  }
+
+  // 重载运算符
+  reference operator*()  const { return const_cast<reference>((*cv)[index]); }
+  pointer   operator->() const { return &(operator*()); }
+
+  difference_type operator-(const self& x) const
+  {
+    return static_cast<difference_type>(index) - static_cast<difference_type>(x.index);
+  }
+
+  self& operator++()    { ++index; return *this; }
+  self  operator++(int) { self tmp = *this; ++index; return tmp; }
+  self& operator--()    { --index; return *this; }
+  self  operator--(int) { self tmp = *this; --index; return tmp; }
+
+  self& operator+=(difference_type n) { index += n; return *this; }
+  self  operator+(difference_type n) const { self tmp = *this; return tmp += n; }
+  self& operator-=(difference_type n) { index -= n; return *this; }
+  self  operator-(difference_type n) const { self tmp = *this; return tmp -= n; }
+
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  // 重载比较操作符
+  bool operator==(const self& rhs) const { return index == rhs.index; }
+  bool operator< (const self& rhs) const { return index < rhs.index; }
+  bool operator!=(const self& rhs) const { return !(*this == rhs); }
+  bool operator> (const self& rhs) const { return rhs < *this; }
+  bool operator<=(const self& rhs) const { return !(rhs < *this); }
+  bool operator>=(const self& rhs) const { return !(*this < rhs); }
+};
+
+// 模板类 concurrent_vector
+// 模板参数代表数据类型
+template <class T>
+class concurrent_vector
+{
+public:
+  // concurrent_vector 的型别定义
+  typedef mystl::allocator<T>                      allocator_type;
+  typedef mystl::allocator<T>                      data_allocator;
+
+  typedef typename allocator_type::value_type      value_type;
+  typedef typename allocator_type::pointer         pointer;
+  typedef typename allocator_type::const_pointer   const_pointer;
+  typedef typename allocator_type::reference       reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::size_type       size_type;
+  typedef typename allocator_type::difference_type difference_type;
+
+  typedef concurrent_vector_iterator<T, T&, T*>             iterator;
+  typedef concurrent_vector_iterator<T, const T&, const T*> const_iterator;
+  typedef mystl::reverse_iterator<iterator>                 reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>           const_reverse_iterator;
+
+  allocator_type get_allocator() { return allocator_type(); }
+
+  // 第 0 段的大小，必须是 2 的幂
+  static constexpr size_type first_segment_log  = 3;
+  static constexpr size_type first_segment_size = static_cast<size_type>(1) << first_segment_log;
+  // 段表的长度，足以容纳 size_type 能表示的所有下标
+  static constexpr size_type max_segments = sizeof(size_type) * 8 - first_segment_log;
+  // 是否需要记录哪些元素构造完成，平凡析构的元素不需要析构，也就不需要标记
+  static constexpr bool track_constructed = !std::is_trivially_destructible<T>::value;
+
+private:
+  std::atomic<size_type> size_;                    // 已经占用的下标个数
+  std::atomic<pointer>   segments_[max_segments];  // 段表，未分配的段为空指针
+
+public:
+  // 构造、复制、移动、析构函数
+  concurrent_vector() noexcept
+  {
+    init_empty();
+  }
+
+  explicit concurrent_vector(size_type n)
+  {
+    init_empty();
+    init_guard([&] { grow_by(n); });
+  }
+
+  concurrent_vector(size_type n, const value_type& value)
+  {
+    init_empty();
+    init_guard([&] { grow_by(n, value); });
+  }
+
+  template <class Iter, typename std::enable_if<
+    mystl::is_forward_iterator<Iter>::value, int>::type = 0>
+  concurrent_vector(Iter first, Iter last)
+  {
+    init_empty();
+    init_guard([&] { grow_by(first, last); });
+  }
+
+  concurrent_vector(std::initializer_list<value_type> ilist)
+  {
+    init_empty();
+    init_guard([&] { grow_by(ilist.begin(), ilist.end()); });
+  }
+
+  concurrent_vector(const concurrent_vector& rhs)
+  {
+    init_empty();
+    init_guard([&] { grow_by(rhs.begin(), rhs.end()); });
+  }
+
+  concurrent_vector(concurrent_vector&& rhs) noexcept
+  {
+    init_empty();
+    swap(rhs);
+  }
+
+  concurrent_vector& operator=(const concurrent_vector& rhs)
+  {
+    if (this != &rhs)
+    {
+      concurrent_vector tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  concurrent_vector& operator=(concurrent_vector&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      destroy_and_recover();
+      swap(rhs);
+    }
+    return *this;
+  }
+
+  concurrent_vector& operator=(std::initializer_list<value_type> ilist)
+  {
+    concurrent_vector tmp(ilist);
+    swap(tmp);
+    return *this;
+  }
+
+  ~concurrent_vector()
+  {
+    destroy_and_recover();
+  }
+
+public:
+  // 迭代器相关操作，end 取调用时的 size()
+  iterator               begin()         noexcept
+  { return iterator(this, 0); }
+  const_iterator         begin()   const noexcept
+  { return const_iterator(this, 0); }
+  iterator               end()           noexcept
+  { return iterator(this, size()); }
+  const_iterator         end()     const noexcept
+  { return const_iterator(this, size()); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关操作
+  bool      empty()    const noexcept { return size() == 0; }
+  size_type size()     const noexcept { return size_.load(std::memory_order_acquire); }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+  size_type capacity() const noexcept;
+  void      reserve(size_type n);
+  void      shrink_to_fit();
+
+  // 访问元素相关操作
+  reference       operator[](size_type n)
+  {
+    MYSTL_DEBUG(n < size());
+    return *element(n);
+  }
+  const_reference operator[](size_type n) const
+  {
+    MYSTL_DEBUG(n < size());
+    return *element(n);
+  }
+  reference       at(size_type n)
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size()), "concurrent_vector<T>::at() subscript out of range");
+    return (*this)[n];
+  }
+  const_reference at(size_type n) const
+  {
+    THROW_OUT_OF_RANGE_IF(!(n < size()), "concurrent_vector<T>::at() subscript out of range");
+    return (*this)[n];
+  }
+
+  reference       front()
+  {
+    MYSTL_DEBUG(!empty());
+    return (*this)[0];
+  }
+  const_reference front() const
+  {
+    MYSTL_DEBUG(!empty());
+    return (*this)[0];
+  }
+  reference       back()
+  {
+    MYSTL_DEBUG(!empty());
+    return (*this)[size() - 1];
+  }
+  const_reference back() const
+  {
+    MYSTL_DEBUG(!empty());
+    return (*this)[size() - 1];
+  }
+
+  // 修改容器相关操作
+
+  // emplace_back / push_back，返回新元素的引用
+  template <class ...Args>
+  reference emplace_back(Args&& ...args);
+
+  reference push_back(const value_type& value) { return emplace_back(value); }
+  reference push_back(value_type&& value)      { return emplace_back(mystl::move(value)); }
+
+  // grow_by，在尾部追加一段连续下标的元素，返回指向第一个新元素的迭代器
+  iterator  grow_by(size_type n);
+  iterator  grow_by(size_type n, const value_type& value);
+  template <class Iter, typename std::enable_if<
+    mystl::is_forward_iterator<Iter>::value, int>::type = 0>
+  iterator  grow_by(Iter first, Iter last);
+
+  // grow_to_at_least，保证 size() 不小于 n，返回指向第一个新元素的迭代器，没有追加时指向第 n 个元素
+  iterator  grow_to_at_least(size_type n);
+
+  // clear
+  void clear();
+
+  // swap
+  void swap(concurrent_vector& rhs) noexcept;
+
+private:
+  // helper functions
+
+  // 段的大小与起始下标
+  static size_type segment_size(size_type k) noexcept
+  { return first_segment_size << k; }
+  static size_type segment_base(size_type k) noexcept
+  { return (first_segment_size << k) - first_segment_size; }
+  // 下标所在的段
+  static size_type segment_of(size_type n) noexcept
+  { return mystl::floor_log2(n + first_segment_size) - first_segment_log; }
+  // 第 k 段分配的大小(以 T 为单位)，包括其后的标记字节
+  static size_type segment_alloc_size(size_type k) noexcept
+  {
+    return segment_size(k) +
+      (track_constructed ? (segment_size(k) + sizeof(T) - 1) / sizeof(T) : 0);
+  }
+  // 第 k 段的标记字节
+  static unsigned char* constructed_flags(pointer seg, size_type k) noexcept
+  { return reinterpret_cast<unsigned char*>(seg + segment_size(k)); }
+
+  pointer   element(size_type n) const noexcept
+  {
+    const size_type k = segment_of(n);
+    return segments_[k].load(std::memory_order_acquire) + (n - segment_base(k));
+  }
+
+  // 返回第 k 段，没有时分配
+  pointer   segment(size_type k);
+
+  // 占用 n 个下标，返回第一个下标
+  size_type claim(size_type n);
+
+  // 对 [first, last) 中的每个下标 i 调用 ctor(p, i) 在 p 上构造元素
+  template <class Ctor>
+  void      construct_range(size_type first, size_type last, Ctor ctor);
+  void      destroy_range(size_type first, size_type last) noexcept;
+
+  // initialize / destroy
+  void      init_empty() noexcept;
+  template <class F>
+  void      init_guard(F f);
+  void      destroy_and_recover() noexcept;
+};
+
+template <class T>
+constexpr typename concurrent_vector<T>::size_type concurrent_vector<T>::first_segment_log;
+template <class T>
+constexpr typename concurrent_vector<T>::size_type concurrent_vector<T>::first_segment_size;
+template <class T>
+constexpr typename concurrent_vector<T>::size_type concurrent_vector<T>::max_segments;
+template <class T>
+constexpr bool concurrent_vector<T>::track_constructed;
+
+/*****************************************************************************************/
+
+// 已分配的连续前缀段的总容量
+template <class T>
+typename concurrent_vector<T>::size_type
+concurrent_vector<T>::capacity() const noexcept
+{
+  size_type k = 0;
+  while (k < max_segments && segments_[k].load(std::memory_order_acquire) != nullptr)
+    ++k;
+  return segment_base(k);
+}
+
+// 预先分配能容纳 n 个元素的段，可以与追加操作并发
+template <class T>
+void concurrent_vector<T>::reserve(size_type n)
+{
+  if (n == 0)
+    return;
+  THROW_LENGTH_ERROR_IF(n > max_size(),
+                        "n can not larger than max_size() in concurrent_vector<T>::reserve(n)");
+  const size_type last = segment_of(n - 1);
+  for (size_type k = 0; k <= last; ++k)
+    segment(k);
+}
+
+// 释放没有元素的段
+template <class T>
+void concurrent_vector<T>::shrink_to_fit()
+{
+  const size_type n = size();
+  const size_type first = n == 0 ? 0 : segment_of(n - 1) + 1;
+  for (size_type k = first; k < max_segments; ++k)
+  {
+    pointer seg = segments_[k].load(std::memory_order_relaxed);
+    if (seg != nullptr)
+    {
+      data_allocator::deallocate(seg, segment_alloc_size(k));
+      segments_[k].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+}
+
+// 在尾部就地构建元素
+template <class T>
+template <class ...Args>
+typename concurrent_vector<T>::reference
+concurrent_vector<T>::emplace_back(Args&& ...args)
+{
+  const size_type n = claim(1);
+  const size_type k = segment_of(n);
+  pointer seg = segment(k);
+  pointer p = seg + (n - segment_base(k));
+  data_allocator::construct(p, mystl::forward<Args>(args)...);
+  if (track_constructed)
+    constructed_flags(seg, k)[n - segment_base(k)] = 1;
+  return *p;
+}
+
+template <class T>
+typename concurrent_vector<T>::iterator
+concurrent_vector<T>::grow_by(size_type n)
+{
+  const size_type first = claim(n);
+  construct_range(first, first + n, [](pointer p, size_type) { data_allocator::construct(p); });
+  return iterator(this, first);
+}
+
+template <class T>
+typename concurrent_vector<T>::iterator
+concurrent_vector<T>::grow_by(size_type n, const value_type& value)
+{
+  const size_type first = claim(n);
+  construct_range(first, first + n,
+                  [&value](pointer p, size_type) { data_allocator::construct(p, value); });
+  return iterator(this, first);
+}
+
+template <class T>
+template <class Iter, typename std::enable_if<
+  mystl::is_forward_iterator<Iter>::value, int>::type>
+typename concurrent_vector<T>::iterator
+concurrent_vector<T>::grow_by(Iter first, Iter last)
+{
+  const size_type n = static_cast<size_type>(mystl::distance(first, last));
+  const size_type pos = claim(n);
+  construct_range(pos, pos + n, [&first](pointer p, size_type)
+  {
+    data_allocator::construct(p, *first);
+    ++first;
+  });
+  return iterator(this, pos);
+}
+
+template <class T>
+typename concurrent_vector<T>::iterator
+concurrent_vector<T>::grow_to_at_least(size_type n)
+{
+  THROW_LENGTH_ERROR_IF(n > max_size(), "concurrent_vector<T>'s size too big");
+  size_type cur = size_.load(std::memory_order_relaxed);
+  while (cur < n && !size_.compare_exchange_weak(cur, n, std::memory_order_relaxed))
+    ;
+  if (cur >= n)
+    return iterator(this, n);
+  construct_range(cur, n, [](pointer p, size_type) { data_allocator::construct(p); });
+  return iterator(this, cur);
+}
+
+// 析构所有构造完成的元素，保留已分配的段
+template <class T>
+void concurrent_vector<T>::clear()
+{
+  destroy_range(0, size_.load(std::memory_order_relaxed));
+  size_.store(0, std::memory_order_relaxed);
+}
+
+template <class T>
+void concurrent_vector<T>::swap(concurrent_vector& rhs) noexcept
+{
+  if (this == &rhs)
+    return;
+  size_type n = size_.load(std::memory_order_relaxed);
+  size_.store(rhs.size_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  rhs.size_.store(n, std::memory_order_relaxed);
+  for (size_type k = 0; k < max_segments; ++k)
+  {
+    pointer seg = segments_[k].load(std::memory_order_relaxed);
+    segments_[k].store(rhs.segments_[k].load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+    rhs.segments_[k].store(seg, std::memory_order_relaxed);
+  }
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 返回第 k 段，没有时分配一段并尝试装入段表，竞争失败时释放自己分配的段
+template <class T>
+typename concurrent_vector<T>::pointer
+concurrent_vector<T>::segment(size_type k)
+{
+  pointer seg = segments_[k].load(std::memory_order_acquire);
+  if (seg != nullptr)
+    return seg;
+  pointer fresh = data_allocator::allocate(segment_alloc_size(k));
+  if (track_constructed)
+  {
+    unsigned char* flags = constructed_flags(fresh, k);
+    for (size_type i = 0; i < segment_size(k); ++i)
+      flags[i] = 0;
+  }
+  if (segments_[k].compare_exchange_strong(seg, fresh, std::memory_order_acq_rel,
+                                           std::memory_order_acquire))
+    return fresh;
+  data_allocator::deallocate(fresh, segment_alloc_size(k));
+  return seg;
+}
+
+template <class T>
+typename concurrent_vector<T>::size_type
+concurrent_vector<T>::claim(size_type n)
+{
+  THROW_LENGTH_ERROR_IF(n > max_size() - size_.load(std::memory_order_relaxed),
+                        "concurrent_vector<T>'s size too big");
+  return size_.fetch_add(n, std::memory_order_relaxed);
+}
+
+// 按段依次构造，每段只取一次段指针，抛出异常时析构本次已经构造的元素
+template <class T>
+template <class Ctor>
+void concurrent_vector<T>::construct_range(size_type first, size_type last, Ctor ctor)
+{
+  const size_type start = first;
+  try
+  {
+    while (first < last)
+    {
+      const size_type k = segment_of(first);
+      const size_type stop = last < segment_base(k + 1) ? last : segment_base(k + 1);
+      pointer seg = segment(k);
+      pointer p = seg + (first - segment_base(k));
+      for (; first < stop; ++first, ++p)
+      {
+        ctor(p, first);
+        if (track_constructed)
+          constructed_flags(seg, k)[first - segment_base(k)] = 1;
+      }
+    }
+  }
+  catch (...)
+  {
+    destroy_range(start, first);
+    throw;
+  }
+}
+
+// 析构 [first, last) 上构造完成的元素并清除标记，跳过分配失败而不存在的段
+template <class T>
+void concurrent_vector<T>::destroy_range(size_type first, size_type last) noexcept
+{
+  if (!track_constructed)
+    return;
+  while (first < last)
+  {
+    const size_type k = segment_of(first);
+    const size_type stop = last < segment_base(k + 1) ? last : segment_base(k + 1);
+    pointer seg = segments_[k].load(std::memory_order_relaxed);
+    if (seg != nullptr)
+    {
+      pointer p = seg + (first - segment_base(k));
+      unsigned char* flag = constructed_flags(seg, k) + (first - segment_base(k));
+      for (size_type i = first; i < stop; ++i, ++p, ++flag)
+      {
+        if (*flag)
+        {
+          data_allocator::destroy(p);
+          *flag = 0;
+        }
+      }
+    }
+    first = stop;
+  }
+}
+
+template <class T>
+void concurrent_vector<T>::init_empty() noexcept
+{
+  size_.store(0, std::memory_order_relaxed);
+  for (size_type k = 0; k < max_segments; ++k)
+    segments_[k].store(nullptr, std::memory_order_relaxed);
+}
+
+// 构造函数中的追加操作抛出异常时，construct_range 已经析构了构造好的元素，这里归还所有的段
+template <class T>
+template <class F>
+void concurrent_vector<T>::init_guard(F f)
+{
+  try
+  {
+    f();
+  }
+  catch (...)
+  {
+    size_.store(0, std::memory_order_relaxed);
+    destroy_and_recover();
+    throw;
+  }
+}
+
+// destroy_and_recover 函数
+template <class T>
+void concurrent_vector<T>::destroy_and_recover() noexcept
+{
+  clear();
+  for (size_type k = 0; k < max_segments; ++k)
+  {
+    pointer seg = segments_[k].load(std::memory_order_relaxed);
+    if (seg != nullptr)
+    {
+      data_allocator::deallocate(seg, segment_alloc_size(k));
+      segments_[k].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+}
+
+/*****************************************************************************************/
+// 重载比较操作符
+
+template <class T>
+bool operator==(const concurrent_vector<T>& lhs, const concurrent_vector<T>& rhs)
+{
+  return lhs.size() == rhs.size() &&
+    mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T>
+bool operator<(const concurrent_vector<T>& lhs, const concurrent_vector<T>& rhs)
+{
+  return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T>
+bool operator!=(const concurrent_vector<T>& lhs, const concurrent_vector<T>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class T>
+bool operator>(const concurrent_vector<T>& lhs, const concurrent_vector<T>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class T>
+bool operator<=(const concurrent_vector<T>& lhs, const concurrent_vector<T>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class T>
+bool operator>=(const concurrent_vector<T>& lhs, const concurrent_vector<T>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T>
+void swap(concurrent_vector<T>& lhs, concurrent_vector<T>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_CONCURRENT_VECTOR_H_
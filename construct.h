@@ -49,6 +49,14 @@ void destroy_one(T* pointer, std::false_type)
     pointer->~T();
   }
 }
+//单个对象的销毁
+template <class T>
+void destroy(T* pointer)
+{
+    //传入的第二个参数,检查pointer是否为平凡析构
+  destroy_one(pointer, std::is_trivially_destructible<T>{});
+}
+
 //两个迭代器范围内的销毁
 template <class ForwardIter>
 void destroy_cat(ForwardIter , ForwardIter , std::true_type) {}
@@ -60,14 +68,6 @@ void destroy_cat(ForwardIter first, ForwardIter last, std::false_type)
     destroy(&*first);
 }
 
-//单个对象的销毁
-template <class T>
-void destroy(T* pointer)
-{
-    //传入的第二个参数,检查pointer是否为平凡析构
-  destroy_one(pointer, std::is_trivially_destructible<T>{});
-}
-
 template <class ForwardIter>
 void destroy(ForwardIter first, ForwardIter last)
 {
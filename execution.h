@@ -0,0 +1,25 @@
+#ifndef TINYSTL_EXECUTION_H_
+#define TINYSTL_EXECUTION_H_
+
+// 这个头文件包含并行算法使用的执行策略
+// parallel_policy : 在线程池上并行执行，缺省使用 default_thread_pool()
+// par             : parallel_policy 的常量，用法为 mystl::sort(mystl::par, first, last)
+//                   也可以用 mystl::par.on(pool) 指定线程池
+
+#include "thread_pool.h"
+
+namespace mystl
+{
+
+struct parallel_policy
+{
+  thread_pool* pool;
+
+  thread_pool&    get_pool() const { return pool != nullptr ? *pool : default_thread_pool(); }
+  parallel_policy on(thread_pool& p) const { return parallel_policy{ &p }; }
+};
+
+constexpr parallel_policy par{ nullptr };
+
+} // namespace mystl
+#endif // !MYTINYSTL_EXECUTION_H_
@@ -0,0 +1,1005 @@
+#ifndef TINYSTL_FLAT_HASH_MAP_H_
+#define TINYSTL_FLAT_HASH_MAP_H_
+
+// 这个头文件包含了一个模板类 flat_hash_map
+// flat_hash_map : 开放定址的哈希表 (Swiss table)，键值对直接存放在一段连续的槽上
+//
+// 每个槽对应一个字节的控制字节：
+//   empty    (0b10000000) : 空槽
+//   deleted  (0b11111110) : 墓碑，元素已删除但探测链不能在此中断
+//   sentinel (0b11111111) : 位于控制字节数组末尾，迭代到此结束
+//   full     (0b0xxxxxxx) : 有元素，低 7 位保存哈希值的低 7 位 (H2)
+// 哈希值的其余高位 (H1) 决定探测的起点，每次取连续 group_width 个控制字节作为一组，
+// 用一次 SIMD 比较找出组内 H2 相同的槽，只对这些槽比较键；组内有空槽即可确定键不存在
+// 探测按组做三角数步长，容量为 2^k - 1，因此可以遍历所有的组
+//
+// 控制字节数组长度为 capacity + 1 + (group_width - 1)，哨兵之后复制了开头的 group_width - 1 个字节，
+// 从任意位置读一组都不需要回绕
+//
+// 删除时，如果槽所在的位置前后都有空槽，且两者的距离小于一组，则没有探测链跨过它，直接置为空槽，
+// 否则置为墓碑；插入时没有剩余空间则整理或扩容，墓碑较多时只在原容量下重新散列
+// 最大装载因子为 7/8，容量小于一组时可以装满
+//
+// 有 SSE2 时一组为 16 个字节，否则用 64 位整数上的位运算一次处理 8 个字节
+// 哈希函数对象没有声明 is_avalanching 时，表内部会对哈希值再做一次混合，
+// 弱哈希函数(例如整数的恒等映射)也能得到均匀的 H1 与 H2
+
+// 异常保证：
+// mystl::flat_hash_map<Key, T> 满足基本异常保证，对 insert / emplace / try_emplace 做强异常安全保证：
+// 扩容与重新散列先把元素搬到新数组 (移动构造可能抛出异常时复制)，全部完成后才替换旧数组，
+// 失败时表保持不变
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+
+#include "concurrency.h"
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "utils.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// 控制字节与组的操作，flat_hash_map 与以后的开放定址表共用
+/*****************************************************************************************/
+namespace swiss
+{
+
+typedef signed char ctrl_t;
+
+constexpr ctrl_t ctrl_empty    = -128;  // 0b10000000
+constexpr ctrl_t ctrl_deleted  = -2;    // 0b11111110
+constexpr ctrl_t ctrl_sentinel = -1;    // 0b11111111
+
+inline bool is_full(ctrl_t c) noexcept             { return c >= 0; }
+inline bool is_empty(ctrl_t c) noexcept            { return c == ctrl_empty; }
+inline bool is_deleted(ctrl_t c) noexcept          { return c == ctrl_deleted; }
+inline bool is_empty_or_deleted(ctrl_t c) noexcept { return c < ctrl_sentinel; }
+
+inline unsigned count_trailing_zeros(uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+  unsigned n = 0;
+  while ((x & 1) == 0)
+  {
+    x >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+inline unsigned count_leading_zeros(uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_clzll(x));
+#else
+  unsigned n = 0;
+  while ((x & (static_cast<uint64_t>(1) << 63)) == 0)
+  {
+    x <<= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+// 组内匹配结果的位集合，每个槽占 1 << Shift 位，有效位数为 Width << Shift
+template <unsigned Width, unsigned Shift>
+class bitmask
+{
+public:
+  explicit bitmask(uint64_t mask) noexcept :mask_(mask) {}
+
+  explicit operator bool() const noexcept { return mask_ != 0; }
+
+  // 最低的匹配位置，调用前需确认非空
+  unsigned lowest() const noexcept { return count_trailing_zeros(mask_) >> Shift; }
+  // 去掉最低的匹配位置
+  void     next() noexcept { mask_ &= mask_ - 1; }
+
+  // 从低位起连续不匹配的槽数
+  unsigned trailing_zeros() const noexcept
+  { return mask_ == 0 ? Width : count_trailing_zeros(mask_) >> Shift; }
+  // 从高位起连续不匹配的槽数
+  unsigned leading_zeros() const noexcept
+  {
+    const unsigned extra = 64 - (Width << Shift);
+    return mask_ == 0 ? Width : count_leading_zeros(mask_ << extra) >> Shift;
+  }
+
+private:
+  uint64_t mask_;
+};
+
+#if MYSTL_HAS_SSE2
+
+// 一组 16 个控制字节，用 SSE2 比较
+class group
+{
+public:
+  static constexpr size_t width = 16;
+  typedef bitmask<16, 0> mask_type;
+
+  explicit group(const ctrl_t* pos) noexcept
+    :ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+  // 控制字节等于 h2 的槽
+  mask_type match(ctrl_t h2) const noexcept
+  {
+    return mask_type(static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+  }
+
+  mask_type match_empty() const noexcept
+  {
+    return mask_type(static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(ctrl_empty), ctrl_))));
+  }
+
+  mask_type match_empty_or_deleted() const noexcept
+  {
+    return mask_type(static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl_))));
+  }
+
+  // 从开头起连续的空槽或墓碑个数
+  unsigned count_leading_empty_or_deleted() const noexcept
+  {
+    const uint32_t mask = static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl_)));
+    return count_trailing_zeros(static_cast<uint64_t>(mask) + 1);
+  }
+
+private:
+  __m128i ctrl_;
+};
+
+#else
+
+// 一组 8 个控制字节，按小端序读入一个 64 位整数，每个字节的最高位表示匹配结果
+class group
+{
+public:
+  static constexpr size_t width = 8;
+  typedef bitmask<8, 3> mask_type;
+
+  explicit group(const ctrl_t* pos) noexcept
+  {
+    unsigned char bytes[8];
+    std::memcpy(bytes, pos, sizeof(bytes));
+    ctrl_ = 0;
+    for (int i = 7; i >= 0; --i)
+      ctrl_ = (ctrl_ << 8) | bytes[i];
+  }
+
+  // 可能有假阳性，调用方总会再比较键
+  mask_type match(ctrl_t h2) const noexcept
+  {
+    const uint64_t x = ctrl_ ^ (lsbs * static_cast<unsigned char>(h2));
+    return mask_type((x - lsbs) & ~x & msbs);
+  }
+
+  mask_type match_empty() const noexcept
+  {
+    return mask_type((ctrl_ & (~ctrl_ << 6)) & msbs);
+  }
+
+  mask_type match_empty_or_deleted() const noexcept
+  {
+    return mask_type((ctrl_ & (~ctrl_ << 7)) & msbs);
+  }
+
+  unsigned count_leading_empty_or_deleted() const noexcept
+  {
+    const uint64_t gaps = 0x00FEFEFEFEFEFEFEULL;
+    return (count_trailing_zeros(((~ctrl_ & (ctrl_ >> 7)) | gaps) + 1) + 7) >> 3;
+  }
+
+private:
+  static constexpr uint64_t lsbs = 0x0101010101010101ULL;
+  static constexpr uint64_t msbs = 0x8080808080808080ULL;
+
+  uint64_t ctrl_;
+};
+
+#endif
+
+// 空表共用的控制字节 : 一个哨兵后跟一组空槽，在空表上查找不需要特判
+inline const ctrl_t* empty_group() noexcept
+{
+  alignas(16) static const ctrl_t g[32] = {
+    ctrl_sentinel, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty };
+  return g;
+}
+
+// 对哈希值再做一次混合，64 位乘法后把高位折叠下来
+inline size_t mix_hash(size_t h) noexcept
+{
+  uint64_t x = static_cast<uint64_t>(h);
+  x ^= x >> 32;
+  x *= 0x9E3779B97F4A7C15ULL;
+  x ^= x >> 29;
+  return static_cast<size_t>(x);
+}
+
+inline size_t  h1(size_t hash) noexcept { return hash >> 7; }
+inline ctrl_t  h2(size_t hash) noexcept { return static_cast<ctrl_t>(hash & 0x7F); }
+
+// 探测序列 : 以组为单位的三角数步长，mask 为容量
+class probe_seq
+{
+public:
+  probe_seq(size_t hash, size_t mask) noexcept
+    :mask_(mask), offset_(hash & mask), index_(0) {}
+
+  size_t offset() const noexcept { return offset_; }
+  size_t offset(size_t i) const noexcept { return (offset_ + i) & mask_; }
+  size_t index() const noexcept { return index_; }
+
+  void   next() noexcept
+  {
+    index_ += group::width;
+    offset_ = (offset_ + index_) & mask_;
+  }
+
+private:
+  size_t mask_;
+  size_t offset_;
+  size_t index_;
+};
+
+// 容量与最多能容纳的元素个数的换算，容量为 2^k - 1
+inline size_t capacity_to_growth(size_t capacity) noexcept
+{
+  if (group::width == 8 && capacity == 7)
+    return 6;
+  return capacity - capacity / 8;
+}
+
+inline size_t growth_to_capacity(size_t growth) noexcept
+{
+  if (group::width == 8 && growth == 7)
+    return 15;
+  const size_t n = growth + (growth == 0 ? 0 : (growth - 1) / 7);
+  return n == 0 ? 0 : mystl::round_up_pow2(n + 1) - 1;
+}
+
+} // namespace swiss
+
+template <class Key, class T, class Hash, class KeyEqual> class flat_hash_map;
+
+// flat_hash_map 的迭代器设计，指向控制字节与对应的槽
+template <class Value, class Ref, class Ptr>
+struct flat_hash_map_iterator : public iterator<forward_iterator_tag, Value>
+{
+  typedef flat_hash_map_iterator<Value, Value&, Value*>             iterator;
+  typedef flat_hash_map_iterator<Value, const Value&, const Value*> const_iterator;
+  typedef flat_hash_map_iterator                                    self;
+
+  typedef Value      value_type;
+  typedef Ptr        pointer;
+  typedef Ref        reference;
+  typedef size_t     size_type;
+  typedef ptrdiff_t  difference_type;
+
+  const swiss::ctrl_t* ctrl;  // 当前槽的控制字节，end 时指向哨兵
+  Value*               slot;  // 当前槽
+
+  // 构造、复制函数
+  flat_hash_map_iterator() noexcept
+    :ctrl(nullptr), slot(nullptr) {}
+
+  flat_hash_map_iterator(const swiss::ctrl_t* c, Value* s) noexcept
+    :ctrl(c), slot(s) {}
+
+  flat_hash_map_iterator(const iterator& rhs) noexcept
+    :ctrl(rhs.ctrl), slot(rhs.slot) {}
+
+  self& operator=(const iterator& rhs) noexcept
+  {
+    ctrl = rhs.ctrl;
+    slot = rhs.slot;
+    return *this;
+  }
+
+  // 重载运算符
+  reference operator*()  const { return *slot; }
+  pointer   operator->() const { return slot; }
+
+  self& operator++()
+  {
+    ++ctrl;
+    ++slot;
+    skip_empty_or_deleted();
+    return *this;
+  }
+  self  operator++(int)
+  {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  // 跳过空槽与墓碑，一次跳过一组中开头连续的若干个
+  void skip_empty_or_deleted() noexcept
+  {
+    while (swiss::is_empty_or_deleted(*ctrl))
+    {
+      const unsigned shift = swiss::group(ctrl).count_leading_empty_or_deleted();
+      ctrl += shift;
+      slot += shift;
+    }
+  }
+
+  // 重载比较操作符
+  bool operator==(const self& rhs) const { return ctrl == rhs.ctrl; }
+  bool operator!=(const self& rhs) const { return ctrl != rhs.ctrl; }
+};
+
+// 模板类 flat_hash_map
+// 参数一代表键值类型，参数二代表实值类型，参数三代表哈希函数，参数四代表键值的相等比较
+template <class Key, class T, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+class flat_hash_map
+{
+public:
+  // flat_hash_map 的型别定义
+  typedef Key                                         key_type;
+  typedef T                                           mapped_type;
+  typedef mystl::pair<const Key, T>                   value_type;
+  typedef Hash                                        hasher;
+  typedef KeyEqual                                    key_equal;
+
+  typedef mystl::allocator<value_type>                allocator_type;
+  typedef mystl::allocator<value_type>                data_allocator;
+  typedef mystl::allocator<swiss::ctrl_t>             ctrl_allocator;
+
+  typedef typename allocator_type::pointer            pointer;
+  typedef typename allocator_type::const_pointer      const_pointer;
+  typedef typename allocator_type::reference          reference;
+  typedef typename allocator_type::const_reference    const_reference;
+  typedef typename allocator_type::size_type          size_type;
+  typedef typename allocator_type::difference_type    difference_type;
+
+  typedef flat_hash_map_iterator<value_type, value_type&, value_type*>             iterator;
+  typedef flat_hash_map_iterator<value_type, const value_type&, const value_type*> const_iterator;
+
+  allocator_type get_allocator() const { return allocator_type(); }
+
+private:
+  swiss::ctrl_t* ctrl_;         // 控制字节，空表时指向共用的 empty_group
+  pointer        slots_;        // 槽
+  size_type      size_;         // 元素个数
+  size_type      capacity_;     // 槽的个数，为 0 或 2^k - 1
+  size_type      growth_left_;  // 不扩容还能插入的元素个数，墓碑不计入
+  hasher         hash_;
+  key_equal      equal_;
+
+public:
+  // 构造、复制、移动、析构函数
+  flat_hash_map()
+    :flat_hash_map(0)
+  {
+  }
+
+  explicit flat_hash_map(size_type bucket_count,
+                         const hasher& hash = hasher(),
+                         const key_equal& equal = key_equal())
+    :ctrl_(empty_ctrl()), slots_(nullptr), size_(0), capacity_(0), growth_left_(0),
+     hash_(hash), equal_(equal)
+  {
+    if (bucket_count != 0)
+      reserve(bucket_count);
+  }
+
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  flat_hash_map(InputIter first, InputIter last, size_type bucket_count = 0,
+                const hasher& hash = hasher(), const key_equal& equal = key_equal())
+    :flat_hash_map(bucket_count, hash, equal)
+  {
+    insert(first, last);
+  }
+
+  flat_hash_map(std::initializer_list<value_type> ilist, size_type bucket_count = 0,
+                const hasher& hash = hasher(), const key_equal& equal = key_equal())
+    :flat_hash_map(bucket_count == 0 ? ilist.size() : bucket_count, hash, equal)
+  {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  flat_hash_map(const flat_hash_map& rhs)
+    :flat_hash_map(rhs.size_, rhs.hash_, rhs.equal_)
+  {
+    for (auto it = rhs.begin(); it != rhs.end(); ++it)
+      insert_unique_noresize(*it);
+  }
+
+  flat_hash_map(flat_hash_map&& rhs) noexcept
+    :ctrl_(rhs.ctrl_), slots_(rhs.slots_), size_(rhs.size_), capacity_(rhs.capacity_),
+     growth_left_(rhs.growth_left_), hash_(rhs.hash_), equal_(rhs.equal_)
+  {
+    rhs.reset_empty();
+  }
+
+  flat_hash_map& operator=(const flat_hash_map& rhs)
+  {
+    if (this != &rhs)
+    {
+      flat_hash_map tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  flat_hash_map& operator=(flat_hash_map&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      destroy_and_recover();
+      ctrl_ = rhs.ctrl_;
+      slots_ = rhs.slots_;
+      size_ = rhs.size_;
+      capacity_ = rhs.capacity_;
+      growth_left_ = rhs.growth_left_;
+      hash_ = rhs.hash_;
+      equal_ = rhs.equal_;
+      rhs.reset_empty();
+    }
+    return *this;
+  }
+
+  flat_hash_map& operator=(std::initializer_list<value_type> ilist)
+  {
+    flat_hash_map tmp(ilist, 0, hash_, equal_);
+    swap(tmp);
+    return *this;
+  }
+
+  ~flat_hash_map()
+  {
+    destroy_and_recover();
+  }
+
+public:
+  // 迭代器相关操作
+  iterator       begin()        noexcept
+  {
+    iterator it(ctrl_, slots_);
+    it.skip_empty_or_deleted();
+    return it;
+  }
+  const_iterator begin()  const noexcept
+  {
+    iterator it(ctrl_, slots_);
+    it.skip_empty_or_deleted();
+    return it;
+  }
+  iterator       end()          noexcept
+  { return iterator(ctrl_ + capacity_, slots_ + capacity_); }
+  const_iterator end()    const noexcept
+  { return const_iterator(ctrl_ + capacity_, slots_ + capacity_); }
+
+  const_iterator cbegin() const noexcept
+  { return begin(); }
+  const_iterator cend()   const noexcept
+  { return end(); }
+
+  // 容量相关操作
+  bool      empty()    const noexcept { return size_ == 0; }
+  size_type size()     const noexcept { return size_; }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(value_type); }
+  size_type capacity() const noexcept { return capacity_; }
+
+  // 哈希策略相关操作
+  size_type bucket_count()    const noexcept { return capacity_; }
+  float     load_factor()     const noexcept
+  { return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / static_cast<float>(capacity_); }
+  float     max_load_factor() const noexcept { return 7.0f / 8.0f; }
+
+  void      rehash(size_type count);
+  void      reserve(size_type count)
+  {
+    if (count > size_ + growth_left_)
+      resize(swiss::growth_to_capacity(count));
+  }
+
+  hasher    hash_function() const { return hash_; }
+  key_equal key_eq()        const { return equal_; }
+
+  // 访问元素相关操作
+  mapped_type&       at(const key_type& key)
+  {
+    iterator it = find(key);
+    THROW_OUT_OF_RANGE_IF(it == end(), "flat_hash_map<Key, T> no such element exists");
+    return it->second;
+  }
+  const mapped_type& at(const key_type& key) const
+  {
+    const_iterator it = find(key);
+    THROW_OUT_OF_RANGE_IF(it == end(), "flat_hash_map<Key, T> no such element exists");
+    return it->second;
+  }
+
+  mapped_type& operator[](const key_type& key)
+  { return try_emplace(key).first->second; }
+  mapped_type& operator[](key_type&& key)
+  { return try_emplace(mystl::move(key)).first->second; }
+
+  // 修改容器相关操作
+
+  // emplace，先构造出键值对再查找，键已存在时丢弃
+  template <class ...Args>
+  mystl::pair<iterator, bool> emplace(Args&& ...args);
+
+  // try_emplace，键不存在时才用 args 构造实值
+  template <class ...Args>
+  mystl::pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+  { return try_emplace_key(key, mystl::forward<Args>(args)...); }
+  template <class ...Args>
+  mystl::pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args)
+  { return try_emplace_key(mystl::move(key), mystl::forward<Args>(args)...); }
+
+  // insert
+  mystl::pair<iterator, bool> insert(const value_type& value)
+  { return try_emplace_key(value.first, value.second); }
+  mystl::pair<iterator, bool> insert(value_type&& value)
+  { return emplace(mystl::move(value)); }
+
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  void insert(InputIter first, InputIter last)
+  {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+  void insert(std::initializer_list<value_type> ilist)
+  { insert(ilist.begin(), ilist.end()); }
+
+  // insert_or_assign
+  template <class M>
+  mystl::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+  {
+    auto r = try_emplace_key(key, mystl::forward<M>(obj));
+    if (!r.second)
+      r.first->second = mystl::forward<M>(obj);
+    return r;
+  }
+
+  // erase / clear
+  iterator  erase(const_iterator pos)
+  {
+    MYSTL_DEBUG(pos != end());
+    iterator it(pos.ctrl, const_cast<pointer>(pos.slot));
+    erase_at(static_cast<size_type>(it.slot - slots_));
+    ++it;
+    return it;
+  }
+  iterator  erase(const_iterator first, const_iterator last)
+  {
+    while (first != last)
+      first = erase(first);
+    return iterator(last.ctrl, const_cast<pointer>(last.slot));
+  }
+  size_type erase(const key_type& key)
+  {
+    const size_type i = find_index(key, hash_of(key));
+    if (i == capacity_)
+      return 0;
+    erase_at(i);
+    return 1;
+  }
+
+  void      clear() noexcept;
+
+  void      swap(flat_hash_map& rhs) noexcept;
+
+  // 查找相关操作
+  iterator       find(const key_type& key)
+  { return make_iterator(find_index(key, hash_of(key))); }
+  const_iterator find(const key_type& key) const
+  { return make_iterator(find_index(key, hash_of(key))); }
+
+  size_type      count(const key_type& key) const
+  { return find_index(key, hash_of(key)) == capacity_ ? 0 : 1; }
+  bool           contains(const key_type& key) const
+  { return find_index(key, hash_of(key)) != capacity_; }
+
+  mystl::pair<iterator, iterator> equal_range(const key_type& key)
+  {
+    iterator it = find(key);
+    iterator last = it;
+    if (last != end())
+      ++last;
+    return mystl::pair<iterator, iterator>(it, last);
+  }
+  mystl::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+  {
+    const_iterator it = find(key);
+    const_iterator last = it;
+    if (last != end())
+      ++last;
+    return mystl::pair<const_iterator, const_iterator>(it, last);
+  }
+
+private:
+  // helper functions
+
+  static swiss::ctrl_t* empty_ctrl() noexcept
+  { return const_cast<swiss::ctrl_t*>(swiss::empty_group()); }
+
+  size_type hash_of(const key_type& key) const
+  { return hash_of(key, mystl::hash_is_avalanching<hasher>()); }
+  size_type hash_of(const key_type& key, m_true_type) const
+  { return static_cast<size_t>(hash_(key)); }
+  size_type hash_of(const key_type& key, m_false_type) const
+  { return swiss::mix_hash(static_cast<size_t>(hash_(key))); }
+
+  iterator make_iterator(size_type i) noexcept
+  { return iterator(ctrl_ + i, slots_ + i); }
+  const_iterator make_iterator(size_type i) const noexcept
+  { return const_iterator(ctrl_ + i, slots_ + i); }
+
+  // 设置控制字节，同时维护哨兵之后的复制
+  void set_ctrl(size_type i, swiss::ctrl_t c) noexcept
+  { set_ctrl(ctrl_, capacity_, i, c); }
+  static void set_ctrl(swiss::ctrl_t* ctrl, size_type capacity, size_type i, swiss::ctrl_t c) noexcept
+  {
+    const size_type cloned = swiss::group::width - 1;
+    ctrl[i] = c;
+    ctrl[((i - cloned) & capacity) + (cloned & capacity)] = c;
+  }
+
+  // 查找键所在的槽，不存在时返回 capacity_
+  size_type find_index(const key_type& key, size_type hash) const;
+  // 找到第一个空槽或墓碑
+  size_type find_first_non_full(size_type hash) const noexcept
+  { return find_first_non_full(ctrl_, capacity_, hash); }
+  static size_type find_first_non_full(const swiss::ctrl_t* ctrl, size_type capacity,
+                                       size_type hash) noexcept;
+  // 为哈希值为 hash 的新元素占用一个槽，必要时整理或扩容
+  size_type prepare_insert(size_type hash);
+
+  template <class K, class ...Args>
+  mystl::pair<iterator, bool> try_emplace_key(K&& key, Args&& ...args);
+
+  // 复制时使用，已经预留了空间且键不重复
+  void      insert_unique_noresize(const value_type& value);
+
+  void      erase_at(size_type i) noexcept;
+  void      erase_meta(size_type i) noexcept;
+
+  void      resize(size_type new_capacity);
+  void      rehash_and_grow_if_necessary();
+
+  void      reset_empty() noexcept
+  {
+    ctrl_ = empty_ctrl();
+    slots_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+    growth_left_ = 0;
+  }
+  void      destroy_and_recover() noexcept;
+};
+
+/*****************************************************************************************/
+
+// 按 count 个元素重新散列，count 小于 size() 时按 size() 计算，为 0 且表为空时释放空间
+template <class Key, class T, class Hash, class KeyEqual>
+void flat_hash_map<Key, T, Hash, KeyEqual>::rehash(size_type count)
+{
+  if (count == 0 && size_ == 0)
+  {
+    destroy_and_recover();
+    return;
+  }
+  const size_type need = swiss::growth_to_capacity(count > size_ ? count : size_);
+  const size_type least = swiss::growth_to_capacity(size_);
+  resize(need > least ? need : least);
+}
+
+template <class Key, class T, class Hash, class KeyEqual>
+template <class ...Args>
+mystl::pair<typename flat_hash_map<Key, T, Hash, KeyEqual>::iterator, bool>
+flat_hash_map<Key, T, Hash, KeyEqual>::emplace(Args&& ...args)
+{
+  value_type value(mystl::forward<Args>(args)...);
+  const size_type hash = hash_of(value.first);
+  const size_type found = find_index(value.first, hash);
+  if (found != capacity_)
+    return mystl::pair<iterator, bool>(make_iterator(found), false);
+  const size_type i = prepare_insert(hash);
+  try
+  {
+    data_allocator::construct(slots_ + i, mystl::move(value));
+  }
+  catch (...)
+  {
+    erase_meta(i);
+    throw;
+  }
+  return mystl::pair<iterator, bool>(make_iterator(i), true);
+}
+
+template <class Key, class T, class Hash, class KeyEqual>
+template <class K, class ...Args>
+mystl::pair<typename flat_hash_map<Key, T, Hash, KeyEqual>::iterator, bool>
+flat_hash_map<Key, T, Hash, KeyEqual>::try_emplace_key(K&& key, Args&& ...args)
+{
+  const size_type hash = hash_of(key);
+  const size_type found = find_index(key, hash);
+  if (found != capacity_)
+    return mystl::pair<iterator, bool>(make_iterator(found), false);
+  const size_type i = prepare_insert(hash);
+  try
+  {
+    data_allocator::construct(slots_ + i, mystl::forward<K>(key),
+                              mapped_type(mystl::forward<Args>(args)...));
+  }
+  catch (...)
+  {
+    erase_meta(i);
+    throw;
+  }
+  return mystl::pair<iterator, bool>(make_iterator(i), true);
+}
+
+template <class Key, class T, class Hash, class KeyEqual>
+void flat_hash_map<Key, T, Hash, KeyEqual>::clear() noexcept
+{
+  if (capacity_ == 0)
+    return;
+  for (size_type i = 0; i < capacity_; ++i)
+  {
+    if (swiss::is_full(ctrl_[i]))
+      data_allocator::destroy(slots_ + i);
+  }
+  std::memset(ctrl_, static_cast<unsigned char>(swiss::ctrl_empty),
+              capacity_ + swiss::group::width);
+  ctrl_[capacity_] = swiss::ctrl_sentinel;
+  size_ = 0;
+  growth_left_ = swiss::capacity_to_growth(capacity_);
+}
+
+template <class Key, class T, class Hash, class KeyEqual>
+void flat_hash_map<Key, T, Hash, KeyEqual>::swap(flat_hash_map& rhs) noexcept
+{
+  mystl::swap(ctrl_, rhs.ctrl_);
+  mystl::swap(slots_, rhs.slots_);
+  mystl::swap(size_, rhs.size_);
+  mystl::swap(capacity_, rhs.capacity_);
+  mystl::swap(growth_left_, rhs.growth_left_);
+  mystl::swap(hash_, rhs.hash_);
+  mystl::swap(equal_, rhs.equal_);
+}
+
+/*****************************************************************************************/
+// helper function
+
+template <class Key, class T, class Hash, class KeyEqual>
+typename flat_hash_map<Key, T, Hash, KeyEqual>::size_type
+flat_hash_map<Key, T, Hash, KeyEqual>::find_index(const key_type& key, size_type hash) const
+{
+  swiss::probe_seq seq(swiss::h1(hash), capacity_);
+  const swiss::ctrl_t tag = swiss::h2(hash);
+  while (true)
+  {
+    const swiss::group g(ctrl_ + seq.offset());
+    for (auto m = g.match(tag); m; m.next())
+    {
+      const size_type i = seq.offset(m.lowest());
+      if (equal_(slots_[i].first, key))
+        return i;
+    }
+    if (g.match_empty())
+      return capacity_;
+    seq.next();
+    MYSTL_DEBUG(seq.index() <= capacity_);
+  }
+}
+
+template <class Key, class T, class Hash, class KeyEqual>
+typename flat_hash_map<Key, T, Hash, KeyEqual>::size_type
+flat_hash_map<Key, T, Hash, KeyEqual>::
+find_first_non_full(const swiss::ctrl_t* ctrl, size_type capacity, size_type hash) noexcept
+{
+  swiss::probe_seq seq(swiss::h1(hash), capacity);
+  while (true)
+  {
+    const auto m = swiss::group(ctrl + seq.offset()).match_empty_or_deleted();
+    if (m)
+      return seq.offset(m.lowest());
+    seq.next();
+    MYSTL_DEBUG(seq.index() <= capacity);
+  }
+}
+
+template <class Key, class T, class Hash, class KeyEqual>
+typename flat_hash_map<Key, T, Hash, KeyEqual>::size_type
+flat_hash_map<Key, T, Hash, KeyEqual>::prepare_insert(size_type hash)
+{
+  size_type i = find_first_non_full(hash);
+  if (growth_left_ == 0 && !swiss::is_deleted(ctrl_[i]))
+  {
+    rehash_and_grow_if_necessary();
+    i = find_first_non_full(hash);
+  }
+  ++size_;
+  growth_left_ -= swiss::is_empty(ctrl_[i]) ? 1 : 0;
+  set_ctrl(i, swiss::h2(hash));
+  return i;
+}
+
+template <class Key, class T, class Hash, class KeyEqual>
+void flat_hash_map<Key, T, Hash, KeyEqual>::
+insert_unique_noresize(const value_type& value)
+{
+  const size_type hash = hash_of(value.first);
+  const size_type i = find_first_non_full(hash);
+  data_allocator::construct(slots_ + i, value);
+  ++size_;
+  --growth_left_;
+  set_ctrl(i, swiss::h2(hash));
+}
+
+// 删除第 i 个槽上的元素
+template <class Key, class T, class Hash, class KeyEqual>
+void flat_hash_map<Key, T, Hash, KeyEqual>::erase_at(size_type i) noexcept
+{
+  data_allocator::destroy(slots_ + i);
+  erase_meta(i);
+}
+
+// 把第 i 个槽标记为空槽或墓碑 : 没有探测窗口跨过它时可以直接置空
+template <class Key, class T, class Hash, class KeyEqual>
+void flat_hash_map<Key, T, Hash, KeyEqual>::erase_meta(size_type i) noexcept
+{
+  --size_;
+  const size_type before = (i - swiss::group::width) & capacity_;
+  const auto empty_after = swiss::group(ctrl_ + i).match_empty();
+  const auto empty_before = swiss::group(ctrl_ + before).match_empty();
+  const bool was_never_full = empty_before && empty_after &&
+    empty_after.trailing_zeros() + empty_before.leading_zeros() < swiss::group::width;
+  set_ctrl(i, was_never_full ? swiss::ctrl_empty : swiss::ctrl_deleted);
+  growth_left_ += was_never_full ? 1 : 0;
+}
+
+template <class Key, class T, class Hash, class KeyEqual>
+void flat_hash_map<Key, T, Hash, KeyEqual>::resize(size_type new_capacity)
+{
+  MYSTL_DEBUG(new_capacity == 0 || ((new_capacity + 1) & new_capacity) == 0);
+  THROW_LENGTH_ERROR_IF(new_capacity > max_size(), "flat_hash_map<Key, T>'s size too big");
+  swiss::ctrl_t* old_ctrl = ctrl_;
+  pointer old_slots = slots_;
+  const size_type old_capacity = capacity_;
+
+  const size_type ctrl_len = new_capacity + swiss::group::width;
+  swiss::ctrl_t* new_ctrl = ctrl_allocator::allocate(ctrl_len);
+  pointer new_slots = nullptr;
+  try
+  {
+    new_slots = data_allocator::allocate(new_capacity);
+  }
+  catch (...)
+  {
+    ctrl_allocator::deallocate(new_ctrl, ctrl_len);
+    throw;
+  }
+  std::memset(new_ctrl, static_cast<unsigned char>(swiss::ctrl_empty), ctrl_len);
+  new_ctrl[new_capacity] = swiss::ctrl_sentinel;
+
+  // 元素搬到新数组上的新位置，哈希值需要重新计算
+  // pair<const Key, T> 的移动构造会复制键，可能抛出异常时改为复制整个元素，
+  // 旧元素在全部搬完之前保持不变，失败时只需析构新数组上已经构造的元素
+  try
+  {
+    for (size_type i = 0; i < old_capacity; ++i)
+    {
+      if (swiss::is_full(old_ctrl[i]))
+      {
+        const size_type hash = hash_of(old_slots[i].first);
+        const size_type target = find_first_non_full(new_ctrl, new_capacity, hash);
+        data_allocator::construct(new_slots + target, std::move_if_noexcept(old_slots[i]));
+        set_ctrl(new_ctrl, new_capacity, target, swiss::h2(hash));
+      }
+    }
+  }
+  catch (...)
+  {
+    for (size_type i = 0; i < new_capacity; ++i)
+    {
+      if (swiss::is_full(new_ctrl[i]))
+        data_allocator::destroy(new_slots + i);
+    }
+    ctrl_allocator::deallocate(new_ctrl, ctrl_len);
+    data_allocator::deallocate(new_slots, new_capacity);
+    throw;
+  }
+
+  // 全部搬完后才切换到新数组
+  for (size_type i = 0; i < old_capacity; ++i)
+  {
+    if (swiss::is_full(old_ctrl[i]))
+      data_allocator::destroy(old_slots + i);
+  }
+  if (old_capacity != 0)
+  {
+    ctrl_allocator::deallocate(old_ctrl, old_capacity + swiss::group::width);
+    data_allocator::deallocate(old_slots, old_capacity);
+  }
+  ctrl_ = new_ctrl;
+  slots_ = new_slots;
+  capacity_ = new_capacity;
+  growth_left_ = swiss::capacity_to_growth(new_capacity) - size_;
+}
+
+// 墓碑较多时在原容量下重新散列，否则容量翻倍
+template <class Key, class T, class Hash, class KeyEqual>
+void flat_hash_map<Key, T, Hash, KeyEqual>::rehash_and_grow_if_necessary()
+{
+  if (capacity_ == 0)
+    resize(1);
+  else if (capacity_ > swiss::group::width && size_ * 32 <= capacity_ * 25)
+    resize(capacity_);
+  else
+    resize(capacity_ * 2 + 1);
+}
+
+template <class Key, class T, class Hash, class KeyEqual>
+void flat_hash_map<Key, T, Hash, KeyEqual>::destroy_and_recover() noexcept
+{
+  if (capacity_ != 0)
+  {
+    clear();
+    ctrl_allocator::deallocate(ctrl_, capacity_ + swiss::group::width);
+    data_allocator::deallocate(slots_, capacity_);
+  }
+  reset_empty();
+}
+
+/*****************************************************************************************/
+// 重载比较操作符
+
+template <class Key, class T, class Hash, class KeyEqual>
+bool operator==(const flat_hash_map<Key, T, Hash, KeyEqual>& lhs,
+                const flat_hash_map<Key, T, Hash, KeyEqual>& rhs)
+{
+  if (lhs.size() != rhs.size())
+    return false;
+  for (auto it = lhs.begin(); it != lhs.end(); ++it)
+  {
+    auto other = rhs.find(it->first);
+    if (other == rhs.end() || !(other->second == it->second))
+      return false;
+  }
+  return true;
+}
+
+template <class Key, class T, class Hash, class KeyEqual>
+bool operator!=(const flat_hash_map<Key, T, Hash, KeyEqual>& lhs,
+                const flat_hash_map<Key, T, Hash, KeyEqual>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+// 重载 mystl 的 swap
+template <class Key, class T, class Hash, class KeyEqual>
+void swap(flat_hash_map<Key, T, Hash, KeyEqual>& lhs,
+          flat_hash_map<Key, T, Hash, KeyEqual>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_FLAT_HASH_MAP_H_
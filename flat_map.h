@@ -0,0 +1,672 @@
+#ifndef TINYSTL_FLAT_MAP_H_
+#define TINYSTL_FLAT_MAP_H_
+
+// 这个头文件包含一个模板类 flat_map
+// flat_map : 映射，元素按键值有序排列，键值不允许重复，底层为两个有序的 mystl::vector，
+// 键与实值分开存放，查找只在连续的键数组上二分，遍历是对两个数组的顺序访问
+// 单个插入、删除要搬移其后的元素，为 O(n)；区间插入先追加到尾部，再排序、归并、去重，
+// 为 O(n + m log m)，适合读多写少、规模中小而频繁遍历的表
+// 插入、删除会使所有迭代器与引用失效
+
+// notes:
+//
+// 1. 迭代器解引用得到 mystl::pair<const Key&, T&> 形式的代理对象而不是 value_type 的引用，
+//    operator-> 返回持有该代理的对象，因此 it->first、it->second 可以照常使用
+// 2. 与 map 相同，key 已存在时 insert / emplace / try_emplace 不会改变已有元素，
+//    区间插入中相等的键只保留最先出现的一个
+
+// 异常保证：
+// 元素的移动构造不抛出异常时，mystl::flat_map<Key, T> 对单个元素的 insert / emplace / try_emplace
+// 做强异常安全保证；区间插入在追加阶段抛出异常时恢复原状，排序、归并阶段抛出异常时容器被清空
+
+#include <initializer_list>
+
+#include "algo.h"
+#include "functional.h"
+#include "iterator.h"
+#include "vector.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 模板类 flat_map_iterator
+// 参数一代表键值类型，参数二代表实值类型，const_iterator 的实值类型带 const
+template <class Key, class T>
+struct flat_map_iterator
+{
+  typedef random_access_iterator_tag                            iterator_category;
+  typedef mystl::pair<Key, typename std::remove_const<T>::type> value_type;
+  typedef mystl::pair<const Key&, T&>                           reference;
+  typedef ptrdiff_t                                             difference_type;
+
+  // operator-> 返回的对象，持有一个代理
+  struct pointer
+  {
+    reference ref;
+    reference* operator->() { return &ref; }
+  };
+
+  typedef flat_map_iterator<Key, typename std::remove_const<T>::type> iterator;
+  typedef flat_map_iterator<Key, T>                                   self;
+
+  const Key* key;    // 指向键
+  T*         value;  // 指向实值
+
+  flat_map_iterator() noexcept :key(nullptr), value(nullptr) {}
+  flat_map_iterator(const Key* k, T* v) noexcept :key(k), value(v) {}
+  flat_map_iterator(const iterator& rhs) noexcept :key(rhs.key), value(rhs.value) {}
+
+  reference operator*()  const { return reference(*key, *value); }
+  pointer   operator->() const { return pointer{ reference(*key, *value) }; }
+  reference operator[](difference_type n) const
+  { return reference(key[n], value[n]); }
+
+  self& operator++() { ++key; ++value; return *this; }
+  self  operator++(int) { self tmp = *this; ++*this; return tmp; }
+  self& operator--() { --key; --value; return *this; }
+  self  operator--(int) { self tmp = *this; --*this; return tmp; }
+
+  self& operator+=(difference_type n) { key += n; value += n; return *this; }
+  self& operator-=(difference_type n) { key -= n; value -= n; return *this; }
+  self  operator+(difference_type n) const { self tmp = *this; return tmp += n; }
+  self  operator-(difference_type n) const { self tmp = *this; return tmp -= n; }
+  friend self operator+(difference_type n, const self& x) { return x + n; }
+  friend difference_type operator-(const self& lhs, const self& rhs)
+  { return lhs.key - rhs.key; }
+
+  friend bool operator==(const self& lhs, const self& rhs) { return lhs.key == rhs.key; }
+  friend bool operator!=(const self& lhs, const self& rhs) { return lhs.key != rhs.key; }
+  friend bool operator< (const self& lhs, const self& rhs) { return lhs.key <  rhs.key; }
+  friend bool operator> (const self& lhs, const self& rhs) { return lhs.key >  rhs.key; }
+  friend bool operator<=(const self& lhs, const self& rhs) { return lhs.key <= rhs.key; }
+  friend bool operator>=(const self& lhs, const self& rhs) { return lhs.key >= rhs.key; }
+};
+
+// 模板类 flat_map
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 mystl::less
+template <class Key, class T, class Compare = mystl::less<Key>>
+class flat_map
+{
+public:
+  // flat_map 的嵌套型别定义
+  typedef Key                               key_type;
+  typedef T                                 mapped_type;
+  typedef mystl::pair<Key, T>               value_type;
+  typedef Compare                           key_compare;
+  typedef mystl::vector<Key>                key_container_type;
+  typedef mystl::vector<T>                  mapped_container_type;
+
+  typedef mystl::pair<const Key&, T&>       reference;
+  typedef mystl::pair<const Key&, const T&> const_reference;
+  typedef size_t                            size_type;
+  typedef ptrdiff_t                         difference_type;
+
+  typedef flat_map_iterator<Key, T>         iterator;
+  typedef flat_map_iterator<Key, const T>   const_iterator;
+  typedef mystl::reverse_iterator<iterator>       reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  // 定义一个 functor，用来进行元素比较
+  class value_compare : public binary_function<const_reference, const_reference, bool>
+  {
+    friend class flat_map<Key, T, Compare>;
+  private:
+    Compare comp;
+    value_compare(Compare c) : comp(c) {}
+  public:
+    bool operator()(const const_reference& lhs, const const_reference& rhs) const
+    {
+      return comp(lhs.first, rhs.first);  // 比较键值的大小
+    }
+  };
+
+private:
+  key_container_type    keys_;    // 有序的键
+  mapped_container_type values_;  // 与键一一对应的实值
+  key_compare           comp_;
+
+public:
+  key_compare   key_comp()   const { return comp_; }
+  value_compare value_comp() const { return value_compare(comp_); }
+
+public:
+  // 构造、复制、移动、赋值函数
+  flat_map() = default;
+
+  explicit flat_map(const key_compare& comp)
+    :comp_(comp)
+  {
+  }
+
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  flat_map(InputIter first, InputIter last, const key_compare& comp = key_compare())
+    :comp_(comp)
+  {
+    insert(first, last);
+  }
+
+  flat_map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+    :comp_(comp)
+  {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  // 接管两个等长的数组，已经有序且不重复时只做一次 O(n) 的检查
+  flat_map(key_container_type keys, mapped_container_type values,
+           const key_compare& comp = key_compare())
+    :keys_(mystl::move(keys)), values_(mystl::move(values)), comp_(comp)
+  {
+    THROW_LENGTH_ERROR_IF(keys_.size() != values_.size(),
+                          "flat_map<Key, T>'s keys and values have different sizes");
+    sort_and_merge(0);
+  }
+
+  flat_map(const flat_map& rhs) = default;
+  flat_map(flat_map&& rhs) noexcept
+    :keys_(mystl::move(rhs.keys_)), values_(mystl::move(rhs.values_)), comp_(rhs.comp_)
+  {
+  }
+
+  flat_map& operator=(const flat_map& rhs) = default;
+  flat_map& operator=(flat_map&& rhs) noexcept
+  {
+    keys_ = mystl::move(rhs.keys_);
+    values_ = mystl::move(rhs.values_);
+    comp_ = rhs.comp_;
+    return *this;
+  }
+
+  flat_map& operator=(std::initializer_list<value_type> ilist)
+  {
+    flat_map tmp(ilist, comp_);
+    swap(tmp);
+    return *this;
+  }
+
+  ~flat_map() = default;
+
+  // 迭代器相关
+  iterator               begin()         noexcept
+  { return make_iterator(0); }
+  const_iterator         begin()   const noexcept
+  { return make_iterator(0); }
+  iterator               end()           noexcept
+  { return make_iterator(size()); }
+  const_iterator         end()     const noexcept
+  { return make_iterator(size()); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关
+  bool      empty()    const noexcept { return keys_.empty(); }
+  size_type size()     const noexcept { return keys_.size(); }
+  size_type max_size() const noexcept { return keys_.max_size(); }
+  size_type capacity() const noexcept { return keys_.capacity(); }
+
+  void      reserve(size_type n)
+  {
+    keys_.reserve(n);
+    values_.reserve(n);
+  }
+  void      shrink_to_fit()
+  {
+    keys_.shrink_to_fit();
+    values_.shrink_to_fit();
+  }
+
+  // 底层的两个数组，只读
+  const key_container_type&    keys()   const noexcept { return keys_; }
+  const mapped_container_type& values() const noexcept { return values_; }
+
+  // 访问元素相关
+
+  // 若键值不存在，at 会抛出一个异常
+  mapped_type&       at(const key_type& key)
+  {
+    const size_type i = find_index(key);
+    THROW_OUT_OF_RANGE_IF(i == size(), "flat_map<Key, T> no such element exists");
+    return values_[i];
+  }
+  const mapped_type& at(const key_type& key) const
+  {
+    const size_type i = find_index(key);
+    THROW_OUT_OF_RANGE_IF(i == size(), "flat_map<Key, T> no such element exists");
+    return values_[i];
+  }
+
+  mapped_type& operator[](const key_type& key)
+  { return values_[try_emplace_at(lower_index(key), key).first]; }
+  mapped_type& operator[](key_type&& key)
+  { return values_[try_emplace_at(lower_index(key), mystl::move(key)).first]; }
+
+  // 插入删除相关
+
+  // emplace / emplace_hint，先构造出 value_type 再插入
+  template <class ...Args>
+  mystl::pair<iterator, bool> emplace(Args&& ...args)
+  {
+    value_type value(mystl::forward<Args>(args)...);
+    return insert(mystl::move(value));
+  }
+
+  template <class ...Args>
+  iterator emplace_hint(const_iterator hint, Args&& ...args)
+  {
+    value_type value(mystl::forward<Args>(args)...);
+    return insert(hint, mystl::move(value));
+  }
+
+  // try_emplace，键不存在时才用 args 构造实值
+  template <class ...Args>
+  mystl::pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+  { return make_result(try_emplace_at(lower_index(key), key, mystl::forward<Args>(args)...)); }
+  template <class ...Args>
+  mystl::pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args)
+  {
+    const size_type pos = lower_index(key);
+    return make_result(try_emplace_at(pos, mystl::move(key), mystl::forward<Args>(args)...));
+  }
+
+  // hint 恰好是插入位置时不需要二分查找
+  template <class ...Args>
+  iterator try_emplace(const_iterator hint, const key_type& key, Args&& ...args)
+  {
+    const size_type pos = hint_index(hint, key);
+    return make_iterator(try_emplace_at(pos, key, mystl::forward<Args>(args)...).first);
+  }
+  template <class ...Args>
+  iterator try_emplace(const_iterator hint, key_type&& key, Args&& ...args)
+  {
+    const size_type pos = hint_index(hint, key);
+    return make_iterator(try_emplace_at(pos, mystl::move(key),
+                                        mystl::forward<Args>(args)...).first);
+  }
+
+  // insert
+  mystl::pair<iterator, bool> insert(const value_type& value)
+  { return try_emplace(value.first, value.second); }
+  mystl::pair<iterator, bool> insert(value_type&& value)
+  { return try_emplace(mystl::move(value.first), mystl::move(value.second)); }
+
+  iterator insert(const_iterator hint, const value_type& value)
+  { return try_emplace(hint, value.first, value.second); }
+  iterator insert(const_iterator hint, value_type&& value)
+  { return try_emplace(hint, mystl::move(value.first), mystl::move(value.second)); }
+
+  // 区间插入：追加到尾部后排序、归并、去重，而不是逐个插入搬移
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  void insert(InputIter first, InputIter last)
+  {
+    const size_type n = size();
+    try
+    {
+      for (; first != last; ++first)
+      {
+        keys_.emplace_back((*first).first);
+        values_.emplace_back((*first).second);
+      }
+    }
+    catch (...)
+    {
+      keys_.erase(keys_.begin() + n, keys_.end());
+      values_.erase(values_.begin() + n, values_.end());
+      throw;
+    }
+    sort_and_merge(n);
+  }
+  void insert(std::initializer_list<value_type> ilist)
+  { insert(ilist.begin(), ilist.end()); }
+
+  // insert_or_assign
+  template <class M>
+  mystl::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+  {
+    auto r = try_emplace_at(lower_index(key), key, mystl::forward<M>(obj));
+    if (!r.second)
+      values_[r.first] = mystl::forward<M>(obj);
+    return make_result(r);
+  }
+  template <class M>
+  mystl::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+  {
+    const size_type pos = lower_index(key);
+    auto r = try_emplace_at(pos, mystl::move(key), mystl::forward<M>(obj));
+    if (!r.second)
+      values_[r.first] = mystl::forward<M>(obj);
+    return make_result(r);
+  }
+
+  // erase / clear，删除后所有迭代器失效，erase 返回下一个元素的迭代器
+  iterator  erase(const_iterator position)
+  {
+    MYSTL_DEBUG(position != cend());
+    const size_type i = index_of(position);
+    keys_.erase(keys_.begin() + i);
+    values_.erase(values_.begin() + i);
+    return make_iterator(i);
+  }
+  iterator  erase(iterator position)
+  { return erase(const_iterator(position)); }
+  size_type erase(const key_type& key)
+  {
+    const size_type i = find_index(key);
+    if (i == size())
+      return 0;
+    keys_.erase(keys_.begin() + i);
+    values_.erase(values_.begin() + i);
+    return 1;
+  }
+  iterator  erase(const_iterator first, const_iterator last)
+  {
+    const size_type f = index_of(first);
+    const size_type l = index_of(last);
+    if (f == l)
+      return make_iterator(f);
+    keys_.erase(keys_.begin() + f, keys_.begin() + l);
+    values_.erase(values_.begin() + f, values_.begin() + l);
+    return make_iterator(f);
+  }
+
+  void      clear() noexcept
+  {
+    keys_.clear();
+    values_.clear();
+  }
+
+  void      swap(flat_map& rhs) noexcept
+  {
+    keys_.swap(rhs.keys_);
+    values_.swap(rhs.values_);
+    mystl::swap(comp_, rhs.comp_);
+  }
+
+  // flat_map 相关操作
+
+  iterator       find(const key_type& key)
+  { return make_iterator(find_index(key)); }
+  const_iterator find(const key_type& key) const
+  { return make_iterator(find_index(key)); }
+
+  size_type      count(const key_type& key) const
+  { return find_index(key) != size() ? 1 : 0; }
+  bool           contains(const key_type& key) const
+  { return find_index(key) != size(); }
+
+  iterator       lower_bound(const key_type& key)
+  { return make_iterator(lower_index(key)); }
+  const_iterator lower_bound(const key_type& key) const
+  { return make_iterator(lower_index(key)); }
+
+  iterator       upper_bound(const key_type& key)
+  { return make_iterator(upper_index(key)); }
+  const_iterator upper_bound(const key_type& key) const
+  { return make_iterator(upper_index(key)); }
+
+  mystl::pair<iterator, iterator>
+  equal_range(const key_type& key)
+  {
+    const size_type i = lower_index(key);
+    const size_type j = (i != size() && !comp_(key, keys_[i])) ? i + 1 : i;
+    return mystl::pair<iterator, iterator>(make_iterator(i), make_iterator(j));
+  }
+  mystl::pair<const_iterator, const_iterator>
+  equal_range(const key_type& key) const
+  {
+    const size_type i = lower_index(key);
+    const size_type j = (i != size() && !comp_(key, keys_[i])) ? i + 1 : i;
+    return mystl::pair<const_iterator, const_iterator>(make_iterator(i), make_iterator(j));
+  }
+
+public:
+  friend bool operator==(const flat_map& lhs, const flat_map& rhs)
+  { return lhs.keys_ == rhs.keys_ && lhs.values_ == rhs.values_; }
+  friend bool operator< (const flat_map& lhs, const flat_map& rhs)
+  {
+    return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+private:
+  // helper functions
+
+  iterator       make_iterator(size_type i) noexcept
+  { return iterator(keys_.data() + i, values_.data() + i); }
+  const_iterator make_iterator(size_type i) const noexcept
+  { return const_iterator(keys_.data() + i, values_.data() + i); }
+
+  size_type index_of(const_iterator it) const noexcept
+  { return static_cast<size_type>(it.key - keys_.data()); }
+
+  mystl::pair<iterator, bool> make_result(const mystl::pair<size_type, bool>& r)
+  { return mystl::pair<iterator, bool>(make_iterator(r.first), r.second); }
+
+  size_type lower_index(const key_type& key) const
+  {
+    return static_cast<size_type>(
+      mystl::lower_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+  }
+  size_type upper_index(const key_type& key) const
+  {
+    return static_cast<size_type>(
+      mystl::upper_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+  }
+  // 找不到时返回 size()
+  size_type find_index(const key_type& key) const
+  {
+    const size_type i = lower_index(key);
+    return (i != size() && !comp_(key, keys_[i])) ? i : size();
+  }
+
+  // hint 满足 prev < key < *hint 时直接使用，否则退回二分查找
+  size_type hint_index(const_iterator hint, const key_type& key) const
+  {
+    const size_type h = index_of(hint);
+    if ((h == 0 || comp_(keys_[h - 1], key)) && (h == size() || !comp_(keys_[h], key)))
+      return h;
+    return lower_index(key);
+  }
+
+  // pos 为 key 的 lower_bound，返回元素的下标以及是否插入
+  template <class K, class ...Args>
+  mystl::pair<size_type, bool> try_emplace_at(size_type pos, K&& key, Args&& ...args)
+  {
+    if (pos != size() && !comp_(key, keys_[pos]))
+      return mystl::pair<size_type, bool>(pos, false);
+    auto it = keys_.emplace(keys_.begin() + pos, mystl::forward<K>(key));
+    try
+    {
+      values_.emplace(values_.begin() + pos, mystl::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      keys_.erase(it);
+      throw;
+    }
+    return mystl::pair<size_type, bool>(pos, true);
+  }
+
+  void sort_and_merge(size_type n);
+  void sort_tail(size_type n);
+  void unique_tail(size_type n);
+  void merge_tail(size_type n);
+};
+
+/*****************************************************************************************/
+
+// [0, n) 为原有的有序部分，[n, size()) 为新追加的部分
+// 依次把尾部排序、去掉尾部重复的键与已存在于前部的键，再与前部归并
+template <class Key, class T, class Compare>
+void flat_map<Key, T, Compare>::
+sort_and_merge(size_type n)
+{
+  if (n == size())
+    return;
+  try
+  {
+    sort_tail(n);
+    unique_tail(n);
+    // 尾部整体大于前部时 (例如按序追加) 不需要归并
+    if (n != 0 && n != size() && comp_(keys_[n], keys_[n - 1]))
+      merge_tail(n);
+  }
+  catch (...)
+  {
+    clear();
+    throw;
+  }
+}
+
+// 稳定地排序尾部：对下标排序，键相等时按下标，再按下标把键与实值一起搬到位
+template <class Key, class T, class Compare>
+void flat_map<Key, T, Compare>::
+sort_tail(size_type n)
+{
+  const key_type* k = keys_.data() + n;
+  const size_type m = size() - n;
+  if (mystl::is_sorted(k, k + m, comp_))
+    return;
+  mystl::vector<size_type> index(m);
+  for (size_type i = 0; i < m; ++i)
+    index[i] = i;
+  const key_compare& comp = comp_;
+  mystl::sort(index.begin(), index.end(), [k, &comp](size_type a, size_type b)
+  {
+    return comp(k[a], k[b]) || (!comp(k[b], k[a]) && a < b);
+  });
+
+  key_container_type    tk;
+  mapped_container_type tv;
+  tk.reserve(m);
+  tv.reserve(m);
+  for (size_type i = 0; i < m; ++i)
+  {
+    tk.emplace_back(mystl::move(keys_[n + index[i]]));
+    tv.emplace_back(mystl::move(values_[n + index[i]]));
+  }
+  for (size_type i = 0; i < m; ++i)
+  {
+    keys_[n + i] = mystl::move(tk[i]);
+    values_[n + i] = mystl::move(tv[i]);
+  }
+}
+
+// 有序的尾部中相等的键只保留第一个，前部已经存在的键也去掉，在原地压缩
+template <class Key, class T, class Compare>
+void flat_map<Key, T, Compare>::
+unique_tail(size_type n)
+{
+  const size_type len = size();
+  size_type out = n;
+  size_type from = 0;  // 尾部有序，前部的查找起点单调不减
+  for (size_type i = n; i < len; ++i)
+  {
+    if (out != n && !comp_(keys_[out - 1], keys_[i]))
+      continue;
+    if (n != 0 && !comp_(keys_[n - 1], keys_[i]))
+    {
+      from = static_cast<size_type>(mystl::lower_bound(keys_.begin() + from, keys_.begin() + n,
+                                                       keys_[i], comp_) - keys_.begin());
+      if (!comp_(keys_[i], keys_[from]))
+        continue;
+    }
+    if (out != i)
+    {
+      keys_[out] = mystl::move(keys_[i]);
+      values_[out] = mystl::move(values_[i]);
+    }
+    ++out;
+  }
+  keys_.erase(keys_.begin() + out, keys_.end());
+  values_.erase(values_.begin() + out, values_.end());
+}
+
+// 两部分有序且互不重复，把尾部移到临时数组，再从后向前归并，只需要尾部大小的额外空间
+template <class Key, class T, class Compare>
+void flat_map<Key, T, Compare>::
+merge_tail(size_type n)
+{
+  const size_type m = size() - n;
+  key_container_type    tk;
+  mapped_container_type tv;
+  tk.reserve(m);
+  tv.reserve(m);
+  for (size_type i = n; i < n + m; ++i)
+  {
+    tk.emplace_back(mystl::move(keys_[i]));
+    tv.emplace_back(mystl::move(values_[i]));
+  }
+  size_type i = n;      // 前部待归并的元素个数
+  size_type j = m;      // 尾部待归并的元素个数
+  size_type out = n + m;
+  while (j != 0)
+  {
+    --out;
+    if (i != 0 && comp_(tk[j - 1], keys_[i - 1]))
+    {
+      --i;
+      keys_[out] = mystl::move(keys_[i]);
+      values_[out] = mystl::move(values_[i]);
+    }
+    else
+    {
+      --j;
+      keys_[out] = mystl::move(tk[j]);
+      values_[out] = mystl::move(tv[j]);
+    }
+  }
+}
+
+/*****************************************************************************************/
+
+// 重载比较操作符
+template <class Key, class T, class Compare>
+bool operator!=(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class Key, class T, class Compare>
+bool operator<=(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>=(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class Key, class T, class Compare>
+void swap(flat_map<Key, T, Compare>& lhs, flat_map<Key, T, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_FLAT_MAP_H_
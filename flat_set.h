@@ -0,0 +1,342 @@
+#ifndef TINYSTL_FLAT_SET_H_
+#define TINYSTL_FLAT_SET_H_
+
+// 这个头文件包含一个模板类 flat_set
+// flat_set : 集合，元素按键值有序排列，键值不允许重复，底层为一个有序的 mystl::vector
+// 查找在连续数组上二分，遍历就是数组的顺序访问
+// 单个插入、删除要搬移其后的元素，为 O(n)；区间插入先追加到尾部，再排序、归并、去重，
+// 为 O(n + m log m)，适合读多写少、规模中小而频繁遍历的集合
+// 插入、删除会使所有迭代器与引用失效
+
+// 异常保证：
+// 元素的移动构造不抛出异常时，mystl::flat_set<Key> 对单个元素的 insert / emplace 做强异常安全保证；
+// 区间插入在追加阶段抛出异常时恢复原状，排序、归并阶段抛出异常时容器被清空
+
+#include <initializer_list>
+
+#include "algo.h"
+#include "functional.h"
+#include "vector.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 模板类 flat_set
+// 参数一代表键值类型，参数二代表键值比较方式，缺省使用 mystl::less
+template <class Key, class Compare = mystl::less<Key>>
+class flat_set
+{
+public:
+  // flat_set 的型别定义，元素不能修改，iterator 与 const_iterator 相同
+  typedef Key                       key_type;
+  typedef Key                       value_type;
+  typedef Compare                   key_compare;
+  typedef Compare                   value_compare;
+  typedef mystl::vector<Key>        container_type;
+
+  typedef const Key*                pointer;
+  typedef const Key*                const_pointer;
+  typedef const Key&                reference;
+  typedef const Key&                const_reference;
+  typedef size_t                    size_type;
+  typedef ptrdiff_t                 difference_type;
+
+  typedef typename container_type::const_iterator          iterator;
+  typedef typename container_type::const_iterator          const_iterator;
+  typedef typename container_type::const_reverse_iterator  reverse_iterator;
+  typedef typename container_type::const_reverse_iterator  const_reverse_iterator;
+
+private:
+  container_type keys_;  // 有序的元素
+  key_compare    comp_;
+
+public:
+  key_compare   key_comp()   const { return comp_; }
+  value_compare value_comp() const { return comp_; }
+
+public:
+  // 构造、复制、移动、赋值函数
+  flat_set() = default;
+
+  explicit flat_set(const key_compare& comp)
+    :comp_(comp)
+  {
+  }
+
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  flat_set(InputIter first, InputIter last, const key_compare& comp = key_compare())
+    :comp_(comp)
+  {
+    insert(first, last);
+  }
+
+  flat_set(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+    :comp_(comp)
+  {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  // 接管一个数组，已经有序且不重复时只做一次 O(n) 的检查
+  explicit flat_set(container_type keys, const key_compare& comp = key_compare())
+    :keys_(mystl::move(keys)), comp_(comp)
+  {
+    sort_and_merge(0);
+  }
+
+  flat_set(const flat_set& rhs) = default;
+  flat_set(flat_set&& rhs) noexcept
+    :keys_(mystl::move(rhs.keys_)), comp_(rhs.comp_)
+  {
+  }
+
+  flat_set& operator=(const flat_set& rhs) = default;
+  flat_set& operator=(flat_set&& rhs) noexcept
+  {
+    keys_ = mystl::move(rhs.keys_);
+    comp_ = rhs.comp_;
+    return *this;
+  }
+
+  flat_set& operator=(std::initializer_list<value_type> ilist)
+  {
+    flat_set tmp(ilist, comp_);
+    swap(tmp);
+    return *this;
+  }
+
+  ~flat_set() = default;
+
+  // 迭代器相关
+  iterator               begin()   const noexcept
+  { return keys_.begin(); }
+  iterator               end()     const noexcept
+  { return keys_.end(); }
+  reverse_iterator       rbegin()  const noexcept
+  { return keys_.rbegin(); }
+  reverse_iterator       rend()    const noexcept
+  { return keys_.rend(); }
+
+  const_iterator         cbegin()  const noexcept
+  { return keys_.cbegin(); }
+  const_iterator         cend()    const noexcept
+  { return keys_.cend(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return keys_.crbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return keys_.crend(); }
+
+  // 容量相关
+  bool      empty()    const noexcept { return keys_.empty(); }
+  size_type size()     const noexcept { return keys_.size(); }
+  size_type max_size() const noexcept { return keys_.max_size(); }
+  size_type capacity() const noexcept { return keys_.capacity(); }
+
+  void      reserve(size_type n) { keys_.reserve(n); }
+  void      shrink_to_fit()      { keys_.shrink_to_fit(); }
+
+  // 底层的数组，只读
+  const container_type& keys() const noexcept { return keys_; }
+
+  // 插入删除操作
+
+  // emplace / emplace_hint，先构造出元素再插入
+  template <class ...Args>
+  mystl::pair<iterator, bool> emplace(Args&& ...args)
+  {
+    value_type value(mystl::forward<Args>(args)...);
+    return insert(mystl::move(value));
+  }
+
+  template <class ...Args>
+  iterator emplace_hint(const_iterator hint, Args&& ...args)
+  {
+    value_type value(mystl::forward<Args>(args)...);
+    return insert(hint, mystl::move(value));
+  }
+
+  // insert
+  mystl::pair<iterator, bool> insert(const value_type& value)
+  { return insert_at(lower_bound(value), value); }
+  mystl::pair<iterator, bool> insert(value_type&& value)
+  { return insert_at(lower_bound(value), mystl::move(value)); }
+
+  // hint 恰好是插入位置时不需要二分查找
+  iterator insert(const_iterator hint, const value_type& value)
+  { return insert_at(hint_position(hint, value), value).first; }
+  iterator insert(const_iterator hint, value_type&& value)
+  { return insert_at(hint_position(hint, value), mystl::move(value)).first; }
+
+  // 区间插入：追加到尾部后排序、归并、去重，而不是逐个插入搬移
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  void insert(InputIter first, InputIter last)
+  {
+    const size_type n = size();
+    try
+    {
+      for (; first != last; ++first)
+        keys_.emplace_back(*first);
+    }
+    catch (...)
+    {
+      keys_.erase(keys_.begin() + n, keys_.end());
+      throw;
+    }
+    sort_and_merge(n);
+  }
+  void insert(std::initializer_list<value_type> ilist)
+  { insert(ilist.begin(), ilist.end()); }
+
+  // erase / clear，删除后所有迭代器失效，erase 返回下一个元素的迭代器
+  iterator  erase(const_iterator position)
+  {
+    MYSTL_DEBUG(position != cend());
+    return keys_.erase(position);
+  }
+  size_type erase(const key_type& key)
+  {
+    const_iterator it = find(key);
+    if (it == end())
+      return 0;
+    keys_.erase(it);
+    return 1;
+  }
+  iterator  erase(const_iterator first, const_iterator last)
+  { return first == last ? first : keys_.erase(first, last); }
+
+  void      clear() noexcept
+  { keys_.clear(); }
+
+  void      swap(flat_set& rhs) noexcept
+  {
+    keys_.swap(rhs.keys_);
+    mystl::swap(comp_, rhs.comp_);
+  }
+
+  // flat_set 相关操作
+
+  iterator       find(const key_type& key) const
+  {
+    const_iterator it = lower_bound(key);
+    return (it != end() && !comp_(key, *it)) ? it : end();
+  }
+
+  size_type      count(const key_type& key) const
+  { return find(key) != end() ? 1 : 0; }
+  bool           contains(const key_type& key) const
+  { return find(key) != end(); }
+
+  iterator       lower_bound(const key_type& key) const
+  { return mystl::lower_bound(keys_.begin(), keys_.end(), key, comp_); }
+  iterator       upper_bound(const key_type& key) const
+  { return mystl::upper_bound(keys_.begin(), keys_.end(), key, comp_); }
+
+  mystl::pair<iterator, iterator>
+  equal_range(const key_type& key) const
+  {
+    const_iterator it = lower_bound(key);
+    const_iterator next = (it != end() && !comp_(key, *it)) ? it + 1 : it;
+    return mystl::pair<iterator, iterator>(it, next);
+  }
+
+public:
+  friend bool operator==(const flat_set& lhs, const flat_set& rhs)
+  { return lhs.keys_ == rhs.keys_; }
+  friend bool operator< (const flat_set& lhs, const flat_set& rhs)
+  { return lhs.keys_ <  rhs.keys_; }
+
+private:
+  // helper functions
+
+  // hint 满足 prev < value <= *hint 时直接使用，否则退回二分查找
+  const_iterator hint_position(const_iterator hint, const value_type& value) const
+  {
+    if ((hint == begin() || comp_(*(hint - 1), value)) && (hint == end() || !comp_(*hint, value)))
+      return hint;
+    return lower_bound(value);
+  }
+
+  // pos 为 value 的 lower_bound
+  template <class V>
+  mystl::pair<iterator, bool> insert_at(const_iterator pos, V&& value)
+  {
+    if (pos != end() && !comp_(value, *pos))
+      return mystl::pair<iterator, bool>(pos, false);
+    return mystl::pair<iterator, bool>(keys_.insert(pos, mystl::forward<V>(value)), true);
+  }
+
+  void sort_and_merge(size_type n);
+};
+
+/*****************************************************************************************/
+
+// [0, n) 为原有的有序部分，[n, size()) 为新追加的部分
+// 把尾部排序后与前部归并，归并是稳定的，再去重时保留靠前的一个，因此已存在的元素不会被替换
+template <class Key, class Compare>
+void flat_set<Key, Compare>::
+sort_and_merge(size_type n)
+{
+  if (n == size())
+    return;
+  auto first = keys_.begin();
+  auto middle = first + n;
+  auto last = keys_.end();
+  try
+  {
+    if (!mystl::is_sorted(middle, last, comp_))
+      mystl::sort(middle, last, comp_);
+    // 尾部整体大于前部时 (例如按序追加) 不需要归并，只对尾部去重
+    if (n != 0 && comp_(*middle, *(middle - 1)))
+      mystl::inplace_merge(first, middle, last, comp_);
+    else if (n != 0)
+      first = middle - 1;
+    const key_compare& comp = comp_;
+    auto new_last = mystl::unique(first, last, [&comp](const Key& a, const Key& b)
+    {
+      return !comp(a, b);
+    });
+    keys_.erase(new_last, last);
+  }
+  catch (...)
+  {
+    clear();
+    throw;
+  }
+}
+
+// 重载比较操作符
+template <class Key, class Compare>
+bool operator!=(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class Key, class Compare>
+bool operator>(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class Key, class Compare>
+bool operator<=(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class Key, class Compare>
+bool operator>=(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class Key, class Compare>
+void swap(flat_set<Key, Compare>& lhs, flat_set<Key, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_FLAT_SET_H_
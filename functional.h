@@ -2,6 +2,20 @@
 #define TINYSTL_FUNCTIONAL_H_
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MYSTL_HAS_SSE2 1
+#else
+#define MYSTL_HAS_SSE2 0
+#endif
+
+#include "type_traits.h"
+#include "utils.h"
 
 //仿函数的定义
 //仿函数是一种有函数性质的对象
@@ -189,6 +203,372 @@ struct projectsecond :public binary_function<Arg1, Arg2, Arg1>
 {
   Arg2 operator()(const Arg1&, const Arg2& y) const { return y; }
 };
+/*****************************************************************************************/
+// 哈希函数对象
+// hash_mix   : 整数混合函数，一次 64x64->128 位乘法后把高低两半异或 (multiply-xorshift)
+// hash_bytes : 字节序列的哈希，短键按 wyhash 的方式处理，长键先用 8 路 64 位累加器按 64 字节一条
+//              做 xxh3 风格的乘加 (有 SSE2 时一次处理两路)，剩余部分再走短键的路径
+// 结果与平台的字节序和 size_t 宽度有关，不要持久化
+//
+// 所有的 hash 特化都定义了 is_avalanching，表示输出的每一位都已充分混合，
+// 哈希表见到它时不再对哈希值做额外的混合
+/*****************************************************************************************/
+namespace hash_detail
+{
+
+// 64x64->128 位乘法，返回高低两半
+inline void mum(uint64_t& a, uint64_t& b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+  const __uint128_t r = static_cast<__uint128_t>(a) * b;
+  a = static_cast<uint64_t>(r);
+  b = static_cast<uint64_t>(r >> 64);
+#else
+  const uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+  const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  const uint64_t t = rl + (rm0 << 32);
+  uint64_t c = t < rl;
+  const uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+  a = lo;
+#endif
+}
+
+inline uint64_t mix(uint64_t a, uint64_t b) noexcept
+{
+  mum(a, b);
+  return a ^ b;
+}
+
+inline uint64_t read8(const unsigned char* p) noexcept
+{
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t read4(const unsigned char* p) noexcept
+{
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+// 1 到 3 个字节
+inline uint64_t read3(const unsigned char* p, size_t k) noexcept
+{
+  return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+constexpr uint64_t secret[4] = {
+  0x2D358DCCAA6C78A5ULL, 0x8BB84B93962EACC9ULL, 0x4B33A62ED433D4A3ULL, 0x4D5A2DA51DE1AA47ULL };
+
+// 长键路径使用的密钥 : 第 j 条(块内)使用 bulk_secret[j, j + 8)，每块结束时用 bulk_secret[8, 16) 扰动
+constexpr uint64_t bulk_secret[16] = {
+  0x1AC046DDA8E86E2AULL, 0xBE2C3B00B1D348C8ULL, 0x9B1A66A95412FF75ULL, 0xC448C2B1F05F7E4CULL,
+  0xC111CA6B8F6E73C4ULL, 0xB54861920D05B01DULL, 0x8D61500F4A7BBE16ULL, 0x5E0C25471F89E02EULL,
+  0x48105A3D28F0E221ULL, 0x2169F8846B637746ULL, 0x3D628782E0C0D863ULL, 0xA5DDB2216078AA40ULL,
+  0xC8119D17F0571101ULL, 0x98E2E2EB8F33280FULL, 0x8CD1E28860679CC4ULL, 0x9DCA6189C923AEF3ULL };
+
+constexpr size_t   stripe_len        = 64;    // 一条的字节数
+constexpr size_t   stripes_per_block = 8;     // 每块的条数，块结束时扰动累加器
+constexpr size_t   bulk_threshold    = 1024;  // 不短于此长度的键走长键路径
+constexpr uint64_t prime32           = 0x9E3779B1ULL;
+
+#if MYSTL_HAS_SSE2
+
+// 一条 : acc[i] += data[i ^ 1] + lo32(d) * hi32(d)，其中 d = data[i] ^ key[i]
+inline void accumulate_stripe(uint64_t* acc, const unsigned char* p, const uint64_t* key) noexcept
+{
+  for (size_t i = 0; i < 8; i += 2)
+  {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i));
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 8));
+    const __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + i));
+    const __m128i dk = _mm_xor_si128(data, k);
+    const __m128i product = _mm_mul_epu32(dk, _mm_srli_epi64(dk, 32));
+    a = _mm_add_epi64(a, _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2)));
+    a = _mm_add_epi64(a, product);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + i), a);
+  }
+}
+
+// 扰动 : acc[i] = ((acc[i] ^ (acc[i] >> 47)) ^ key[i]) * prime32
+inline void scramble(uint64_t* acc, const uint64_t* key) noexcept
+{
+  const __m128i prime = _mm_set1_epi32(static_cast<int>(prime32));
+  for (size_t i = 0; i < 8; i += 2)
+  {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i));
+    const __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + i));
+    a = _mm_xor_si128(_mm_xor_si128(a, _mm_srli_epi64(a, 47)), k);
+    const __m128i lo = _mm_mul_epu32(a, prime);
+    const __m128i hi = _mm_mul_epu32(_mm_srli_epi64(a, 32), prime);
+    a = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + i), a);
+  }
+}
+
+#else
+
+inline void accumulate_stripe(uint64_t* acc, const unsigned char* p, const uint64_t* key) noexcept
+{
+  uint64_t data[8];
+  for (size_t i = 0; i < 8; ++i)
+    data[i] = read8(p + i * 8);
+  for (size_t i = 0; i < 8; ++i)
+  {
+    const uint64_t dk = data[i] ^ key[i];
+    acc[i] += data[i ^ 1] + (dk & 0xFFFFFFFFULL) * (dk >> 32);
+  }
+}
+
+inline void scramble(uint64_t* acc, const uint64_t* key) noexcept
+{
+  for (size_t i = 0; i < 8; ++i)
+    acc[i] = ((acc[i] ^ (acc[i] >> 47)) ^ key[i]) * prime32;
+}
+
+#endif
+
+// 长键 : 处理所有完整的条，返回合并后的种子，并把 p / len 推进到剩余部分
+inline uint64_t hash_bulk(const unsigned char*& p, size_t& len, uint64_t seed) noexcept
+{
+  uint64_t acc[8] = {
+    seed ^ bulk_secret[0], seed + bulk_secret[1], seed ^ bulk_secret[2], seed + bulk_secret[3],
+    seed ^ bulk_secret[4], seed + bulk_secret[5], seed ^ bulk_secret[6], seed + bulk_secret[7] };
+  const size_t block_len = stripe_len * stripes_per_block;
+  while (len >= block_len)
+  {
+    for (size_t j = 0; j < stripes_per_block; ++j)
+      accumulate_stripe(acc, p + j * stripe_len, bulk_secret + j);
+    scramble(acc, bulk_secret + 8);
+    p += block_len;
+    len -= block_len;
+  }
+  for (size_t j = 0; len >= stripe_len; ++j)
+  {
+    accumulate_stripe(acc, p, bulk_secret + j);
+    p += stripe_len;
+    len -= stripe_len;
+  }
+  uint64_t result = seed;
+  for (size_t i = 0; i < 8; i += 2)
+    result += mix(acc[i] ^ bulk_secret[i + 8], acc[i + 1] ^ bulk_secret[i + 9]);
+  return result;
+}
+
+} // namespace hash_detail
+
+// 整数混合函数
+inline size_t hash_mix(uint64_t x) noexcept
+{
+  return static_cast<size_t>(hash_detail::mix(x ^ hash_detail::secret[0], hash_detail::secret[1]));
+}
+
+// 字节序列 [data, data + len) 的哈希
+inline size_t hash_bytes(const void* data, size_t len, uint64_t seed = 0) noexcept
+{
+  using namespace hash_detail;
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  const uint64_t total = len;
+  seed ^= mix(seed ^ secret[0], secret[1]);
+  if (len >= bulk_threshold)
+    seed = hash_bulk(p, len, seed);
+  uint64_t a, b;
+  if (len <= 16)
+  {
+    if (len >= 4)
+    {
+      a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+      b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+    }
+    else if (len > 0)
+    {
+      a = read3(p, len);
+      b = 0;
+    }
+    else
+    {
+      a = b = 0;
+    }
+  }
+  else
+  {
+    size_t i = len;
+    if (i >= 48)
+    {
+      uint64_t see1 = seed, see2 = seed;
+      do
+      {
+        seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+        see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+        see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i >= 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16)
+    {
+      seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    // 不足 16 字节时向前借用已经处理过的字节，长键路径保证前面至少还有一条
+    a = read8(p + i - 16);
+    b = read8(p + i - 8);
+  }
+  a ^= secret[1];
+  b ^= seed;
+  mum(a, b);
+  return static_cast<size_t>(mix(a ^ secret[0] ^ total, b ^ secret[1]));
+}
+
+// 对于大部分类型，hash 什么都不做
+template <class Key>
+struct hash {};
+
+// 针对指针的偏特化版本
+template <class T>
+struct hash<T*>
+{
+  typedef void is_avalanching;
+  size_t operator()(T* p) const noexcept
+  { return mystl::hash_mix(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p))); }
+};
+
+// 对于整型类型，混合后返回
+#define MYSTL_INTEGER_HASH_FCN(Type)                                                \
+template <> struct hash<Type>                                                       \
+{                                                                                   \
+  typedef void is_avalanching;                                                      \
+  size_t operator()(Type val) const noexcept                                        \
+  { return mystl::hash_mix(static_cast<uint64_t>(val)); }                           \
+};
+
+MYSTL_INTEGER_HASH_FCN(bool)
+
+MYSTL_INTEGER_HASH_FCN(char)
+
+MYSTL_INTEGER_HASH_FCN(signed char)
+
+MYSTL_INTEGER_HASH_FCN(unsigned char)
+
+MYSTL_INTEGER_HASH_FCN(wchar_t)
+
+MYSTL_INTEGER_HASH_FCN(char16_t)
+
+MYSTL_INTEGER_HASH_FCN(char32_t)
+
+MYSTL_INTEGER_HASH_FCN(short)
+
+MYSTL_INTEGER_HASH_FCN(unsigned short)
+
+MYSTL_INTEGER_HASH_FCN(int)
+
+MYSTL_INTEGER_HASH_FCN(unsigned int)
+
+MYSTL_INTEGER_HASH_FCN(long)
+
+MYSTL_INTEGER_HASH_FCN(unsigned long)
+
+MYSTL_INTEGER_HASH_FCN(long long)
+
+MYSTL_INTEGER_HASH_FCN(unsigned long long)
+
+#undef MYSTL_INTEGER_HASH_FCN
+
+// 对于浮点数，+0 与 -0 的哈希值相同，其余按位表示混合
+template <>
+struct hash<float>
+{
+  typedef void is_avalanching;
+  size_t operator()(const float& val) const noexcept
+  {
+    if (val == 0.0f)
+      return mystl::hash_mix(0);
+    uint32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    return mystl::hash_mix(bits);
+  }
+};
+
+template <>
+struct hash<double>
+{
+  typedef void is_avalanching;
+  size_t operator()(const double& val) const noexcept
+  {
+    if (val == 0.0)
+      return mystl::hash_mix(0);
+    uint64_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    return mystl::hash_mix(bits);
+  }
+};
+
+// long double 的存储可能含有填充字节，拆成尾数与指数分别计算
+template <>
+struct hash<long double>
+{
+  typedef void is_avalanching;
+  size_t operator()(const long double& val) const noexcept
+  {
+    if (val == 0.0L)
+      return mystl::hash_mix(0);
+    int exp = 0;
+    const double mantissa = static_cast<double>(std::frexp(val, &exp));
+    uint64_t bits;
+    std::memcpy(&bits, &mantissa, sizeof(bits));
+    return mystl::hash_mix(bits ^ (static_cast<uint64_t>(static_cast<unsigned>(exp)) << 52));
+  }
+};
+
+// 字符串按字节序列计算
+template <class CharT, class Traits, class Alloc>
+struct hash<std::basic_string<CharT, Traits, Alloc>>
+{
+  typedef void is_avalanching;
+  size_t operator()(const std::basic_string<CharT, Traits, Alloc>& s) const noexcept
+  { return mystl::hash_bytes(s.data(), s.size() * sizeof(CharT)); }
+};
+
+// hash_combine，把 value 的哈希值合并进 seed
+// seed 与 value 的哈希值与不同的密钥异或后再相乘，两者不对称，pair(a, b) 与 pair(b, a) 的哈希值不同
+template <class T>
+void hash_combine(size_t& seed, const T& value)
+{
+  seed = static_cast<size_t>(hash_detail::mix(
+    static_cast<uint64_t>(seed) ^ hash_detail::secret[2],
+    static_cast<uint64_t>(mystl::hash<T>()(value)) ^ hash_detail::secret[3]));
+}
+
+// 针对 pair 的偏特化版本
+template <class T1, class T2>
+struct hash<mystl::pair<T1, T2>>
+{
+  typedef void is_avalanching;
+  size_t operator()(const mystl::pair<T1, T2>& p) const
+  {
+    size_t seed = mystl::hash<T1>()(p.first);
+    mystl::hash_combine(seed, p.second);
+    return seed;
+  }
+};
+
+// 判断哈希函数对象是否声明了 is_avalanching
+template <class T>
+struct hash_void { typedef void type; };
+
+template <class Hash, class = void>
+struct hash_is_avalanching : m_false_type {};
+
+template <class Hash>
+struct hash_is_avalanching<Hash, typename mystl::hash_void<typename Hash::is_avalanching>::type>
+  : m_true_type {};
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,837 @@
+#ifndef TINYSTL_HASHTABLE_H_
+#define TINYSTL_HASHTABLE_H_
+
+// 这个头文件包含了一个模板类 hashtable
+// hashtable : 分离链接法的哈希表，作为 unordered_map / unordered_set 的底层实现
+//
+// 每个元素单独存放在一个节点上，节点由 pool_allocator 分配，插入、删除与重新散列都不移动元素，
+// 指向元素的指针与引用在元素被删除之前一直有效，迭代器在重新散列后失效
+// 桶数组是一个 mystl::vector，长度为 2 的幂，用哈希值的低位选桶，每个桶是一条单向链表
+// 节点中保存了元素的哈希值：重新散列时不再计算键的哈希，查找时先比较哈希值再比较键，
+// 迭代器走完一个桶后也由它找到下一个桶
+// 哈希函数对象没有声明 is_avalanching 时，先用 hash_mix 混合一次，保证低位均匀
+//
+// 节点可以用 extract 取出，再 insert 到另一个同类型的容器中，元素既不复制也不移动
+
+// 异常保证：
+// insert / emplace / try_emplace 做强异常安全保证，重新散列只分配桶数组，不调用哈希函数
+
+#include <cmath>
+#include <initializer_list>
+
+#include "concurrency.h"
+#include "functional.h"
+#include "iterator.h"
+#include "node_handle.h"
+#include "pool_allocator.h"
+#include "type_traits.h"
+#include "utils.h"
+#include "vector.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// hashtable 的节点
+template <class T>
+struct hashtable_node
+{
+  typedef T       value_type;
+
+  hashtable_node* next;   // 同一个桶中的下一个节点
+  size_t          hash;   // 元素的哈希值
+  T               value;  // 元素
+
+  template <class ...Args>
+  explicit hashtable_node(Args&& ...args)
+    :next(nullptr), hash(0), value(mystl::forward<Args>(args)...)
+  {
+  }
+};
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual> class hashtable;
+
+// hashtable 的迭代器设计，保存当前节点与桶数组，走完一个桶后顺序查找下一个非空的桶
+template <class T, class Ref, class Ptr>
+struct hashtable_iterator : public iterator<forward_iterator_tag, T>
+{
+  typedef hashtable_iterator<T, T&, T*>             iterator;
+  typedef hashtable_iterator<T, const T&, const T*> const_iterator;
+  typedef hashtable_iterator                        self;
+
+  typedef hashtable_node<T>*  node_ptr;
+
+  typedef T          value_type;
+  typedef Ptr        pointer;
+  typedef Ref        reference;
+  typedef size_t     size_type;
+  typedef ptrdiff_t  difference_type;
+
+  node_ptr        node;     // 当前节点，end 时为空
+  const node_ptr* buckets;  // 桶数组
+  size_type       mask;     // 桶的个数减一
+
+  // 构造、复制函数
+  hashtable_iterator() noexcept
+    :node(nullptr), buckets(nullptr), mask(0) {}
+
+  hashtable_iterator(node_ptr n, const node_ptr* b, size_type m) noexcept
+    :node(n), buckets(b), mask(m) {}
+
+  hashtable_iterator(const iterator& rhs) noexcept
+    :node(rhs.node), buckets(rhs.buckets), mask(rhs.mask) {}
+
+  self& operator=(const iterator& rhs) noexcept
+  {
+    node = rhs.node;
+    buckets = rhs.buckets;
+    mask = rhs.mask;
+    return *this;
+  }
+
+  // 重载运算符
+  reference operator*()  const { return node->value; }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    MYSTL_DEBUG(node != nullptr);
+    const size_type bucket = node->hash & mask;
+    node = node->next;
+    if (node == nullptr)
+    {
+      for (size_type i = bucket + 1; i <= mask; ++i)
+      {
+        if (buckets[i] != nullptr)
+        {
+          node = buckets[i];
+          break;
+        }
+      }
+    }
+    return *this;
+  }
+  self  operator++(int)
+  {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  // 重载比较操作符
+  bool operator==(const self& rhs) const { return node == rhs.node; }
+  bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+// 桶内的迭代器，只沿着一个桶的链表前进
+template <class T, class Ref, class Ptr>
+struct hashtable_local_iterator : public iterator<forward_iterator_tag, T>
+{
+  typedef hashtable_local_iterator<T, T&, T*>             iterator;
+  typedef hashtable_local_iterator<T, const T&, const T*> const_iterator;
+  typedef hashtable_local_iterator                        self;
+
+  typedef hashtable_node<T>*  node_ptr;
+
+  typedef T          value_type;
+  typedef Ptr        pointer;
+  typedef Ref        reference;
+  typedef size_t     size_type;
+  typedef ptrdiff_t  difference_type;
+
+  node_ptr node;
+
+  hashtable_local_iterator() noexcept
+    :node(nullptr) {}
+
+  explicit hashtable_local_iterator(node_ptr n) noexcept
+    :node(n) {}
+
+  hashtable_local_iterator(const iterator& rhs) noexcept
+    :node(rhs.node) {}
+
+  self& operator=(const iterator& rhs) noexcept
+  {
+    node = rhs.node;
+    return *this;
+  }
+
+  reference operator*()  const { return node->value; }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    MYSTL_DEBUG(node != nullptr);
+    node = node->next;
+    return *this;
+  }
+  self  operator++(int)
+  {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  bool operator==(const self& rhs) const { return node == rhs.node; }
+  bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+// 模板类 hashtable
+// 参数一代表元素类型，参数二代表键值类型，参数三代表从元素中取出键值的函数对象，
+// 参数四代表哈希函数，参数五代表键值的相等比较，键值不允许重复
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+class hashtable
+{
+public:
+  // hashtable 的型别定义
+  typedef Key                                         key_type;
+  typedef Value                                       value_type;
+  typedef Hash                                        hasher;
+  typedef KeyEqual                                    key_equal;
+
+  typedef hashtable_node<Value>                       node;
+  typedef node*                                       node_ptr;
+  typedef mystl::pool_allocator<node>                 node_allocator;
+  typedef mystl::vector<node_ptr>                     bucket_type;
+
+  typedef mystl::allocator<Value>                     allocator_type;
+  typedef typename allocator_type::pointer            pointer;
+  typedef typename allocator_type::const_pointer      const_pointer;
+  typedef typename allocator_type::reference          reference;
+  typedef typename allocator_type::const_reference    const_reference;
+  typedef typename allocator_type::size_type          size_type;
+  typedef typename allocator_type::difference_type    difference_type;
+
+  typedef hashtable_iterator<Value, Value&, Value*>                   iterator;
+  typedef hashtable_iterator<Value, const Value&, const Value*>       const_iterator;
+  typedef hashtable_local_iterator<Value, Value&, Value*>             local_iterator;
+  typedef hashtable_local_iterator<Value, const Value&, const Value*> const_local_iterator;
+
+  typedef mystl::node_handle<node>                            node_type;
+  typedef node_insert_return<iterator, node_type>             insert_return_type;
+
+  allocator_type get_allocator() const { return allocator_type(); }
+
+  static constexpr size_type min_bucket_count = 8;
+
+private:
+  bucket_type buckets_;   // 桶数组，为空或长度为 2 的幂
+  size_type   size_;      // 元素个数
+  float       mlf_;       // 最大装载因子
+  hasher      hash_;
+  key_equal   equal_;
+
+public:
+  // 构造、复制、移动、析构函数
+  explicit hashtable(size_type bucket_count,
+                     const hasher& hash = hasher(),
+                     const key_equal& equal = key_equal())
+    :buckets_(), size_(0), mlf_(1.0f), hash_(hash), equal_(equal)
+  {
+    if (bucket_count != 0)
+      rehash(bucket_count);
+  }
+
+  hashtable(const hashtable& rhs)
+    :buckets_(), size_(0), mlf_(rhs.mlf_), hash_(rhs.hash_), equal_(rhs.equal_)
+  {
+    copy_from(rhs);
+  }
+
+  hashtable(hashtable&& rhs) noexcept
+    :buckets_(mystl::move(rhs.buckets_)), size_(rhs.size_), mlf_(rhs.mlf_),
+     hash_(rhs.hash_), equal_(rhs.equal_)
+  {
+    rhs.size_ = 0;
+  }
+
+  hashtable& operator=(const hashtable& rhs)
+  {
+    if (this != &rhs)
+    {
+      hashtable tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  hashtable& operator=(hashtable&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      hashtable tmp(mystl::move(rhs));
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  ~hashtable()
+  {
+    clear();
+  }
+
+public:
+  // 迭代器相关操作
+  iterator       begin()        noexcept
+  { return make_iterator(first_node()); }
+  const_iterator begin()  const noexcept
+  { return make_iterator(first_node()); }
+  iterator       end()          noexcept
+  { return make_iterator(nullptr); }
+  const_iterator end()    const noexcept
+  { return make_iterator(nullptr); }
+
+  const_iterator cbegin() const noexcept
+  { return begin(); }
+  const_iterator cend()   const noexcept
+  { return end(); }
+
+  // 容量相关操作
+  bool      empty()    const noexcept { return size_ == 0; }
+  size_type size()     const noexcept { return size_; }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(node); }
+
+  // 修改容器相关操作
+
+  // emplace_unique，先构造出节点再查找，键已存在时回收节点
+  template <class ...Args>
+  mystl::pair<iterator, bool> emplace_unique(Args&& ...args);
+
+  // try_emplace_unique，只用于 map，键不存在时才构造实值
+  template <class K, class ...Args>
+  mystl::pair<iterator, bool> try_emplace_unique(K&& key, Args&& ...args);
+
+  // insert_unique
+  mystl::pair<iterator, bool> insert_unique(const value_type& value);
+  mystl::pair<iterator, bool> insert_unique(value_type&& value)
+  { return emplace_unique(mystl::move(value)); }
+
+  // 前向迭代器的区间先按区间长度预留桶
+  template <class InputIter>
+  void insert_unique(InputIter first, InputIter last)
+  { insert_unique_range(first, last, iterator_category(first)); }
+
+  insert_return_type insert_unique(node_type&& nh);
+
+  // erase / extract / clear
+  iterator  erase(const_iterator pos);
+  iterator  erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type& key);
+
+  node_type extract(const_iterator pos)
+  {
+    MYSTL_DEBUG(pos != end());
+    unlink_node(pos.node);
+    return node_handle_access::make(pos.node);
+  }
+  node_type extract(const key_type& key)
+  {
+    const node_ptr p = find_node(key, hash_of(key));
+    if (p == nullptr)
+      return node_type();
+    unlink_node(p);
+    return node_handle_access::make(p);
+  }
+
+  void      clear() noexcept;
+
+  void      swap(hashtable& rhs) noexcept;
+
+  // 查找相关操作
+  iterator       find(const key_type& key)
+  { return make_iterator(find_node(key, hash_of(key))); }
+  const_iterator find(const key_type& key) const
+  { return make_iterator(find_node(key, hash_of(key))); }
+
+  size_type      count(const key_type& key) const
+  { return find_node(key, hash_of(key)) == nullptr ? 0 : 1; }
+  bool           contains(const key_type& key) const
+  { return find_node(key, hash_of(key)) != nullptr; }
+
+  mystl::pair<iterator, iterator> equal_range(const key_type& key)
+  {
+    iterator it = find(key);
+    iterator last = it;
+    if (last != end())
+      ++last;
+    return mystl::pair<iterator, iterator>(it, last);
+  }
+  mystl::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+  {
+    const_iterator it = find(key);
+    const_iterator last = it;
+    if (last != end())
+      ++last;
+    return mystl::pair<const_iterator, const_iterator>(it, last);
+  }
+
+  // 桶相关操作
+  local_iterator       begin(size_type n)        noexcept
+  {
+    MYSTL_DEBUG(n < bucket_count());
+    return local_iterator(buckets_[n]);
+  }
+  const_local_iterator begin(size_type n)  const noexcept
+  {
+    MYSTL_DEBUG(n < bucket_count());
+    return const_local_iterator(buckets_[n]);
+  }
+  const_local_iterator cbegin(size_type n) const noexcept
+  { return begin(n); }
+  local_iterator       end(size_type n)          noexcept
+  {
+    MYSTL_DEBUG(n < bucket_count());
+    return local_iterator(nullptr);
+  }
+  const_local_iterator end(size_type n)    const noexcept
+  {
+    MYSTL_DEBUG(n < bucket_count());
+    return const_local_iterator(nullptr);
+  }
+  const_local_iterator cend(size_type n)   const noexcept
+  { return end(n); }
+
+  size_type bucket_count()     const noexcept { return buckets_.size(); }
+  size_type max_bucket_count() const noexcept { return buckets_.max_size(); }
+  size_type bucket_size(size_type n) const noexcept;
+  size_type bucket(const key_type& key) const
+  {
+    MYSTL_DEBUG(bucket_count() != 0);
+    return hash_of(key) & (bucket_count() - 1);
+  }
+
+  // 哈希策略相关操作
+  float     load_factor()     const noexcept
+  {
+    return bucket_count() == 0 ? 0.0f
+      : static_cast<float>(size_) / static_cast<float>(bucket_count());
+  }
+  float     max_load_factor() const noexcept { return mlf_; }
+  void      max_load_factor(float ml)
+  {
+    THROW_OUT_OF_RANGE_IF(!(ml > 0.0f), "hashtable<T> invalid max load factor");
+    mlf_ = ml;
+    if (size_ > max_elements())
+      rehash(0);
+  }
+
+  // rehash，桶数取不小于 count 且能容纳现有元素的 2 的幂
+  void      rehash(size_type count);
+  // reserve，保证插入 count 个元素之前不会重新散列
+  void      reserve(size_type count)
+  { rehash(buckets_for(count)); }
+
+  hasher    hash_function() const { return hash_; }
+  key_equal key_eq()        const { return equal_; }
+
+  bool      equal_to(const hashtable& rhs) const;
+
+private:
+  // helper functions
+
+  static const key_type& key_of(const value_type& value)
+  { return ExtractKey()(value); }
+
+  size_type hash_of(const key_type& key) const
+  { return hash_of(key, mystl::hash_is_avalanching<hasher>()); }
+  size_type hash_of(const key_type& key, m_true_type) const
+  { return static_cast<size_type>(hash_(key)); }
+  size_type hash_of(const key_type& key, m_false_type) const
+  { return mystl::hash_mix(static_cast<uint64_t>(hash_(key))); }
+
+  iterator make_iterator(node_ptr p) noexcept
+  { return iterator(p, buckets_.data(), bucket_count() - 1); }
+  const_iterator make_iterator(node_ptr p) const noexcept
+  { return const_iterator(p, buckets_.data(), bucket_count() - 1); }
+
+  node_ptr  first_node() const noexcept;
+  node_ptr  find_node(const key_type& key, size_type hash) const;
+
+  // 不重新散列时最多能容纳的元素个数
+  size_type max_elements() const noexcept
+  { return static_cast<size_type>(static_cast<double>(bucket_count()) * mlf_); }
+  // 容纳 count 个元素所需的桶数
+  size_type buckets_for(size_type count) const
+  { return static_cast<size_type>(std::ceil(static_cast<double>(count) / mlf_)); }
+
+  // 为一个新元素预留空间，之后的 link_node 不会失败
+  void      prepare_insert();
+  void      link_node(node_ptr p) noexcept;
+  void      unlink_node(node_ptr p) noexcept;
+
+  template <class ...Args>
+  node_ptr  create_node(Args&& ...args);
+  void      destroy_node(node_ptr p) noexcept;
+
+  template <class InputIter>
+  void      insert_unique_range(InputIter first, InputIter last, input_iterator_tag);
+  template <class ForwardIter>
+  void      insert_unique_range(ForwardIter first, ForwardIter last, forward_iterator_tag);
+
+  void      rehash_to(size_type n);
+  void      copy_from(const hashtable& rhs);
+};
+
+/*****************************************************************************************/
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+template <class ...Args>
+mystl::pair<typename hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::iterator, bool>
+hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::emplace_unique(Args&& ...args)
+{
+  node_ptr p = create_node(mystl::forward<Args>(args)...);
+  try
+  {
+    p->hash = hash_of(key_of(p->value));
+    const node_ptr found = find_node(key_of(p->value), p->hash);
+    if (found != nullptr)
+    {
+      destroy_node(p);
+      return mystl::pair<iterator, bool>(make_iterator(found), false);
+    }
+    prepare_insert();
+  }
+  catch (...)
+  {
+    destroy_node(p);
+    throw;
+  }
+  link_node(p);
+  return mystl::pair<iterator, bool>(make_iterator(p), true);
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+template <class K, class ...Args>
+mystl::pair<typename hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::iterator, bool>
+hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::try_emplace_unique(K&& key, Args&& ...args)
+{
+  typedef typename value_type::second_type mapped_type;
+  const size_type hash = hash_of(key);
+  const node_ptr found = find_node(key, hash);
+  if (found != nullptr)
+    return mystl::pair<iterator, bool>(make_iterator(found), false);
+  prepare_insert();
+  node_ptr p = create_node(mystl::forward<K>(key), mapped_type(mystl::forward<Args>(args)...));
+  p->hash = hash;
+  link_node(p);
+  return mystl::pair<iterator, bool>(make_iterator(p), true);
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+mystl::pair<typename hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::iterator, bool>
+hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::insert_unique(const value_type& value)
+{
+  const size_type hash = hash_of(key_of(value));
+  const node_ptr found = find_node(key_of(value), hash);
+  if (found != nullptr)
+    return mystl::pair<iterator, bool>(make_iterator(found), false);
+  prepare_insert();
+  node_ptr p = create_node(value);
+  p->hash = hash;
+  link_node(p);
+  return mystl::pair<iterator, bool>(make_iterator(p), true);
+}
+
+// 插入节点句柄，键已存在时节点留在返回值中
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+typename hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::insert_return_type
+hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::insert_unique(node_type&& nh)
+{
+  if (nh.empty())
+    return insert_return_type{ end(), false, node_type() };
+  node_ptr p = node_handle_access::get(nh);
+  p->hash = hash_of(key_of(p->value));
+  const node_ptr found = find_node(key_of(p->value), p->hash);
+  if (found != nullptr)
+    return insert_return_type{ make_iterator(found), false, mystl::move(nh) };
+  prepare_insert();
+  link_node(node_handle_access::release(nh));
+  return insert_return_type{ make_iterator(p), true, node_type() };
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+typename hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::iterator
+hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::erase(const_iterator pos)
+{
+  MYSTL_DEBUG(pos != end());
+  const_iterator next = pos;
+  ++next;
+  unlink_node(pos.node);
+  destroy_node(pos.node);
+  return make_iterator(next.node);
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+typename hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::iterator
+hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::erase(const_iterator first, const_iterator last)
+{
+  while (first != last)
+    first = erase(first);
+  return make_iterator(last.node);
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+typename hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::size_type
+hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::erase(const key_type& key)
+{
+  if (size_ == 0)
+    return 0;
+  const size_type hash = hash_of(key);
+  node_ptr* link = &buckets_[hash & (bucket_count() - 1)];
+  for (node_ptr p = *link; p != nullptr; link = &p->next, p = p->next)
+  {
+    if (p->hash == hash && equal_(key_of(p->value), key))
+    {
+      *link = p->next;
+      --size_;
+      destroy_node(p);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+void hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::clear() noexcept
+{
+  if (size_ == 0)
+    return;
+  for (size_type i = 0; i < bucket_count(); ++i)
+  {
+    node_ptr p = buckets_[i];
+    while (p != nullptr)
+    {
+      const node_ptr next = p->next;
+      destroy_node(p);
+      p = next;
+    }
+    buckets_[i] = nullptr;
+  }
+  size_ = 0;
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+void hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::swap(hashtable& rhs) noexcept
+{
+  buckets_.swap(rhs.buckets_);
+  mystl::swap(size_, rhs.size_);
+  mystl::swap(mlf_, rhs.mlf_);
+  mystl::swap(hash_, rhs.hash_);
+  mystl::swap(equal_, rhs.equal_);
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+typename hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::size_type
+hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::bucket_size(size_type n) const noexcept
+{
+  MYSTL_DEBUG(n < bucket_count());
+  size_type result = 0;
+  for (node_ptr p = buckets_[n]; p != nullptr; p = p->next)
+    ++result;
+  return result;
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+void hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::rehash(size_type count)
+{
+  size_type need = buckets_for(size_);
+  if (count > need)
+    need = count;
+  if (need == 0)
+  {
+    if (bucket_count() != 0)
+      bucket_type().swap(buckets_);
+    return;
+  }
+  THROW_LENGTH_ERROR_IF(need > max_bucket_count() / 2, "hashtable<T>'s bucket count too big");
+  need = mystl::round_up_pow2(need < min_bucket_count ? min_bucket_count : need);
+  if (need != bucket_count())
+    rehash_to(need);
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+bool hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::equal_to(const hashtable& rhs) const
+{
+  if (size_ != rhs.size_)
+    return false;
+  for (auto it = begin(); it != end(); ++it)
+  {
+    auto other = rhs.find(key_of(*it));
+    if (other == rhs.end() || !(*other == *it))
+      return false;
+  }
+  return true;
+}
+
+/*****************************************************************************************/
+// helper function
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+typename hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::node_ptr
+hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::first_node() const noexcept
+{
+  if (size_ == 0)
+    return nullptr;
+  for (size_type i = 0; i < bucket_count(); ++i)
+  {
+    if (buckets_[i] != nullptr)
+      return buckets_[i];
+  }
+  return nullptr;
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+typename hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::node_ptr
+hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::
+find_node(const key_type& key, size_type hash) const
+{
+  if (size_ == 0)
+    return nullptr;
+  for (node_ptr p = buckets_[hash & (bucket_count() - 1)]; p != nullptr; p = p->next)
+  {
+    if (p->hash == hash && equal_(key_of(p->value), key))
+      return p;
+  }
+  return nullptr;
+}
+
+// 插入后元素个数超过上限时，桶数至少翻倍
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+void hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::prepare_insert()
+{
+  if (size_ + 1 <= max_elements())
+    return;
+  THROW_LENGTH_ERROR_IF(size_ == max_size(), "hashtable<T>'s size too big");
+  const size_type need = buckets_for(size_ + 1);
+  const size_type twice = bucket_count() * 2;
+  rehash(need > twice ? need : twice);
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+void hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::link_node(node_ptr p) noexcept
+{
+  node_ptr& head = buckets_[p->hash & (bucket_count() - 1)];
+  p->next = head;
+  head = p;
+  ++size_;
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+void hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::unlink_node(node_ptr p) noexcept
+{
+  node_ptr* link = &buckets_[p->hash & (bucket_count() - 1)];
+  while (*link != p)
+    link = &(*link)->next;
+  *link = p->next;
+  p->next = nullptr;
+  --size_;
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+template <class ...Args>
+typename hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::node_ptr
+hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::create_node(Args&& ...args)
+{
+  node_ptr p = node_allocator::allocate();
+  try
+  {
+    node_allocator::construct(p, mystl::forward<Args>(args)...);
+  }
+  catch (...)
+  {
+    node_allocator::deallocate(p);
+    throw;
+  }
+  return p;
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+void hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::destroy_node(node_ptr p) noexcept
+{
+  node_allocator::destroy(p);
+  node_allocator::deallocate(p);
+}
+
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+template <class InputIter>
+void hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::
+insert_unique_range(InputIter first, InputIter last, input_iterator_tag)
+{
+  for (; first != last; ++first)
+    insert_unique(*first);
+}
+
+// 区间中可能有重复的键，按全部不重复预留，多出的桶只影响装载因子
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+template <class ForwardIter>
+void hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::
+insert_unique_range(ForwardIter first, ForwardIter last, forward_iterator_tag)
+{
+  const size_type n = static_cast<size_type>(mystl::distance(first, last));
+  if (size_ + n > max_elements())
+    reserve(size_ + n);
+  for (; first != last; ++first)
+    insert_unique(*first);
+}
+
+// 把所有节点按保存的哈希值挂到 n 个新桶上，只有分配桶数组可能抛出异常
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+void hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::rehash_to(size_type n)
+{
+  bucket_type new_buckets(n, nullptr);
+  const size_type mask = n - 1;
+  for (size_type i = 0; i < bucket_count(); ++i)
+  {
+    node_ptr p = buckets_[i];
+    while (p != nullptr)
+    {
+      const node_ptr next = p->next;
+      node_ptr& head = new_buckets[p->hash & mask];
+      p->next = head;
+      head = p;
+      p = next;
+    }
+  }
+  buckets_.swap(new_buckets);
+}
+
+// 复制时桶数与 rhs 相同，节点保持原来在桶中的顺序
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+void hashtable<Value, Key, ExtractKey, Hash, KeyEqual>::copy_from(const hashtable& rhs)
+{
+  if (rhs.bucket_count() == 0)
+    return;
+  bucket_type(rhs.bucket_count(), nullptr).swap(buckets_);
+  try
+  {
+    for (size_type i = 0; i < rhs.bucket_count(); ++i)
+    {
+      node_ptr* tail = &buckets_[i];
+      for (node_ptr p = rhs.buckets_[i]; p != nullptr; p = p->next)
+      {
+        node_ptr copy = create_node(p->value);
+        copy->hash = p->hash;
+        *tail = copy;
+        tail = &copy->next;
+        ++size_;
+      }
+    }
+  }
+  catch (...)
+  {
+    clear();
+    throw;
+  }
+}
+
+/*****************************************************************************************/
+// 重载 mystl 的 swap
+template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+void swap(hashtable<Value, Key, ExtractKey, Hash, KeyEqual>& lhs,
+          hashtable<Value, Key, ExtractKey, Hash, KeyEqual>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_HASHTABLE_H_
@@ -2,8 +2,13 @@
 #define TINYSTL_HEAP_ALGO_H_
 
 // 这个头文件包含 heap 的四个算法 : push_heap, pop_heap, sort_heap, make_heap
+// 以及它们的 d 叉堆版本 : push_dary_heap, pop_dary_heap, make_dary_heap
+// 和最小-最大堆的算法   : push_minmax_heap, pop_minmax_heap_min, pop_minmax_heap_max, make_minmax_heap
 
 #include "iterator.h"
+#include "algobase.h"
+#include "utils.h"
+#include "functional.h"
 
 namespace mystl
 {
@@ -19,17 +24,18 @@ void push_heap_aux(RandomIter first, Distance holeIndex, Distance topIndex, T va
   while (holeIndex > topIndex && *(first + parent) < value)
   {
     // 使用 operator<，所以 heap 为 max-heap
-    *(first + holeIndex) = *(first + parent);
+    *(first + holeIndex) = mystl::move(*(first + parent));
     holeIndex = parent;
     parent = (holeIndex - 1) / 2;
   }
-  *(first + holeIndex) = value;
+  *(first + holeIndex) = mystl::move(value);
 }
 
 template <class RandomIter, class Distance>
 void push_heap_d(RandomIter first, RandomIter last, Distance*)
 {
-  mystl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), *(last - 1));
+  mystl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0),
+                       mystl::move(*(last - 1)));
 }
 
 template <class RandomIter>
@@ -46,18 +52,18 @@ void push_heap_aux(RandomIter first, Distance holeIndex, Distance topIndex, T va
   auto parent = (holeIndex - 1) / 2;
   while (holeIndex > topIndex && comp(*(first + parent), value))
   {
-    *(first + holeIndex) = *(first + parent);
+    *(first + holeIndex) = mystl::move(*(first + parent));
     holeIndex = parent;
     parent = (holeIndex - 1) / 2;
   }
-  *(first + holeIndex) = value;
+  *(first + holeIndex) = mystl::move(value);
 }
 
 template <class RandomIter, class Compared, class Distance>
 void push_heap_d(RandomIter first, RandomIter last, Distance*, Compared comp)
 {
   mystl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0),
-                       *(last - 1), comp);
+                       mystl::move(*(last - 1)), comp);
 }
 
 template <class RandomIter, class Compared>
@@ -69,6 +75,12 @@ void push_heap(RandomIter first, RandomIter last, Compared comp)
 /*****************************************************************************************/
 // pop_heap
 // 该函数接受两个迭代器，表示 heap 容器的首尾，将 heap 的根节点取出放到容器尾部，调整 heap
+//
+// adjust_heap 采用自底向上(Floyd)的下溯方式：空洞沿较大的子节点一路下沉到叶子，
+// 每层只比较两个子节点，不与 value 比较；然后再把 value 从叶子处上溯到合适的位置。
+// 由于被调整的 value 通常来自堆尾，本身就很小，上溯往往只需一两步，
+// 总比较次数约为 logn + O(1)，而经典的自顶向下做法每层需要两次比较，约 2logn。
+// pop_heap、sort_heap 以及依赖它们的 partial_sort、intro_sort 的 heap sort 退化路径都由此受益
 /*****************************************************************************************/
 template <class RandomIter, class T, class Distance>
 void adjust_heap(RandomIter first, Distance holeIndex, Distance len, T value)
@@ -80,17 +92,17 @@ void adjust_heap(RandomIter first, Distance holeIndex, Distance len, T value)
   {
     if (*(first + rchild) < *(first + rchild - 1))
       --rchild;
-    *(first + holeIndex) = *(first + rchild);
+    *(first + holeIndex) = mystl::move(*(first + rchild));
     holeIndex = rchild;
     rchild = 2 * (rchild + 1);
   }
   if (rchild == len)
   {  // 如果没有右子节点
-    *(first + holeIndex) = *(first + (rchild - 1));
+    *(first + holeIndex) = mystl::move(*(first + (rchild - 1)));
     holeIndex = rchild - 1;
   }
   // 再执行一次上溯(percolate up)过程
-  mystl::push_heap_aux(first, holeIndex, topIndex, value);
+  mystl::push_heap_aux(first, holeIndex, topIndex, mystl::move(value));
 }
 
 template <class RandomIter, class T, class Distance>
@@ -98,14 +110,15 @@ void pop_heap_aux(RandomIter first, RandomIter last, RandomIter result, T value,
                   Distance*)
 {
   // 先将首值调至尾节点，然后调整[first, last - 1)使之重新成为一个 max-heap
-  *result = *first;
-  mystl::adjust_heap(first, static_cast<Distance>(0), last - first, value);
+  *result = mystl::move(*first);
+  mystl::adjust_heap(first, static_cast<Distance>(0), last - first, mystl::move(value));
 }
 
 template <class RandomIter>
 void pop_heap(RandomIter first, RandomIter last)
 {
-  mystl::pop_heap_aux(first, last - 1, last - 1, *(last - 1), distance_type(first));
+  mystl::pop_heap_aux(first, last - 1, last - 1, mystl::move(*(last - 1)),
+                      distance_type(first));
 }
 
 // 重载版本使用函数对象 comp 代替比较操作
@@ -119,31 +132,31 @@ void adjust_heap(RandomIter first, Distance holeIndex, Distance len, T value,
   while (rchild < len)
   {
     if (comp(*(first + rchild), *(first + rchild - 1)))  --rchild;
-    *(first + holeIndex) = *(first + rchild);
+    *(first + holeIndex) = mystl::move(*(first + rchild));
     holeIndex = rchild;
     rchild = 2 * (rchild + 1);
   }
   if (rchild == len)
   {
-    *(first + holeIndex) = *(first + (rchild - 1));
+    *(first + holeIndex) = mystl::move(*(first + (rchild - 1)));
     holeIndex = rchild - 1;
   }
   // 再执行一次上溯(percolate up)过程
-  mystl::push_heap_aux(first, holeIndex, topIndex, value, comp);
+  mystl::push_heap_aux(first, holeIndex, topIndex, mystl::move(value), comp);
 }
 
 template <class RandomIter, class T, class Distance, class Compared>
 void pop_heap_aux(RandomIter first, RandomIter last, RandomIter result, 
                   T value, Distance*, Compared comp)
 {
-  *result = *first;  // 先将尾指设置成首值，即尾指为欲求结果
-  mystl::adjust_heap(first, static_cast<Distance>(0), last - first, value, comp);
+  *result = mystl::move(*first);  // 先将尾指设置成首值，即尾指为欲求结果
+  mystl::adjust_heap(first, static_cast<Distance>(0), last - first, mystl::move(value), comp);
 }
 
 template <class RandomIter, class Compared>
 void pop_heap(RandomIter first, RandomIter last, Compared comp)
 {
-  mystl::pop_heap_aux(first, last - 1, last - 1, *(last - 1),
+  mystl::pop_heap_aux(first, last - 1, last - 1, mystl::move(*(last - 1)),
                       distance_type(first), comp);
 }
 
@@ -185,7 +198,7 @@ void make_heap_aux(RandomIter first, RandomIter last, Distance*)
   while (true)
   {
     // 重排以 holeIndex 为首的子树
-    mystl::adjust_heap(first, holeIndex, len, *(first + holeIndex));
+    mystl::adjust_heap(first, holeIndex, len, mystl::move(*(first + holeIndex)));
     if (holeIndex == 0)
       return;
     holeIndex--;
@@ -209,7 +222,7 @@ void make_heap_aux(RandomIter first, RandomIter last, Distance*, Compared comp)
   while (true)
   {
     // 重排以 holeIndex 为首的子树
-    mystl::adjust_heap(first, holeIndex, len, *(first + holeIndex), comp);
+    mystl::adjust_heap(first, holeIndex, len, mystl::move(*(first + holeIndex)), comp);
     if (holeIndex == 0)
       return;
     holeIndex--;
@@ -222,6 +235,361 @@ void make_heap(RandomIter first, RandomIter last, Compared comp)
   mystl::make_heap_aux(first, last, distance_type(first), comp);
 }
 
+/*****************************************************************************************/
+// d 叉堆 : push_dary_heap, pop_dary_heap, make_dary_heap
+// 模板参数 D 表示每个节点的子节点个数，节点 i 的子节点为 [D * i + 1, D * i + D]，父节点为 (i - 1) / D
+// D 越大树越矮，上溯越快；D = 4 时一个节点的子节点通常位于同一条 cache line 上
+// D = 2 时与上面的二叉堆算法等价
+/*****************************************************************************************/
+template <size_t D, class RandomIter, class Distance, class T, class Compared>
+void dary_push_heap_aux(RandomIter first, Distance holeIndex, Distance topIndex, T value,
+                        Compared comp)
+{
+  static_assert(D >= 2, "the arity of a heap must be at least 2");
+  const auto d = static_cast<Distance>(D);
+  auto parent = (holeIndex - 1) / d;
+  while (holeIndex > topIndex && comp(*(first + parent), value))
+  {
+    *(first + holeIndex) = mystl::move(*(first + parent));
+    holeIndex = parent;
+    parent = (holeIndex - 1) / d;
+  }
+  *(first + holeIndex) = mystl::move(value);
+}
+
+template <size_t D, class RandomIter, class Distance, class Compared>
+void push_dary_heap_d(RandomIter first, RandomIter last, Distance*, Compared comp)
+{
+  auto value = mystl::move(*(last - 1));
+  mystl::dary_push_heap_aux<D>(first, static_cast<Distance>((last - first) - 1),
+                               static_cast<Distance>(0), mystl::move(value), comp);
+}
+
+template <size_t D, class RandomIter, class Compared>
+void push_dary_heap(RandomIter first, RandomIter last, Compared comp)
+{ // 新元素应该已置于底部容器的最尾端
+  mystl::push_dary_heap_d<D>(first, last, distance_type(first), comp);
+}
+
+template <size_t D, class RandomIter>
+void push_dary_heap(RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  mystl::push_dary_heap<D>(first, last, mystl::less<value_type>());
+}
+
+// 与 adjust_heap 相同，先把空洞下溯到叶子，每层在至多 D 个子节点中选出最大者，再上溯放入 value
+template <size_t D, class RandomIter, class T, class Distance, class Compared>
+void dary_adjust_heap(RandomIter first, Distance holeIndex, Distance len, T value,
+                      Compared comp)
+{
+  const auto d = static_cast<Distance>(D);
+  auto topIndex = holeIndex;
+  auto child = d * holeIndex + 1;
+  while (child < len)
+  {
+    auto largest = child;
+    const auto child_end = len - child < d ? len : child + d;
+    for (auto i = child + 1; i < child_end; ++i)
+    {
+      if (comp(*(first + largest), *(first + i)))
+        largest = i;
+    }
+    *(first + holeIndex) = mystl::move(*(first + largest));
+    holeIndex = largest;
+    child = d * holeIndex + 1;
+  }
+  mystl::dary_push_heap_aux<D>(first, holeIndex, topIndex, mystl::move(value), comp);
+}
+
+template <size_t D, class RandomIter, class Distance, class Compared>
+void pop_dary_heap_d(RandomIter first, RandomIter last, Distance*, Compared comp)
+{
+  // 先把尾值取出，将首值放至尾节点，然后调整[first, last - 1)使之重新成为一个 d 叉堆
+  auto value = mystl::move(*(last - 1));
+  *(last - 1) = mystl::move(*first);
+  mystl::dary_adjust_heap<D>(first, static_cast<Distance>(0),
+                             static_cast<Distance>((last - first) - 1),
+                             mystl::move(value), comp);
+}
+
+template <size_t D, class RandomIter, class Compared>
+void pop_dary_heap(RandomIter first, RandomIter last, Compared comp)
+{
+  if (last - first < 2)
+    return;
+  mystl::pop_dary_heap_d<D>(first, last, distance_type(first), comp);
+}
+
+template <size_t D, class RandomIter>
+void pop_dary_heap(RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  mystl::pop_dary_heap<D>(first, last, mystl::less<value_type>());
+}
+
+template <size_t D, class RandomIter, class Distance, class Compared>
+void make_dary_heap_d(RandomIter first, RandomIter last, Distance*, Compared comp)
+{
+  const auto len = static_cast<Distance>(last - first);
+  if (len < 2)
+    return;
+  // 从最后一个非叶子节点开始，依次重排以 holeIndex 为首的子树
+  auto holeIndex = (len - 2) / static_cast<Distance>(D);
+  while (true)
+  {
+    auto value = mystl::move(*(first + holeIndex));
+    mystl::dary_adjust_heap<D>(first, holeIndex, len, mystl::move(value), comp);
+    if (holeIndex == 0)
+      return;
+    holeIndex--;
+  }
+}
+
+template <size_t D, class RandomIter, class Compared>
+void make_dary_heap(RandomIter first, RandomIter last, Compared comp)
+{
+  mystl::make_dary_heap_d<D>(first, last, distance_type(first), comp);
+}
+
+template <size_t D, class RandomIter>
+void make_dary_heap(RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  mystl::make_dary_heap<D>(first, last, mystl::less<value_type>());
+}
+
+/*****************************************************************************************/
+// 最小-最大堆(min-max heap) : push_minmax_heap, pop_minmax_heap_min, pop_minmax_heap_max, make_minmax_heap
+// 偶数层(根为第 0 层)为最小层，节点不大于其所有子孙；奇数层为最大层，节点不小于其所有子孙
+// 因此最小值在根上，最大值在根的两个子节点之一，两端的取出都是 O(logn)，且只使用一段连续空间
+// 最大层上的操作与最小层相同，只是把 comp 的两个参数对调，由 minmax_heap_reverse 完成
+/*****************************************************************************************/
+template <class Compared>
+struct minmax_heap_reverse
+{
+  Compared comp;
+
+  explicit minmax_heap_reverse(Compared c) :comp(c) {}
+
+  template <class T>
+  bool operator()(const T& lhs, const T& rhs) const { return comp(rhs, lhs); }
+};
+
+// 求节点所在的层，根为第 0 层
+template <class Distance>
+Distance minmax_heap_level(Distance index)
+{
+  Distance level = 0;
+  for (++index; index > 1; index >>= 1)
+    ++level;
+  return level;
+}
+
+// 沿祖父节点上溯，LevelCompared 为当前层的比较方式
+template <class RandomIter, class Distance, class LevelCompared>
+void minmax_heap_bubble_up(RandomIter first, Distance holeIndex, LevelCompared comp)
+{
+  while (holeIndex > 2)
+  {
+    const auto grandparent = (holeIndex - 3) / 4;
+    if (!comp(*(first + holeIndex), *(first + grandparent)))
+      break;
+    mystl::iter_swap(first + holeIndex, first + grandparent);
+    holeIndex = grandparent;
+  }
+}
+
+// 在子节点与孙节点中找出 LevelCompared 意义下最小者，与当前节点交换后继续向孙节点下溯
+template <class RandomIter, class Distance, class LevelCompared>
+void minmax_heap_trickle_down(RandomIter first, Distance holeIndex, Distance len,
+                              LevelCompared comp)
+{
+  while (true)
+  {
+    const auto child = 2 * holeIndex + 1;
+    if (child >= len)
+      return;
+    auto best = child;
+    if (child + 1 < len && comp(*(first + child + 1), *(first + best)))
+      best = child + 1;
+    bool grandchild = false;
+    const auto grand_first = 2 * child + 1;
+    const auto grand_last = len - grand_first < 4 ? len : grand_first + 4;
+    for (auto i = grand_first; i < grand_last; ++i)
+    {
+      if (comp(*(first + i), *(first + best)))
+      {
+        best = i;
+        grandchild = true;
+      }
+    }
+    if (!comp(*(first + best), *(first + holeIndex)))
+      return;
+    mystl::iter_swap(first + holeIndex, first + best);
+    if (!grandchild)
+      return;
+    // 换下来的值可能违反它与中间层(另一种层)父节点的关系
+    const auto parent = (best - 1) / 2;
+    if (comp(*(first + parent), *(first + best)))
+      mystl::iter_swap(first + best, first + parent);
+    holeIndex = best;
+  }
+}
+
+template <class RandomIter, class Distance, class Compared>
+void push_minmax_heap_d(RandomIter first, RandomIter last, Distance*, Compared comp)
+{
+  const auto holeIndex = static_cast<Distance>((last - first) - 1);
+  if (holeIndex <= 0)
+    return;
+  const auto parent = (holeIndex - 1) / 2;
+  const minmax_heap_reverse<Compared> rcomp(comp);
+  if ((mystl::minmax_heap_level(holeIndex) & 1) == 0)
+  { // 新元素位于最小层，父节点位于最大层
+    if (comp(*(first + parent), *(first + holeIndex)))
+    {
+      mystl::iter_swap(first + holeIndex, first + parent);
+      mystl::minmax_heap_bubble_up(first, parent, rcomp);
+    }
+    else
+    {
+      mystl::minmax_heap_bubble_up(first, holeIndex, comp);
+    }
+  }
+  else
+  { // 新元素位于最大层，父节点位于最小层
+    if (comp(*(first + holeIndex), *(first + parent)))
+    {
+      mystl::iter_swap(first + holeIndex, first + parent);
+      mystl::minmax_heap_bubble_up(first, parent, comp);
+    }
+    else
+    {
+      mystl::minmax_heap_bubble_up(first, holeIndex, rcomp);
+    }
+  }
+}
+
+template <class RandomIter, class Compared>
+void push_minmax_heap(RandomIter first, RandomIter last, Compared comp)
+{ // 新元素应该已置于底部容器的最尾端
+  mystl::push_minmax_heap_d(first, last, distance_type(first), comp);
+}
+
+template <class RandomIter>
+void push_minmax_heap(RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  mystl::push_minmax_heap(first, last, mystl::less<value_type>());
+}
+
+// 返回最大元素的位置
+template <class RandomIter, class Compared>
+RandomIter minmax_heap_max(RandomIter first, RandomIter last, Compared comp)
+{
+  const auto len = last - first;
+  if (len < 3)
+    return first + (len - 1);
+  return comp(*(first + 1), *(first + 2)) ? first + 2 : first + 1;
+}
+
+template <class RandomIter>
+RandomIter minmax_heap_max(RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  return mystl::minmax_heap_max(first, last, mystl::less<value_type>());
+}
+
+// 将最小元素(根)放到容器尾部，调整 [first, last - 1)
+template <class RandomIter, class Distance, class Compared>
+void pop_minmax_heap_min_d(RandomIter first, RandomIter last, Distance*, Compared comp)
+{
+  const auto len = static_cast<Distance>(last - first);
+  if (len < 2)
+    return;
+  mystl::iter_swap(first, last - 1);
+  mystl::minmax_heap_trickle_down(first, static_cast<Distance>(0), len - 1, comp);
+}
+
+template <class RandomIter, class Compared>
+void pop_minmax_heap_min(RandomIter first, RandomIter last, Compared comp)
+{
+  mystl::pop_minmax_heap_min_d(first, last, distance_type(first), comp);
+}
+
+template <class RandomIter>
+void pop_minmax_heap_min(RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  mystl::pop_minmax_heap_min(first, last, mystl::less<value_type>());
+}
+
+// 将最大元素放到容器尾部，调整 [first, last - 1)
+template <class RandomIter, class Distance, class Compared>
+void pop_minmax_heap_max_d(RandomIter first, RandomIter last, Distance*, Compared comp)
+{
+  const auto len = static_cast<Distance>(last - first);
+  if (len < 2)
+    return;
+  const auto holeIndex = static_cast<Distance>(mystl::minmax_heap_max(first, last, comp) - first);
+  if (holeIndex == len - 1)
+    return;
+  mystl::iter_swap(first + holeIndex, last - 1);
+  mystl::minmax_heap_trickle_down(first, holeIndex, len - 1,
+                                  minmax_heap_reverse<Compared>(comp));
+}
+
+template <class RandomIter, class Compared>
+void pop_minmax_heap_max(RandomIter first, RandomIter last, Compared comp)
+{
+  mystl::pop_minmax_heap_max_d(first, last, distance_type(first), comp);
+}
+
+template <class RandomIter>
+void pop_minmax_heap_max(RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  mystl::pop_minmax_heap_max(first, last, mystl::less<value_type>());
+}
+
+template <class RandomIter, class Distance, class Compared>
+void make_minmax_heap_d(RandomIter first, RandomIter last, Distance*, Compared comp)
+{
+  const auto len = static_cast<Distance>(last - first);
+  if (len < 2)
+    return;
+  // 从最后一个非叶子节点开始，依次对每棵子树做下溯，层号随下标递减而递减
+  auto holeIndex = (len - 2) / 2;
+  auto level = mystl::minmax_heap_level(holeIndex);
+  const minmax_heap_reverse<Compared> rcomp(comp);
+  while (true)
+  {
+    if ((level & 1) == 0)
+      mystl::minmax_heap_trickle_down(first, holeIndex, len, comp);
+    else
+      mystl::minmax_heap_trickle_down(first, holeIndex, len, rcomp);
+    if (holeIndex == 0)
+      return;
+    if ((holeIndex & (holeIndex + 1)) == 0)  // holeIndex + 1 为 2 的幂，是本层第一个节点
+      --level;
+    --holeIndex;
+  }
+}
+
+template <class RandomIter, class Compared>
+void make_minmax_heap(RandomIter first, RandomIter last, Compared comp)
+{
+  mystl::make_minmax_heap_d(first, last, distance_type(first), comp);
+}
+
+template <class RandomIter>
+void make_minmax_heap(RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  mystl::make_minmax_heap(first, last, mystl::less<value_type>());
+}
+
 } // namespace mystl
 #endif // !MYTINYSTL_HEAP_ALGO_H_
 
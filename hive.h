@@ -0,0 +1,755 @@
+#ifndef TINYSTL_HIVE_H_
+#define TINYSTL_HIVE_H_
+
+// 这个头文件包含一个模板类 hive
+// hive : 无序的元素池，元素存放在容量按几何级数增长的块中，插入、删除都不会使其它元素的迭代器、指针与引用失效
+// 删除留下的空位按块记录在空闲链表中，插入时优先复用，因此高频的插入删除不需要逐个分配内存
+// 每个块带一个 skipfield，遍历时一步跳过一整段连续的空位，遍历的代价与元素个数而不是空位个数成正比
+
+// notes:
+//
+// 1. skipfield 采用 jump-counting 的方式：一段连续空位的第一个与最后一个槽记录这段的长度，
+//    元素所在的槽为 0，中间槽的值不再使用；正向遍历在段首跳过整段，反向遍历在段尾跳过整段
+// 2. 每段空位的第一个槽内存放空闲链表的节点 (前一段与后一段的段首下标)，插入时取链表头的段首
+// 3. 元素个数为 0 的块会被移出，保留一个作为备用块，避免在块的边界上反复分配与释放
+// 4. 元素的顺序由它所在的槽决定，复用空位的元素可能出现在较早插入的元素之前
+
+// 异常保证：
+// mystl::hive<T> 对 insert / emplace 做强异常安全保证，erase 不抛出异常
+
+#include <cstdint>
+#include <initializer_list>
+
+#include "algobase.h"
+#include "iterator.h"
+#include "memory.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// hive 的块
+template <class T>
+struct hive_block
+{
+  // 空闲链表的节点，存放在每段空位的第一个槽内
+  struct free_node
+  {
+    uint16_t prev;
+    uint16_t next;
+  };
+
+  typedef typename std::aligned_storage<
+    (sizeof(T) > sizeof(free_node) ? sizeof(T) : sizeof(free_node)),
+    (alignof(T) > alignof(free_node) ? alignof(T) : alignof(free_node))>::type slot_type;
+
+  static constexpr uint16_t npos = 0xFFFF;
+
+  hive_block* prev;       // 块链表中的前一个块
+  hive_block* next;       // 块链表中的后一个块
+  hive_block* free_prev;  // 有空位的块组成的链表
+  hive_block* free_next;
+  slot_type*  slots;
+  uint16_t*   skip;       // skipfield，长度为 capacity + 1，[top, capacity] 恒为 0
+  uint16_t    capacity;
+  uint16_t    top;        // 用过的槽的上界，除最后一个块外都等于 capacity
+  uint16_t    size;       // 元素个数
+  uint16_t    free_head;  // 空闲链表头部那段空位的段首，npos 表示没有空位
+
+  T*         value(size_t i) noexcept { return reinterpret_cast<T*>(&slots[i]); }
+  free_node* node(size_t i)  noexcept { return reinterpret_cast<free_node*>(&slots[i]); }
+};
+
+template <class T>
+constexpr uint16_t hive_block<T>::npos;
+
+// hive 的迭代器设计，迭代器由块与槽的下标组成
+template <class T>
+struct hive_iterator_base
+{
+  typedef hive_block<T>* block_ptr;
+
+  block_ptr block;  // 当前块，空容器时为 nullptr
+  size_t    index;  // 当前槽，end 时为最后一个块的 top
+
+  // 前进时落在一段空位的段首则跳过整段，走到块的 top 后进入下一个块
+  void incr() noexcept
+  {
+    ++index;
+    index += block->skip[index];
+    if (index == block->top && block->next != nullptr)
+    {
+      block = block->next;
+      index = block->skip[0];
+    }
+  }
+
+  // 后退时落在一段空位的段尾则跳到段首，再继续后退
+  void decr() noexcept
+  {
+    for (;;)
+    {
+      if (index == 0)
+      {
+        block = block->prev;
+        index = block->top;
+      }
+      --index;
+      const size_t n = block->skip[index];
+      if (n == 0)
+        break;
+      index -= n - 1;
+    }
+  }
+
+  bool operator==(const hive_iterator_base& rhs) const noexcept
+  { return block == rhs.block && index == rhs.index; }
+  bool operator!=(const hive_iterator_base& rhs) const noexcept
+  { return !(*this == rhs); }
+};
+
+template <class T>
+struct hive_iterator : public hive_iterator_base<T>
+{
+  typedef bidirectional_iterator_tag  iterator_category;
+  typedef T                           value_type;
+  typedef T*                          pointer;
+  typedef T&                          reference;
+  typedef ptrdiff_t                   difference_type;
+  typedef hive_iterator<T>            self;
+  typedef hive_block<T>*              block_ptr;
+
+  hive_iterator() noexcept
+  {
+    this->block = nullptr;
+    this->index = 0;
+  }
+  hive_iterator(block_ptr b, size_t i) noexcept
+  {
+    this->block = b;
+    this->index = i;
+  }
+
+  reference operator*()  const { return *this->block->value(this->index); }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++() { this->incr(); return *this; }
+  self  operator++(int) { self tmp = *this; this->incr(); return tmp; }
+  self& operator--() { this->decr(); return *this; }
+  self  operator--(int) { self tmp = *this; this->decr(); return tmp; }
+};
+
+template <class T>
+struct hive_const_iterator : public hive_iterator_base<T>
+{
+  typedef bidirectional_iterator_tag  iterator_category;
+  typedef T                           value_type;
+  typedef const T*                    pointer;
+  typedef const T&                    reference;
+  typedef ptrdiff_t                   difference_type;
+  typedef hive_const_iterator<T>      self;
+  typedef hive_block<T>*              block_ptr;
+
+  hive_const_iterator() noexcept
+  {
+    this->block = nullptr;
+    this->index = 0;
+  }
+  hive_const_iterator(block_ptr b, size_t i) noexcept
+  {
+    this->block = b;
+    this->index = i;
+  }
+  hive_const_iterator(const hive_iterator<T>& rhs) noexcept
+  {
+    this->block = rhs.block;
+    this->index = rhs.index;
+  }
+
+  reference operator*()  const { return *this->block->value(this->index); }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++() { this->incr(); return *this; }
+  self  operator++(int) { self tmp = *this; this->incr(); return tmp; }
+  self& operator--() { this->decr(); return *this; }
+  self  operator--(int) { self tmp = *this; this->decr(); return tmp; }
+};
+
+// 模板类 hive
+// 参数代表元素类型
+template <class T>
+class hive
+{
+public:
+  // hive 的嵌套型别定义
+  typedef mystl::allocator<T>                      allocator_type;
+  typedef mystl::allocator<T>                      data_allocator;
+
+  typedef typename allocator_type::value_type      value_type;
+  typedef typename allocator_type::pointer         pointer;
+  typedef typename allocator_type::const_pointer   const_pointer;
+  typedef typename allocator_type::reference       reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::size_type       size_type;
+  typedef typename allocator_type::difference_type difference_type;
+
+  typedef hive_iterator<T>                         iterator;
+  typedef hive_const_iterator<T>                   const_iterator;
+  typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+  allocator_type get_allocator() { return allocator_type(); }
+
+private:
+  typedef hive_block<T>                            block;
+  typedef hive_block<T>*                           block_ptr;
+  typedef typename block::slot_type                slot_type;
+  typedef typename block::free_node                free_node;
+  typedef mystl::allocator<block>                  block_allocator;
+  typedef mystl::allocator<slot_type>              slot_allocator;
+  typedef mystl::allocator<uint16_t>               skip_allocator;
+
+  static constexpr uint16_t  npos = block::npos;
+  static constexpr size_type kMinBlock = 8;     // 第一个块的容量
+  static constexpr size_type kMaxBlock = 8192;  // 块容量的上限，skipfield 用 16 位
+
+  block_ptr head_;         // 第一个块
+  block_ptr tail_;         // 最后一个块，新元素在它的 top 处追加
+  block_ptr free_blocks_;  // 有空位的块组成的链表
+  block_ptr unused_;       // 备用的空块
+  size_type size_;
+  size_type capacity_;     // 所有块 (包括备用块) 的容量之和
+
+public:
+  // 构造、复制、移动、析构函数，委托构造完成后抛出异常时会调用析构函数释放已有的元素
+  hive() noexcept
+    :head_(nullptr), tail_(nullptr), free_blocks_(nullptr), unused_(nullptr),
+     size_(0), capacity_(0)
+  {
+  }
+
+  explicit hive(size_type n)
+    :hive()
+  {
+    for (size_type i = 0; i < n; ++i)
+      emplace();
+  }
+
+  hive(size_type n, const value_type& value)
+    :hive()
+  {
+    insert(n, value);
+  }
+
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  hive(InputIter first, InputIter last)
+    :hive()
+  {
+    insert(first, last);
+  }
+
+  hive(std::initializer_list<value_type> ilist)
+    :hive()
+  {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  // 复制后元素紧密排列，不保留 rhs 中的空位
+  hive(const hive& rhs)
+    :hive()
+  {
+    insert(rhs.begin(), rhs.end());
+  }
+
+  hive(hive&& rhs) noexcept
+    :head_(rhs.head_), tail_(rhs.tail_), free_blocks_(rhs.free_blocks_), unused_(rhs.unused_),
+     size_(rhs.size_), capacity_(rhs.capacity_)
+  {
+    rhs.head_ = nullptr;
+    rhs.tail_ = nullptr;
+    rhs.free_blocks_ = nullptr;
+    rhs.unused_ = nullptr;
+    rhs.size_ = 0;
+    rhs.capacity_ = 0;
+  }
+
+  hive& operator=(const hive& rhs)
+  {
+    if (this != &rhs)
+    {
+      hive tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+  hive& operator=(hive&& rhs) noexcept
+  {
+    hive tmp(mystl::move(rhs));
+    swap(tmp);
+    return *this;
+  }
+  hive& operator=(std::initializer_list<value_type> ilist)
+  {
+    hive tmp(ilist);
+    swap(tmp);
+    return *this;
+  }
+
+  ~hive()
+  {
+    clear();
+    shrink_to_fit();
+  }
+
+public:
+  // 迭代器相关操作
+  iterator               begin()         noexcept
+  { return head_ ? iterator(head_, head_->skip[0]) : iterator(); }
+  const_iterator         begin()   const noexcept
+  { return head_ ? const_iterator(head_, head_->skip[0]) : const_iterator(); }
+  iterator               end()           noexcept
+  { return tail_ ? iterator(tail_, tail_->top) : iterator(); }
+  const_iterator         end()     const noexcept
+  { return tail_ ? const_iterator(tail_, tail_->top) : const_iterator(); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关操作
+  bool      empty()    const noexcept { return size_ == 0; }
+  size_type size()     const noexcept { return size_; }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(slot_type); }
+  size_type capacity() const noexcept { return capacity_; }
+
+  // 释放备用的空块
+  void      shrink_to_fit() noexcept
+  {
+    if (unused_ != nullptr)
+    {
+      capacity_ -= unused_->capacity;
+      destroy_block(unused_);
+      unused_ = nullptr;
+    }
+  }
+
+  // 由元素的指针得到它的迭代器，p 不属于本容器时返回 end()，复杂度与块的个数成正比
+  iterator       get_iterator(const_pointer p) noexcept;
+  const_iterator get_iterator(const_pointer p) const noexcept
+  { return const_cast<hive*>(this)->get_iterator(p); }
+
+  // 插入删除相关操作
+
+  // emplace / insert，优先复用空位，否则在最后一个块的 top 处追加，返回新元素的迭代器
+  template <class ...Args>
+  iterator emplace(Args&& ...args);
+
+  iterator insert(const value_type& value)
+  { return emplace(value); }
+  iterator insert(value_type&& value)
+  { return emplace(mystl::move(value)); }
+
+  void     insert(size_type n, const value_type& value)
+  {
+    for (; n > 0; --n)
+      emplace(value);
+  }
+
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  void     insert(InputIter first, InputIter last)
+  {
+    for (; first != last; ++first)
+      emplace(*first);
+  }
+  void     insert(std::initializer_list<value_type> ilist)
+  { insert(ilist.begin(), ilist.end()); }
+
+  // erase 返回下一个元素的迭代器，其它元素的迭代器仍然有效
+  iterator erase(const_iterator pos) noexcept;
+  iterator erase(const_iterator first, const_iterator last) noexcept;
+
+  void     clear() noexcept;
+
+  void     swap(hive& rhs) noexcept
+  {
+    mystl::swap(head_, rhs.head_);
+    mystl::swap(tail_, rhs.tail_);
+    mystl::swap(free_blocks_, rhs.free_blocks_);
+    mystl::swap(unused_, rhs.unused_);
+    mystl::swap(size_, rhs.size_);
+    mystl::swap(capacity_, rhs.capacity_);
+  }
+
+private:
+  // helper functions
+
+  // block
+  block_ptr create_block(size_type n);
+  void      reset_block(block_ptr b) noexcept;
+  void      destroy_block(block_ptr b) noexcept;
+  void      append_block();
+  void      remove_block(block_ptr b) noexcept;
+
+  // free list
+  void      free_push(block_ptr b, size_type s) noexcept;
+  void      free_remove(block_ptr b, free_node n) noexcept;
+  void      free_move(block_ptr b, size_type to, free_node n) noexcept;
+  void      free_blocks_push(block_ptr b) noexcept;
+  void      free_blocks_remove(block_ptr b) noexcept;
+};
+
+/*****************************************************************************************/
+
+template <class T>
+constexpr uint16_t hive<T>::npos;
+template <class T>
+constexpr typename hive<T>::size_type hive<T>::kMinBlock;
+template <class T>
+constexpr typename hive<T>::size_type hive<T>::kMaxBlock;
+
+// 由指针找到所在的块
+template <class T>
+typename hive<T>::iterator
+hive<T>::get_iterator(const_pointer p) noexcept
+{
+  const slot_type* s = reinterpret_cast<const slot_type*>(p);
+  for (block_ptr b = head_; b != nullptr; b = b->next)
+  {
+    if (s >= b->slots && s < b->slots + b->top)
+      return iterator(b, static_cast<size_type>(s - b->slots));
+  }
+  return end();
+}
+
+// 复用空闲链表头部那段空位的第一个槽，该段缩短一格，链表节点随段首后移
+template <class T>
+template <class ...Args>
+typename hive<T>::iterator
+hive<T>::emplace(Args&& ...args)
+{
+  if (free_blocks_ != nullptr)
+  {
+    block_ptr b = free_blocks_;
+    const size_type s = b->free_head;
+    const size_type len = b->skip[s];
+    const free_node node = *b->node(s);
+    try
+    {
+      data_allocator::construct(b->value(s), mystl::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      *b->node(s) = node;
+      throw;
+    }
+    b->skip[s] = 0;
+    if (len == 1)
+    {
+      free_remove(b, node);
+    }
+    else
+    {
+      b->skip[s + 1] = static_cast<uint16_t>(len - 1);
+      b->skip[s + len - 1] = static_cast<uint16_t>(len - 1);
+      free_move(b, s + 1, node);
+    }
+    ++b->size;
+    ++size_;
+    return iterator(b, s);
+  }
+
+  const bool grown = tail_ == nullptr || tail_->top == tail_->capacity;
+  if (grown)
+    append_block();
+  block_ptr b = tail_;
+  try
+  {
+    data_allocator::construct(b->value(b->top), mystl::forward<Args>(args)...);
+  }
+  catch (...)
+  {
+    if (grown)
+      remove_block(b);
+    throw;
+  }
+  ++b->size;
+  ++size_;
+  return iterator(b, b->top++);
+}
+
+// 根据左右相邻的槽是否为空位，新建、延长或合并空位段
+template <class T>
+typename hive<T>::iterator
+hive<T>::erase(const_iterator pos) noexcept
+{
+  MYSTL_DEBUG(pos != cend());
+  block_ptr b = pos.block;
+  const size_type i = pos.index;
+  iterator next(b, i);
+  ++next;
+  data_allocator::destroy(b->value(i));
+  --size_;
+  if (--b->size == 0)
+  {
+    remove_block(b);
+    return next.block == b ? end() : next;
+  }
+
+  const size_type left = i > 0 ? b->skip[i - 1] : 0;
+  const size_type right = b->skip[i + 1];
+  if (left == 0 && right == 0)
+  {
+    b->skip[i] = 1;
+    free_push(b, i);
+  }
+  else if (right == 0)
+  {
+    const size_type len = left + 1;
+    b->skip[i - left] = static_cast<uint16_t>(len);
+    b->skip[i] = static_cast<uint16_t>(len);
+  }
+  else if (left == 0)
+  {
+    const size_type len = right + 1;
+    free_move(b, i, *b->node(i + 1));
+    b->skip[i] = static_cast<uint16_t>(len);
+    b->skip[i + len - 1] = static_cast<uint16_t>(len);
+  }
+  else
+  {
+    const size_type len = left + right + 1;
+    free_remove(b, *b->node(i + 1));
+    b->skip[i - left] = static_cast<uint16_t>(len);
+    b->skip[i - left + len - 1] = static_cast<uint16_t>(len);
+  }
+  return next;
+}
+
+// 删除 [first, last) 内的元素，last 为 end() 时最后一个块可能被移出，因此每次重新取 end()
+template <class T>
+typename hive<T>::iterator
+hive<T>::erase(const_iterator first, const_iterator last) noexcept
+{
+  if (last == cend())
+  {
+    while (first != cend())
+      first = erase(first);
+    return end();
+  }
+  iterator it(first.block, first.index);
+  while (it != last)
+    it = erase(it);
+  return it;
+}
+
+template <class T>
+void hive<T>::clear() noexcept
+{
+  block_ptr b = head_;
+  while (b != nullptr)
+  {
+    block_ptr next = b->next;
+    for (iterator it(b, b->skip[0]); it.index < b->top; )
+    {
+      data_allocator::destroy(&*it);
+      ++it.index;
+      it.index += b->skip[it.index];
+    }
+    b->size = 0;
+    remove_block(b);
+    b = next;
+  }
+  size_ = 0;
+}
+
+// 一次分配块头、槽与 skipfield，失败时释放已分配的部分
+template <class T>
+typename hive<T>::block_ptr
+hive<T>::create_block(size_type n)
+{
+  block_ptr b = block_allocator::allocate(1);
+  try
+  {
+    b->slots = slot_allocator::allocate(n);
+    try
+    {
+      b->skip = skip_allocator::allocate(n + 1);
+    }
+    catch (...)
+    {
+      slot_allocator::deallocate(b->slots);
+      throw;
+    }
+  }
+  catch (...)
+  {
+    block_allocator::deallocate(b);
+    throw;
+  }
+  b->capacity = static_cast<uint16_t>(n);
+  reset_block(b);
+  return b;
+}
+
+template <class T>
+void hive<T>::reset_block(block_ptr b) noexcept
+{
+  b->prev = b->next = nullptr;
+  b->free_prev = b->free_next = nullptr;
+  b->top = 0;
+  b->size = 0;
+  b->free_head = npos;
+  for (size_type i = 0; i <= b->capacity; ++i)
+    b->skip[i] = 0;
+}
+
+template <class T>
+void hive<T>::destroy_block(block_ptr b) noexcept
+{
+  skip_allocator::deallocate(b->skip);
+  slot_allocator::deallocate(b->slots);
+  block_allocator::deallocate(b);
+}
+
+// 优先使用备用块，否则新块的容量与已有元素个数相当，使块的容量按几何级数增长
+template <class T>
+void hive<T>::append_block()
+{
+  block_ptr b = unused_;
+  if (b != nullptr)
+  {
+    unused_ = nullptr;
+  }
+  else
+  {
+    const size_type n = mystl::min(kMaxBlock, mystl::max(kMinBlock, size_));
+    b = create_block(n);
+    capacity_ += n;
+  }
+  b->prev = tail_;
+  if (tail_ != nullptr)
+    tail_->next = b;
+  else
+    head_ = b;
+  tail_ = b;
+}
+
+// 移出空块，保留容量较大的一个作为备用块
+template <class T>
+void hive<T>::remove_block(block_ptr b) noexcept
+{
+  MYSTL_DEBUG(b->size == 0);
+  if (b->free_head != npos)
+    free_blocks_remove(b);
+  if (b->prev != nullptr)
+    b->prev->next = b->next;
+  else
+    head_ = b->next;
+  if (b->next != nullptr)
+    b->next->prev = b->prev;
+  else
+    tail_ = b->prev;
+
+  if (unused_ != nullptr && unused_->capacity >= b->capacity)
+  {
+    capacity_ -= b->capacity;
+    destroy_block(b);
+    return;
+  }
+  if (unused_ != nullptr)
+  {
+    capacity_ -= unused_->capacity;
+    destroy_block(unused_);
+  }
+  reset_block(b);
+  unused_ = b;
+}
+
+// 把段首 s 放到块的空闲链表头部
+template <class T>
+void hive<T>::free_push(block_ptr b, size_type s) noexcept
+{
+  free_node* n = b->node(s);
+  n->prev = npos;
+  n->next = b->free_head;
+  if (b->free_head != npos)
+    b->node(b->free_head)->prev = static_cast<uint16_t>(s);
+  else
+    free_blocks_push(b);
+  b->free_head = static_cast<uint16_t>(s);
+}
+
+// 从块的空闲链表中摘下节点 n 所在的段，n 为该段链表节点的副本
+template <class T>
+void hive<T>::free_remove(block_ptr b, free_node n) noexcept
+{
+  if (n.prev != npos)
+    b->node(n.prev)->next = n.next;
+  else
+    b->free_head = n.next;
+  if (n.next != npos)
+    b->node(n.next)->prev = n.prev;
+  if (b->free_head == npos)
+    free_blocks_remove(b);
+}
+
+// 段首移到 to，把链表节点 n 写到 to 处，再修正前后节点的指向
+template <class T>
+void hive<T>::free_move(block_ptr b, size_type to, free_node n) noexcept
+{
+  *b->node(to) = n;
+  if (n.prev != npos)
+    b->node(n.prev)->next = static_cast<uint16_t>(to);
+  else
+    b->free_head = static_cast<uint16_t>(to);
+  if (n.next != npos)
+    b->node(n.next)->prev = static_cast<uint16_t>(to);
+}
+
+template <class T>
+void hive<T>::free_blocks_push(block_ptr b) noexcept
+{
+  b->free_prev = nullptr;
+  b->free_next = free_blocks_;
+  if (free_blocks_ != nullptr)
+    free_blocks_->free_prev = b;
+  free_blocks_ = b;
+}
+
+template <class T>
+void hive<T>::free_blocks_remove(block_ptr b) noexcept
+{
+  if (b->free_prev != nullptr)
+    b->free_prev->free_next = b->free_next;
+  else
+    free_blocks_ = b->free_next;
+  if (b->free_next != nullptr)
+    b->free_next->free_prev = b->free_prev;
+  b->free_prev = b->free_next = nullptr;
+}
+
+// 重载 mystl 的 swap
+template <class T>
+void swap(hive<T>& lhs, hive<T>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_HIVE_H_
@@ -52,7 +52,7 @@ struct iterator_traits_impl{};
 //可以用来在具体的迭代器类型上实例化 iterator_traits_impl 结构体模板，并从中获取迭代器的特性类型别名。
 template<class Iterator>
 struct iterator_traits_impl<Iterator,true>{
-typedef typename Iterator::iterator_category itetator_category;
+typedef typename Iterator::iterator_category iterator_category;
 typedef typename Iterator::value_type value_type;
 typedef typename Iterator::pointer pointer;
 typedef typename Iterator::reference reference;
@@ -89,7 +89,7 @@ struct iterator_traits
 template<class T>
 struct iterator_traits<T*>
 {
-    typedef random_access_iterator_tag          iterator_type;
+    typedef random_access_iterator_tag          iterator_category;
     typedef T                                   value_type;
     typedef T*                                  pointer;
     typedef T&                                  reference;
@@ -199,7 +199,7 @@ _distance(RandomAccessIterator first,RandomAccessIterator last,random_access_ite
 
 template<class InputIterator>
 inline typename iterator_traits<InputIterator>::difference_type
-distance(InputIterator first,InputIterator last,input_iterator_tag){
+distance(InputIterator first,InputIterator last){
   typedef typename iterator_traits<InputIterator>::iterator_category category;
   return _distance(first,last,category());
 
@@ -270,10 +270,25 @@ public:
       return *(--tmp);
     }
 
+    //指针直接取地址；类类型的迭代器转交给它自己的 operator->，
+    //operator* 返回代理对象的迭代器(例如 flat_map_iterator)也能使用
     pointer operator->() const
+  {
+    return arrow(m_bool_constant<std::is_pointer<Iterator>::value>());
+  }
+
+private:
+    pointer arrow(m_true_type) const
   {
     return &(operator*());
   }
+    pointer arrow(m_false_type) const
+  {
+    auto tmp = current;
+    return (--tmp).operator->();
+  }
+
+public:
 
   // 前进(++)变为后退(--)
   //前缀
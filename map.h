@@ -0,0 +1,613 @@
+#ifndef TINYSTL_MAP_H_
+#define TINYSTL_MAP_H_
+
+// 这个头文件包含了两个模板类 map 和 multimap
+// map      : 映射，元素具有键值和实值，会根据键值大小自动排序，键值不允许重复
+// multimap : 映射，元素具有键值和实值，会根据键值大小自动排序，键值允许重复
+// 底层实现为 rb_tree，节点由 pool_allocator 分配，删除之前引用保持有效，
+// 节点可以 extract 后修改键值再插入，merge 在两个容器间转移节点而不复制元素
+
+// 异常保证：
+// mystl::map<Key, T> / mystl::multimap<Key, T> 满足基本异常保证，
+// 对 insert / emplace / try_emplace 做强异常安全保证
+
+#include "rb_tree.h"
+
+namespace mystl
+{
+
+// 模板类 map，键值不允许重复
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 mystl::less
+template <class Key, class T, class Compare = mystl::less<Key>>
+class map
+{
+public:
+  // map 的嵌套型别定义
+  typedef Key                        key_type;
+  typedef T                          mapped_type;
+  typedef mystl::pair<const Key, T>  value_type;
+  typedef Compare                    key_compare;
+
+  // 定义一个 functor，用来进行元素比较
+  class value_compare : public binary_function<value_type, value_type, bool>
+  {
+    friend class map<Key, T, Compare>;
+  private:
+    Compare comp;
+    value_compare(Compare c) : comp(c) {}
+  public:
+    bool operator()(const value_type& lhs, const value_type& rhs) const
+    {
+      return comp(lhs.first, rhs.first);  // 比较键值的大小
+    }
+  };
+
+private:
+  // 以 mystl::rb_tree 作为底层机制
+  typedef mystl::rb_tree<value_type, key_type, mystl::selectfirst<value_type>,
+                         key_compare> base_type;
+  base_type tree_;
+
+public:
+  // 使用 rb_tree 的型别
+  typedef typename base_type::allocator_type          allocator_type;
+  typedef typename base_type::pointer                 pointer;
+  typedef typename base_type::const_pointer           const_pointer;
+  typedef typename base_type::reference               reference;
+  typedef typename base_type::const_reference         const_reference;
+  typedef typename base_type::size_type               size_type;
+  typedef typename base_type::difference_type         difference_type;
+
+  typedef typename base_type::iterator                iterator;
+  typedef typename base_type::const_iterator          const_iterator;
+  typedef typename base_type::reverse_iterator        reverse_iterator;
+  typedef typename base_type::const_reverse_iterator  const_reverse_iterator;
+
+  typedef typename base_type::node_type               node_type;
+  typedef typename base_type::insert_return_type      insert_return_type;
+
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+  key_compare    key_comp()      const { return tree_.key_comp(); }
+  value_compare  value_comp()    const { return value_compare(tree_.key_comp()); }
+
+public:
+  // 构造、复制、移动、赋值函数
+  map() = default;
+
+  explicit map(const key_compare& comp)
+    :tree_(comp)
+  {
+  }
+
+  // 空容器中插入有序区间时 O(n) 建树
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  map(InputIter first, InputIter last, const key_compare& comp = key_compare())
+    :tree_(comp)
+  {
+    tree_.insert_unique(first, last);
+  }
+
+  map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+    :tree_(comp)
+  {
+    tree_.insert_unique(ilist.begin(), ilist.end());
+  }
+
+  map(const map& rhs)
+    :tree_(rhs.tree_)
+  {
+  }
+  map(map&& rhs) noexcept
+    :tree_(mystl::move(rhs.tree_))
+  {
+  }
+
+  map& operator=(const map& rhs)
+  {
+    tree_ = rhs.tree_;
+    return *this;
+  }
+  map& operator=(map&& rhs) noexcept
+  {
+    tree_ = mystl::move(rhs.tree_);
+    return *this;
+  }
+
+  map& operator=(std::initializer_list<value_type> ilist)
+  {
+    map tmp(ilist, tree_.key_comp());
+    swap(tmp);
+    return *this;
+  }
+
+  ~map() = default;
+
+  // 迭代器相关
+  iterator               begin()         noexcept
+  { return tree_.begin(); }
+  const_iterator         begin()   const noexcept
+  { return tree_.begin(); }
+  iterator               end()           noexcept
+  { return tree_.end(); }
+  const_iterator         end()     const noexcept
+  { return tree_.end(); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return tree_.rbegin(); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return tree_.rbegin(); }
+  reverse_iterator       rend()          noexcept
+  { return tree_.rend(); }
+  const_reverse_iterator rend()    const noexcept
+  { return tree_.rend(); }
+
+  const_iterator         cbegin()  const noexcept
+  { return tree_.cbegin(); }
+  const_iterator         cend()    const noexcept
+  { return tree_.cend(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return tree_.crbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return tree_.crend(); }
+
+  // 容量相关
+  bool      empty()    const noexcept { return tree_.empty(); }
+  size_type size()     const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+
+  // 访问元素相关
+
+  // 若键值不存在，at 会抛出一个异常
+  mapped_type&       at(const key_type& key)
+  {
+    iterator it = tree_.find(key);
+    THROW_OUT_OF_RANGE_IF(it == end(), "map<Key, T> no such element exists");
+    return it->second;
+  }
+  const mapped_type& at(const key_type& key) const
+  {
+    const_iterator it = tree_.find(key);
+    THROW_OUT_OF_RANGE_IF(it == end(), "map<Key, T> no such element exists");
+    return it->second;
+  }
+
+  mapped_type& operator[](const key_type& key)
+  { return tree_.try_emplace_unique(key).first->second; }
+  mapped_type& operator[](key_type&& key)
+  { return tree_.try_emplace_unique(mystl::move(key)).first->second; }
+
+  // 插入删除相关
+
+  // emplace / emplace_hint
+  template <class ...Args>
+  mystl::pair<iterator, bool> emplace(Args&& ...args)
+  { return tree_.emplace_unique(mystl::forward<Args>(args)...); }
+
+  // hint 为插入位置之后的元素时不需要从根查找，按顺序在 end() 处插入为均摊 O(1)
+  template <class ...Args>
+  iterator emplace_hint(const_iterator hint, Args&& ...args)
+  { return tree_.emplace_unique_use_hint(hint, mystl::forward<Args>(args)...); }
+
+  // try_emplace，键不存在时才用 args 构造实值
+  template <class ...Args>
+  mystl::pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+  { return tree_.try_emplace_unique(key, mystl::forward<Args>(args)...); }
+  template <class ...Args>
+  mystl::pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args)
+  { return tree_.try_emplace_unique(mystl::move(key), mystl::forward<Args>(args)...); }
+
+  template <class ...Args>
+  iterator try_emplace(const_iterator hint, const key_type& key, Args&& ...args)
+  { return tree_.try_emplace_unique_use_hint(hint, key, mystl::forward<Args>(args)...); }
+  template <class ...Args>
+  iterator try_emplace(const_iterator hint, key_type&& key, Args&& ...args)
+  {
+    return tree_.try_emplace_unique_use_hint(hint, mystl::move(key),
+                                             mystl::forward<Args>(args)...);
+  }
+
+  // insert
+  mystl::pair<iterator, bool> insert(const value_type& value)
+  { return tree_.insert_unique(value); }
+  mystl::pair<iterator, bool> insert(value_type&& value)
+  { return tree_.insert_unique(mystl::move(value)); }
+
+  iterator insert(const_iterator hint, const value_type& value)
+  { return tree_.insert_unique(hint, value); }
+  iterator insert(const_iterator hint, value_type&& value)
+  { return tree_.insert_unique(hint, mystl::move(value)); }
+
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  void insert(InputIter first, InputIter last)
+  { tree_.insert_unique(first, last); }
+  void insert(std::initializer_list<value_type> ilist)
+  { tree_.insert_unique(ilist.begin(), ilist.end()); }
+
+  // 插入节点句柄，键已存在时节点留在返回值的 node 中
+  insert_return_type insert(node_type&& nh)
+  { return tree_.insert_unique(mystl::move(nh)); }
+  iterator insert(const_iterator hint, node_type&& nh)
+  { return tree_.insert_unique(hint, mystl::move(nh)); }
+
+  // insert_or_assign
+  template <class M>
+  mystl::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+  {
+    auto r = tree_.try_emplace_unique(key, mystl::forward<M>(obj));
+    if (!r.second)
+      r.first->second = mystl::forward<M>(obj);
+    return r;
+  }
+  template <class M>
+  mystl::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+  {
+    auto r = tree_.try_emplace_unique(mystl::move(key), mystl::forward<M>(obj));
+    if (!r.second)
+      r.first->second = mystl::forward<M>(obj);
+    return r;
+  }
+
+  // erase / extract / merge / clear
+  iterator  erase(const_iterator position)
+  { return tree_.erase(position); }
+  iterator  erase(iterator position)
+  { return tree_.erase(position); }
+  size_type erase(const key_type& key)
+  { return tree_.erase_unique(key); }
+  iterator  erase(const_iterator first, const_iterator last)
+  { return tree_.erase(first, last); }
+
+  node_type extract(const_iterator position)
+  { return tree_.extract(position); }
+  node_type extract(const key_type& key)
+  { return tree_.extract(key); }
+
+  void      merge(map& source)
+  { tree_.merge_unique(source.tree_); }
+  void      merge(map&& source)
+  { tree_.merge_unique(source.tree_); }
+
+  void      clear() noexcept
+  { tree_.clear(); }
+
+  void      swap(map& rhs) noexcept
+  { tree_.swap(rhs.tree_); }
+
+  // map 相关操作
+
+  iterator       find(const key_type& key)
+  { return tree_.find(key); }
+  const_iterator find(const key_type& key) const
+  { return tree_.find(key); }
+
+  size_type      count(const key_type& key) const
+  { return tree_.count_unique(key); }
+  bool           contains(const key_type& key) const
+  { return tree_.find(key) != tree_.end(); }
+
+  iterator       lower_bound(const key_type& key)
+  { return tree_.lower_bound(key); }
+  const_iterator lower_bound(const key_type& key) const
+  { return tree_.lower_bound(key); }
+
+  iterator       upper_bound(const key_type& key)
+  { return tree_.upper_bound(key); }
+  const_iterator upper_bound(const key_type& key) const
+  { return tree_.upper_bound(key); }
+
+  mystl::pair<iterator, iterator>
+  equal_range(const key_type& key)
+  { return tree_.equal_range_unique(key); }
+  mystl::pair<const_iterator, const_iterator>
+  equal_range(const key_type& key) const
+  { return tree_.equal_range_unique(key); }
+
+public:
+  friend bool operator==(const map& lhs, const map& rhs) { return lhs.tree_ == rhs.tree_; }
+  friend bool operator< (const map& lhs, const map& rhs) { return lhs.tree_ <  rhs.tree_; }
+};
+
+// 重载比较操作符
+template <class Key, class T, class Compare>
+bool operator!=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class Key, class T, class Compare>
+bool operator<=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class Key, class T, class Compare>
+void swap(map<Key, T, Compare>& lhs, map<Key, T, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+
+// 模板类 multimap，键值允许重复
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用 mystl::less
+template <class Key, class T, class Compare = mystl::less<Key>>
+class multimap
+{
+public:
+  // multimap 的型别定义
+  typedef Key                        key_type;
+  typedef T                          mapped_type;
+  typedef mystl::pair<const Key, T>  value_type;
+  typedef Compare                    key_compare;
+
+  // 定义一个 functor，用来进行元素比较
+  class value_compare : public binary_function<value_type, value_type, bool>
+  {
+    friend class multimap<Key, T, Compare>;
+  private:
+    Compare comp;
+    value_compare(Compare c) : comp(c) {}
+  public:
+    bool operator()(const value_type& lhs, const value_type& rhs) const
+    {
+      return comp(lhs.first, rhs.first);
+    }
+  };
+
+private:
+  // 用 mystl::rb_tree 作为底层机制
+  typedef mystl::rb_tree<value_type, key_type, mystl::selectfirst<value_type>,
+                         key_compare> base_type;
+  base_type tree_;
+
+public:
+  // 使用 rb_tree 的型别
+  typedef typename base_type::allocator_type          allocator_type;
+  typedef typename base_type::pointer                 pointer;
+  typedef typename base_type::const_pointer           const_pointer;
+  typedef typename base_type::reference               reference;
+  typedef typename base_type::const_reference         const_reference;
+  typedef typename base_type::size_type               size_type;
+  typedef typename base_type::difference_type         difference_type;
+
+  typedef typename base_type::iterator                iterator;
+  typedef typename base_type::const_iterator          const_iterator;
+  typedef typename base_type::reverse_iterator        reverse_iterator;
+  typedef typename base_type::const_reverse_iterator  const_reverse_iterator;
+
+  typedef typename base_type::node_type               node_type;
+
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+  key_compare    key_comp()      const { return tree_.key_comp(); }
+  value_compare  value_comp()    const { return value_compare(tree_.key_comp()); }
+
+public:
+  // 构造、复制、移动函数
+  multimap() = default;
+
+  explicit multimap(const key_compare& comp)
+    :tree_(comp)
+  {
+  }
+
+  // 空容器中插入有序区间时 O(n) 建树
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  multimap(InputIter first, InputIter last, const key_compare& comp = key_compare())
+    :tree_(comp)
+  {
+    tree_.insert_multi(first, last);
+  }
+
+  multimap(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+    :tree_(comp)
+  {
+    tree_.insert_multi(ilist.begin(), ilist.end());
+  }
+
+  multimap(const multimap& rhs)
+    :tree_(rhs.tree_)
+  {
+  }
+  multimap(multimap&& rhs) noexcept
+    :tree_(mystl::move(rhs.tree_))
+  {
+  }
+
+  multimap& operator=(const multimap& rhs)
+  {
+    tree_ = rhs.tree_;
+    return *this;
+  }
+  multimap& operator=(multimap&& rhs) noexcept
+  {
+    tree_ = mystl::move(rhs.tree_);
+    return *this;
+  }
+
+  multimap& operator=(std::initializer_list<value_type> ilist)
+  {
+    multimap tmp(ilist, tree_.key_comp());
+    swap(tmp);
+    return *this;
+  }
+
+  ~multimap() = default;
+
+  // 迭代器相关
+  iterator               begin()         noexcept
+  { return tree_.begin(); }
+  const_iterator         begin()   const noexcept
+  { return tree_.begin(); }
+  iterator               end()           noexcept
+  { return tree_.end(); }
+  const_iterator         end()     const noexcept
+  { return tree_.end(); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return tree_.rbegin(); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return tree_.rbegin(); }
+  reverse_iterator       rend()          noexcept
+  { return tree_.rend(); }
+  const_reverse_iterator rend()    const noexcept
+  { return tree_.rend(); }
+
+  const_iterator         cbegin()  const noexcept
+  { return tree_.cbegin(); }
+  const_iterator         cend()    const noexcept
+  { return tree_.cend(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return tree_.crbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return tree_.crend(); }
+
+  // 容量相关
+  bool      empty()    const noexcept { return tree_.empty(); }
+  size_type size()     const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+
+  // 插入删除操作
+
+  // emplace / emplace_hint
+  template <class ...Args>
+  iterator emplace(Args&& ...args)
+  { return tree_.emplace_multi(mystl::forward<Args>(args)...); }
+
+  template <class ...Args>
+  iterator emplace_hint(const_iterator hint, Args&& ...args)
+  { return tree_.emplace_multi_use_hint(hint, mystl::forward<Args>(args)...); }
+
+  // insert
+  iterator insert(const value_type& value)
+  { return tree_.insert_multi(value); }
+  iterator insert(value_type&& value)
+  { return tree_.insert_multi(mystl::move(value)); }
+
+  iterator insert(const_iterator hint, const value_type& value)
+  { return tree_.insert_multi(hint, value); }
+  iterator insert(const_iterator hint, value_type&& value)
+  { return tree_.insert_multi(hint, mystl::move(value)); }
+
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  void insert(InputIter first, InputIter last)
+  { tree_.insert_multi(first, last); }
+  void insert(std::initializer_list<value_type> ilist)
+  { tree_.insert_multi(ilist.begin(), ilist.end()); }
+
+  // 插入节点句柄
+  iterator insert(node_type&& nh)
+  { return tree_.insert_multi(mystl::move(nh)); }
+  iterator insert(const_iterator hint, node_type&& nh)
+  { return tree_.insert_multi(hint, mystl::move(nh)); }
+
+  // erase / extract / merge / clear
+  iterator  erase(const_iterator position)
+  { return tree_.erase(position); }
+  iterator  erase(iterator position)
+  { return tree_.erase(position); }
+  size_type erase(const key_type& key)
+  { return tree_.erase_multi(key); }
+  iterator  erase(const_iterator first, const_iterator last)
+  { return tree_.erase(first, last); }
+
+  node_type extract(const_iterator position)
+  { return tree_.extract(position); }
+  node_type extract(const key_type& key)
+  { return tree_.extract(key); }
+
+  void      merge(multimap& source)
+  { tree_.merge_multi(source.tree_); }
+  void      merge(multimap&& source)
+  { tree_.merge_multi(source.tree_); }
+
+  void      clear() noexcept
+  { tree_.clear(); }
+
+  void      swap(multimap& rhs) noexcept
+  { tree_.swap(rhs.tree_); }
+
+  // multimap 相关操作
+
+  iterator       find(const key_type& key)
+  { return tree_.find(key); }
+  const_iterator find(const key_type& key) const
+  { return tree_.find(key); }
+
+  size_type      count(const key_type& key) const
+  { return tree_.count_multi(key); }
+  bool           contains(const key_type& key) const
+  { return tree_.find(key) != tree_.end(); }
+
+  iterator       lower_bound(const key_type& key)
+  { return tree_.lower_bound(key); }
+  const_iterator lower_bound(const key_type& key) const
+  { return tree_.lower_bound(key); }
+
+  iterator       upper_bound(const key_type& key)
+  { return tree_.upper_bound(key); }
+  const_iterator upper_bound(const key_type& key) const
+  { return tree_.upper_bound(key); }
+
+  mystl::pair<iterator, iterator>
+  equal_range(const key_type& key)
+  { return tree_.equal_range_multi(key); }
+  mystl::pair<const_iterator, const_iterator>
+  equal_range(const key_type& key) const
+  { return tree_.equal_range_multi(key); }
+
+public:
+  friend bool operator==(const multimap& lhs, const multimap& rhs) { return lhs.tree_ == rhs.tree_; }
+  friend bool operator< (const multimap& lhs, const multimap& rhs) { return lhs.tree_ <  rhs.tree_; }
+};
+
+// 重载比较操作符
+template <class Key, class T, class Compare>
+bool operator!=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class Key, class T, class Compare>
+bool operator<=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare>
+bool operator>=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class Key, class T, class Compare>
+void swap(multimap<Key, T, Compare>& lhs, multimap<Key, T, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_MAP_H_
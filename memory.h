@@ -137,6 +137,7 @@ template <class ForwardIterator, class T>
 void temporary_buffer<ForwardIterator, T>::allocate_buffer()
 {
   original_len = len;
+  buffer = nullptr;
   if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T)))
     len = INT_MAX / sizeof(T);
   while (len > 0)
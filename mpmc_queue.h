@@ -0,0 +1,260 @@
+#ifndef TINYSTL_MPMC_QUEUE_H_
+#define TINYSTL_MPMC_QUEUE_H_
+
+// 这个头文件包含了一个模板类 mpmc_queue
+// mpmc_queue : 有界的多生产者 / 多消费者队列 (Vyukov 数组队列)
+//
+// 每个槽位带一个序号 seq：
+//   seq == pos        槽位空闲，可由抢到 pos 的生产者写入
+//   seq == pos + 1    槽位已写入，可由抢到 pos 的消费者读出
+// 生产者与消费者各自只对 enqueue_pos_ / dequeue_pos_ 做一次 CAS，槽位本身不需要 CAS，
+// 两个下标放在不同的缓存行上
+//
+// try_push / try_pop 不会阻塞；push / pop 在队列满 / 空时先自旋一小段时间，
+// 之后在条件变量上等待，只有存在等待者时对方才会去加锁通知
+
+// 异常保证：
+// 元素先在槽位之外构造好，抢到槽位之后只做移动构造，因此要求 T 的移动构造不抛出异常，
+// 构造抛出异常时队列保持不变
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <type_traits>
+
+#include "concurrency.h"
+#include "memory.h"
+#include "utils.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+template <class T>
+class mpmc_queue
+{
+public:
+  typedef T                                        value_type;
+  typedef T&                                       reference;
+  typedef const T&                                 const_reference;
+  typedef size_t                                   size_type;
+
+  static_assert(std::is_nothrow_move_constructible<T>::value,
+                "mpmc_queue<T> requires T to be nothrow move constructible");
+
+private:
+  struct cell
+  {
+    std::atomic<size_type>                                  seq;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+    T* value() noexcept { return reinterpret_cast<T*>(&storage); }
+  };
+
+  typedef mystl::allocator<cell>                   cell_allocator;
+
+  // 自旋多少次之后进入等待
+  enum { spin_count = 64 };
+
+private:
+  alignas(cache_line_size) std::atomic<size_type> enqueue_pos_;
+  alignas(cache_line_size) std::atomic<size_type> dequeue_pos_;
+  alignas(cache_line_size) cell*                  cells_;
+  size_type                                       mask_;
+
+  // 阻塞接口使用
+  alignas(cache_line_size) std::atomic<size_type> push_waiters_;
+  std::atomic<size_type>                          pop_waiters_;
+  std::mutex                                      wait_mutex_;
+  std::condition_variable                         not_full_;
+  std::condition_variable                         not_empty_;
+
+public:
+  // 构造、析构函数，容量向上取整为 2 的幂且至少为 2
+  explicit mpmc_queue(size_type capacity)
+    :enqueue_pos_(0), dequeue_pos_(0), push_waiters_(0), pop_waiters_(0)
+  {
+    THROW_LENGTH_ERROR_IF(capacity > (static_cast<size_type>(-1) >> 1) / sizeof(cell),
+                          "mpmc_queue<T>'s capacity too big");
+    const size_type cap = round_up_pow2(capacity < 2 ? 2 : capacity);
+    cells_ = cell_allocator::allocate(cap);
+    mask_ = cap - 1;
+    for (size_type i = 0; i < cap; ++i)
+    {
+      cell_allocator::construct(cells_ + i);
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  mpmc_queue(const mpmc_queue&) = delete;
+  mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+  ~mpmc_queue()
+  {
+    size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+    const size_type last = enqueue_pos_.load(std::memory_order_relaxed);
+    for (; pos != last; ++pos)
+      mystl::destroy(cells_[pos & mask_].value());
+    mystl::destroy(cells_, cells_ + mask_ + 1);
+    cell_allocator::deallocate(cells_, mask_ + 1);
+  }
+
+public:
+  // 容量相关操作，size 与 empty 只是某一时刻的近似值
+  size_type capacity() const noexcept { return mask_ + 1; }
+
+  size_type size() const noexcept
+  {
+    const size_type head = dequeue_pos_.load(std::memory_order_acquire);
+    const size_type tail = enqueue_pos_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+  bool      empty() const noexcept { return size() == 0; }
+
+  // 非阻塞接口，队列满 / 空时返回 false
+
+  template <class ...Args>
+  bool try_emplace(Args&& ...args)
+  { return try_push(value_type(mystl::forward<Args>(args)...)); }
+
+  bool try_push(const value_type& value) { return try_push(value_type(value)); }
+
+  bool try_push(value_type&& value)
+  {
+    if (!enqueue(value))
+      return false;
+    wake(pop_waiters_, not_empty_);
+    return true;
+  }
+
+  bool try_pop(value_type& value)
+  {
+    if (!dequeue(value))
+      return false;
+    wake(push_waiters_, not_full_);
+    return true;
+  }
+
+  // 阻塞接口
+
+  template <class ...Args>
+  void emplace(Args&& ...args)
+  { push(value_type(mystl::forward<Args>(args)...)); }
+
+  void push(const value_type& value) { push(value_type(value)); }
+
+  void push(value_type&& value)
+  {
+    for (int i = 0; i < spin_count; ++i)
+    {
+      if (try_push(mystl::move(value)))
+        return;
+      cpu_relax();
+    }
+    {
+      std::unique_lock<std::mutex> lk(wait_mutex_);
+      push_waiters_.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      while (!enqueue(value))
+        not_full_.wait(lk);
+      push_waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    wake(pop_waiters_, not_empty_);
+  }
+
+  void pop(value_type& value)
+  {
+    for (int i = 0; i < spin_count; ++i)
+    {
+      if (try_pop(value))
+        return;
+      cpu_relax();
+    }
+    {
+      std::unique_lock<std::mutex> lk(wait_mutex_);
+      pop_waiters_.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      while (!dequeue(value))
+        not_empty_.wait(lk);
+      pop_waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    wake(push_waiters_, not_full_);
+  }
+
+private:
+  // 抢占 enqueue_pos_ 并把 value 移入槽位，不通知等待者
+  // 抢到槽位之后不会再抛出异常，失败时 value 保持不变
+  bool enqueue(value_type& value) noexcept
+  {
+    cell* c = nullptr;
+    size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      c = cells_ + (pos & mask_);
+      const size_type seq = c->seq.load(std::memory_order_acquire);
+      const ptrdiff_t diff = static_cast<ptrdiff_t>(seq - pos);
+      if (diff == 0)
+      {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    mystl::construct(c->value(), mystl::move(value));
+    c->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 抢占 dequeue_pos_ 并读出槽位，不通知等待者
+  bool dequeue(value_type& value)
+  {
+    cell* c = nullptr;
+    size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      c = cells_ + (pos & mask_);
+      const size_type seq = c->seq.load(std::memory_order_acquire);
+      const ptrdiff_t diff = static_cast<ptrdiff_t>(seq - (pos + 1));
+      if (diff == 0)
+      {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    // 先移出槽位并交还，再赋给 value，赋值抛出异常也不会占住槽位
+    value_type tmp(mystl::move(*c->value()));
+    mystl::destroy(c->value());
+    c->seq.store(pos + mask_ + 1, std::memory_order_release);
+    value = mystl::move(tmp);
+    return true;
+  }
+
+  // 有等待者时加锁通知，加锁保证等待者不会在检查与进入等待之间错过通知
+  void wake(std::atomic<size_type>& waiters, std::condition_variable& cv)
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) != 0)
+    {
+      std::lock_guard<std::mutex> lk(wait_mutex_);
+      cv.notify_one();
+    }
+  }
+};
+
+} // namespace mystl
+#endif // !MYTINYSTL_MPMC_QUEUE_H_
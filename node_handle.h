@@ -0,0 +1,146 @@
+#ifndef TINYSTL_NODE_HANDLE_H_
+#define TINYSTL_NODE_HANDLE_H_
+
+// 这个头文件包含了节点式容器共用的节点句柄 node_handle 与 insert(node_type&&) 的返回值类型
+// node_handle : 持有一个从容器中取出的节点，析构时销毁元素并把节点还给 pool_allocator
+//   对 map 类的容器提供 key() / mapped()，对 set 类的容器提供 value()
+//   节点在同一种节点类型的容器之间转移时，元素既不复制也不移动
+// 容器通过 node_handle_access 创建句柄或取回节点
+
+#include <type_traits>
+
+#include "pool_allocator.h"
+#include "utils.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+template <class Node>
+class node_handle
+{
+  friend struct node_handle_access;
+
+public:
+  typedef typename Node::value_type          value_type;
+  typedef Node*                              node_ptr;
+  typedef mystl::pool_allocator<Node>        node_allocator;
+
+private:
+  node_ptr node_;
+
+public:
+  node_handle() noexcept
+    :node_(nullptr)
+  {
+  }
+
+  node_handle(node_handle&& rhs) noexcept
+    :node_(rhs.node_)
+  {
+    rhs.node_ = nullptr;
+  }
+
+  node_handle& operator=(node_handle&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      reset();
+      node_ = rhs.node_;
+      rhs.node_ = nullptr;
+    }
+    return *this;
+  }
+
+  node_handle(const node_handle&) = delete;
+  node_handle& operator=(const node_handle&) = delete;
+
+  ~node_handle()
+  {
+    reset();
+  }
+
+  bool empty() const noexcept { return node_ == nullptr; }
+  explicit operator bool() const noexcept { return node_ != nullptr; }
+
+  value_type& value() const
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    return node_->value;
+  }
+
+  // map 的节点可以修改键，重新插入时按新的键查找位置
+  template <class V = value_type>
+  typename std::remove_const<typename V::first_type>::type& key() const
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    return const_cast<typename std::remove_const<typename V::first_type>::type&>(
+      node_->value.first);
+  }
+
+  template <class V = value_type>
+  typename V::second_type& mapped() const
+  {
+    MYSTL_DEBUG(node_ != nullptr);
+    return node_->value.second;
+  }
+
+  void swap(node_handle& rhs) noexcept
+  {
+    mystl::swap(node_, rhs.node_);
+  }
+
+private:
+  explicit node_handle(node_ptr p) noexcept
+    :node_(p)
+  {
+  }
+
+  void reset() noexcept
+  {
+    if (node_ != nullptr)
+    {
+      node_allocator::destroy(node_);
+      node_allocator::deallocate(node_);
+      node_ = nullptr;
+    }
+  }
+};
+
+template <class Node>
+void swap(node_handle<Node>& lhs, node_handle<Node>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+// 容器访问句柄内部节点的入口
+struct node_handle_access
+{
+  template <class Node>
+  static node_handle<Node> make(Node* p) noexcept
+  { return node_handle<Node>(p); }
+
+  template <class Node>
+  static Node* get(const node_handle<Node>& nh) noexcept
+  { return nh.node_; }
+
+  template <class Node>
+  static Node* release(node_handle<Node>& nh) noexcept
+  {
+    Node* p = nh.node_;
+    nh.node_ = nullptr;
+    return p;
+  }
+};
+
+// insert(node_type&&) 的返回值，插入失败时节点留在 node 中
+template <class Iter, class NodeHandle>
+struct node_insert_return
+{
+  Iter       position;
+  bool       inserted;
+  NodeHandle node;
+};
+
+} // namespace mystl
+#endif // !MYTINYSTL_NODE_HANDLE_H_
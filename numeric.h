@@ -0,0 +1,297 @@
+#ifndef TINYSTL_NUMERIC_H_
+#define TINYSTL_NUMERIC_H_
+
+// 这个头文件包含了 mystl 的数值算法
+// accumulate / inner_product / partial_sum / adjacent_difference / iota 按顺序从左到右计算
+// reduce / transform_reduce / inclusive_scan / exclusive_scan 不保证计算顺序，要求运算满足结合律，
+// 并行版本见 parallel_numeric.h
+
+#include "iterator.h"
+#include "functional.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// accumulate
+// 版本1：以初值 init 对每个元素进行累加
+// 版本2：以初值 init 对每个元素进行二元操作
+/*****************************************************************************************/
+// 版本1
+template <class InputIter, class T>
+T accumulate(InputIter first, InputIter last, T init)
+{
+  for (; first != last; ++first)
+  {
+    init += *first;
+  }
+  return init;
+}
+
+// 版本2
+template <class InputIter, class T, class BinaryOp>
+T accumulate(InputIter first, InputIter last, T init, BinaryOp binary_op)
+{
+  for (; first != last; ++first)
+  {
+    init = binary_op(init, *first);
+  }
+  return init;
+}
+
+/*****************************************************************************************/
+// adjacent_difference
+// 版本1：计算相邻元素的差值，结果保存到以 result 为起始的区间上
+// 版本2：自定义相邻元素的二元操作
+/*****************************************************************************************/
+// 版本1
+template <class InputIter, class OutputIter>
+OutputIter adjacent_difference(InputIter first, InputIter last, OutputIter result)
+{
+  if (first == last)  return result;
+  *result = *first;  // 记录第一个元素
+  auto value = *first;
+  while (++first != last)
+  {
+    auto tmp = *first;
+    *++result = tmp - value;
+    value = tmp;
+  }
+  return ++result;
+}
+
+// 版本2
+template <class InputIter, class OutputIter, class BinaryOp>
+OutputIter adjacent_difference(InputIter first, InputIter last, OutputIter result,
+                               BinaryOp binary_op)
+{
+  if (first == last)  return result;
+  *result = *first;  // 记录第一个元素
+  auto value = *first;
+  while (++first != last)
+  {
+    auto tmp = *first;
+    *++result = binary_op(tmp, value);
+    value = tmp;
+  }
+  return ++result;
+}
+
+/*****************************************************************************************/
+// inner_product
+// 版本1：以 init 为初值，计算两个区间的内积
+// 版本2：自定义 operator+ 和 operator*
+/*****************************************************************************************/
+// 版本1
+template <class InputIter1, class InputIter2, class T>
+T inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init)
+{
+  for (; first1 != last1; ++first1, ++first2)
+  {
+    init = init + (*first1 * *first2);
+  }
+  return init;
+}
+
+// 版本2
+template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+T inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                BinaryOp1 binary_op1, BinaryOp2 binary_op2)
+{
+  for (; first1 != last1; ++first1, ++first2)
+  {
+    init = binary_op1(init, binary_op2(*first1, *first2));
+  }
+  return init;
+}
+
+/*****************************************************************************************/
+// iota
+// 填充[first, last)，以 value 为初值开始递增
+/*****************************************************************************************/
+template <class ForwardIter, class T>
+void iota(ForwardIter first, ForwardIter last, T value)
+{
+  while (first != last)
+  {
+    *first++ = value;
+    ++value;
+  }
+}
+
+/*****************************************************************************************/
+// partial_sum
+// 版本1：计算局部累计求和，结果保存到以 result 为起始的区间上
+// 版本2：进行局部进行自定义二元操作
+/*****************************************************************************************/
+template <class InputIter, class OutputIter>
+OutputIter partial_sum(InputIter first, InputIter last, OutputIter result)
+{
+  if (first == last)  return result;
+  *result = *first;  // 记录第一个元素
+  auto value = *first;
+  while (++first != last)
+  {
+    value = value + *first;
+    *++result = value;
+  }
+  return ++result;
+}
+
+// 版本2
+template <class InputIter, class OutputIter, class BinaryOp>
+OutputIter partial_sum(InputIter first, InputIter last, OutputIter result,
+                       BinaryOp binary_op)
+{
+  if (first == last)  return result;
+  *result = *first;  //记录第一个元素
+  auto value = *first;
+  while (++first != last)
+  {
+    value = binary_op(value, *first);
+    *++result = value;
+  }
+  return ++result;
+}
+
+/*****************************************************************************************/
+// reduce
+// 与 accumulate 相同，但不保证计算顺序
+// 版本1：以 identity_element(plus<T>()) 为初值求和
+// 版本2：以 init 为初值求和
+// 版本3：以 init 为初值进行二元操作
+/*****************************************************************************************/
+// 版本3
+template <class InputIter, class T, class BinaryOp>
+T reduce(InputIter first, InputIter last, T init, BinaryOp binary_op)
+{
+  for (; first != last; ++first)
+  {
+    init = binary_op(init, *first);
+  }
+  return init;
+}
+
+// 版本2
+template <class InputIter, class T>
+T reduce(InputIter first, InputIter last, T init)
+{
+  return mystl::reduce(first, last, init, mystl::plus<T>());
+}
+
+// 版本1
+template <class InputIter>
+typename iterator_traits<InputIter>::value_type
+reduce(InputIter first, InputIter last)
+{
+  typedef typename iterator_traits<InputIter>::value_type value_type;
+  return mystl::reduce(first, last, mystl::identity_element(mystl::plus<value_type>()),
+                       mystl::plus<value_type>());
+}
+
+/*****************************************************************************************/
+// transform_reduce
+// 版本1：计算两个区间的内积，即 reduce(plus, transform(multiplies))，初值为 init
+// 版本2：以 reduce_op 合并 transform_op(*first1, *first2)
+// 版本3：以 reduce_op 合并 transform_op(*first)
+/*****************************************************************************************/
+// 版本2
+template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                   BinaryOp1 reduce_op, BinaryOp2 transform_op)
+{
+  for (; first1 != last1; ++first1, ++first2)
+  {
+    init = reduce_op(init, transform_op(*first1, *first2));
+  }
+  return init;
+}
+
+// 版本1
+template <class InputIter1, class InputIter2, class T>
+T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init)
+{
+  return mystl::transform_reduce(first1, last1, first2, init,
+                                 mystl::plus<T>(), mystl::multiplies<T>());
+}
+
+// 版本3
+template <class InputIter, class T, class BinaryOp, class UnaryOp>
+T transform_reduce(InputIter first, InputIter last, T init,
+                   BinaryOp reduce_op, UnaryOp transform_op)
+{
+  for (; first != last; ++first)
+  {
+    init = reduce_op(init, transform_op(*first));
+  }
+  return init;
+}
+
+/*****************************************************************************************/
+// inclusive_scan
+// 第 i 个输出为前 i + 1 个元素的累计结果，与 partial_sum 相同但不保证计算顺序
+// 版本1：求和
+// 版本2：自定义二元操作
+// 版本3：自定义二元操作，并以 init 为初值
+/*****************************************************************************************/
+// 版本3
+template <class InputIter, class OutputIter, class BinaryOp, class T>
+OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                          BinaryOp binary_op, T init)
+{
+  for (; first != last; ++first, ++result)
+  {
+    init = binary_op(init, *first);
+    *result = init;
+  }
+  return result;
+}
+
+// 版本2
+template <class InputIter, class OutputIter, class BinaryOp>
+OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                          BinaryOp binary_op)
+{
+  if (first == last)  return result;
+  typename iterator_traits<InputIter>::value_type value = *first;
+  *result = value;
+  return mystl::inclusive_scan(++first, last, ++result, binary_op, value);
+}
+
+// 版本1
+template <class InputIter, class OutputIter>
+OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result)
+{
+  typedef typename iterator_traits<InputIter>::value_type value_type;
+  return mystl::inclusive_scan(first, last, result, mystl::plus<value_type>());
+}
+
+/*****************************************************************************************/
+// exclusive_scan
+// 第 i 个输出为 init 与前 i 个元素的累计结果，第 0 个输出为 init
+// 版本1：求和
+// 版本2：自定义二元操作
+/*****************************************************************************************/
+// 版本2
+template <class InputIter, class OutputIter, class T, class BinaryOp>
+OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result,
+                          T init, BinaryOp binary_op)
+{
+  for (; first != last; ++first, ++result)
+  {
+    T tmp = binary_op(init, *first);  // 先读出 *first，result 可以与 first 相同
+    *result = init;
+    init = tmp;
+  }
+  return result;
+}
+
+// 版本1
+template <class InputIter, class OutputIter, class T>
+OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, T init)
+{
+  return mystl::exclusive_scan(first, last, result, init, mystl::plus<T>());
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_NUMERIC_H_
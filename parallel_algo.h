@@ -0,0 +1,755 @@
+#ifndef TINYSTL_PARALLEL_ALGO_H_
+#define TINYSTL_PARALLEL_ALGO_H_
+
+// 这个头文件包含了 algo.h 中部分算法的并行版本，第一个参数为执行策略，例如
+//   mystl::sort(mystl::par, v.begin(), v.end());
+//   mystl::sort(mystl::par.on(pool), d.begin(), d.end(), comp);
+// 要求随机访问迭代器，区间较小时退化为对应的串行算法
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+
+#include "algo.h"
+#include "execution.h"
+#include "vector.h"
+
+namespace mystl
+{
+
+constexpr static size_t kParallelSortCutoff      = 1 << 14;  // 区间不超过此长度时调用串行 sort
+constexpr static size_t kParallelPartitionCutoff = 1 << 16;  // 区间不超过此长度时串行分割
+constexpr static size_t kParallelBlockSize       = 1 << 14;  // 并行分割时每块的最小长度
+constexpr static size_t kParallelGrain           = 1 << 13;  // 逐元素算法每块的最小长度，用于摊薄调度开销
+constexpr static size_t kParallelCancelCheck     = 1 << 10;  // 可提前结束的算法每处理这么多元素检查一次
+
+/*****************************************************************************************/
+// parallel_chunk_plan / parallel_chunks
+// 把 [0, n) 切成若干块，每个线程大约分到四块，每块不少于 kParallelGrain
+// 除第一块外，块的边界都落在 offset + k * align 上，调用方用它把写入的边界对齐到缓存行
+// 同样的参数总是得到同样的切法，两遍扫描的算法据此让两遍使用相同的块
+/*****************************************************************************************/
+struct parallel_chunk_plan
+{
+  size_t n;
+  size_t offset;
+  size_t chunk;
+  size_t count;
+
+  parallel_chunk_plan(size_t threads, size_t len, size_t off, size_t align)
+    :n(len), offset(off)
+  {
+    chunk = n / (threads * 4);
+    if (chunk < kParallelGrain)
+      chunk = kParallelGrain;
+    chunk = (chunk + align - 1) / align * align;
+    count = n > offset ? (n - offset + chunk - 1) / chunk : 1;
+  }
+
+  // 第 c 块为 [begin(c), begin(c + 1))
+  size_t begin(size_t c) const
+  {
+    if (c == 0)
+      return 0;
+    const size_t b = offset + c * chunk;
+    return b < n ? b : n;
+  }
+};
+
+// 并行调用 body(c, b, e)，c 为块的编号
+template <class Body>
+void run_chunks(thread_pool& pool, const parallel_chunk_plan& plan, const Body& body)
+{
+  mystl::parallel_for(pool, 0, plan.count, 1, [&](size_t cb, size_t ce)
+  {
+    for (size_t c = cb; c < ce; ++c)
+      body(c, plan.begin(c), plan.begin(c + 1));
+  });
+}
+
+// 并行调用 body(b, e)
+template <class Body>
+void parallel_chunks(thread_pool& pool, size_t n, size_t offset, size_t align, const Body& body)
+{
+  mystl::run_chunks(pool, parallel_chunk_plan(pool.size(), n, offset, align),
+                    [&](size_t, size_t b, size_t e) { body(b, e); });
+}
+
+// 计算写入区间在缓存行上的对齐 : 每行容纳 align 个元素，从 it 开始第 offset 个元素位于行首
+template <class Iter>
+void cache_line_alignment(Iter it, size_t& offset, size_t& align)
+{
+  typedef typename iterator_traits<Iter>::value_type value_type;
+  const size_t size = sizeof(value_type);
+  const size_t addr = reinterpret_cast<size_t>(&*it);
+  offset = 0;
+  align = 1;
+  if (size <= cache_line_size && cache_line_size % size == 0 && addr % size == 0)
+  {
+    align = cache_line_size / size;
+    offset = (cache_line_size - addr % cache_line_size) % cache_line_size / size;
+  }
+}
+
+// 区间太小或线程池只有一个线程时不值得并行
+inline bool parallel_worthwhile(thread_pool& pool, size_t n)
+{
+  return n > kParallelGrain && pool.size() > 1;
+}
+
+/*****************************************************************************************/
+// find_if / find_if_not / any_of / all_of
+// 各块记录找到的最小下标，下标更小的块已经找到时其余块提前结束
+/*****************************************************************************************/
+template <class RandomIter, class UnaryPredicate>
+RandomIter parallel_find_if_aux(thread_pool& pool, RandomIter first, RandomIter last,
+                                UnaryPredicate unary_pred, bool expected)
+{
+  const size_t n = static_cast<size_t>(last - first);
+  std::atomic<size_t> found(n);
+  mystl::parallel_chunks(pool, n, 0, 1, [&](size_t b, size_t e)
+  {
+    auto it = first + b;
+    for (size_t i = b; i < e; )
+    {
+      if (found.load(std::memory_order_relaxed) <= i)
+        return;
+      const size_t stop = e - i > kParallelCancelCheck ? i + kParallelCancelCheck : e;
+      for (; i < stop; ++i, ++it)
+      {
+        if (static_cast<bool>(unary_pred(*it)) == expected)
+        {
+          size_t cur = found.load(std::memory_order_relaxed);
+          while (i < cur && !found.compare_exchange_weak(cur, i, std::memory_order_relaxed))
+            ;
+          return;
+        }
+      }
+    }
+  });
+  return first + found.load(std::memory_order_relaxed);
+}
+
+template <class RandomIter, class UnaryPredicate>
+RandomIter find_if(const parallel_policy& policy, RandomIter first, RandomIter last,
+                   UnaryPredicate unary_pred)
+{
+  thread_pool& pool = policy.get_pool();
+  if (!parallel_worthwhile(pool, static_cast<size_t>(last - first)))
+    return mystl::find_if(first, last, unary_pred);
+  return mystl::parallel_find_if_aux(pool, first, last, unary_pred, true);
+}
+
+template <class RandomIter, class UnaryPredicate>
+RandomIter find_if_not(const parallel_policy& policy, RandomIter first, RandomIter last,
+                       UnaryPredicate unary_pred)
+{
+  thread_pool& pool = policy.get_pool();
+  if (!parallel_worthwhile(pool, static_cast<size_t>(last - first)))
+    return mystl::find_if_not(first, last, unary_pred);
+  return mystl::parallel_find_if_aux(pool, first, last, unary_pred, false);
+}
+
+template <class RandomIter, class UnaryPredicate>
+bool any_of(const parallel_policy& policy, RandomIter first, RandomIter last,
+            UnaryPredicate unary_pred)
+{
+  return mystl::find_if(policy, first, last, unary_pred) != last;
+}
+
+template <class RandomIter, class UnaryPredicate>
+bool all_of(const parallel_policy& policy, RandomIter first, RandomIter last,
+            UnaryPredicate unary_pred)
+{
+  return mystl::find_if_not(policy, first, last, unary_pred) == last;
+}
+
+template <class RandomIter, class UnaryPredicate>
+bool none_of(const parallel_policy& policy, RandomIter first, RandomIter last,
+             UnaryPredicate unary_pred)
+{
+  return mystl::find_if(policy, first, last, unary_pred) == last;
+}
+
+/*****************************************************************************************/
+// count_if
+// 每块计数后求和
+/*****************************************************************************************/
+template <class RandomIter, class UnaryPredicate>
+size_t count_if(const parallel_policy& policy, RandomIter first, RandomIter last,
+                UnaryPredicate unary_pred)
+{
+  thread_pool& pool = policy.get_pool();
+  const size_t n = static_cast<size_t>(last - first);
+  if (!parallel_worthwhile(pool, n))
+    return mystl::count_if(first, last, unary_pred);
+  std::atomic<size_t> total(0);
+  mystl::parallel_chunks(pool, n, 0, 1, [&](size_t b, size_t e)
+  {
+    size_t c = 0;
+    auto it = first + b;
+    for (size_t i = b; i < e; ++i, ++it)
+    {
+      if (unary_pred(*it))
+        ++c;
+    }
+    total.fetch_add(c, std::memory_order_relaxed);
+  });
+  return total.load(std::memory_order_relaxed);
+}
+
+/*****************************************************************************************/
+// for_each
+// 各块的边界对齐到缓存行，f 原地修改元素时不会与相邻的块伪共享
+/*****************************************************************************************/
+template <class RandomIter, class Function>
+void for_each(const parallel_policy& policy, RandomIter first, RandomIter last, Function f)
+{
+  thread_pool& pool = policy.get_pool();
+  const size_t n = static_cast<size_t>(last - first);
+  if (!parallel_worthwhile(pool, n))
+  {
+    mystl::for_each(first, last, f);
+    return;
+  }
+  size_t offset, align;
+  mystl::cache_line_alignment(first, offset, align);
+  mystl::parallel_chunks(pool, n, offset, align, [&](size_t b, size_t e)
+  {
+    auto it = first + b;
+    for (size_t i = b; i < e; ++i, ++it)
+      f(*it);
+  });
+}
+
+/*****************************************************************************************/
+// transform
+// 按输出区间对齐到缓存行切块，返回输出区间的尾部
+/*****************************************************************************************/
+template <class RandomIter, class RandomOutIter, class UnaryOperation>
+RandomOutIter transform(const parallel_policy& policy, RandomIter first, RandomIter last,
+                        RandomOutIter result, UnaryOperation unary_op)
+{
+  thread_pool& pool = policy.get_pool();
+  const size_t n = static_cast<size_t>(last - first);
+  if (!parallel_worthwhile(pool, n))
+    return mystl::transform(first, last, result, unary_op);
+  size_t offset, align;
+  mystl::cache_line_alignment(result, offset, align);
+  mystl::parallel_chunks(pool, n, offset, align, [&](size_t b, size_t e)
+  {
+    auto it = first + b;
+    auto out = result + b;
+    for (size_t i = b; i < e; ++i, ++it, ++out)
+      *out = unary_op(*it);
+  });
+  return result + n;
+}
+
+template <class RandomIter1, class RandomIter2, class RandomOutIter, class BinaryOperation>
+RandomOutIter transform(const parallel_policy& policy, RandomIter1 first1, RandomIter1 last1,
+                        RandomIter2 first2, RandomOutIter result, BinaryOperation binary_op)
+{
+  thread_pool& pool = policy.get_pool();
+  const size_t n = static_cast<size_t>(last1 - first1);
+  if (!parallel_worthwhile(pool, n))
+    return mystl::transform(first1, last1, first2, result, binary_op);
+  size_t offset, align;
+  mystl::cache_line_alignment(result, offset, align);
+  mystl::parallel_chunks(pool, n, offset, align, [&](size_t b, size_t e)
+  {
+    auto it1 = first1 + b;
+    auto it2 = first2 + b;
+    auto out = result + b;
+    for (size_t i = b; i < e; ++i, ++it1, ++it2, ++out)
+      *out = binary_op(*it1, *it2);
+  });
+  return result + n;
+}
+
+/*****************************************************************************************/
+// parallel_partition_aux
+// 把 [first, last) 切成若干块，各块并行地做 partition，得到判定为 true 的元素总数 L；
+// 此时 [first, first + L) 中判定为 false 的元素与 [first + L, last) 中判定为 true 的元素个数相等，
+// 再把两者按顺序成对交换，交换也按段并行。返回分界点，不保证元素的原始相对位置
+/*****************************************************************************************/
+struct partition_span
+{
+  size_t first;  // 错位元素所在区间 [first, last)，下标相对于整个区间
+  size_t last;
+  size_t offset; // 之前各区间的错位元素个数之和
+};
+
+// 在 spans 中找到第 k 个错位元素所在的区间
+inline size_t find_partition_span(const mystl::vector<partition_span>& spans, size_t k)
+{
+  size_t lo = 0, hi = spans.size();
+  while (hi - lo > 1)
+  {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (spans[mid].offset <= k)
+      lo = mid;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+template <class RandomIter, class UnaryPredicate>
+RandomIter parallel_partition_aux(thread_pool& pool, RandomIter first, RandomIter last,
+                                  UnaryPredicate pred)
+{
+  const size_t n = static_cast<size_t>(last - first);
+  size_t blocks = pool.size() * 4;
+  if (blocks > n / kParallelBlockSize)
+    blocks = n / kParallelBlockSize;
+  if (blocks < 2)
+    return mystl::partition(first, last, pred);
+
+  // 第 i 块为 [begin(i), begin(i + 1))，长度相差不超过 1
+  const size_t q = n / blocks, r = n % blocks;
+  auto block_begin = [q, r](size_t i) { return q * i + (i < r ? i : r); };
+
+  mystl::vector<size_t> cuts(blocks, 0);
+  mystl::parallel_for(pool, 0, blocks, 1, [&](size_t b, size_t e)
+  {
+    for (size_t i = b; i < e; ++i)
+    {
+      auto cut = mystl::partition(first + block_begin(i), first + block_begin(i + 1), pred);
+      cuts[i] = static_cast<size_t>(cut - first);
+    }
+  });
+
+  size_t len = 0;
+  for (size_t i = 0; i < blocks; ++i)
+    len += cuts[i] - block_begin(i);
+
+  // 左段中的 false 元素与右段中的 true 元素
+  mystl::vector<partition_span> left_spans, right_spans;
+  size_t misplaced = 0, right_count = 0;
+  for (size_t i = 0; i < blocks; ++i)
+  {
+    const size_t bfirst = block_begin(i), blast = block_begin(i + 1);
+    const size_t false_last = blast < len ? blast : len;
+    if (cuts[i] < false_last)
+    {
+      left_spans.push_back(partition_span{ cuts[i], false_last, misplaced });
+      misplaced += false_last - cuts[i];
+    }
+    const size_t true_first = bfirst > len ? bfirst : len;
+    if (true_first < cuts[i])
+    {
+      right_spans.push_back(partition_span{ true_first, cuts[i], right_count });
+      right_count += cuts[i] - true_first;
+    }
+  }
+  MYSTL_DEBUG(misplaced == right_count);
+
+  mystl::parallel_for(pool, 0, misplaced, kParallelBlockSize, [&](size_t b, size_t e)
+  {
+    size_t li = find_partition_span(left_spans, b);
+    size_t ri = find_partition_span(right_spans, b);
+    size_t l = left_spans[li].first + (b - left_spans[li].offset);
+    size_t r = right_spans[ri].first + (b - right_spans[ri].offset);
+    for (size_t k = b; k < e; ++k)
+    {
+      mystl::iter_swap(first + l, first + r);
+      if (++l == left_spans[li].last && ++li < left_spans.size())
+        l = left_spans[li].first;
+      if (++r == right_spans[ri].last && ++ri < right_spans.size())
+        r = right_spans[ri].first;
+    }
+  });
+  return first + len;
+}
+
+/*****************************************************************************************/
+// partition / partition_copy
+// partition 由 parallel_partition_aux 完成
+// partition_copy 分两遍 : 第一遍各块判定元素并记下结果，统计判定为 true 的个数，
+// 由前缀和得到每块在两个输出区间中的起始位置，第二遍各块按记下的结果写出
+/*****************************************************************************************/
+template <class RandomIter, class UnaryPredicate>
+RandomIter partition(const parallel_policy& policy, RandomIter first, RandomIter last,
+                     UnaryPredicate unary_pred)
+{
+  return mystl::parallel_partition_aux(policy.get_pool(), first, last, unary_pred);
+}
+
+template <class RandomIter, class RandomIter1, class RandomIter2, class UnaryPredicate>
+mystl::pair<RandomIter1, RandomIter2>
+partition_copy(const parallel_policy& policy, RandomIter first, RandomIter last,
+               RandomIter1 result_true, RandomIter2 result_false, UnaryPredicate unary_pred)
+{
+  thread_pool& pool = policy.get_pool();
+  const size_t n = static_cast<size_t>(last - first);
+  if (!parallel_worthwhile(pool, n))
+    return mystl::partition_copy(first, last, result_true, result_false, unary_pred);
+
+  mystl::vector<unsigned char> flags(n);
+  size_t offset, align;
+  mystl::cache_line_alignment(flags.begin(), offset, align);
+  const parallel_chunk_plan plan(pool.size(), n, offset, align);
+
+  mystl::vector<size_t> trues(plan.count, 0);
+  mystl::run_chunks(pool, plan, [&](size_t c, size_t b, size_t e)
+  {
+    size_t count = 0;
+    auto it = first + b;
+    for (size_t i = b; i < e; ++i, ++it)
+    {
+      const bool flag = static_cast<bool>(unary_pred(*it));
+      flags[i] = flag;
+      count += flag;
+    }
+    trues[c] = count;
+  });
+
+  // 就地求出每块之前判定为 true 的元素个数
+  size_t total = 0;
+  for (size_t c = 0; c < plan.count; ++c)
+  {
+    const size_t count = trues[c];
+    trues[c] = total;
+    total += count;
+  }
+
+  mystl::run_chunks(pool, plan, [&](size_t c, size_t b, size_t e)
+  {
+    auto it = first + b;
+    auto out_true = result_true + trues[c];
+    auto out_false = result_false + (b - trues[c]);
+    for (size_t i = b; i < e; ++i, ++it)
+    {
+      if (flags[i])
+      {
+        *out_true = *it;
+        ++out_true;
+      }
+      else
+      {
+        *out_false = *it;
+        ++out_false;
+      }
+    }
+  });
+  return mystl::pair<RandomIter1, RandomIter2>(result_true + total, result_false + (n - total));
+}
+
+/*****************************************************************************************/
+// sort
+// 并行快速排序 : 取九个样本的中位数作为枢轴，大区间用 parallel_partition_aux 分割，
+// 左右两段用 parallel_invoke 并行递归；区间较小或递归过深时调用串行的 intro_sort
+// 枢轴左侧过小时说明重复元素较多，再把与枢轴相等的元素分出来，它们已经有序
+/*****************************************************************************************/
+template <class T, class Compared>
+struct sort_less_than_pivot
+{
+  const T*  pivot;
+  Compared  comp;
+
+  template <class U>
+  bool operator()(const U& x) const { return comp(x, *pivot); }
+};
+
+template <class T, class Compared>
+struct sort_not_greater_than_pivot
+{
+  const T*  pivot;
+  Compared  comp;
+
+  template <class U>
+  bool operator()(const U& x) const { return !comp(*pivot, x); }
+};
+
+// 取九个样本的中位数作为枢轴，返回一份拷贝，分割时元素会被交换
+template <class RandomIter, class Compared>
+typename iterator_traits<RandomIter>::value_type
+parallel_pivot(RandomIter first, RandomIter last, Compared comp)
+{
+  const size_t step = static_cast<size_t>(last - first) / 8;
+  return mystl::median(
+    mystl::median(*first, *(first + step), *(first + 2 * step), comp),
+    mystl::median(*(first + 3 * step), *(first + 4 * step), *(first + 5 * step), comp),
+    mystl::median(*(first + 6 * step), *(first + 7 * step), *(last - 1), comp), comp);
+}
+
+template <class RandomIter, class Compared>
+void parallel_sort_aux(thread_pool& pool, RandomIter first, RandomIter last,
+                       size_t depth_limit, Compared comp)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  const size_t n = static_cast<size_t>(last - first);
+  if (n <= kParallelSortCutoff || depth_limit == 0)
+  {
+    mystl::sort(first, last, comp);
+    return;
+  }
+  --depth_limit;
+
+  const value_type pivot = mystl::parallel_pivot(first, last, comp);
+
+  RandomIter cut, mid;
+  if (n > kParallelPartitionCutoff)
+  {
+    cut = mystl::parallel_partition_aux(pool, first, last,
+      sort_less_than_pivot<value_type, Compared>{ &pivot, comp });
+    mid = cut;
+    if (static_cast<size_t>(cut - first) < n / 16)
+    {
+      mid = mystl::parallel_partition_aux(pool, cut, last,
+        sort_not_greater_than_pivot<value_type, Compared>{ &pivot, comp });
+    }
+  }
+  else
+  {
+    cut = mystl::unchecked_partition(first, last, pivot, comp);
+    mid = cut;
+  }
+  mystl::parallel_invoke(pool,
+    [&] { mystl::parallel_sort_aux(pool, first, cut, depth_limit, comp); },
+    [&] { mystl::parallel_sort_aux(pool, mid, last, depth_limit, comp); });
+}
+
+template <class RandomIter, class Compared>
+void sort(const parallel_policy& policy, RandomIter first, RandomIter last, Compared comp)
+{
+  thread_pool& pool = policy.get_pool();
+  const size_t n = static_cast<size_t>(last - first);
+  if (n <= kParallelSortCutoff || pool.size() < 2)
+  {
+    mystl::sort(first, last, comp);
+    return;
+  }
+  mystl::parallel_sort_aux(pool, first, last, slg2(n) * 2, comp);
+}
+
+template <class RandomIter>
+void sort(const parallel_policy& policy, RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  mystl::sort(policy, first, last, mystl::less<value_type>());
+}
+
+/*****************************************************************************************/
+// nth_element
+// 并行快速选择 : 与 sort 相同的枢轴与分割，只在 nth 所在的一段继续，nth 落在与枢轴相等的元素中时结束
+// 区间较小或分割次数过多时调用串行的 nth_element
+/*****************************************************************************************/
+template <class RandomIter, class Compared>
+void nth_element(const parallel_policy& policy, RandomIter first, RandomIter nth,
+                 RandomIter last, Compared comp)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  thread_pool& pool = policy.get_pool();
+  if (nth == last)
+    return;
+  size_t depth_limit = slg2(static_cast<size_t>(last - first)) * 2;
+  while (static_cast<size_t>(last - first) > kParallelPartitionCutoff &&
+         pool.size() > 1 && depth_limit-- > 0)
+  {
+    const size_t n = static_cast<size_t>(last - first);
+    const value_type pivot = mystl::parallel_pivot(first, last, comp);
+    RandomIter cut = mystl::parallel_partition_aux(pool, first, last,
+      sort_less_than_pivot<value_type, Compared>{ &pivot, comp });
+    if (nth < cut)
+    {
+      last = cut;
+      continue;
+    }
+    RandomIter mid = cut;
+    if (static_cast<size_t>(cut - first) < n / 16)
+    {
+      mid = mystl::parallel_partition_aux(pool, cut, last,
+        sort_not_greater_than_pivot<value_type, Compared>{ &pivot, comp });
+      if (nth < mid)
+        return;
+    }
+    first = mid;
+  }
+  mystl::nth_element(first, nth, last, comp);
+}
+
+template <class RandomIter>
+void nth_element(const parallel_policy& policy, RandomIter first, RandomIter nth,
+                 RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  mystl::nth_element(policy, first, nth, last, mystl::less<value_type>());
+}
+
+/*****************************************************************************************/
+// merge / inplace_merge
+// merge path : 输出的第 d 个位置之前来自第一个区间的元素个数可以二分求出，
+// 因此把输出切成若干块，每块两端各做一次二分，得到两个输入中对应的子区间，各块独立地串行合并
+// inplace_merge 先把整个区间并行移动构造到未初始化的缓冲区，再并行地移动合并回原区间；
+// 元素的移动构造可能抛出异常或缓冲区申请失败时退化为串行版本
+/*****************************************************************************************/
+// 合并 [first1, first1 + n1) 与 [first2, first2 + n2) 时，输出的前 diag 个元素中来自第一个区间的个数
+// 相等的元素中第一个区间的在前，与串行的 merge 一致
+template <class RandomIter1, class RandomIter2, class Compared>
+size_t merge_path_split(RandomIter1 first1, size_t n1, RandomIter2 first2, size_t n2,
+                        size_t diag, Compared comp)
+{
+  size_t lo = diag > n2 ? diag - n2 : 0;
+  size_t hi = diag < n1 ? diag : n1;
+  while (lo < hi)
+  {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (comp(*(first2 + (diag - mid - 1)), *(first1 + mid)))
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return lo;
+}
+
+// 与 merge 相同，但把元素移动赋值到 result
+template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+OutputIter move_merge(InputIter1 first1, InputIter1 last1,
+                      InputIter2 first2, InputIter2 last2,
+                      OutputIter result, Compared comp)
+{
+  while (first1 != last1 && first2 != last2)
+  {
+    if (comp(*first2, *first1))
+    {
+      *result = mystl::move(*first2);
+      ++first2;
+    }
+    else
+    {
+      *result = mystl::move(*first1);
+      ++first1;
+    }
+    ++result;
+  }
+  return mystl::move(first2, last2, mystl::move(first1, last1, result));
+}
+
+// 按 Move 选择复制合并或移动合并
+template <class RandomIter1, class RandomIter2, class RandomIter3, class Compared>
+void merge_chunk(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2,
+                 RandomIter3 result, Compared comp, std::false_type)
+{
+  mystl::merge(first1, last1, first2, last2, result, comp);
+}
+
+template <class RandomIter1, class RandomIter2, class RandomIter3, class Compared>
+void merge_chunk(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2,
+                 RandomIter3 result, Compared comp, std::true_type)
+{
+  mystl::move_merge(first1, last1, first2, last2, result, comp);
+}
+
+template <class RandomIter1, class RandomIter2, class RandomIter3, class Compared, class Move>
+RandomIter3 parallel_merge_aux(thread_pool& pool, RandomIter1 first1, RandomIter1 last1,
+                               RandomIter2 first2, RandomIter2 last2,
+                               RandomIter3 result, Compared comp, Move move)
+{
+  const size_t n1 = static_cast<size_t>(last1 - first1);
+  const size_t n2 = static_cast<size_t>(last2 - first2);
+  size_t offset, align;
+  mystl::cache_line_alignment(result, offset, align);
+  mystl::parallel_chunks(pool, n1 + n2, offset, align, [&](size_t b, size_t e)
+  {
+    const size_t i1 = mystl::merge_path_split(first1, n1, first2, n2, b, comp);
+    const size_t j1 = mystl::merge_path_split(first1, n1, first2, n2, e, comp);
+    mystl::merge_chunk(first1 + i1, first1 + j1, first2 + (b - i1), first2 + (e - j1),
+                       result + b, comp, move);
+  });
+  return result + (n1 + n2);
+}
+
+template <class RandomIter1, class RandomIter2, class RandomIter3, class Compared>
+RandomIter3 merge(const parallel_policy& policy, RandomIter1 first1, RandomIter1 last1,
+                  RandomIter2 first2, RandomIter2 last2, RandomIter3 result, Compared comp)
+{
+  thread_pool& pool = policy.get_pool();
+  if (!parallel_worthwhile(pool, static_cast<size_t>((last1 - first1) + (last2 - first2))))
+    return mystl::merge(first1, last1, first2, last2, result, comp);
+  return mystl::parallel_merge_aux(pool, first1, last1, first2, last2, result, comp,
+                                   std::false_type());
+}
+
+template <class RandomIter1, class RandomIter2, class RandomIter3>
+RandomIter3 merge(const parallel_policy& policy, RandomIter1 first1, RandomIter1 last1,
+                  RandomIter2 first2, RandomIter2 last2, RandomIter3 result)
+{
+  typedef typename iterator_traits<RandomIter1>::value_type value_type;
+  return mystl::merge(policy, first1, last1, first2, last2, result, mystl::less<value_type>());
+}
+
+// inplace_merge 的未初始化缓冲区，[p, p + n) 上是已经构造的元素
+// 正常结束时由调用方并行析构并把 n 置 0，合并抛出异常时由析构函数串行析构
+template <class T>
+struct parallel_merge_buffer
+{
+  T*     p;
+  size_t n;
+
+  explicit parallel_merge_buffer(size_t len)
+    :p(static_cast<T*>(::operator new(len * sizeof(T), std::nothrow))), n(0)
+  {
+  }
+
+  ~parallel_merge_buffer()
+  {
+    mystl::destroy(p, p + n);
+    ::operator delete(p);
+  }
+
+  parallel_merge_buffer(const parallel_merge_buffer&) = delete;
+  parallel_merge_buffer& operator=(const parallel_merge_buffer&) = delete;
+};
+
+template <class RandomIter, class Compared>
+void inplace_merge(const parallel_policy& policy, RandomIter first, RandomIter middle,
+                   RandomIter last, Compared comp)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  thread_pool& pool = policy.get_pool();
+  const size_t n = static_cast<size_t>(last - first);
+  // 并行的移动构造没有办法在中途失败后撤销，因此只对不抛出异常的移动构造并行
+  if (first == middle || middle == last || !parallel_worthwhile(pool, n) ||
+      !std::is_nothrow_move_constructible<value_type>::value)
+  {
+    mystl::inplace_merge(first, middle, last, comp);
+    return;
+  }
+  parallel_merge_buffer<value_type> buf(n);
+  if (buf.p == nullptr)
+  {
+    mystl::inplace_merge(first, middle, last, comp);
+    return;
+  }
+  value_type* p = buf.p;
+  size_t offset, align;
+  mystl::cache_line_alignment(p, offset, align);
+  mystl::parallel_chunks(pool, n, offset, align, [&](size_t b, size_t e)
+  {
+    mystl::uninitialized_move(first + b, first + e, p + b);
+  });
+  buf.n = n;
+  const size_t n1 = static_cast<size_t>(middle - first);
+  mystl::parallel_merge_aux(pool, p, p + n1, p + n1, p + n, first, comp, std::true_type());
+  if (!std::is_trivially_destructible<value_type>::value)
+  {
+    mystl::parallel_chunks(pool, n, offset, align, [&](size_t b, size_t e)
+    {
+      mystl::destroy(p + b, p + e);
+    });
+  }
+  buf.n = 0;
+}
+
+template <class RandomIter>
+void inplace_merge(const parallel_policy& policy, RandomIter first, RandomIter middle,
+                   RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  mystl::inplace_merge(policy, first, middle, last, mystl::less<value_type>());
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_PARALLEL_ALGO_H_
@@ -0,0 +1,259 @@
+#ifndef TINYSTL_PARALLEL_NUMERIC_H_
+#define TINYSTL_PARALLEL_NUMERIC_H_
+
+// 这个头文件包含了 numeric.h 中 reduce / transform_reduce / inclusive_scan / exclusive_scan 的并行版本
+// 第一个参数为执行策略，要求随机访问迭代器，运算需满足结合律；区间较小时退化为串行版本
+//
+// reduce / transform_reduce : 各块独立归约，块的结果再按二叉树两两合并
+// inclusive_scan / exclusive_scan : 两遍扫描
+//   第一遍各块并行求出块内的归约结果，串行求出每块的起始值
+//   第二遍各块从自己的起始值开始并行扫描并写出，两遍使用相同的块，result 可以与 first 相同
+
+#include "numeric.h"
+#include "parallel_algo.h"
+#include "vector.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// parallel_reduce_aux
+// leaf(b, e) 返回非空区间 [b, e) 的归约结果，各块的结果按二叉树合并后再与 init 合并
+/*****************************************************************************************/
+template <class T, class BinaryOp, class Leaf>
+T parallel_reduce_aux(thread_pool& pool, size_t n, T init, BinaryOp reduce_op, const Leaf& leaf)
+{
+  const parallel_chunk_plan plan(pool.size(), n, 0, 1);
+  mystl::vector<T> partial(plan.count, init);
+  mystl::run_chunks(pool, plan, [&](size_t c, size_t b, size_t e) { partial[c] = leaf(b, e); });
+  for (size_t step = 1; step < plan.count; step *= 2)
+  {
+    for (size_t i = 0; i + step < plan.count; i += 2 * step)
+      partial[i] = reduce_op(partial[i], partial[i + step]);
+  }
+  return reduce_op(init, partial[0]);
+}
+
+/*****************************************************************************************/
+// reduce
+/*****************************************************************************************/
+template <class RandomIter, class T, class BinaryOp>
+T reduce(const parallel_policy& policy, RandomIter first, RandomIter last, T init,
+         BinaryOp binary_op)
+{
+  thread_pool& pool = policy.get_pool();
+  const size_t n = static_cast<size_t>(last - first);
+  if (!parallel_worthwhile(pool, n))
+    return mystl::reduce(first, last, init, binary_op);
+  return mystl::parallel_reduce_aux(pool, n, init, binary_op, [&](size_t b, size_t e) -> T
+  {
+    auto it = first + b;
+    T acc = *it;
+    for (++it, ++b; b < e; ++b, ++it)
+      acc = binary_op(acc, *it);
+    return acc;
+  });
+}
+
+template <class RandomIter, class T>
+T reduce(const parallel_policy& policy, RandomIter first, RandomIter last, T init)
+{
+  return mystl::reduce(policy, first, last, init, mystl::plus<T>());
+}
+
+template <class RandomIter>
+typename iterator_traits<RandomIter>::value_type
+reduce(const parallel_policy& policy, RandomIter first, RandomIter last)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  return mystl::reduce(policy, first, last, mystl::identity_element(mystl::plus<value_type>()),
+                       mystl::plus<value_type>());
+}
+
+/*****************************************************************************************/
+// transform_reduce
+/*****************************************************************************************/
+template <class RandomIter1, class RandomIter2, class T, class BinaryOp1, class BinaryOp2>
+T transform_reduce(const parallel_policy& policy, RandomIter1 first1, RandomIter1 last1,
+                   RandomIter2 first2, T init, BinaryOp1 reduce_op, BinaryOp2 transform_op)
+{
+  thread_pool& pool = policy.get_pool();
+  const size_t n = static_cast<size_t>(last1 - first1);
+  if (!parallel_worthwhile(pool, n))
+    return mystl::transform_reduce(first1, last1, first2, init, reduce_op, transform_op);
+  return mystl::parallel_reduce_aux(pool, n, init, reduce_op, [&](size_t b, size_t e) -> T
+  {
+    auto it1 = first1 + b;
+    auto it2 = first2 + b;
+    T acc = transform_op(*it1, *it2);
+    for (++it1, ++it2, ++b; b < e; ++b, ++it1, ++it2)
+      acc = reduce_op(acc, transform_op(*it1, *it2));
+    return acc;
+  });
+}
+
+template <class RandomIter1, class RandomIter2, class T>
+T transform_reduce(const parallel_policy& policy, RandomIter1 first1, RandomIter1 last1,
+                   RandomIter2 first2, T init)
+{
+  return mystl::transform_reduce(policy, first1, last1, first2, init,
+                                 mystl::plus<T>(), mystl::multiplies<T>());
+}
+
+template <class RandomIter, class T, class BinaryOp, class UnaryOp>
+T transform_reduce(const parallel_policy& policy, RandomIter first, RandomIter last, T init,
+                   BinaryOp reduce_op, UnaryOp transform_op)
+{
+  thread_pool& pool = policy.get_pool();
+  const size_t n = static_cast<size_t>(last - first);
+  if (!parallel_worthwhile(pool, n))
+    return mystl::transform_reduce(first, last, init, reduce_op, transform_op);
+  return mystl::parallel_reduce_aux(pool, n, init, reduce_op, [&](size_t b, size_t e) -> T
+  {
+    auto it = first + b;
+    T acc = transform_op(*it);
+    for (++it, ++b; b < e; ++b, ++it)
+      acc = reduce_op(acc, transform_op(*it));
+    return acc;
+  });
+}
+
+/*****************************************************************************************/
+// parallel_scan_aux
+// 两遍扫描的公共部分 : 求出每块的起始值，然后并行调用 scan(b, e, start)
+// start 指向块的起始值，没有 init 时第 0 块没有起始值，start 为空指针
+/*****************************************************************************************/
+template <class T, class RandomIter, class RandomOutIter, class BinaryOp, class Scan>
+void parallel_scan_aux(thread_pool& pool, RandomIter first, size_t n, RandomOutIter result,
+                       BinaryOp binary_op, const T* init, const Scan& scan)
+{
+  size_t offset, align;
+  mystl::cache_line_alignment(result, offset, align);
+  const parallel_chunk_plan plan(pool.size(), n, offset, align);
+
+  // 第一遍 : 除最后一块外求出每块的归约结果
+  mystl::vector<T> sums(plan.count, *first);
+  mystl::run_chunks(pool, plan, [&](size_t c, size_t b, size_t e)
+  {
+    if (c + 1 == plan.count)
+      return;
+    auto it = first + b;
+    T acc = *it;
+    for (++it, ++b; b < e; ++b, ++it)
+      acc = binary_op(acc, *it);
+    sums[c] = acc;
+  });
+
+  // 串行求出每块的起始值，就地覆盖 sums
+  T prev = init != nullptr ? binary_op(*init, sums[0]) : sums[0];
+  if (init != nullptr)
+    sums[0] = *init;
+  for (size_t c = 1; c < plan.count; ++c)
+  {
+    const T sum = sums[c];
+    sums[c] = prev;
+    prev = binary_op(prev, sum);
+  }
+
+  // 第二遍 : 各块从起始值开始扫描
+  mystl::run_chunks(pool, plan, [&](size_t c, size_t b, size_t e)
+  {
+    scan(b, e, (c == 0 && init == nullptr) ? nullptr : &sums[c]);
+  });
+}
+
+/*****************************************************************************************/
+// inclusive_scan
+/*****************************************************************************************/
+template <class RandomIter, class RandomOutIter, class BinaryOp, class T>
+RandomOutIter inclusive_scan(const parallel_policy& policy, RandomIter first, RandomIter last,
+                             RandomOutIter result, BinaryOp binary_op, T init)
+{
+  thread_pool& pool = policy.get_pool();
+  const size_t n = static_cast<size_t>(last - first);
+  if (!parallel_worthwhile(pool, n))
+    return mystl::inclusive_scan(first, last, result, binary_op, init);
+  mystl::parallel_scan_aux<T>(pool, first, n, result, binary_op, &init,
+    [&](size_t b, size_t e, const T* start)
+  {
+    auto it = first + b;
+    auto out = result + b;
+    T acc = *start;
+    for (; b < e; ++b, ++it, ++out)
+    {
+      acc = binary_op(acc, *it);
+      *out = acc;
+    }
+  });
+  return result + n;
+}
+
+template <class RandomIter, class RandomOutIter, class BinaryOp>
+RandomOutIter inclusive_scan(const parallel_policy& policy, RandomIter first, RandomIter last,
+                             RandomOutIter result, BinaryOp binary_op)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  thread_pool& pool = policy.get_pool();
+  const size_t n = static_cast<size_t>(last - first);
+  if (!parallel_worthwhile(pool, n))
+    return mystl::inclusive_scan(first, last, result, binary_op);
+  mystl::parallel_scan_aux<value_type>(pool, first, n, result, binary_op, nullptr,
+    [&](size_t b, size_t e, const value_type* start)
+  {
+    auto it = first + b;
+    auto out = result + b;
+    value_type acc = start != nullptr ? binary_op(*start, *it) : *it;
+    *out = acc;
+    for (++b, ++it, ++out; b < e; ++b, ++it, ++out)
+    {
+      acc = binary_op(acc, *it);
+      *out = acc;
+    }
+  });
+  return result + n;
+}
+
+template <class RandomIter, class RandomOutIter>
+RandomOutIter inclusive_scan(const parallel_policy& policy, RandomIter first, RandomIter last,
+                             RandomOutIter result)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  return mystl::inclusive_scan(policy, first, last, result, mystl::plus<value_type>());
+}
+
+/*****************************************************************************************/
+// exclusive_scan
+/*****************************************************************************************/
+template <class RandomIter, class RandomOutIter, class T, class BinaryOp>
+RandomOutIter exclusive_scan(const parallel_policy& policy, RandomIter first, RandomIter last,
+                             RandomOutIter result, T init, BinaryOp binary_op)
+{
+  thread_pool& pool = policy.get_pool();
+  const size_t n = static_cast<size_t>(last - first);
+  if (!parallel_worthwhile(pool, n))
+    return mystl::exclusive_scan(first, last, result, init, binary_op);
+  mystl::parallel_scan_aux<T>(pool, first, n, result, binary_op, &init,
+    [&](size_t b, size_t e, const T* start)
+  {
+    auto it = first + b;
+    auto out = result + b;
+    T acc = *start;
+    for (; b < e; ++b, ++it, ++out)
+    {
+      T tmp = binary_op(acc, *it);  // 先读出 *it，result 可以与 first 相同
+      *out = acc;
+      acc = tmp;
+    }
+  });
+  return result + n;
+}
+
+template <class RandomIter, class RandomOutIter, class T>
+RandomOutIter exclusive_scan(const parallel_policy& policy, RandomIter first, RandomIter last,
+                             RandomOutIter result, T init)
+{
+  return mystl::exclusive_scan(policy, first, last, result, init, mystl::plus<T>());
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_PARALLEL_NUMERIC_H_
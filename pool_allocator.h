@@ -0,0 +1,320 @@
+#ifndef TINYSTL_POOL_ALLOCATOR_H_
+#define TINYSTL_POOL_ALLOCATOR_H_
+
+// 这个头文件包含了一个模板类 pool_allocator，用于节点式容器的单个节点的分配
+// 接口与 mystl::allocator 相同，只有 allocate() / allocate(1) 走内存池，其余情况直接使用 ::operator new
+//
+// 内存池按节点的大小与对齐分为不同的规格，同一规格的所有类型共用一个池：
+//   每个线程有自己的空闲链表与当前块，分配与回收都不加锁
+//   空闲链表为空时先从全局链表取一批节点，再从当前块上切出节点，当前块用完时向系统申请新块，
+//   块的大小按倍数增长直到上限；申请到的块挂在全局的链表上，不再还给系统
+//   线程的空闲链表超过两批时把一批节点交给全局链表，线程退出时交出全部空闲节点与当前块的剩余部分，
+//   全局链表由互斥锁保护，每次只搬一批节点
+// 因此节点可以在同规格的容器之间转移；在一个线程分配、在另一个线程回收的节点经过全局链表回到分配的线程，
+// 每个线程缓存的空闲节点不超过两批
+// 线程缓存析构之后 (例如主线程退出后析构的静态容器) 不再使用它，回收的节点直接交给全局链表，
+// 分配也直接从全局链表或新块中取
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+#include "construct.h"
+#include "utils.h"
+
+namespace mystl
+{
+
+namespace pool_detail
+{
+
+struct free_node
+{
+  free_node* next;
+};
+
+// 所有规格共用的块链表，块的开头保存下一个块的地址
+inline std::atomic<void*>& chunk_list() noexcept
+{
+  static std::atomic<void*> head(nullptr);
+  return head;
+}
+
+// 节点大小为 Size、对齐为 Align 的内存池
+template <size_t Size, size_t Align>
+class node_pool
+{
+public:
+  static constexpr size_t node_size = (Size + Align - 1) / Align * Align;
+  static constexpr size_t header_size = (sizeof(void*) + Align - 1) / Align * Align;
+  static constexpr size_t first_chunk_nodes = 32;
+  static constexpr size_t max_chunk_nodes = 4096;
+  static constexpr size_t batch_nodes = 64;  // 线程与全局链表之间每次搬动的节点数
+
+private:
+  // 各线程共用的空闲链表
+  // head 只在持有锁时修改，分配前可以不加锁地读它来判断是否为空
+  struct central_list
+  {
+    std::mutex              mutex;
+    std::atomic<free_node*> head;
+
+    central_list() noexcept :head(nullptr) {}
+  };
+
+  // 不析构，线程退出时 (包括主线程在静态对象析构之后) 仍然可以交还节点
+  static central_list& central() noexcept
+  {
+    static central_list* list = new central_list;
+    return *list;
+  }
+
+  struct local_cache
+  {
+    free_node* free_list;
+    size_t     count;       // free_list 中的节点数
+    char*      cur;         // 当前块上尚未切出的部分
+    char*      end;
+    size_t     chunk_nodes; // 下一个块的节点数
+
+    local_cache() noexcept
+      :free_list(nullptr), count(0), cur(nullptr), end(nullptr), chunk_nodes(first_chunk_nodes)
+    {
+    }
+
+    // 线程退出时把当前块剩余的部分切成节点，连同空闲链表一起交给全局链表
+    ~local_cache()
+    {
+      torn_down() = true;
+      for (; cur != end; cur += node_size)
+      {
+        free_node* n = reinterpret_cast<free_node*>(cur);
+        n->next = free_list;
+        free_list = n;
+      }
+      if (free_list == nullptr)
+        return;
+      free_node* tail = free_list;
+      while (tail->next != nullptr)
+        tail = tail->next;
+      push_central(free_list, tail);
+      free_list = nullptr;
+    }
+  };
+
+  static local_cache& local() noexcept
+  {
+    static thread_local local_cache cache;
+    return cache;
+  }
+
+  // 本线程的缓存是否已经析构，平凡析构的 thread_local 在线程退出的整个过程中都可以读写
+  static bool& torn_down() noexcept
+  {
+    static thread_local bool flag = false;
+    return flag;
+  }
+
+public:
+  static void* allocate()
+  {
+    if (torn_down())
+      return allocate_orphan();
+    local_cache& c = local();
+    if (c.free_list == nullptr)
+      pop_central(c);
+    if (c.free_list != nullptr)
+    {
+      free_node* p = c.free_list;
+      c.free_list = p->next;
+      --c.count;
+      return p;
+    }
+    if (c.cur == c.end)
+      refill(c);
+    void* p = c.cur;
+    c.cur += node_size;
+    return p;
+  }
+
+  static void deallocate(void* p) noexcept
+  {
+    free_node* n = static_cast<free_node*>(p);
+    if (torn_down())
+    {
+      push_central(n, n);
+      return;
+    }
+    local_cache& c = local();
+    n->next = c.free_list;
+    c.free_list = n;
+    if (++c.count >= 2 * batch_nodes)
+      release_batch(c);
+  }
+
+private:
+  // 把空闲链表头部的一批节点交给全局链表
+  static void release_batch(local_cache& c) noexcept
+  {
+    free_node* head = c.free_list;
+    free_node* tail = head;
+    for (size_t i = 1; i < batch_nodes; ++i)
+      tail = tail->next;
+    c.free_list = tail->next;
+    c.count -= batch_nodes;
+    push_central(head, tail);
+  }
+
+  static void push_central(free_node* head, free_node* tail) noexcept
+  {
+    central_list& g = central();
+    std::lock_guard<std::mutex> lock(g.mutex);
+    tail->next = g.head.load(std::memory_order_relaxed);
+    g.head.store(head, std::memory_order_relaxed);
+  }
+
+  // 从全局链表取至多一批节点放进空的线程空闲链表
+  static void pop_central(local_cache& c) noexcept
+  {
+    central_list& g = central();
+    if (g.head.load(std::memory_order_relaxed) == nullptr)
+      return;
+    std::lock_guard<std::mutex> lock(g.mutex);
+    free_node* head = g.head.load(std::memory_order_relaxed);
+    if (head == nullptr)
+      return;
+    free_node* tail = head;
+    size_t n = 1;
+    for (; n < batch_nodes && tail->next != nullptr; ++n)
+      tail = tail->next;
+    g.head.store(tail->next, std::memory_order_relaxed);
+    tail->next = nullptr;
+    c.free_list = head;
+    c.count = n;
+  }
+
+  // 缓存析构之后的分配 : 从全局链表取一个节点，全局链表为空时申请只有一个节点的块
+  static void* allocate_orphan()
+  {
+    central_list& g = central();
+    if (g.head.load(std::memory_order_relaxed) != nullptr)
+    {
+      std::lock_guard<std::mutex> lock(g.mutex);
+      free_node* head = g.head.load(std::memory_order_relaxed);
+      if (head != nullptr)
+      {
+        g.head.store(head->next, std::memory_order_relaxed);
+        return head;
+      }
+    }
+    return new_chunk(1);
+  }
+
+  static void refill(local_cache& c)
+  {
+    c.cur = new_chunk(c.chunk_nodes);
+    c.end = c.cur + node_size * c.chunk_nodes;
+    if (c.chunk_nodes < max_chunk_nodes)
+      c.chunk_nodes *= 2;
+  }
+
+  // 申请一个能放下 nodes 个节点的块并挂到块链表上，返回第一个节点的位置
+  static char* new_chunk(size_t nodes)
+  {
+    const size_t bytes = header_size + node_size * nodes;
+    char* chunk = static_cast<char*>(::operator new(bytes));
+    void** link = reinterpret_cast<void**>(chunk);
+    auto& head = chunk_list();
+    *link = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(*link, chunk, std::memory_order_release,
+                                       std::memory_order_relaxed))
+    {
+    }
+    return chunk + header_size;
+  }
+};
+
+// 节点的对齐至少要能放下 free_node
+constexpr size_t pool_align(size_t align) noexcept
+{
+  return align < alignof(free_node) ? alignof(free_node) : align;
+}
+
+} // namespace pool_detail
+
+// 模板类：pool_allocator
+// 模板参数代表数据类型，对齐超过 max_align_t 的类型不使用内存池
+template <class T>
+class pool_allocator
+{
+public:
+  typedef T            value_type;
+  typedef T*           pointer;
+  typedef const T*     const_pointer;
+  typedef T&           reference;
+  typedef const T&     const_reference;
+  typedef size_t       size_type;
+  typedef ptrdiff_t    difference_type;
+
+private:
+  static constexpr bool use_pool = alignof(T) <= alignof(std::max_align_t);
+  typedef pool_detail::node_pool<sizeof(T), pool_detail::pool_align(alignof(T))> pool_type;
+
+public:
+  static T*   allocate()
+  { return allocate_node(m_bool_constant<use_pool>()); }
+  static T*   allocate(size_type n)
+  {
+    if (n == 0)
+      return nullptr;
+    if (n == 1)
+      return allocate();
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  static void deallocate(T* ptr)
+  {
+    if (ptr == nullptr)
+      return;
+    deallocate_node(ptr, m_bool_constant<use_pool>());
+  }
+  static void deallocate(T* ptr, size_type n)
+  {
+    if (ptr == nullptr)
+      return;
+    if (n == 1)
+      deallocate(ptr);
+    else
+      ::operator delete(ptr);
+  }
+
+  static void construct(T* ptr)
+  { mystl::construct(ptr); }
+  static void construct(T* ptr, const T& value)
+  { mystl::construct(ptr, value); }
+  static void construct(T* ptr, T&& value)
+  { mystl::construct(ptr, mystl::move(value)); }
+  template <class... Args>
+  static void construct(T* ptr, Args&& ...args)
+  { mystl::construct(ptr, mystl::forward<Args>(args)...); }
+
+  static void destroy(T* ptr)
+  { mystl::destroy(ptr); }
+  static void destroy(T* first, T* last)
+  { mystl::destroy(first, last); }
+
+private:
+  static T*   allocate_node(m_true_type)
+  { return static_cast<T*>(pool_type::allocate()); }
+  static T*   allocate_node(m_false_type)
+  { return static_cast<T*>(::operator new(sizeof(T))); }
+
+  static void deallocate_node(T* ptr, m_true_type)
+  { pool_type::deallocate(ptr); }
+  static void deallocate_node(T* ptr, m_false_type)
+  { ::operator delete(ptr); }
+};
+
+} // namespace mystl
+#endif // !MYTINYSTL_POOL_ALLOCATOR_H_
@@ -1,21 +1,26 @@
 #ifndef MYTINYSTL_QUEUE_H_
 #define MYTINYSTL_QUEUE_H_
 
-// 这个头文件包含了两个模板类 queue 和 priority_queue
-// queue          : 队列
-// 优先队列的实现有问题,故暂时删除
+// 这个头文件包含了四个模板类 queue、priority_queue、minmax_priority_queue 和 indexed_priority_queue
+// queue                  : 队列
+// priority_queue         : 优先队列，底层为 d 叉堆，缺省为二叉堆
+// minmax_priority_queue  : 双端优先队列，底层为最小-最大堆，可同时取出最小与最大元素
+// indexed_priority_queue : 带位置索引的优先队列，支持 O(logn) 的 decrease_key / increase_key / erase
 #include "deque.h"
+#include "circular_buffer.h"
 #include "vector.h"
 #include "functional.h"
 #include "heap_algo.h"
+#include "exceptdef.h"
 
 namespace mystl
 {
 
 // 模板类 queue
 //适配器,不是容器
-// 参数一代表数据类型，参数二代表底层容器类型，缺省使用 mystl::deque 作为底层容器
-template <class T, class Container = mystl::deque<T>>
+// 参数一代表数据类型，参数二代表底层容器类型，缺省使用 mystl::circular_buffer 作为底层容器
+// 也可以指定 mystl::deque<T> 等任何支持 front/back/push_back/pop_front 的容器
+template <class T, class Container = mystl::circular_buffer<T>>
 class queue
 {
 public:
@@ -176,6 +181,576 @@ void swap(queue<T, Container>& lhs, queue<T, Container>& rhs) noexcept(noexcept(
 
 /*****************************************************************************************/
 
+// 模板类 priority_queue
+// 参数一代表数据类型，参数二代表容器类型，缺省使用 mystl::vector 作为底层容器
+// 参数三代表比较权值的方式，缺省使用 mystl::less 作为比较方式
+// 参数四代表堆的叉数，缺省为 2（二叉堆），可选 4、8 等以降低树高、让子节点落在同一条 cache line 上
+template <class T, class Container = mystl::vector<T>,
+  class Compare = mystl::less<typename Container::value_type>, size_t Arity = 2>
+class priority_queue
+{
+public:
+  typedef Container                           container_type;
+  typedef Compare                             value_compare;
+  // 使用底层容器的型别
+  typedef typename Container::value_type      value_type;
+  typedef typename Container::size_type       size_type;
+  typedef typename Container::reference       reference;
+  typedef typename Container::const_reference const_reference;
+
+  static constexpr size_t arity = Arity;
+
+  static_assert(std::is_same<T, value_type>::value,
+                "the value_type of Container should be same with T");
+  static_assert(Arity >= 2, "the arity of priority_queue should be at least 2");
+
+private:
+  container_type c_;     // 用底层容器来表现 priority_queue
+  value_compare  comp_;  // 权值比较的标准
+
+public:
+  // 构造、复制、移动函数
+  priority_queue() = default;
+
+  priority_queue(const Compare& c) 
+    :c_(), comp_(c) 
+  {
+  }
+
+  explicit priority_queue(size_type n)
+    :c_(n)
+  {
+    mystl::make_dary_heap<Arity>(c_.begin(), c_.end(), comp_);
+  }
+  priority_queue(size_type n, const value_type& value) 
+    :c_(n, value)
+  {
+    mystl::make_dary_heap<Arity>(c_.begin(), c_.end(), comp_);
+  }
+
+  template <class IIter>
+  priority_queue(IIter first, IIter last) 
+    :c_(first, last)
+  {
+    mystl::make_dary_heap<Arity>(c_.begin(), c_.end(), comp_);
+  }
+
+  priority_queue(std::initializer_list<T> ilist)
+    :c_(ilist.begin(), ilist.end())
+  {
+    mystl::make_dary_heap<Arity>(c_.begin(), c_.end(), comp_);
+  }
+
+  priority_queue(const Container& s)
+    :c_(s)
+  {
+    mystl::make_dary_heap<Arity>(c_.begin(), c_.end(), comp_);
+  }
+  priority_queue(Container&& s)
+    :c_(mystl::move(s))
+  {
+    mystl::make_dary_heap<Arity>(c_.begin(), c_.end(), comp_);
+  }
+
+  priority_queue(const priority_queue& rhs)
+    :c_(rhs.c_), comp_(rhs.comp_)
+  {
+  }
+  priority_queue(priority_queue&& rhs) noexcept(std::is_nothrow_move_constructible<Container>::value)
+    :c_(mystl::move(rhs.c_)), comp_(rhs.comp_)
+  {
+  }
+
+  priority_queue& operator=(const priority_queue& rhs)
+  {
+    c_ = rhs.c_;
+    comp_ = rhs.comp_;
+    return *this;
+  }
+  priority_queue& operator=(priority_queue&& rhs) noexcept(std::is_nothrow_move_assignable<Container>::value)
+  {
+    c_ = mystl::move(rhs.c_);
+    comp_ = rhs.comp_;
+    return *this;
+  }
+  priority_queue& operator=(std::initializer_list<T> ilist)
+  {
+    c_ = ilist;
+    comp_ = value_compare();
+    mystl::make_dary_heap<Arity>(c_.begin(), c_.end(), comp_);
+    return *this;
+  }
+
+  ~priority_queue() = default;
+
+public:
+
+  // 访问元素相关操作
+  const_reference top() const { return c_.front(); }
+
+  // 容量相关操作
+  bool      empty() const noexcept { return c_.empty(); }
+  size_type size()  const noexcept { return c_.size(); }
+
+  // 修改容器相关操作
+  template <class... Args>
+  void emplace(Args&& ...args)
+  {
+    c_.emplace_back(mystl::forward<Args>(args)...);
+    mystl::push_dary_heap<Arity>(c_.begin(), c_.end(), comp_);
+  }
+
+  void push(const value_type& value)
+  {
+    c_.push_back(value);
+    mystl::push_dary_heap<Arity>(c_.begin(), c_.end(), comp_);
+  }
+  void push(value_type&& value)
+  {
+    c_.push_back(mystl::move(value));
+    mystl::push_dary_heap<Arity>(c_.begin(), c_.end(), comp_);
+  }
+
+  void pop()
+  {
+    mystl::pop_dary_heap<Arity>(c_.begin(), c_.end(), comp_);
+    c_.pop_back();
+  }
+
+  void clear()
+  {
+    c_.clear();
+  }
+
+  void swap(priority_queue& rhs) noexcept(noexcept(mystl::swap(c_, rhs.c_)) &&
+                                          noexcept(mystl::swap(comp_, rhs.comp_)))
+  {
+    mystl::swap(c_, rhs.c_);
+    mystl::swap(comp_, rhs.comp_);
+  }
+
+public:
+  friend bool operator==(const priority_queue& lhs, const priority_queue& rhs)
+  {
+    return lhs.c_ == rhs.c_;
+  }
+  friend bool operator!=(const priority_queue& lhs, const priority_queue& rhs)
+  {
+    return lhs.c_ != rhs.c_;
+  }
+};
+
+template <class T, class Container, class Compare, size_t Arity>
+constexpr size_t priority_queue<T, Container, Compare, Arity>::arity;
+
+// 重载 mystl 的 swap
+template <class T, class Container, class Compare, size_t Arity>
+void swap(priority_queue<T, Container, Compare, Arity>& lhs,
+          priority_queue<T, Container, Compare, Arity>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+  lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+
+// 模板类 minmax_priority_queue
+// 参数一代表数据类型，参数二代表容器类型，缺省使用 mystl::vector 作为底层容器
+// 参数三代表比较权值的方式，缺省使用 mystl::less 作为比较方式
+// min() / max() 为 O(1)，push、pop_min、pop_max 为 O(logn)，适合有界的候选集，例如保留 top-k 并淘汰最差者
+template <class T, class Container = mystl::vector<T>,
+  class Compare = mystl::less<typename Container::value_type>>
+class minmax_priority_queue
+{
+public:
+  typedef Container                           container_type;
+  typedef Compare                             value_compare;
+  // 使用底层容器的型别
+  typedef typename Container::value_type      value_type;
+  typedef typename Container::size_type       size_type;
+  typedef typename Container::reference       reference;
+  typedef typename Container::const_reference const_reference;
+
+  static_assert(std::is_same<T, value_type>::value,
+                "the value_type of Container should be same with T");
+
+private:
+  container_type c_;     // 用底层容器来表现 minmax_priority_queue
+  value_compare  comp_;  // 权值比较的标准
+
+public:
+  // 构造、复制、移动函数
+  minmax_priority_queue() = default;
+
+  minmax_priority_queue(const Compare& c)
+    :c_(), comp_(c)
+  {
+  }
+
+  template <class IIter>
+  minmax_priority_queue(IIter first, IIter last)
+    :c_(first, last)
+  {
+    mystl::make_minmax_heap(c_.begin(), c_.end(), comp_);
+  }
+
+  minmax_priority_queue(std::initializer_list<T> ilist)
+    :c_(ilist.begin(), ilist.end())
+  {
+    mystl::make_minmax_heap(c_.begin(), c_.end(), comp_);
+  }
+
+  minmax_priority_queue(const Container& s)
+    :c_(s)
+  {
+    mystl::make_minmax_heap(c_.begin(), c_.end(), comp_);
+  }
+  minmax_priority_queue(Container&& s)
+    :c_(mystl::move(s))
+  {
+    mystl::make_minmax_heap(c_.begin(), c_.end(), comp_);
+  }
+
+  minmax_priority_queue(const minmax_priority_queue& rhs) = default;
+  minmax_priority_queue(minmax_priority_queue&& rhs) = default;
+  minmax_priority_queue& operator=(const minmax_priority_queue& rhs) = default;
+  minmax_priority_queue& operator=(minmax_priority_queue&& rhs) = default;
+
+  ~minmax_priority_queue() = default;
+
+public:
+
+  // 访问元素相关操作
+  const_reference min() const
+  {
+    MYSTL_DEBUG(!empty());
+    return c_.front();
+  }
+  const_reference max() const
+  {
+    MYSTL_DEBUG(!empty());
+    return *mystl::minmax_heap_max(c_.begin(), c_.end(), comp_);
+  }
+
+  // 容量相关操作
+  bool      empty() const noexcept { return c_.empty(); }
+  size_type size()  const noexcept { return c_.size(); }
+
+  // 修改容器相关操作
+  template <class... Args>
+  void emplace(Args&& ...args)
+  {
+    c_.emplace_back(mystl::forward<Args>(args)...);
+    mystl::push_minmax_heap(c_.begin(), c_.end(), comp_);
+  }
+
+  void push(const value_type& value)
+  {
+    c_.push_back(value);
+    mystl::push_minmax_heap(c_.begin(), c_.end(), comp_);
+  }
+  void push(value_type&& value)
+  {
+    c_.push_back(mystl::move(value));
+    mystl::push_minmax_heap(c_.begin(), c_.end(), comp_);
+  }
+
+  void pop_min()
+  {
+    MYSTL_DEBUG(!empty());
+    mystl::pop_minmax_heap_min(c_.begin(), c_.end(), comp_);
+    c_.pop_back();
+  }
+  void pop_max()
+  {
+    MYSTL_DEBUG(!empty());
+    mystl::pop_minmax_heap_max(c_.begin(), c_.end(), comp_);
+    c_.pop_back();
+  }
+
+  void clear()
+  {
+    c_.clear();
+  }
+
+  void swap(minmax_priority_queue& rhs) noexcept(noexcept(mystl::swap(c_, rhs.c_)) &&
+                                                 noexcept(mystl::swap(comp_, rhs.comp_)))
+  {
+    mystl::swap(c_, rhs.c_);
+    mystl::swap(comp_, rhs.comp_);
+  }
+};
+
+// 重载 mystl 的 swap
+template <class T, class Container, class Compare>
+void swap(minmax_priority_queue<T, Container, Compare>& lhs,
+          minmax_priority_queue<T, Container, Compare>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+  lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+
+// 模板类 indexed_priority_queue
+// 参数一代表键的类型，必须是整数，键的取值即为其在位置索引中的下标，适用于图算法中的节点编号，
+// 因此键不能为负数，push 负数的键会抛出 out_of_range，contains 对负数的键返回 false
+// 参数二代表优先级的类型，参数三代表比较优先级的方式，缺省使用 mystl::less
+// 与 priority_queue 不同，top 为 Compare 意义下最小的元素，以符合 Dijkstra / A* 中 decrease_key 的习惯用法
+// 每个键至多在队列中出现一次，pos_ 记录每个键在堆中的下标，
+// 因此 contains 为 O(1)，decrease_key、increase_key、erase 为 O(logn)，不再需要插入重复项再惰性跳过
+template <class Key, class Priority, class Compare = mystl::less<Priority>>
+class indexed_priority_queue
+{
+public:
+  typedef Key                                 key_type;
+  typedef Priority                            priority_type;
+  typedef Compare                             priority_compare;
+  typedef size_t                              size_type;
+
+  static_assert(std::is_integral<Key>::value,
+                "the key of indexed_priority_queue should be an integral type");
+
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+  // 堆中的节点，把优先级与键放在一起，比较时不必再经过一次索引
+  struct node
+  {
+    key_type      key;
+    priority_type priority;
+  };
+
+  mystl::vector<node>      heap_;  // 以 Compare 为序的二叉堆，heap_[0] 为最小者
+  mystl::vector<size_type> pos_;   // pos_[key] 为 key 在 heap_ 中的下标，不在队列中时为 npos
+  priority_compare         comp_;  // 优先级比较的标准
+
+public:
+  // 构造、复制、移动函数
+  indexed_priority_queue() = default;
+
+  explicit indexed_priority_queue(const Compare& c)
+    :heap_(), pos_(), comp_(c)
+  {
+  }
+
+  // 预先为 [0, key_count) 的键分配位置索引
+  explicit indexed_priority_queue(size_type key_count, const Compare& c = Compare())
+    :heap_(), pos_(key_count, npos), comp_(c)
+  {
+  }
+
+  indexed_priority_queue(const indexed_priority_queue& rhs) = default;
+  indexed_priority_queue(indexed_priority_queue&& rhs) = default;
+  indexed_priority_queue& operator=(const indexed_priority_queue& rhs) = default;
+  indexed_priority_queue& operator=(indexed_priority_queue&& rhs) = default;
+
+  ~indexed_priority_queue() = default;
+
+public:
+
+  // 访问元素相关操作
+  key_type             top_key()      const { MYSTL_DEBUG(!empty()); return heap_.front().key; }
+  const priority_type& top_priority() const { MYSTL_DEBUG(!empty()); return heap_.front().priority; }
+
+  const priority_type& priority(const key_type& key) const
+  {
+    MYSTL_DEBUG(contains(key));
+    return heap_[pos_[index_of(key)]].priority;
+  }
+
+  // 容量相关操作
+  bool      empty() const noexcept { return heap_.empty(); }
+  size_type size()  const noexcept { return heap_.size(); }
+
+  bool      contains(const key_type& key) const noexcept
+  {
+    if (is_negative(key, std::is_signed<key_type>()))
+      return false;
+    const auto i = index_of(key);
+    return i < pos_.size() && pos_[i] != npos;
+  }
+
+  // 为 [0, key_count) 的键预留位置索引
+  void      reserve_keys(size_type key_count)
+  {
+    if (pos_.size() < key_count)
+      pos_.resize(key_count, npos);
+  }
+
+  // 修改容器相关操作
+
+  // 插入一个不在队列中的键
+  void push(const key_type& key, const priority_type& priority)
+  {
+    THROW_OUT_OF_RANGE_IF(is_negative(key, std::is_signed<key_type>()),
+                          "the key of indexed_priority_queue can not be negative");
+    MYSTL_DEBUG(!contains(key));
+    reserve_keys(index_of(key) + 1);
+    heap_.push_back(node{ key, priority });
+    sift_up(heap_.size() - 1, 0);
+  }
+
+  // 若键已存在则更新其优先级，否则插入
+  void push_or_update(const key_type& key, const priority_type& priority)
+  {
+    if (contains(key))
+      update(key, priority);
+    else
+      push(key, priority);
+  }
+
+  // 弹出 top
+  void pop()
+  {
+    MYSTL_DEBUG(!empty());
+    remove_at(0);
+  }
+
+  // 新的优先级不大于原优先级，节点向堆顶移动
+  void decrease_key(const key_type& key, const priority_type& priority)
+  {
+    MYSTL_DEBUG(contains(key));
+    const auto hole = pos_[index_of(key)];
+    MYSTL_DEBUG(!comp_(heap_[hole].priority, priority));
+    heap_[hole].priority = priority;
+    sift_up(hole, 0);
+  }
+
+  // 新的优先级不小于原优先级，节点向叶子移动
+  void increase_key(const key_type& key, const priority_type& priority)
+  {
+    MYSTL_DEBUG(contains(key));
+    const auto hole = pos_[index_of(key)];
+    MYSTL_DEBUG(!comp_(priority, heap_[hole].priority));
+    heap_[hole].priority = priority;
+    sift_down(hole);
+  }
+
+  // 任意方向地修改优先级
+  void update(const key_type& key, const priority_type& priority)
+  {
+    MYSTL_DEBUG(contains(key));
+    const auto hole = pos_[index_of(key)];
+    if (comp_(priority, heap_[hole].priority))
+    {
+      heap_[hole].priority = priority;
+      sift_up(hole, 0);
+    }
+    else
+    {
+      heap_[hole].priority = priority;
+      sift_down(hole);
+    }
+  }
+
+  // 删除一个键，键不在队列中时返回 false
+  bool erase(const key_type& key)
+  {
+    if (!contains(key))
+      return false;
+    remove_at(pos_[index_of(key)]);
+    return true;
+  }
+
+  void clear()
+  {
+    for (size_type i = 0; i < heap_.size(); ++i)
+      pos_[index_of(heap_[i].key)] = npos;
+    heap_.clear();
+  }
+
+  void swap(indexed_priority_queue& rhs) noexcept
+  {
+    heap_.swap(rhs.heap_);
+    pos_.swap(rhs.pos_);
+    mystl::swap(comp_, rhs.comp_);
+  }
+
+private:
+  // helper functions
+
+  static size_type index_of(const key_type& key) noexcept
+  {
+    return static_cast<size_type>(key);
+  }
+
+  // 按键是否为有符号类型分派，避免无符号类型上总是为假的比较
+  static bool is_negative(const key_type& key, std::true_type) noexcept
+  { return key < 0; }
+  static bool is_negative(const key_type&, std::false_type) noexcept
+  { return false; }
+
+  void place(size_type hole, node&& value)
+  {
+    pos_[index_of(value.key)] = hole;
+    heap_[hole] = mystl::move(value);
+  }
+
+  // 与 push_heap_aux 相同的上溯过程，只是每次移动节点时同时更新位置索引
+  void sift_up(size_type hole, size_type top)
+  {
+    node value = mystl::move(heap_[hole]);
+    while (hole > top)
+    {
+      const auto parent = (hole - 1) / 2;
+      if (!comp_(value.priority, heap_[parent].priority))
+        break;
+      place(hole, mystl::move(heap_[parent]));
+      hole = parent;
+    }
+    place(hole, mystl::move(value));
+  }
+
+  // 与 adjust_heap 相同的自底向上下溯：空洞先沿较小的子节点沉到叶子，再上溯放入原节点
+  void sift_down(size_type hole)
+  {
+    const auto top = hole;
+    const auto len = heap_.size();
+    node value = mystl::move(heap_[hole]);
+    auto child = 2 * hole + 1;
+    while (child < len)
+    {
+      if (child + 1 < len && comp_(heap_[child + 1].priority, heap_[child].priority))
+        ++child;
+      place(hole, mystl::move(heap_[child]));
+      hole = child;
+      child = 2 * hole + 1;
+    }
+    heap_[hole] = mystl::move(value);
+    sift_up(hole, top);
+  }
+
+  // 用堆尾节点填补 hole，再视其优先级上溯或下溯
+  void remove_at(size_type hole)
+  {
+    pos_[index_of(heap_[hole].key)] = npos;
+    const auto last = heap_.size() - 1;
+    if (hole != last)
+    {
+      heap_[hole] = mystl::move(heap_[last]);
+      heap_.pop_back();
+      if (hole > 0 && comp_(heap_[hole].priority, heap_[(hole - 1) / 2].priority))
+        sift_up(hole, 0);
+      else
+        sift_down(hole);
+    }
+    else
+    {
+      heap_.pop_back();
+    }
+  }
+};
+
+template <class Key, class Priority, class Compare>
+constexpr typename indexed_priority_queue<Key, Priority, Compare>::size_type
+indexed_priority_queue<Key, Priority, Compare>::npos;
+
+// 重载 mystl 的 swap
+template <class Key, class Priority, class Compare>
+void swap(indexed_priority_queue<Key, Priority, Compare>& lhs,
+          indexed_priority_queue<Key, Priority, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
 
 } // namespace mystl
 #endif // !MYTINYSTL_QUEUE_H_
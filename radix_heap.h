@@ -0,0 +1,211 @@
+#ifndef TINYSTL_RADIX_HEAP_H_
+#define TINYSTL_RADIX_HEAP_H_
+
+// 这个头文件包含了一个模板类 radix_heap
+// radix_heap : 基数堆，适用于单调(取出的键不减)的整数或时间戳优先级
+//
+// 与 heap_algo.h 中基于比较的堆不同，radix_heap 按与上一次取出的键 last_ 的最高不同位把元素分桶：
+//   * 与 last_ 相等的键放在 0 号桶，否则放在 bit_width(key ^ last_) 号桶
+//   * 取出时若 0 号桶为空，找到第一个非空桶，以其中最小键为新的 last_，把该桶的元素重新分到更低的桶
+// 每个元素最多下移 bits(Key) 次，因此 push / pop 的均摊代价为 O(logC)，C 为键的取值范围，常数很小
+//
+// 使用约束：push 的键不得小于最近一次 top_key / top_value / pop 所看到的键(即 last_key())
+
+#include "vector.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// 计算 x 的有效位数，x 为 0 时返回 0
+inline size_t radix_heap_bit_width(unsigned long long x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return x == 0 ? 0 : static_cast<size_t>(64 - __builtin_clzll(x));
+#else
+  size_t n = 0;
+  for (; x != 0; x >>= 1)
+    ++n;
+  return n;
+#endif
+}
+
+// 模板类 radix_heap
+// 参数一代表键的类型，必须是整数；有符号整数会被保序地映射为无符号数
+// 参数二代表与键一同存放的值的类型
+template <class Key, class Value>
+class radix_heap
+{
+public:
+  typedef Key                                          key_type;
+  typedef Value                                        value_type;
+  typedef size_t                                       size_type;
+
+  static_assert(std::is_integral<Key>::value,
+                "the key of radix_heap should be an integral type");
+
+private:
+  typedef typename std::make_unsigned<Key>::type       ukey_type;
+
+  struct entry
+  {
+    ukey_type  key;
+    value_type value;
+  };
+
+  // 0 号桶加上每一位各一个桶
+  static constexpr size_type bucket_count = sizeof(ukey_type) * 8 + 1;
+
+  mystl::vector<entry> buckets_[bucket_count];
+  ukey_type            last_;  // 最近一次取出(或作为堆顶看到)的键
+  size_type            size_;
+
+public:
+  // 构造、复制、移动函数
+  radix_heap()
+    :last_(0), size_(0)
+  {
+  }
+
+  radix_heap(const radix_heap& rhs) = default;
+  radix_heap& operator=(const radix_heap& rhs) = default;
+
+  radix_heap(radix_heap&& rhs) noexcept
+    :last_(rhs.last_), size_(rhs.size_)
+  {
+    for (size_type i = 0; i < bucket_count; ++i)
+      buckets_[i].swap(rhs.buckets_[i]);
+    rhs.size_ = 0;
+  }
+  radix_heap& operator=(radix_heap&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      clear();
+      swap(rhs);
+    }
+    return *this;
+  }
+
+  ~radix_heap() = default;
+
+public:
+
+  // 访问元素相关操作，会把最小键整理到 0 号桶，因此不是 const 成员
+  key_type          top_key()
+  {
+    MYSTL_DEBUG(!empty());
+    pull();
+    return from_unsigned(last_);
+  }
+  value_type&       top_value()
+  {
+    MYSTL_DEBUG(!empty());
+    pull();
+    return buckets_[0].back().value;
+  }
+
+  key_type          last_key() const noexcept { return from_unsigned(last_); }
+
+  // 容量相关操作
+  bool      empty() const noexcept { return size_ == 0; }
+  size_type size()  const noexcept { return size_; }
+
+  // 修改容器相关操作
+  void push(const key_type& key, const value_type& value)
+  {
+    const auto k = to_unsigned(key);
+    MYSTL_DEBUG(!(k < last_));
+    buckets_[bucket_of(k)].push_back(entry{ k, value });
+    ++size_;
+  }
+  void push(const key_type& key, value_type&& value)
+  {
+    const auto k = to_unsigned(key);
+    MYSTL_DEBUG(!(k < last_));
+    buckets_[bucket_of(k)].push_back(entry{ k, mystl::move(value) });
+    ++size_;
+  }
+
+  void pop()
+  {
+    MYSTL_DEBUG(!empty());
+    pull();
+    buckets_[0].pop_back();
+    --size_;
+  }
+
+  void clear()
+  {
+    for (size_type i = 0; i < bucket_count; ++i)
+      buckets_[i].clear();
+    last_ = 0;
+    size_ = 0;
+  }
+
+  void swap(radix_heap& rhs) noexcept
+  {
+    for (size_type i = 0; i < bucket_count; ++i)
+      buckets_[i].swap(rhs.buckets_[i]);
+    mystl::swap(last_, rhs.last_);
+    mystl::swap(size_, rhs.size_);
+  }
+
+private:
+  // helper functions
+
+  // 有符号数翻转符号位后，其无符号表示的大小关系与原值一致
+  static ukey_type to_unsigned(key_type key) noexcept
+  {
+    return static_cast<ukey_type>(key) ^ sign_bit();
+  }
+  static key_type  from_unsigned(ukey_type key) noexcept
+  {
+    return static_cast<key_type>(key ^ sign_bit());
+  }
+  static constexpr ukey_type sign_bit() noexcept
+  {
+    return std::is_signed<key_type>::value
+      ? static_cast<ukey_type>(static_cast<ukey_type>(1) << (sizeof(ukey_type) * 8 - 1))
+      : static_cast<ukey_type>(0);
+  }
+
+  size_type bucket_of(ukey_type key) const noexcept
+  {
+    return mystl::radix_heap_bit_width(static_cast<unsigned long long>(key ^ last_));
+  }
+
+  // 保证 0 号桶非空：找到第一个非空桶，以其最小键为新的 last_，把桶中元素重新分配到更低的桶
+  void pull()
+  {
+    if (!buckets_[0].empty())
+      return;
+    size_type i = 1;
+    while (buckets_[i].empty())
+      ++i;
+    auto& bucket = buckets_[i];
+    auto new_last = bucket[0].key;
+    for (size_type j = 1; j < bucket.size(); ++j)
+    {
+      if (bucket[j].key < new_last)
+        new_last = bucket[j].key;
+    }
+    last_ = new_last;
+    for (size_type j = 0; j < bucket.size(); ++j)
+      buckets_[bucket_of(bucket[j].key)].push_back(mystl::move(bucket[j]));
+    bucket.clear();
+  }
+};
+
+template <class Key, class Value>
+constexpr typename radix_heap<Key, Value>::size_type radix_heap<Key, Value>::bucket_count;
+
+// 重载 mystl 的 swap
+template <class Key, class Value>
+void swap(radix_heap<Key, Value>& lhs, radix_heap<Key, Value>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_RADIX_HEAP_H_
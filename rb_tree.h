@@ -0,0 +1,1675 @@
+#ifndef TINYSTL_RB_TREE_H_
+#define TINYSTL_RB_TREE_H_
+
+// 这个头文件包含一个模板类 rb_tree
+// rb_tree : 红黑树，作为 map / set / multimap / multiset 的底层实现
+//
+// 树带有一个头节点 header_：header_.parent 指向根，header_.left / header_.right 指向最小 / 最大节点，
+// 根的 parent 指向 header_，end() 即为 header_，header_ 的颜色为红色，以便与根区分
+// 节点由 pool_allocator 分配，插入、删除都不移动元素，节点可以 extract 后插入到另一棵同类型的树
+//
+// 带提示的插入先检查提示位置与它的前驱 / 后继，命中时不需要从根查找，
+// 按顺序在 end() 处插入时每次为均摊 O(1)
+// 向空树插入一个区间时，先构造出所有节点，若区间按键有序则 O(n) 直接建成一棵平衡的树，
+// 否则逐个插入
+
+// 异常保证：
+// insert / emplace 做强异常安全保证，区间插入满足基本异常保证
+
+#include <initializer_list>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "concurrency.h"
+#include "functional.h"
+#include "iterator.h"
+#include "node_handle.h"
+#include "pool_allocator.h"
+#include "type_traits.h"
+#include "utils.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// rb tree 节点颜色的类型
+
+typedef bool rb_tree_color_type;
+
+static constexpr rb_tree_color_type rb_tree_red   = false;
+static constexpr rb_tree_color_type rb_tree_black = true;
+
+// rb tree 的节点设计
+
+struct rb_tree_node_base
+{
+  typedef rb_tree_node_base* base_ptr;
+
+  base_ptr           parent;  // 父节点
+  base_ptr           left;    // 左子节点
+  base_ptr           right;   // 右子节点
+  rb_tree_color_type color;   // 节点颜色
+};
+
+template <class T>
+struct rb_tree_node : public rb_tree_node_base
+{
+  typedef T value_type;
+
+  T value;  // 节点值
+
+  template <class ...Args>
+  explicit rb_tree_node(Args&& ...args)
+    :value(mystl::forward<Args>(args)...)
+  {
+  }
+};
+
+/*****************************************************************************************/
+// tree algorithm
+
+typedef rb_tree_node_base* rb_tree_base_ptr;
+
+inline rb_tree_base_ptr rb_tree_min(rb_tree_base_ptr x) noexcept
+{
+  while (x->left != nullptr)
+    x = x->left;
+  return x;
+}
+
+inline rb_tree_base_ptr rb_tree_max(rb_tree_base_ptr x) noexcept
+{
+  while (x->right != nullptr)
+    x = x->right;
+  return x;
+}
+
+// 中序遍历的下一个节点，最大节点的下一个为 header
+inline rb_tree_base_ptr rb_tree_increment(rb_tree_base_ptr x) noexcept
+{
+  if (x->right != nullptr)
+    return rb_tree_min(x->right);
+  rb_tree_base_ptr y = x->parent;
+  while (x == y->right)
+  {
+    x = y;
+    y = y->parent;
+  }
+  // 根没有右子节点且为最大节点时，x 最终停在 header 上，y 为根
+  return x->right != y ? y : x;
+}
+
+// 中序遍历的上一个节点，header 的上一个为最大节点
+inline rb_tree_base_ptr rb_tree_decrement(rb_tree_base_ptr x) noexcept
+{
+  if (x->color == rb_tree_red && x->parent->parent == x)
+    return x->right;
+  if (x->left != nullptr)
+    return rb_tree_max(x->left);
+  rb_tree_base_ptr y = x->parent;
+  while (x == y->left)
+  {
+    x = y;
+    y = y->parent;
+  }
+  return y;
+}
+
+/*---------------------------------------*\
+|       p                         p       |
+|      / \                       / \      |
+|     x   d    rotate left      y   d     |
+|    / \       ===========>    / \        |
+|   a   y                     x   c       |
+|      / \                   / \          |
+|     b   c                 a   b         |
+\*---------------------------------------*/
+// 左旋，参数一为左旋点，参数二为根节点
+inline void rb_tree_rotate_left(rb_tree_base_ptr x, rb_tree_base_ptr& root) noexcept
+{
+  rb_tree_base_ptr y = x->right;
+  x->right = y->left;
+  if (y->left != nullptr)
+    y->left->parent = x;
+  y->parent = x->parent;
+  if (x == root)
+    root = y;
+  else if (x == x->parent->left)
+    x->parent->left = y;
+  else
+    x->parent->right = y;
+  y->left = x;
+  x->parent = y;
+}
+
+/*----------------------------------------*\
+|     p                         p          |
+|    / \                       / \         |
+|   d   x      rotate right   d   y        |
+|      / \     ===========>      / \       |
+|     y   a                     b   x      |
+|    / \                           / \     |
+|   b   c                         c   a    |
+\*----------------------------------------*/
+// 右旋，参数一为右旋点，参数二为根节点
+inline void rb_tree_rotate_right(rb_tree_base_ptr x, rb_tree_base_ptr& root) noexcept
+{
+  rb_tree_base_ptr y = x->left;
+  x->left = y->right;
+  if (y->right != nullptr)
+    y->right->parent = x;
+  y->parent = x->parent;
+  if (x == root)
+    root = y;
+  else if (x == x->parent->right)
+    x->parent->right = y;
+  else
+    x->parent->left = y;
+  y->right = x;
+  x->parent = y;
+}
+
+// 插入节点后使 rb tree 重新平衡，参数一为新增节点，参数二为根节点
+//
+// case 1: 新增节点位于根节点，令新增节点为黑
+// case 2: 新增节点的父节点为黑，没有破坏平衡，直接返回
+// case 3: 父节点和叔叔节点都为红，令父节点和叔叔节点为黑，祖父节点为红，
+//         然后令祖父节点为当前节点，继续处理
+// case 4: 父节点为红，叔叔节点为 NIL 或黑色，父节点为左（右）孩子，当前节点为右（左）孩子，
+//         让父节点成为当前节点，再以当前节点为支点左（右）旋
+// case 5: 父节点为红，叔叔节点为 NIL 或黑色，父节点为左（右）孩子，当前节点为左（右）孩子，
+//         让父节点变为黑色，祖父节点变为红色，以祖父节点为支点右（左）旋
+inline void rb_tree_insert_rebalance(rb_tree_base_ptr x, rb_tree_base_ptr& root) noexcept
+{
+  x->color = rb_tree_red;
+  while (x != root && x->parent->color == rb_tree_red)
+  {
+    rb_tree_base_ptr xpp = x->parent->parent;
+    if (x->parent == xpp->left)
+    {
+      rb_tree_base_ptr uncle = xpp->right;
+      if (uncle != nullptr && uncle->color == rb_tree_red)
+      { // case 3
+        x->parent->color = rb_tree_black;
+        uncle->color = rb_tree_black;
+        xpp->color = rb_tree_red;
+        x = xpp;
+      }
+      else
+      {
+        if (x == x->parent->right)
+        { // case 4
+          x = x->parent;
+          rb_tree_rotate_left(x, root);
+        }
+        // case 5
+        x->parent->color = rb_tree_black;
+        xpp->color = rb_tree_red;
+        rb_tree_rotate_right(xpp, root);
+        break;
+      }
+    }
+    else
+    {
+      rb_tree_base_ptr uncle = xpp->left;
+      if (uncle != nullptr && uncle->color == rb_tree_red)
+      { // case 3
+        x->parent->color = rb_tree_black;
+        uncle->color = rb_tree_black;
+        xpp->color = rb_tree_red;
+        x = xpp;
+      }
+      else
+      {
+        if (x == x->parent->left)
+        { // case 4
+          x = x->parent;
+          rb_tree_rotate_right(x, root);
+        }
+        // case 5
+        x->parent->color = rb_tree_black;
+        xpp->color = rb_tree_red;
+        rb_tree_rotate_left(xpp, root);
+        break;
+      }
+    }
+  }
+  root->color = rb_tree_black;
+}
+
+// 删除节点前使 rb tree 重新平衡，参数一为要删除的节点，参数二为根节点，参数三为最小节点，参数四为最大节点
+// 有两个子节点时用后继节点 y 替换 z 的位置，返回从树上摘下的节点 z
+inline rb_tree_base_ptr rb_tree_erase_rebalance(rb_tree_base_ptr z, rb_tree_base_ptr& root,
+                                                rb_tree_base_ptr& leftmost,
+                                                rb_tree_base_ptr& rightmost) noexcept
+{
+  // y 是可能的替换节点，指向最终要删除的位置
+  rb_tree_base_ptr y = (z->left == nullptr || z->right == nullptr) ? z : rb_tree_min(z->right);
+  // x 是 y 的一个独子节点或 NIL 节点
+  rb_tree_base_ptr x = y->left != nullptr ? y->left : y->right;
+  // xp 为 x 的父节点
+  rb_tree_base_ptr xp = nullptr;
+
+  if (y != z)
+  { // z 有两个非空子节点，用 y 顶替 z
+    z->left->parent = y;
+    y->left = z->left;
+    if (y != z->right)
+    { // y 不是 z 的右子节点，x 接到 y 原来的位置
+      xp = y->parent;
+      if (x != nullptr)
+        x->parent = y->parent;
+      y->parent->left = x;
+      y->right = z->right;
+      z->right->parent = y;
+    }
+    else
+    {
+      xp = y;
+    }
+    if (root == z)
+      root = y;
+    else if (z == z->parent->left)
+      z->parent->left = y;
+    else
+      z->parent->right = y;
+    y->parent = z->parent;
+    mystl::swap(y->color, z->color);
+    y = z;
+  }
+  else
+  { // z 至多有一个子节点，x 直接顶替 z
+    xp = y->parent;
+    if (x != nullptr)
+      x->parent = y->parent;
+    if (root == z)
+      root = x;
+    else if (z == z->parent->left)
+      z->parent->left = x;
+    else
+      z->parent->right = x;
+    if (leftmost == z)
+      leftmost = x == nullptr ? xp : rb_tree_min(x);
+    if (rightmost == z)
+      rightmost = x == nullptr ? xp : rb_tree_max(x);
+  }
+
+  // 此时 y 指向要删除的节点，x 为替代节点，从 x 开始调整
+  // 如果删除的节点为红色，树的性质没有被破坏，否则按以下情况调整（x 为左子节点为例）：
+  // case 1: 兄弟节点为红色，令父节点为红，兄弟节点为黑，进行左（右）旋，继续处理
+  // case 2: 兄弟节点为黑色，且两个子节点都为黑色或 NIL，令兄弟节点为红，父节点成为当前节点，继续处理
+  // case 3: 兄弟节点为黑色，左子节点为红色或 NIL，右子节点为黑色或 NIL，
+  //         令兄弟节点为红，兄弟节点的左子节点为黑，以兄弟节点为支点右（左）旋，继续处理
+  // case 4: 兄弟节点为黑色，右子节点为红色，令兄弟节点为父节点的颜色，父节点为黑色，兄弟节点的右子节点
+  //         为黑色，以父节点为支点左（右）旋，树的性质调整完成，算法结束
+  if (y->color != rb_tree_red)
+  {
+    while (x != root && (x == nullptr || x->color == rb_tree_black))
+    {
+      if (x == xp->left)
+      {
+        rb_tree_base_ptr brother = xp->right;
+        if (brother->color == rb_tree_red)
+        { // case 1
+          brother->color = rb_tree_black;
+          xp->color = rb_tree_red;
+          rb_tree_rotate_left(xp, root);
+          brother = xp->right;
+        }
+        if ((brother->left == nullptr || brother->left->color == rb_tree_black) &&
+            (brother->right == nullptr || brother->right->color == rb_tree_black))
+        { // case 2
+          brother->color = rb_tree_red;
+          x = xp;
+          xp = xp->parent;
+        }
+        else
+        {
+          if (brother->right == nullptr || brother->right->color == rb_tree_black)
+          { // case 3
+            if (brother->left != nullptr)
+              brother->left->color = rb_tree_black;
+            brother->color = rb_tree_red;
+            rb_tree_rotate_right(brother, root);
+            brother = xp->right;
+          }
+          // case 4
+          brother->color = xp->color;
+          xp->color = rb_tree_black;
+          if (brother->right != nullptr)
+            brother->right->color = rb_tree_black;
+          rb_tree_rotate_left(xp, root);
+          break;
+        }
+      }
+      else
+      { // x 为右子节点，对称处理
+        rb_tree_base_ptr brother = xp->left;
+        if (brother->color == rb_tree_red)
+        { // case 1
+          brother->color = rb_tree_black;
+          xp->color = rb_tree_red;
+          rb_tree_rotate_right(xp, root);
+          brother = xp->left;
+        }
+        if ((brother->left == nullptr || brother->left->color == rb_tree_black) &&
+            (brother->right == nullptr || brother->right->color == rb_tree_black))
+        { // case 2
+          brother->color = rb_tree_red;
+          x = xp;
+          xp = xp->parent;
+        }
+        else
+        {
+          if (brother->left == nullptr || brother->left->color == rb_tree_black)
+          { // case 3
+            if (brother->right != nullptr)
+              brother->right->color = rb_tree_black;
+            brother->color = rb_tree_red;
+            rb_tree_rotate_left(brother, root);
+            brother = xp->left;
+          }
+          // case 4
+          brother->color = xp->color;
+          xp->color = rb_tree_black;
+          if (brother->left != nullptr)
+            brother->left->color = rb_tree_black;
+          rb_tree_rotate_right(xp, root);
+          break;
+        }
+      }
+    }
+    if (x != nullptr)
+      x->color = rb_tree_black;
+  }
+  return y;
+}
+
+/*****************************************************************************************/
+
+// rb tree 的迭代器设计
+template <class T, class Ref, class Ptr>
+struct rb_tree_iterator : public iterator<bidirectional_iterator_tag, T>
+{
+  typedef rb_tree_iterator<T, T&, T*>             iterator;
+  typedef rb_tree_iterator<T, const T&, const T*> const_iterator;
+  typedef rb_tree_iterator                        self;
+
+  typedef rb_tree_node_base*  base_ptr;
+  typedef rb_tree_node<T>*    node_ptr;
+
+  typedef T          value_type;
+  typedef Ptr        pointer;
+  typedef Ref        reference;
+  typedef size_t     size_type;
+  typedef ptrdiff_t  difference_type;
+
+  base_ptr node;  // 当前节点，end 时指向 header
+
+  // 构造、复制函数
+  rb_tree_iterator() noexcept
+    :node(nullptr) {}
+
+  explicit rb_tree_iterator(base_ptr x) noexcept
+    :node(x) {}
+
+  rb_tree_iterator(const iterator& rhs) noexcept
+    :node(rhs.node) {}
+
+  self& operator=(const iterator& rhs) noexcept
+  {
+    node = rhs.node;
+    return *this;
+  }
+
+  // 重载运算符
+  reference operator*()  const { return static_cast<node_ptr>(node)->value; }
+  pointer   operator->() const { return &(operator*()); }
+
+  self& operator++()
+  {
+    node = rb_tree_increment(node);
+    return *this;
+  }
+  self  operator++(int)
+  {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  self& operator--()
+  {
+    node = rb_tree_decrement(node);
+    return *this;
+  }
+  self  operator--(int)
+  {
+    self tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  // 重载比较操作符
+  bool operator==(const self& rhs) const { return node == rhs.node; }
+  bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+// 模板类 rb_tree
+// 参数一代表元素类型，参数二代表键值类型，参数三代表从元素中取出键值的函数对象，参数四代表键值比较类型
+template <class Value, class Key, class ExtractKey, class Compare>
+class rb_tree
+{
+public:
+  // rb_tree 的嵌套型别定义
+  typedef Key                                         key_type;
+  typedef Value                                       value_type;
+  typedef Compare                                     key_compare;
+
+  typedef rb_tree_node_base                           base_type;
+  typedef rb_tree_node_base*                          base_ptr;
+  typedef rb_tree_node<Value>                         node;
+  typedef node*                                       node_ptr;
+  typedef mystl::pool_allocator<node>                 node_allocator;
+
+  typedef mystl::allocator<Value>                     allocator_type;
+  typedef typename allocator_type::pointer            pointer;
+  typedef typename allocator_type::const_pointer      const_pointer;
+  typedef typename allocator_type::reference          reference;
+  typedef typename allocator_type::const_reference    const_reference;
+  typedef typename allocator_type::size_type          size_type;
+  typedef typename allocator_type::difference_type    difference_type;
+
+  typedef rb_tree_iterator<Value, Value&, Value*>             iterator;
+  typedef rb_tree_iterator<Value, const Value&, const Value*> const_iterator;
+  typedef mystl::reverse_iterator<iterator>                   reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator>             const_reverse_iterator;
+
+  typedef mystl::node_handle<node>                            node_type;
+  typedef node_insert_return<iterator, node_type>             insert_return_type;
+
+  allocator_type get_allocator() const { return allocator_type(); }
+  key_compare    key_comp()      const { return key_comp_; }
+
+private:
+  // 新节点的插入位置 : 作为 parent 的左子节点或右子节点
+  struct insert_pos
+  {
+    base_ptr parent;
+    bool     left;
+  };
+
+private:
+  // 用以下三个数据表现 rb tree
+  base_type   header_;      // 特殊节点，与根节点互为对方的父节点
+  size_type   node_count_;  // 节点数
+  key_compare key_comp_;    // 节点键值比较的准则
+
+private:
+  // 以下三个函数用于取得根节点，最小节点和最大节点
+  base_ptr& root()      noexcept { return header_.parent; }
+  base_ptr& leftmost()  noexcept { return header_.left; }
+  base_ptr& rightmost() noexcept { return header_.right; }
+  base_ptr  root()      const noexcept { return header_.parent; }
+  base_ptr  leftmost()  const noexcept { return header_.left; }
+  base_ptr  rightmost() const noexcept { return header_.right; }
+
+  base_ptr  header()    const noexcept { return const_cast<base_ptr>(&header_); }
+
+public:
+  // 构造、复制、析构函数
+  rb_tree()
+    :node_count_(0), key_comp_()
+  {
+    reset_header();
+  }
+
+  explicit rb_tree(const key_compare& comp)
+    :node_count_(0), key_comp_(comp)
+  {
+    reset_header();
+  }
+
+  rb_tree(const rb_tree& rhs);
+  rb_tree(rb_tree&& rhs) noexcept;
+
+  rb_tree& operator=(const rb_tree& rhs);
+  rb_tree& operator=(rb_tree&& rhs) noexcept;
+
+  ~rb_tree() { clear(); }
+
+public:
+  // 迭代器相关操作
+
+  iterator               begin()         noexcept
+  { return iterator(leftmost()); }
+  const_iterator         begin()   const noexcept
+  { return const_iterator(leftmost()); }
+  iterator               end()           noexcept
+  { return iterator(header()); }
+  const_iterator         end()     const noexcept
+  { return const_iterator(header()); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()          noexcept
+  { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()    const noexcept
+  { return const_reverse_iterator(begin()); }
+
+  const_iterator         cbegin()  const noexcept
+  { return begin(); }
+  const_iterator         cend()    const noexcept
+  { return end(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return rbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return rend(); }
+
+  // 容量相关操作
+
+  bool      empty()    const noexcept { return node_count_ == 0; }
+  size_type size()     const noexcept { return node_count_; }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(node); }
+
+  // 插入删除相关操作
+
+  // emplace
+  template <class ...Args>
+  iterator  emplace_multi(Args&& ...args);
+
+  template <class ...Args>
+  mystl::pair<iterator, bool> emplace_unique(Args&& ...args);
+
+  template <class ...Args>
+  iterator  emplace_multi_use_hint(const_iterator hint, Args&& ...args);
+
+  template <class ...Args>
+  iterator  emplace_unique_use_hint(const_iterator hint, Args&& ...args);
+
+  // try_emplace，只用于 map，键不存在时才构造实值
+  template <class K, class ...Args>
+  mystl::pair<iterator, bool> try_emplace_unique(K&& key, Args&& ...args);
+
+  template <class K, class ...Args>
+  iterator  try_emplace_unique_use_hint(const_iterator hint, K&& key, Args&& ...args);
+
+  // insert
+
+  iterator  insert_multi(const value_type& value)
+  { return emplace_multi(value); }
+  iterator  insert_multi(value_type&& value)
+  { return emplace_multi(mystl::move(value)); }
+
+  iterator  insert_multi(const_iterator hint, const value_type& value)
+  { return emplace_multi_use_hint(hint, value); }
+  iterator  insert_multi(const_iterator hint, value_type&& value)
+  { return emplace_multi_use_hint(hint, mystl::move(value)); }
+
+  template <class InputIter>
+  void      insert_multi(InputIter first, InputIter last)
+  { insert_range(first, last, m_false_type()); }
+
+  mystl::pair<iterator, bool> insert_unique(const value_type& value);
+  mystl::pair<iterator, bool> insert_unique(value_type&& value)
+  { return emplace_unique(mystl::move(value)); }
+
+  iterator  insert_unique(const_iterator hint, const value_type& value);
+  iterator  insert_unique(const_iterator hint, value_type&& value)
+  { return emplace_unique_use_hint(hint, mystl::move(value)); }
+
+  template <class InputIter>
+  void      insert_unique(InputIter first, InputIter last)
+  { insert_range(first, last, m_true_type()); }
+
+  // 节点句柄
+  iterator           insert_multi(node_type&& nh);
+  iterator           insert_multi(const_iterator hint, node_type&& nh);
+  insert_return_type insert_unique(node_type&& nh);
+  iterator           insert_unique(const_iterator hint, node_type&& nh);
+
+  // erase / extract
+
+  iterator  erase(const_iterator pos);
+  size_type erase_multi(const key_type& key);
+  size_type erase_unique(const key_type& key);
+  iterator  erase(const_iterator first, const_iterator last);
+
+  node_type extract(const_iterator pos)
+  {
+    MYSTL_DEBUG(pos != end());
+    return node_handle_access::make(unlink_node(pos.node));
+  }
+  node_type extract(const key_type& key)
+  {
+    const_iterator it = find(key);
+    return it == end() ? node_type() : extract(it);
+  }
+
+  // merge，把 source 中的节点转移过来，键重复的节点留在 source 中
+  void      merge_unique(rb_tree& source);
+  void      merge_multi(rb_tree& source);
+
+  void      clear() noexcept;
+
+  // rb_tree 相关操作
+
+  iterator       find(const key_type& key);
+  const_iterator find(const key_type& key) const;
+
+  size_type      count_multi(const key_type& key) const
+  {
+    auto p = equal_range_multi(key);
+    return static_cast<size_type>(mystl::distance(p.first, p.second));
+  }
+  size_type      count_unique(const key_type& key) const
+  { return find(key) != end() ? 1 : 0; }
+
+  iterator       lower_bound(const key_type& key)
+  { return iterator(lower_bound_node(key)); }
+  const_iterator lower_bound(const key_type& key) const
+  { return const_iterator(lower_bound_node(key)); }
+
+  iterator       upper_bound(const key_type& key)
+  { return iterator(upper_bound_node(key)); }
+  const_iterator upper_bound(const key_type& key) const
+  { return const_iterator(upper_bound_node(key)); }
+
+  mystl::pair<iterator, iterator>
+  equal_range_multi(const key_type& key)
+  { return mystl::pair<iterator, iterator>(lower_bound(key), upper_bound(key)); }
+  mystl::pair<const_iterator, const_iterator>
+  equal_range_multi(const key_type& key) const
+  { return mystl::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key)); }
+
+  mystl::pair<iterator, iterator>
+  equal_range_unique(const key_type& key)
+  {
+    iterator it = find(key);
+    iterator next = it;
+    return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
+  }
+  mystl::pair<const_iterator, const_iterator>
+  equal_range_unique(const key_type& key) const
+  {
+    const_iterator it = find(key);
+    const_iterator next = it;
+    return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
+  }
+
+  void      swap(rb_tree& rhs) noexcept;
+
+private:
+  // helper functions
+
+  static const key_type& key_of(base_ptr x) noexcept
+  { return ExtractKey()(static_cast<node_ptr>(x)->value); }
+  static const key_type& key_of(const value_type& value) noexcept
+  { return ExtractKey()(value); }
+
+  void      reset_header() noexcept
+  {
+    header_.color = rb_tree_red;
+    header_.parent = nullptr;
+    header_.left = &header_;
+    header_.right = &header_;
+  }
+  // 接管 rhs 的节点，rhs 的头节点重置为空树
+  void      steal(rb_tree& rhs) noexcept;
+
+  // node related
+  template <class ...Args>
+  node_ptr  create_node(Args&& ...args);
+  static void destroy_node(base_ptr p) noexcept;
+  static void destroy_chain(base_ptr chain) noexcept;
+  node_ptr  clone_node(base_ptr x);
+
+  // 查找插入位置
+  insert_pos get_insert_multi_pos(const key_type& key);
+  // 第二个值为 false 时 parent 为键相同的节点
+  mystl::pair<insert_pos, bool> get_insert_unique_pos(const key_type& key);
+  insert_pos get_insert_multi_hint_pos(const_iterator hint, const key_type& key);
+  mystl::pair<insert_pos, bool>
+             get_insert_unique_hint_pos(const_iterator hint, const key_type& key);
+
+  // 把节点挂到 pos 上并重新平衡
+  iterator  insert_node_at(insert_pos pos, base_ptr z) noexcept;
+  // 从树上摘下节点，不销毁
+  node_ptr  unlink_node(base_ptr z) noexcept;
+
+  base_ptr  lower_bound_node(const key_type& key) const;
+  base_ptr  upper_bound_node(const key_type& key) const;
+
+  // 区间插入
+  template <class InputIter, class Unique>
+  void      insert_range(InputIter first, InputIter last, Unique unique);
+  template <class Unique>
+  void      insert_chain(base_ptr chain, Unique unique);
+  void      insert_node_multi(base_ptr z);
+  void      insert_node_unique(base_ptr z);
+  static base_ptr build_sorted(base_ptr& chain, size_type n, size_type depth,
+                               size_type red_depth) noexcept;
+
+  // 复制与清除
+  base_ptr  copy_from(base_ptr x, base_ptr p);
+  static void erase_since(base_ptr x) noexcept;
+};
+
+/*****************************************************************************************/
+
+// 复制构造函数
+template <class Value, class Key, class ExtractKey, class Compare>
+rb_tree<Value, Key, ExtractKey, Compare>::
+rb_tree(const rb_tree& rhs)
+  :node_count_(0), key_comp_(rhs.key_comp_)
+{
+  reset_header();
+  if (rhs.node_count_ != 0)
+  {
+    root() = copy_from(rhs.root(), header());
+    leftmost() = rb_tree_min(root());
+    rightmost() = rb_tree_max(root());
+    node_count_ = rhs.node_count_;
+  }
+}
+
+// 移动构造函数
+template <class Value, class Key, class ExtractKey, class Compare>
+rb_tree<Value, Key, ExtractKey, Compare>::
+rb_tree(rb_tree&& rhs) noexcept
+  :node_count_(0), key_comp_(rhs.key_comp_)
+{
+  reset_header();
+  steal(rhs);
+}
+
+// 复制赋值操作符
+template <class Value, class Key, class ExtractKey, class Compare>
+rb_tree<Value, Key, ExtractKey, Compare>&
+rb_tree<Value, Key, ExtractKey, Compare>::
+operator=(const rb_tree& rhs)
+{
+  if (this != &rhs)
+  {
+    rb_tree tmp(rhs);
+    swap(tmp);
+  }
+  return *this;
+}
+
+// 移动赋值操作符
+template <class Value, class Key, class ExtractKey, class Compare>
+rb_tree<Value, Key, ExtractKey, Compare>&
+rb_tree<Value, Key, ExtractKey, Compare>::
+operator=(rb_tree&& rhs) noexcept
+{
+  if (this != &rhs)
+  {
+    clear();
+    key_comp_ = rhs.key_comp_;
+    steal(rhs);
+  }
+  return *this;
+}
+
+// 就地插入元素，键值允许重复
+template <class Value, class Key, class ExtractKey, class Compare>
+template <class ...Args>
+typename rb_tree<Value, Key, ExtractKey, Compare>::iterator
+rb_tree<Value, Key, ExtractKey, Compare>::
+emplace_multi(Args&& ...args)
+{
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T>'s size too big");
+  node_ptr np = create_node(mystl::forward<Args>(args)...);
+  return insert_node_at(get_insert_multi_pos(key_of(np->value)), np);
+}
+
+// 就地插入元素，键值不允许重复
+template <class Value, class Key, class ExtractKey, class Compare>
+template <class ...Args>
+mystl::pair<typename rb_tree<Value, Key, ExtractKey, Compare>::iterator, bool>
+rb_tree<Value, Key, ExtractKey, Compare>::
+emplace_unique(Args&& ...args)
+{
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T>'s size too big");
+  node_ptr np = create_node(mystl::forward<Args>(args)...);
+  mystl::pair<insert_pos, bool> res;
+  try
+  {
+    res = get_insert_unique_pos(key_of(np->value));
+  }
+  catch (...)
+  {
+    destroy_node(np);
+    throw;
+  }
+  if (!res.second)
+  {
+    destroy_node(np);
+    return mystl::make_pair(iterator(res.first.parent), false);
+  }
+  return mystl::make_pair(insert_node_at(res.first, np), true);
+}
+
+// 就地插入元素，键值允许重复，当 hint 位置与插入位置接近时，插入操作的时间复杂度可以降低
+template <class Value, class Key, class ExtractKey, class Compare>
+template <class ...Args>
+typename rb_tree<Value, Key, ExtractKey, Compare>::iterator
+rb_tree<Value, Key, ExtractKey, Compare>::
+emplace_multi_use_hint(const_iterator hint, Args&& ...args)
+{
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T>'s size too big");
+  node_ptr np = create_node(mystl::forward<Args>(args)...);
+  return insert_node_at(get_insert_multi_hint_pos(hint, key_of(np->value)), np);
+}
+
+// 就地插入元素，键值不允许重复，当 hint 位置与插入位置接近时，插入操作的时间复杂度可以降低
+template <class Value, class Key, class ExtractKey, class Compare>
+template <class ...Args>
+typename rb_tree<Value, Key, ExtractKey, Compare>::iterator
+rb_tree<Value, Key, ExtractKey, Compare>::
+emplace_unique_use_hint(const_iterator hint, Args&& ...args)
+{
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T>'s size too big");
+  node_ptr np = create_node(mystl::forward<Args>(args)...);
+  mystl::pair<insert_pos, bool> res;
+  try
+  {
+    res = get_insert_unique_hint_pos(hint, key_of(np->value));
+  }
+  catch (...)
+  {
+    destroy_node(np);
+    throw;
+  }
+  if (!res.second)
+  {
+    destroy_node(np);
+    return iterator(res.first.parent);
+  }
+  return insert_node_at(res.first, np);
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+template <class K, class ...Args>
+mystl::pair<typename rb_tree<Value, Key, ExtractKey, Compare>::iterator, bool>
+rb_tree<Value, Key, ExtractKey, Compare>::
+try_emplace_unique(K&& key, Args&& ...args)
+{
+  typedef typename value_type::second_type mapped_type;
+  const auto res = get_insert_unique_pos(key);
+  if (!res.second)
+    return mystl::make_pair(iterator(res.first.parent), false);
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T>'s size too big");
+  node_ptr np = create_node(mystl::forward<K>(key), mapped_type(mystl::forward<Args>(args)...));
+  return mystl::make_pair(insert_node_at(res.first, np), true);
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+template <class K, class ...Args>
+typename rb_tree<Value, Key, ExtractKey, Compare>::iterator
+rb_tree<Value, Key, ExtractKey, Compare>::
+try_emplace_unique_use_hint(const_iterator hint, K&& key, Args&& ...args)
+{
+  typedef typename value_type::second_type mapped_type;
+  const auto res = get_insert_unique_hint_pos(hint, key);
+  if (!res.second)
+    return iterator(res.first.parent);
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T>'s size too big");
+  node_ptr np = create_node(mystl::forward<K>(key), mapped_type(mystl::forward<Args>(args)...));
+  return insert_node_at(res.first, np);
+}
+
+// 插入元素，节点键值不允许重复，键已存在时不复制元素
+template <class Value, class Key, class ExtractKey, class Compare>
+mystl::pair<typename rb_tree<Value, Key, ExtractKey, Compare>::iterator, bool>
+rb_tree<Value, Key, ExtractKey, Compare>::
+insert_unique(const value_type& value)
+{
+  const auto res = get_insert_unique_pos(key_of(value));
+  if (!res.second)
+    return mystl::make_pair(iterator(res.first.parent), false);
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T>'s size too big");
+  return mystl::make_pair(insert_node_at(res.first, create_node(value)), true);
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::iterator
+rb_tree<Value, Key, ExtractKey, Compare>::
+insert_unique(const_iterator hint, const value_type& value)
+{
+  const auto res = get_insert_unique_hint_pos(hint, key_of(value));
+  if (!res.second)
+    return iterator(res.first.parent);
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "rb_tree<T>'s size too big");
+  return insert_node_at(res.first, create_node(value));
+}
+
+// 插入节点句柄
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::iterator
+rb_tree<Value, Key, ExtractKey, Compare>::
+insert_multi(node_type&& nh)
+{
+  if (nh.empty())
+    return end();
+  const insert_pos pos = get_insert_multi_pos(key_of(node_handle_access::get(nh)->value));
+  return insert_node_at(pos, node_handle_access::release(nh));
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::iterator
+rb_tree<Value, Key, ExtractKey, Compare>::
+insert_multi(const_iterator hint, node_type&& nh)
+{
+  if (nh.empty())
+    return end();
+  const insert_pos pos =
+    get_insert_multi_hint_pos(hint, key_of(node_handle_access::get(nh)->value));
+  return insert_node_at(pos, node_handle_access::release(nh));
+}
+
+// 键已存在时节点留在返回值中
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::insert_return_type
+rb_tree<Value, Key, ExtractKey, Compare>::
+insert_unique(node_type&& nh)
+{
+  if (nh.empty())
+    return insert_return_type{ end(), false, node_type() };
+  const auto res = get_insert_unique_pos(key_of(node_handle_access::get(nh)->value));
+  if (!res.second)
+    return insert_return_type{ iterator(res.first.parent), false, mystl::move(nh) };
+  iterator it = insert_node_at(res.first, node_handle_access::release(nh));
+  return insert_return_type{ it, true, node_type() };
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::iterator
+rb_tree<Value, Key, ExtractKey, Compare>::
+insert_unique(const_iterator hint, node_type&& nh)
+{
+  if (nh.empty())
+    return end();
+  const auto res =
+    get_insert_unique_hint_pos(hint, key_of(node_handle_access::get(nh)->value));
+  if (!res.second)
+    return iterator(res.first.parent);
+  return insert_node_at(res.first, node_handle_access::release(nh));
+}
+
+// 删除 pos 位置的节点
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::iterator
+rb_tree<Value, Key, ExtractKey, Compare>::
+erase(const_iterator pos)
+{
+  MYSTL_DEBUG(pos != end());
+  iterator next(pos.node);
+  ++next;
+  destroy_node(unlink_node(pos.node));
+  return next;
+}
+
+// 删除与 key 相等的元素，返回删除的个数
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::size_type
+rb_tree<Value, Key, ExtractKey, Compare>::
+erase_multi(const key_type& key)
+{
+  auto p = equal_range_multi(key);
+  const size_type n = static_cast<size_type>(mystl::distance(p.first, p.second));
+  erase(p.first, p.second);
+  return n;
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::size_type
+rb_tree<Value, Key, ExtractKey, Compare>::
+erase_unique(const key_type& key)
+{
+  iterator it = find(key);
+  if (it == end())
+    return 0;
+  erase(it);
+  return 1;
+}
+
+// 删除 [first, last) 区间内的元素
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::iterator
+rb_tree<Value, Key, ExtractKey, Compare>::
+erase(const_iterator first, const_iterator last)
+{
+  if (first == begin() && last == end())
+  {
+    clear();
+    return end();
+  }
+  while (first != last)
+    first = erase(first);
+  return iterator(last.node);
+}
+
+// 键重复的节点留在 source 中
+template <class Value, class Key, class ExtractKey, class Compare>
+void rb_tree<Value, Key, ExtractKey, Compare>::
+merge_unique(rb_tree& source)
+{
+  if (&source == this)
+    return;
+  for (iterator it = source.begin(); it != source.end(); )
+  {
+    const auto res = get_insert_unique_pos(key_of(it.node));
+    base_ptr z = it.node;
+    ++it;
+    if (res.second)
+      insert_node_at(res.first, source.unlink_node(z));
+  }
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+void rb_tree<Value, Key, ExtractKey, Compare>::
+merge_multi(rb_tree& source)
+{
+  if (&source == this)
+    return;
+  for (iterator it = source.begin(); it != source.end(); )
+  {
+    base_ptr z = it.node;
+    ++it;
+    const insert_pos pos = get_insert_multi_pos(key_of(z));
+    insert_node_at(pos, source.unlink_node(z));
+  }
+}
+
+// 清空 rb tree
+template <class Value, class Key, class ExtractKey, class Compare>
+void rb_tree<Value, Key, ExtractKey, Compare>::
+clear() noexcept
+{
+  if (node_count_ != 0)
+  {
+    erase_since(root());
+    reset_header();
+    node_count_ = 0;
+  }
+}
+
+// 查找键值为 key 的节点，返回指向它的迭代器
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::iterator
+rb_tree<Value, Key, ExtractKey, Compare>::
+find(const key_type& key)
+{
+  iterator j = lower_bound(key);
+  return (j == end() || key_comp_(key, key_of(j.node))) ? end() : j;
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::const_iterator
+rb_tree<Value, Key, ExtractKey, Compare>::
+find(const key_type& key) const
+{
+  const_iterator j = lower_bound(key);
+  return (j == end() || key_comp_(key, key_of(j.node))) ? end() : j;
+}
+
+// 交换 rb tree
+template <class Value, class Key, class ExtractKey, class Compare>
+void rb_tree<Value, Key, ExtractKey, Compare>::
+swap(rb_tree& rhs) noexcept
+{
+  if (this != &rhs)
+  {
+    rb_tree tmp(mystl::move(rhs));
+    rhs.steal(*this);
+    steal(tmp);
+    mystl::swap(key_comp_, rhs.key_comp_);
+  }
+}
+
+/*****************************************************************************************/
+// helper function
+
+template <class Value, class Key, class ExtractKey, class Compare>
+void rb_tree<Value, Key, ExtractKey, Compare>::
+steal(rb_tree& rhs) noexcept
+{
+  if (rhs.node_count_ == 0)
+  {
+    reset_header();
+    node_count_ = 0;
+    return;
+  }
+  header_.parent = rhs.header_.parent;
+  header_.left = rhs.header_.left;
+  header_.right = rhs.header_.right;
+  header_.parent->parent = &header_;
+  node_count_ = rhs.node_count_;
+  rhs.reset_header();
+  rhs.node_count_ = 0;
+}
+
+// 创建一个结点
+template <class Value, class Key, class ExtractKey, class Compare>
+template <class ...Args>
+typename rb_tree<Value, Key, ExtractKey, Compare>::node_ptr
+rb_tree<Value, Key, ExtractKey, Compare>::
+create_node(Args&& ...args)
+{
+  node_ptr p = node_allocator::allocate();
+  try
+  {
+    node_allocator::construct(p, mystl::forward<Args>(args)...);
+  }
+  catch (...)
+  {
+    node_allocator::deallocate(p);
+    throw;
+  }
+  p->parent = nullptr;
+  p->left = nullptr;
+  p->right = nullptr;
+  return p;
+}
+
+// 销毁一个结点
+template <class Value, class Key, class ExtractKey, class Compare>
+void rb_tree<Value, Key, ExtractKey, Compare>::
+destroy_node(base_ptr p) noexcept
+{
+  node_ptr np = static_cast<node_ptr>(p);
+  node_allocator::destroy(np);
+  node_allocator::deallocate(np);
+}
+
+// 销毁一条用 right 串起的节点链
+template <class Value, class Key, class ExtractKey, class Compare>
+void rb_tree<Value, Key, ExtractKey, Compare>::
+destroy_chain(base_ptr chain) noexcept
+{
+  while (chain != nullptr)
+  {
+    base_ptr next = chain->right;
+    destroy_node(chain);
+    chain = next;
+  }
+}
+
+// 复制一个结点
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::node_ptr
+rb_tree<Value, Key, ExtractKey, Compare>::
+clone_node(base_ptr x)
+{
+  node_ptr tmp = create_node(static_cast<node_ptr>(x)->value);
+  tmp->color = x->color;
+  return tmp;
+}
+
+// 键值允许重复时的插入位置，相等的键插在已有元素之后
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::insert_pos
+rb_tree<Value, Key, ExtractKey, Compare>::
+get_insert_multi_pos(const key_type& key)
+{
+  base_ptr x = root();
+  base_ptr y = header();
+  bool add_to_left = true;
+  while (x != nullptr)
+  {
+    y = x;
+    add_to_left = key_comp_(key, key_of(x));
+    x = add_to_left ? x->left : x->right;
+  }
+  return insert_pos{ y, add_to_left };
+}
+
+// 键值不允许重复时的插入位置
+template <class Value, class Key, class ExtractKey, class Compare>
+mystl::pair<typename rb_tree<Value, Key, ExtractKey, Compare>::insert_pos, bool>
+rb_tree<Value, Key, ExtractKey, Compare>::
+get_insert_unique_pos(const key_type& key)
+{
+  base_ptr x = root();
+  base_ptr y = header();
+  bool add_to_left = true;
+  while (x != nullptr)
+  {
+    y = x;
+    add_to_left = key_comp_(key, key_of(x));
+    x = add_to_left ? x->left : x->right;
+  }
+  iterator j(y);  // 此时 y 为插入点的父节点
+  if (add_to_left)
+  {
+    if (y == header() || j == begin())
+      return mystl::make_pair(insert_pos{ y, true }, true);
+    --j;  // 与前驱比较
+  }
+  if (key_comp_(key_of(j.node), key))
+    return mystl::make_pair(insert_pos{ y, add_to_left }, true);
+  // 键值重复，返回已有的节点
+  return mystl::make_pair(insert_pos{ j.node, false }, false);
+}
+
+// 带提示的插入位置 : 键值允许重复
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::insert_pos
+rb_tree<Value, Key, ExtractKey, Compare>::
+get_insert_multi_hint_pos(const_iterator hint, const key_type& key)
+{
+  base_ptr pos = hint.node;
+  if (pos == header())
+  { // 提示为 end()，不小于最大元素时直接接在最大节点之后
+    if (node_count_ != 0 && !key_comp_(key, key_of(rightmost())))
+      return insert_pos{ rightmost(), false };
+    return get_insert_multi_pos(key);
+  }
+  if (!key_comp_(key_of(pos), key))
+  { // key <= *hint，检查前驱
+    if (pos == leftmost())
+      return insert_pos{ pos, true };
+    base_ptr before = rb_tree_decrement(pos);
+    if (!key_comp_(key, key_of(before)))
+      return before->right == nullptr ? insert_pos{ before, false } : insert_pos{ pos, true };
+    return get_insert_multi_pos(key);
+  }
+  // *hint < key，检查后继
+  if (pos == rightmost())
+    return insert_pos{ pos, false };
+  base_ptr after = rb_tree_increment(pos);
+  if (!key_comp_(key_of(after), key))
+    return pos->right == nullptr ? insert_pos{ pos, false } : insert_pos{ after, true };
+  return get_insert_multi_pos(key);
+}
+
+// 带提示的插入位置 : 键值不允许重复
+template <class Value, class Key, class ExtractKey, class Compare>
+mystl::pair<typename rb_tree<Value, Key, ExtractKey, Compare>::insert_pos, bool>
+rb_tree<Value, Key, ExtractKey, Compare>::
+get_insert_unique_hint_pos(const_iterator hint, const key_type& key)
+{
+  base_ptr pos = hint.node;
+  if (pos == header())
+  { // 提示为 end()，大于最大元素时直接接在最大节点之后
+    if (node_count_ != 0 && key_comp_(key_of(rightmost()), key))
+      return mystl::make_pair(insert_pos{ rightmost(), false }, true);
+    return get_insert_unique_pos(key);
+  }
+  if (key_comp_(key, key_of(pos)))
+  { // key < *hint，检查前驱
+    if (pos == leftmost())
+      return mystl::make_pair(insert_pos{ pos, true }, true);
+    base_ptr before = rb_tree_decrement(pos);
+    if (key_comp_(key_of(before), key))
+    {
+      return mystl::make_pair(before->right == nullptr ? insert_pos{ before, false }
+                                                       : insert_pos{ pos, true }, true);
+    }
+    return get_insert_unique_pos(key);
+  }
+  if (key_comp_(key_of(pos), key))
+  { // *hint < key，检查后继
+    if (pos == rightmost())
+      return mystl::make_pair(insert_pos{ pos, false }, true);
+    base_ptr after = rb_tree_increment(pos);
+    if (key_comp_(key, key_of(after)))
+    {
+      return mystl::make_pair(pos->right == nullptr ? insert_pos{ pos, false }
+                                                    : insert_pos{ after, true }, true);
+    }
+    return get_insert_unique_pos(key);
+  }
+  // 与提示位置的键相等
+  return mystl::make_pair(insert_pos{ pos, false }, false);
+}
+
+// 把节点 z 挂到 pos 上，返回指向它的迭代器
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::iterator
+rb_tree<Value, Key, ExtractKey, Compare>::
+insert_node_at(insert_pos pos, base_ptr z) noexcept
+{
+  base_ptr x = pos.parent;
+  z->parent = x;
+  z->left = nullptr;
+  z->right = nullptr;
+  if (x == header())
+  { // 空树
+    root() = z;
+    leftmost() = z;
+    rightmost() = z;
+  }
+  else if (pos.left)
+  {
+    x->left = z;
+    if (x == leftmost())
+      leftmost() = z;
+  }
+  else
+  {
+    x->right = z;
+    if (x == rightmost())
+      rightmost() = z;
+  }
+  rb_tree_insert_rebalance(z, root());
+  ++node_count_;
+  return iterator(z);
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::node_ptr
+rb_tree<Value, Key, ExtractKey, Compare>::
+unlink_node(base_ptr z) noexcept
+{
+  base_ptr y = rb_tree_erase_rebalance(z, root(), leftmost(), rightmost());
+  --node_count_;
+  if (node_count_ == 0)
+    reset_header();
+  return static_cast<node_ptr>(y);
+}
+
+// 第一个不小于 key 的节点
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::base_ptr
+rb_tree<Value, Key, ExtractKey, Compare>::
+lower_bound_node(const key_type& key) const
+{
+  base_ptr y = header();
+  base_ptr x = root();
+  while (x != nullptr)
+  {
+    if (!key_comp_(key_of(x), key))
+    { // key <= x
+      y = x;
+      x = x->left;
+    }
+    else
+    {
+      x = x->right;
+    }
+  }
+  return y;
+}
+
+// 第一个大于 key 的节点
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::base_ptr
+rb_tree<Value, Key, ExtractKey, Compare>::
+upper_bound_node(const key_type& key) const
+{
+  base_ptr y = header();
+  base_ptr x = root();
+  while (x != nullptr)
+  {
+    if (key_comp_(key, key_of(x)))
+    { // key < x
+      y = x;
+      x = x->left;
+    }
+    else
+    {
+      x = x->right;
+    }
+  }
+  return y;
+}
+
+// 区间插入
+// 空树时先把所有元素构造成一条用 right 串起的链，再整体插入；否则逐个在 end() 处带提示插入
+template <class Value, class Key, class ExtractKey, class Compare>
+template <class InputIter, class Unique>
+void rb_tree<Value, Key, ExtractKey, Compare>::
+insert_range(InputIter first, InputIter last, Unique unique)
+{
+  if (node_count_ != 0)
+  {
+    for (; first != last; ++first)
+    {
+      if (Unique::value)
+        emplace_unique_use_hint(end(), *first);
+      else
+        emplace_multi_use_hint(end(), *first);
+    }
+    return;
+  }
+  base_ptr chain = nullptr;
+  base_ptr* tail = &chain;
+  size_type n = 0;
+  try
+  {
+    for (; first != last; ++first, ++n)
+    {
+      THROW_LENGTH_ERROR_IF(n > max_size() - 1, "rb_tree<T>'s size too big");
+      base_ptr np = create_node(*first);
+      *tail = np;
+      tail = &np->right;
+    }
+  }
+  catch (...)
+  {
+    destroy_chain(chain);
+    throw;
+  }
+  insert_chain(chain, unique);
+}
+
+// 把一条链上的节点插入到空树中，链按键有序时直接建树
+template <class Value, class Key, class ExtractKey, class Compare>
+template <class Unique>
+void rb_tree<Value, Key, ExtractKey, Compare>::
+insert_chain(base_ptr chain, Unique /*unique*/)
+{
+  // 检查是否有序，键值不允许重复时顺便去掉相邻的重复节点
+  size_type n = 0;
+  bool sorted = true;
+  base_ptr prev = nullptr;
+  try
+  {
+    for (base_ptr* link = &chain; *link != nullptr; )
+    {
+      base_ptr cur = *link;
+      if (prev != nullptr)
+      {
+        if (key_comp_(key_of(cur), key_of(prev)))
+        {
+          sorted = false;
+          break;
+        }
+        if (Unique::value && !key_comp_(key_of(prev), key_of(cur)))
+        {
+          *link = cur->right;
+          destroy_node(cur);
+          continue;
+        }
+      }
+      ++n;
+      prev = cur;
+      link = &cur->right;
+    }
+  }
+  catch (...)
+  {
+    destroy_chain(chain);
+    throw;
+  }
+  if (sorted)
+  {
+    if (n == 0)
+      return;
+    const size_type red_depth = mystl::floor_log2(n + 1);
+    base_ptr cur = chain;
+    base_ptr r = build_sorted(cur, n, 0, red_depth);
+    r->parent = header();
+    root() = r;
+    leftmost() = rb_tree_min(r);
+    rightmost() = rb_tree_max(r);
+    node_count_ = n;
+    return;
+  }
+  // 无序时逐个插入，比较抛出异常时销毁还没插入的节点
+  try
+  {
+    while (chain != nullptr)
+    {
+      base_ptr next = chain->right;
+      if (Unique::value)
+        insert_node_unique(chain);
+      else
+        insert_node_multi(chain);
+      chain = next;
+    }
+  }
+  catch (...)
+  {
+    destroy_chain(chain);
+    throw;
+  }
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+void rb_tree<Value, Key, ExtractKey, Compare>::
+insert_node_multi(base_ptr z)
+{
+  insert_node_at(get_insert_multi_pos(key_of(z)), z);
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+void rb_tree<Value, Key, ExtractKey, Compare>::
+insert_node_unique(base_ptr z)
+{
+  const auto res = get_insert_unique_pos(key_of(z));
+  if (res.second)
+    insert_node_at(res.first, z);
+  else
+    destroy_node(z);
+}
+
+// 用链上的前 n 个节点按中序建一棵平衡的树，chain 前进到第 n + 1 个节点
+// 每次取中点为根，所有空子节点的深度相差不超过一，
+// 把深度为 red_depth (最后一层不满时即为最后一层) 的节点染红，其余染黑
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::base_ptr
+rb_tree<Value, Key, ExtractKey, Compare>::
+build_sorted(base_ptr& chain, size_type n, size_type depth, size_type red_depth) noexcept
+{
+  if (n == 0)
+    return nullptr;
+  const size_type left_n = n / 2;
+  base_ptr left = build_sorted(chain, left_n, depth + 1, red_depth);
+  base_ptr x = chain;
+  chain = chain->right;
+  x->left = left;
+  if (left != nullptr)
+    left->parent = x;
+  base_ptr right = build_sorted(chain, n - left_n - 1, depth + 1, red_depth);
+  x->right = right;
+  if (right != nullptr)
+    right->parent = x;
+  x->color = depth == red_depth ? rb_tree_red : rb_tree_black;
+  return x;
+}
+
+// 递归复制一颗树，节点从 x 开始，p 为 x 的父节点
+template <class Value, class Key, class ExtractKey, class Compare>
+typename rb_tree<Value, Key, ExtractKey, Compare>::base_ptr
+rb_tree<Value, Key, ExtractKey, Compare>::
+copy_from(base_ptr x, base_ptr p)
+{
+  base_ptr top = clone_node(x);
+  top->parent = p;
+  try
+  {
+    if (x->right)
+      top->right = copy_from(x->right, top);
+    p = top;
+    x = x->left;
+    while (x != nullptr)
+    {
+      base_ptr y = clone_node(x);
+      p->left = y;
+      y->parent = p;
+      if (x->right)
+        y->right = copy_from(x->right, y);
+      p = y;
+      x = x->left;
+    }
+  }
+  catch (...)
+  {
+    erase_since(top);
+    throw;
+  }
+  return top;
+}
+
+// 从 x 节点开始删除该节点及其子树
+template <class Value, class Key, class ExtractKey, class Compare>
+void rb_tree<Value, Key, ExtractKey, Compare>::
+erase_since(base_ptr x) noexcept
+{
+  while (x != nullptr)
+  {
+    erase_since(x->right);
+    base_ptr y = x->left;
+    destroy_node(x);
+    x = y;
+  }
+}
+
+// 重载比较操作符
+template <class Value, class Key, class ExtractKey, class Compare>
+bool operator==(const rb_tree<Value, Key, ExtractKey, Compare>& lhs,
+                const rb_tree<Value, Key, ExtractKey, Compare>& rhs)
+{
+  return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+bool operator<(const rb_tree<Value, Key, ExtractKey, Compare>& lhs,
+               const rb_tree<Value, Key, ExtractKey, Compare>& rhs)
+{
+  return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+bool operator!=(const rb_tree<Value, Key, ExtractKey, Compare>& lhs,
+                const rb_tree<Value, Key, ExtractKey, Compare>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+bool operator>(const rb_tree<Value, Key, ExtractKey, Compare>& lhs,
+               const rb_tree<Value, Key, ExtractKey, Compare>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+bool operator<=(const rb_tree<Value, Key, ExtractKey, Compare>& lhs,
+                const rb_tree<Value, Key, ExtractKey, Compare>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class Value, class Key, class ExtractKey, class Compare>
+bool operator>=(const rb_tree<Value, Key, ExtractKey, Compare>& lhs,
+                const rb_tree<Value, Key, ExtractKey, Compare>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class Value, class Key, class ExtractKey, class Compare>
+void swap(rb_tree<Value, Key, ExtractKey, Compare>& lhs,
+          rb_tree<Value, Key, ExtractKey, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_RB_TREE_H_
@@ -0,0 +1,483 @@
+#ifndef TINYSTL_SET_H_
+#define TINYSTL_SET_H_
+
+// 这个头文件包含两个模板类 set 和 multiset
+// set      : 集合，元素按键值有序排列，键值不允许重复
+// multiset : 集合，元素按键值有序排列，键值允许重复
+// 底层实现为 rb_tree，节点由 pool_allocator 分配，删除之前引用保持有效，
+// 节点可以 extract 后插入到另一个 set / multiset，merge 在两个容器间转移节点而不复制元素
+
+// 异常保证：
+// mystl::set<Key> / mystl::multiset<Key> 满足基本异常保证，对 insert / emplace 做强异常安全保证
+
+#include "rb_tree.h"
+
+namespace mystl
+{
+
+// 模板类 set，键值不允许重复
+// 参数一代表键值类型，参数二代表键值比较方式，缺省使用 mystl::less
+template <class Key, class Compare = mystl::less<Key>>
+class set
+{
+private:
+  typedef mystl::rb_tree<Key, Key, mystl::identity<Key>, Compare> base_type;
+  base_type tree_;
+
+public:
+  // set 的型别定义，元素不能修改，iterator 与 const_iterator 相同
+  typedef typename base_type::key_type                key_type;
+  typedef typename base_type::value_type              value_type;
+  typedef typename base_type::key_compare             key_compare;
+  typedef typename base_type::key_compare             value_compare;
+
+  typedef typename base_type::allocator_type          allocator_type;
+  typedef typename base_type::pointer                 pointer;
+  typedef typename base_type::const_pointer           const_pointer;
+  typedef typename base_type::reference               reference;
+  typedef typename base_type::const_reference         const_reference;
+  typedef typename base_type::size_type               size_type;
+  typedef typename base_type::difference_type         difference_type;
+
+  typedef typename base_type::const_iterator          iterator;
+  typedef typename base_type::const_iterator          const_iterator;
+  typedef typename base_type::const_reverse_iterator  reverse_iterator;
+  typedef typename base_type::const_reverse_iterator  const_reverse_iterator;
+
+  typedef typename base_type::node_type               node_type;
+  typedef node_insert_return<iterator, node_type>     insert_return_type;
+
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+  key_compare    key_comp()      const { return tree_.key_comp(); }
+  value_compare  value_comp()    const { return tree_.key_comp(); }
+
+public:
+  // 构造、复制、移动函数
+  set() = default;
+
+  explicit set(const key_compare& comp)
+    :tree_(comp)
+  {
+  }
+
+  // 空容器中插入有序区间时 O(n) 建树
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  set(InputIter first, InputIter last, const key_compare& comp = key_compare())
+    :tree_(comp)
+  {
+    tree_.insert_unique(first, last);
+  }
+
+  set(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+    :tree_(comp)
+  {
+    tree_.insert_unique(ilist.begin(), ilist.end());
+  }
+
+  set(const set& rhs)
+    :tree_(rhs.tree_)
+  {
+  }
+  set(set&& rhs) noexcept
+    :tree_(mystl::move(rhs.tree_))
+  {
+  }
+
+  set& operator=(const set& rhs)
+  {
+    tree_ = rhs.tree_;
+    return *this;
+  }
+  set& operator=(set&& rhs) noexcept
+  {
+    tree_ = mystl::move(rhs.tree_);
+    return *this;
+  }
+
+  set& operator=(std::initializer_list<value_type> ilist)
+  {
+    set tmp(ilist, tree_.key_comp());
+    swap(tmp);
+    return *this;
+  }
+
+  ~set() = default;
+
+  // 迭代器相关
+  iterator               begin()   const noexcept
+  { return tree_.begin(); }
+  iterator               end()     const noexcept
+  { return tree_.end(); }
+  reverse_iterator       rbegin()  const noexcept
+  { return tree_.rbegin(); }
+  reverse_iterator       rend()    const noexcept
+  { return tree_.rend(); }
+
+  const_iterator         cbegin()  const noexcept
+  { return tree_.cbegin(); }
+  const_iterator         cend()    const noexcept
+  { return tree_.cend(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return tree_.crbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return tree_.crend(); }
+
+  // 容量相关
+  bool      empty()    const noexcept { return tree_.empty(); }
+  size_type size()     const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+
+  // 插入删除操作
+
+  // emplace / emplace_hint
+  template <class ...Args>
+  mystl::pair<iterator, bool> emplace(Args&& ...args)
+  {
+    auto r = tree_.emplace_unique(mystl::forward<Args>(args)...);
+    return mystl::pair<iterator, bool>(r.first, r.second);
+  }
+
+  // hint 为插入位置之后的元素时不需要从根查找，按顺序在 end() 处插入为均摊 O(1)
+  template <class ...Args>
+  iterator emplace_hint(const_iterator hint, Args&& ...args)
+  { return tree_.emplace_unique_use_hint(hint, mystl::forward<Args>(args)...); }
+
+  // insert
+  mystl::pair<iterator, bool> insert(const value_type& value)
+  {
+    auto r = tree_.insert_unique(value);
+    return mystl::pair<iterator, bool>(r.first, r.second);
+  }
+  mystl::pair<iterator, bool> insert(value_type&& value)
+  {
+    auto r = tree_.insert_unique(mystl::move(value));
+    return mystl::pair<iterator, bool>(r.first, r.second);
+  }
+
+  iterator insert(const_iterator hint, const value_type& value)
+  { return tree_.insert_unique(hint, value); }
+  iterator insert(const_iterator hint, value_type&& value)
+  { return tree_.insert_unique(hint, mystl::move(value)); }
+
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  void insert(InputIter first, InputIter last)
+  { tree_.insert_unique(first, last); }
+  void insert(std::initializer_list<value_type> ilist)
+  { tree_.insert_unique(ilist.begin(), ilist.end()); }
+
+  // 插入节点句柄，键已存在时节点留在返回值的 node 中
+  insert_return_type insert(node_type&& nh)
+  {
+    auto r = tree_.insert_unique(mystl::move(nh));
+    return insert_return_type{ r.position, r.inserted, mystl::move(r.node) };
+  }
+  iterator insert(const_iterator hint, node_type&& nh)
+  { return tree_.insert_unique(hint, mystl::move(nh)); }
+
+  // erase / extract / merge / clear
+  iterator  erase(const_iterator position)
+  { return tree_.erase(position); }
+  size_type erase(const key_type& key)
+  { return tree_.erase_unique(key); }
+  iterator  erase(const_iterator first, const_iterator last)
+  { return tree_.erase(first, last); }
+
+  node_type extract(const_iterator position)
+  { return tree_.extract(position); }
+  node_type extract(const key_type& key)
+  { return tree_.extract(key); }
+
+  void      merge(set& source)
+  { tree_.merge_unique(source.tree_); }
+  void      merge(set&& source)
+  { tree_.merge_unique(source.tree_); }
+
+  void      clear() noexcept
+  { tree_.clear(); }
+
+  void      swap(set& rhs) noexcept
+  { tree_.swap(rhs.tree_); }
+
+  // set 相关操作
+  iterator  find(const key_type& key) const
+  { return tree_.find(key); }
+  size_type count(const key_type& key) const
+  { return tree_.count_unique(key); }
+  bool      contains(const key_type& key) const
+  { return tree_.find(key) != tree_.end(); }
+
+  iterator  lower_bound(const key_type& key) const
+  { return tree_.lower_bound(key); }
+  iterator  upper_bound(const key_type& key) const
+  { return tree_.upper_bound(key); }
+
+  mystl::pair<iterator, iterator> equal_range(const key_type& key) const
+  { return tree_.equal_range_unique(key); }
+
+public:
+  friend bool operator==(const set& lhs, const set& rhs) { return lhs.tree_ == rhs.tree_; }
+  friend bool operator< (const set& lhs, const set& rhs) { return lhs.tree_ <  rhs.tree_; }
+};
+
+// 重载比较操作符
+template <class Key, class Compare>
+bool operator!=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class Key, class Compare>
+bool operator>(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class Key, class Compare>
+bool operator<=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class Key, class Compare>
+bool operator>=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class Key, class Compare>
+void swap(set<Key, Compare>& lhs, set<Key, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+
+// 模板类 multiset，键值允许重复
+// 参数一代表键值类型，参数二代表键值比较方式，缺省使用 mystl::less
+template <class Key, class Compare = mystl::less<Key>>
+class multiset
+{
+private:
+  typedef mystl::rb_tree<Key, Key, mystl::identity<Key>, Compare> base_type;
+  base_type tree_;
+
+public:
+  // multiset 的型别定义，元素不能修改，iterator 与 const_iterator 相同
+  typedef typename base_type::key_type                key_type;
+  typedef typename base_type::value_type              value_type;
+  typedef typename base_type::key_compare             key_compare;
+  typedef typename base_type::key_compare             value_compare;
+
+  typedef typename base_type::allocator_type          allocator_type;
+  typedef typename base_type::pointer                 pointer;
+  typedef typename base_type::const_pointer           const_pointer;
+  typedef typename base_type::reference               reference;
+  typedef typename base_type::const_reference         const_reference;
+  typedef typename base_type::size_type               size_type;
+  typedef typename base_type::difference_type         difference_type;
+
+  typedef typename base_type::const_iterator          iterator;
+  typedef typename base_type::const_iterator          const_iterator;
+  typedef typename base_type::const_reverse_iterator  reverse_iterator;
+  typedef typename base_type::const_reverse_iterator  const_reverse_iterator;
+
+  typedef typename base_type::node_type               node_type;
+
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+  key_compare    key_comp()      const { return tree_.key_comp(); }
+  value_compare  value_comp()    const { return tree_.key_comp(); }
+
+public:
+  // 构造、复制、移动函数
+  multiset() = default;
+
+  explicit multiset(const key_compare& comp)
+    :tree_(comp)
+  {
+  }
+
+  // 空容器中插入有序区间时 O(n) 建树
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  multiset(InputIter first, InputIter last, const key_compare& comp = key_compare())
+    :tree_(comp)
+  {
+    tree_.insert_multi(first, last);
+  }
+
+  multiset(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+    :tree_(comp)
+  {
+    tree_.insert_multi(ilist.begin(), ilist.end());
+  }
+
+  multiset(const multiset& rhs)
+    :tree_(rhs.tree_)
+  {
+  }
+  multiset(multiset&& rhs) noexcept
+    :tree_(mystl::move(rhs.tree_))
+  {
+  }
+
+  multiset& operator=(const multiset& rhs)
+  {
+    tree_ = rhs.tree_;
+    return *this;
+  }
+  multiset& operator=(multiset&& rhs) noexcept
+  {
+    tree_ = mystl::move(rhs.tree_);
+    return *this;
+  }
+
+  multiset& operator=(std::initializer_list<value_type> ilist)
+  {
+    multiset tmp(ilist, tree_.key_comp());
+    swap(tmp);
+    return *this;
+  }
+
+  ~multiset() = default;
+
+  // 迭代器相关
+  iterator               begin()   const noexcept
+  { return tree_.begin(); }
+  iterator               end()     const noexcept
+  { return tree_.end(); }
+  reverse_iterator       rbegin()  const noexcept
+  { return tree_.rbegin(); }
+  reverse_iterator       rend()    const noexcept
+  { return tree_.rend(); }
+
+  const_iterator         cbegin()  const noexcept
+  { return tree_.cbegin(); }
+  const_iterator         cend()    const noexcept
+  { return tree_.cend(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return tree_.crbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return tree_.crend(); }
+
+  // 容量相关
+  bool      empty()    const noexcept { return tree_.empty(); }
+  size_type size()     const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+
+  // 插入删除操作
+
+  // emplace / emplace_hint
+  template <class ...Args>
+  iterator emplace(Args&& ...args)
+  { return tree_.emplace_multi(mystl::forward<Args>(args)...); }
+
+  template <class ...Args>
+  iterator emplace_hint(const_iterator hint, Args&& ...args)
+  { return tree_.emplace_multi_use_hint(hint, mystl::forward<Args>(args)...); }
+
+  // insert
+  iterator insert(const value_type& value)
+  { return tree_.insert_multi(value); }
+  iterator insert(value_type&& value)
+  { return tree_.insert_multi(mystl::move(value)); }
+
+  iterator insert(const_iterator hint, const value_type& value)
+  { return tree_.insert_multi(hint, value); }
+  iterator insert(const_iterator hint, value_type&& value)
+  { return tree_.insert_multi(hint, mystl::move(value)); }
+
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  void insert(InputIter first, InputIter last)
+  { tree_.insert_multi(first, last); }
+  void insert(std::initializer_list<value_type> ilist)
+  { tree_.insert_multi(ilist.begin(), ilist.end()); }
+
+  // 插入节点句柄
+  iterator insert(node_type&& nh)
+  { return tree_.insert_multi(mystl::move(nh)); }
+  iterator insert(const_iterator hint, node_type&& nh)
+  { return tree_.insert_multi(hint, mystl::move(nh)); }
+
+  // erase / extract / merge / clear
+  iterator  erase(const_iterator position)
+  { return tree_.erase(position); }
+  size_type erase(const key_type& key)
+  { return tree_.erase_multi(key); }
+  iterator  erase(const_iterator first, const_iterator last)
+  { return tree_.erase(first, last); }
+
+  node_type extract(const_iterator position)
+  { return tree_.extract(position); }
+  node_type extract(const key_type& key)
+  { return tree_.extract(key); }
+
+  void      merge(multiset& source)
+  { tree_.merge_multi(source.tree_); }
+  void      merge(multiset&& source)
+  { tree_.merge_multi(source.tree_); }
+
+  void      clear() noexcept
+  { tree_.clear(); }
+
+  void      swap(multiset& rhs) noexcept
+  { tree_.swap(rhs.tree_); }
+
+  // multiset 相关操作
+  iterator  find(const key_type& key) const
+  { return tree_.find(key); }
+  size_type count(const key_type& key) const
+  { return tree_.count_multi(key); }
+  bool      contains(const key_type& key) const
+  { return tree_.find(key) != tree_.end(); }
+
+  iterator  lower_bound(const key_type& key) const
+  { return tree_.lower_bound(key); }
+  iterator  upper_bound(const key_type& key) const
+  { return tree_.upper_bound(key); }
+
+  mystl::pair<iterator, iterator> equal_range(const key_type& key) const
+  { return tree_.equal_range_multi(key); }
+
+public:
+  friend bool operator==(const multiset& lhs, const multiset& rhs) { return lhs.tree_ == rhs.tree_; }
+  friend bool operator< (const multiset& lhs, const multiset& rhs) { return lhs.tree_ <  rhs.tree_; }
+};
+
+// 重载比较操作符
+template <class Key, class Compare>
+bool operator!=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <class Key, class Compare>
+bool operator>(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+{
+  return rhs < lhs;
+}
+
+template <class Key, class Compare>
+bool operator<=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+{
+  return !(rhs < lhs);
+}
+
+template <class Key, class Compare>
+bool operator>=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+{
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <class Key, class Compare>
+void swap(multiset<Key, Compare>& lhs, multiset<Key, Compare>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_SET_H_
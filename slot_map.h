@@ -0,0 +1,343 @@
+#ifndef TINYSTL_SLOT_MAP_H_
+#define TINYSTL_SLOT_MAP_H_
+
+// 这个头文件包含一个模板类 slot_map
+// slot_map : 插入时返回一个 {index, generation} 句柄，之后用句柄 O(1) 访问、删除元素
+// 元素紧密地存放在一个 mystl::vector 中，遍历是连续内存上的顺序访问；
+// 句柄经过一张间接表 (slot) 找到元素的位置，删除时把最后一个元素移到空位 (swap-and-pop) 并更新间接表
+// 每次删除使 slot 的代数加一，旧句柄的代数不再匹配，因此过期句柄能被识别而不会访问到新元素
+
+// notes:
+//
+// 1. 句柄在元素被删除前一直有效，与元素在数组中的位置无关；
+//    迭代器、指针与引用在插入 (可能重新分配) 与删除 (最后一个元素被搬动) 后失效
+// 2. 元素的顺序不固定，删除会改变最后一个元素的位置
+// 3. 空闲的 slot 用其 index 字段串成链表，插入时优先复用
+
+// 异常保证：
+// mystl::slot_map<T> 对 insert / emplace 做强异常安全保证；
+// 元素的移动赋值不抛出异常时，erase 不抛出异常
+
+#include <cstdint>
+#include <initializer_list>
+
+#include "functional.h"
+#include "vector.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+// slot_map 的句柄，index 为 slot 的下标，generation 为插入时 slot 的代数
+struct slot_map_key
+{
+  uint32_t index;
+  uint32_t generation;
+
+  friend bool operator==(const slot_map_key& lhs, const slot_map_key& rhs) noexcept
+  { return lhs.index == rhs.index && lhs.generation == rhs.generation; }
+  friend bool operator!=(const slot_map_key& lhs, const slot_map_key& rhs) noexcept
+  { return !(lhs == rhs); }
+};
+
+// 针对 slot_map_key 的特化版本，便于把句柄作为哈希表的键
+template <>
+struct hash<slot_map_key>
+{
+  typedef void is_avalanching;
+  size_t operator()(const slot_map_key& key) const noexcept
+  {
+    return mystl::hash_mix((static_cast<uint64_t>(key.generation) << 32) | key.index);
+  }
+};
+
+// 模板类 slot_map
+// 参数代表元素类型
+template <class T>
+class slot_map
+{
+public:
+  // slot_map 的型别定义
+  typedef slot_map_key                               key_type;
+  typedef T                                          value_type;
+  typedef mystl::vector<T>                           container_type;
+
+  typedef typename container_type::pointer           pointer;
+  typedef typename container_type::const_pointer     const_pointer;
+  typedef typename container_type::reference         reference;
+  typedef typename container_type::const_reference   const_reference;
+  typedef typename container_type::size_type         size_type;
+  typedef typename container_type::difference_type   difference_type;
+
+  typedef typename container_type::iterator                iterator;
+  typedef typename container_type::const_iterator          const_iterator;
+  typedef typename container_type::reverse_iterator        reverse_iterator;
+  typedef typename container_type::const_reverse_iterator  const_reverse_iterator;
+
+private:
+  // 间接表的一项，使用中时 index 为元素在数组中的位置，空闲时为下一个空闲 slot
+  struct slot
+  {
+    uint32_t index;
+    uint32_t generation;
+  };
+
+  static constexpr uint32_t npos = static_cast<uint32_t>(-1);
+
+  container_type          values_;     // 紧密存放的元素
+  mystl::vector<uint32_t> slot_of_;    // 与 values_ 一一对应，记录元素所属的 slot
+  mystl::vector<slot>     slots_;      // 间接表
+  uint32_t                free_head_;  // 空闲 slot 链表的头，npos 表示没有空闲 slot
+
+public:
+  // 构造、复制、移动、赋值函数
+  slot_map() noexcept
+    :free_head_(npos)
+  {
+  }
+
+  slot_map(const slot_map& rhs) = default;
+  slot_map(slot_map&& rhs) noexcept
+    :values_(mystl::move(rhs.values_)), slot_of_(mystl::move(rhs.slot_of_)),
+     slots_(mystl::move(rhs.slots_)), free_head_(rhs.free_head_)
+  {
+    rhs.free_head_ = npos;
+  }
+
+  slot_map& operator=(const slot_map& rhs) = default;
+  slot_map& operator=(slot_map&& rhs) noexcept
+  {
+    slot_map tmp(mystl::move(rhs));
+    swap(tmp);
+    return *this;
+  }
+
+  ~slot_map() = default;
+
+  // 迭代器相关，遍历紧密数组
+  iterator               begin()         noexcept
+  { return values_.begin(); }
+  const_iterator         begin()   const noexcept
+  { return values_.begin(); }
+  iterator               end()           noexcept
+  { return values_.end(); }
+  const_iterator         end()     const noexcept
+  { return values_.end(); }
+
+  reverse_iterator       rbegin()        noexcept
+  { return values_.rbegin(); }
+  const_reverse_iterator rbegin()  const noexcept
+  { return values_.rbegin(); }
+  reverse_iterator       rend()          noexcept
+  { return values_.rend(); }
+  const_reverse_iterator rend()    const noexcept
+  { return values_.rend(); }
+
+  const_iterator         cbegin()  const noexcept
+  { return values_.cbegin(); }
+  const_iterator         cend()    const noexcept
+  { return values_.cend(); }
+  const_reverse_iterator crbegin() const noexcept
+  { return values_.crbegin(); }
+  const_reverse_iterator crend()   const noexcept
+  { return values_.crend(); }
+
+  // 容量相关
+  bool      empty()      const noexcept { return values_.empty(); }
+  size_type size()       const noexcept { return values_.size(); }
+  size_type max_size()   const noexcept { return static_cast<size_type>(npos); }
+  size_type capacity()   const noexcept { return values_.capacity(); }
+  // 间接表的大小，即曾经同时存在的元素个数的最大值
+  size_type slot_count() const noexcept { return slots_.size(); }
+
+  void      reserve(size_type n)
+  {
+    THROW_LENGTH_ERROR_IF(n > max_size(), "slot_map<T>'s size too big");
+    values_.reserve(n);
+    slot_of_.reserve(n);
+    slots_.reserve(n);
+  }
+
+  pointer       data()       noexcept { return values_.data(); }
+  const_pointer data() const noexcept { return values_.data(); }
+
+  // 访问元素相关
+
+  // 句柄有效时返回 true
+  bool contains(const key_type& key) const noexcept
+  {
+    return key.index < slots_.size() && slots_[key.index].generation == key.generation;
+  }
+
+  // 句柄无效时 operator[] 的行为未定义，at 会抛出一个异常
+  reference       operator[](const key_type& key)
+  {
+    MYSTL_DEBUG(contains(key));
+    return values_[slots_[key.index].index];
+  }
+  const_reference operator[](const key_type& key) const
+  {
+    MYSTL_DEBUG(contains(key));
+    return values_[slots_[key.index].index];
+  }
+
+  reference       at(const key_type& key)
+  {
+    THROW_OUT_OF_RANGE_IF(!contains(key), "slot_map<T>::at() invalid key");
+    return values_[slots_[key.index].index];
+  }
+  const_reference at(const key_type& key) const
+  {
+    THROW_OUT_OF_RANGE_IF(!contains(key), "slot_map<T>::at() invalid key");
+    return values_[slots_[key.index].index];
+  }
+
+  // 句柄无效时返回 end()
+  iterator       find(const key_type& key) noexcept
+  { return contains(key) ? begin() + slots_[key.index].index : end(); }
+  const_iterator find(const key_type& key) const noexcept
+  { return contains(key) ? begin() + slots_[key.index].index : end(); }
+
+  // 由迭代器得到元素的句柄
+  key_type key_of(const_iterator pos) const noexcept
+  {
+    MYSTL_DEBUG(pos >= cbegin() && pos < cend());
+    const uint32_t s = slot_of_[static_cast<size_type>(pos - cbegin())];
+    return key_type{ s, slots_[s].generation };
+  }
+
+  // 插入删除相关
+
+  // emplace / insert，返回新元素的句柄
+  template <class ...Args>
+  key_type emplace(Args&& ...args);
+
+  key_type insert(const value_type& value)
+  { return emplace(value); }
+  key_type insert(value_type&& value)
+  { return emplace(mystl::move(value)); }
+
+  // erase，句柄无效时返回 0
+  size_type erase(const key_type& key)
+  {
+    if (!contains(key))
+      return 0;
+    erase_at(slots_[key.index].index);
+    return 1;
+  }
+
+  // 删除 pos 处的元素，返回的迭代器与 pos 位置相同，指向被搬来的最后一个元素
+  iterator  erase(const_iterator pos)
+  {
+    MYSTL_DEBUG(pos >= cbegin() && pos < cend());
+    const size_type i = static_cast<size_type>(pos - cbegin());
+    erase_at(static_cast<uint32_t>(i));
+    return begin() + i;
+  }
+
+  // 删除所有元素，所有句柄失效，slot 留作复用
+  void clear() noexcept;
+
+  void swap(slot_map& rhs) noexcept
+  {
+    values_.swap(rhs.values_);
+    slot_of_.swap(rhs.slot_of_);
+    slots_.swap(rhs.slots_);
+    mystl::swap(free_head_, rhs.free_head_);
+  }
+
+private:
+  void erase_at(uint32_t i);
+  void release_slot(uint32_t s) noexcept;
+};
+
+/*****************************************************************************************/
+
+template <class T>
+constexpr uint32_t slot_map<T>::npos;
+
+// 先在数组尾部构造元素，再占用一个 slot，失败时撤销已完成的步骤
+template <class T>
+template <class ...Args>
+typename slot_map<T>::key_type
+slot_map<T>::emplace(Args&& ...args)
+{
+  THROW_LENGTH_ERROR_IF(size() >= max_size() - 1, "slot_map<T>'s size too big");
+  const uint32_t i = static_cast<uint32_t>(size());
+  values_.emplace_back(mystl::forward<Args>(args)...);
+  uint32_t s = free_head_;
+  try
+  {
+    if (s == npos)
+    {
+      s = static_cast<uint32_t>(slots_.size());
+      slots_.push_back(slot{ i, 0 });
+      try
+      {
+        slot_of_.push_back(s);
+      }
+      catch (...)
+      {
+        slots_.pop_back();
+        throw;
+      }
+    }
+    else
+    {
+      slot_of_.push_back(s);
+      free_head_ = slots_[s].index;
+      slots_[s].index = i;
+    }
+  }
+  catch (...)
+  {
+    values_.pop_back();
+    throw;
+  }
+  return key_type{ s, slots_[s].generation };
+}
+
+// 把最后一个元素移到 i 处并修正它的 slot，再释放 i 原来所属的 slot
+template <class T>
+void slot_map<T>::erase_at(uint32_t i)
+{
+  const uint32_t s = slot_of_[i];
+  const uint32_t last = static_cast<uint32_t>(size() - 1);
+  if (i != last)
+  {
+    values_[i] = mystl::move(values_[last]);
+    slot_of_[i] = slot_of_[last];
+    slots_[slot_of_[i]].index = i;
+  }
+  values_.pop_back();
+  slot_of_.pop_back();
+  release_slot(s);
+}
+
+// 代数加一使旧句柄失效，再把 slot 放回空闲链表
+template <class T>
+void slot_map<T>::release_slot(uint32_t s) noexcept
+{
+  ++slots_[s].generation;
+  slots_[s].index = free_head_;
+  free_head_ = s;
+}
+
+template <class T>
+void slot_map<T>::clear() noexcept
+{
+  for (size_type i = 0; i < slot_of_.size(); ++i)
+    release_slot(slot_of_[i]);
+  values_.clear();
+  slot_of_.clear();
+}
+
+// 重载 mystl 的 swap
+template <class T>
+void swap(slot_map<T>& lhs, slot_map<T>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_SLOT_MAP_H_
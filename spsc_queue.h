@@ -0,0 +1,202 @@
+#ifndef TINYSTL_SPSC_QUEUE_H_
+#define TINYSTL_SPSC_QUEUE_H_
+
+// 这个头文件包含了一个模板类 spsc_queue
+// spsc_queue : 无锁的单生产者 / 单消费者环形队列
+//
+// 容量固定为 2 的幂，head_ 与 tail_ 只增不减，物理位置为 index & (capacity - 1)
+// 生产者只写 tail_，消费者只写 head_，二者放在不同的缓存行上避免伪共享；
+// 每一方再缓存一份对方的下标，只有在缓存值显示队列满 / 空时才去读对方的缓存行
+// 同一时刻只允许一个线程调用 try_push 一族、一个线程调用 try_pop 一族
+
+// 异常保证：
+// try_push / try_emplace 在元素构造抛出异常时队列保持不变
+// try_pop_n 在元素移动抛出异常时已经弹出的元素保持弹出
+
+#include <atomic>
+
+#include "concurrency.h"
+#include "iterator.h"
+#include "memory.h"
+#include "utils.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+template <class T>
+class spsc_queue
+{
+public:
+  typedef mystl::allocator<T>                      allocator_type;
+  typedef mystl::allocator<T>                      data_allocator;
+
+  typedef typename allocator_type::value_type      value_type;
+  typedef typename allocator_type::pointer         pointer;
+  typedef typename allocator_type::reference       reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::size_type       size_type;
+
+private:
+  // 消费者独占的缓存行
+  alignas(cache_line_size) std::atomic<size_type> head_;
+  size_type                                       cached_tail_;
+  // 生产者独占的缓存行
+  alignas(cache_line_size) std::atomic<size_type> tail_;
+  size_type                                       cached_head_;
+  // 只读数据
+  alignas(cache_line_size) pointer                buf_;
+  size_type                                       mask_;
+
+public:
+  // 构造、析构函数，容量向上取整为 2 的幂
+  explicit spsc_queue(size_type capacity)
+    :head_(0), cached_tail_(0), tail_(0), cached_head_(0)
+  {
+    THROW_LENGTH_ERROR_IF(capacity > (static_cast<size_type>(-1) >> 1) / sizeof(T),
+                          "spsc_queue<T>'s capacity too big");
+    const size_type cap = round_up_pow2(capacity);
+    buf_ = data_allocator::allocate(cap);
+    mask_ = cap - 1;
+  }
+
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+
+  ~spsc_queue()
+  {
+    size_type head = head_.load(std::memory_order_relaxed);
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    for (; head != tail; ++head)
+      data_allocator::destroy(buf_ + (head & mask_));
+    data_allocator::deallocate(buf_, mask_ + 1);
+  }
+
+public:
+  // 容量相关操作，size 与 empty 只是某一时刻的近似值
+  size_type capacity() const noexcept { return mask_ + 1; }
+
+  size_type size() const noexcept
+  {
+    const size_type head = head_.load(std::memory_order_acquire);
+    const size_type tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+  }
+  bool      empty() const noexcept { return size() == 0; }
+
+  // 生产者接口，队列满时返回 false
+
+  template <class ...Args>
+  bool try_emplace(Args&& ...args)
+  {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ == capacity())
+    {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ == capacity())
+        return false;
+    }
+    data_allocator::construct(buf_ + (tail & mask_), mystl::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_push(const value_type& value) { return try_emplace(value); }
+  bool try_push(value_type&& value)      { return try_emplace(mystl::move(value)); }
+
+  // 从 first 开始最多压入 n 个元素，只发布一次 tail_，返回实际压入的个数
+  template <class InputIter>
+  size_type try_push_n(InputIter first, size_type n)
+  {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    size_type room = capacity() - (tail - cached_head_);
+    if (room < n)
+    {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      room = capacity() - (tail - cached_head_);
+    }
+    const size_type count = n < room ? n : room;
+    size_type i = 0;
+    try
+    {
+      for (; i < count; ++i, ++first)
+        data_allocator::construct(buf_ + ((tail + i) & mask_), *first);
+    }
+    catch (...)
+    {
+      // 已构造的元素照常发布
+      tail_.store(tail + i, std::memory_order_release);
+      throw;
+    }
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  // 消费者接口，队列空时返回 false
+
+  // 返回队头元素的指针，队列空时返回 nullptr
+  pointer front() noexcept
+  {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_)
+    {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_)
+        return nullptr;
+    }
+    return buf_ + (head & mask_);
+  }
+
+  // 丢弃队头元素，必须在 front() 返回非空之后调用
+  void pop() noexcept
+  {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    MYSTL_DEBUG(head != cached_tail_);
+    data_allocator::destroy(buf_ + (head & mask_));
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  bool try_pop(value_type& value)
+  {
+    pointer p = front();
+    if (p == nullptr)
+      return false;
+    value = mystl::move(*p);
+    pop();
+    return true;
+  }
+
+  // 最多弹出 n 个元素写入 result，只发布一次 head_，返回实际弹出的个数
+  template <class OutputIter>
+  size_type try_pop_n(OutputIter result, size_type n)
+  {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    size_type avail = cached_tail_ - head;
+    if (avail < n)
+    {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      avail = cached_tail_ - head;
+    }
+    const size_type count = n < avail ? n : avail;
+    size_type i = 0;
+    try
+    {
+      for (; i < count; ++i, ++result)
+      {
+        pointer p = buf_ + ((head + i) & mask_);
+        *result = mystl::move(*p);
+        data_allocator::destroy(p);
+      }
+    }
+    catch (...)
+    {
+      head_.store(head + i, std::memory_order_release);
+      throw;
+    }
+    head_.store(head + count, std::memory_order_release);
+    return count;
+  }
+};
+
+} // namespace mystl
+#endif // !MYTINYSTL_SPSC_QUEUE_H_
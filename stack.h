@@ -5,13 +5,15 @@
 // stack : 栈
 //适配器，不算容器
 #include "deque.h"    
+#include "circular_buffer.h"
 
 namespace mystl
 {
 
 // 模板类 stack
-// 参数一代表数据类型，参数二代表底层容器类型，缺省使用 mystl::deque 作为底层容器
-template <class T, class Container = mystl::deque<T>>
+// 参数一代表数据类型，参数二代表底层容器类型，缺省使用 mystl::circular_buffer 作为底层容器
+// 也可以指定 mystl::deque<T>、mystl::vector<T> 等任何支持 back/push_back/pop_back 的容器
+template <class T, class Container = mystl::circular_buffer<T>>
 class stack
 {
 public:
@@ -0,0 +1,485 @@
+#ifndef TINYSTL_THREAD_POOL_H_
+#define TINYSTL_THREAD_POOL_H_
+
+// 这个头文件包含了一个工作窃取线程池 thread_pool 以及建立在其上的 fork-join 接口
+// thread_pool         : 固定数量的工作线程，每个线程有一个 ws_deque (Chase-Lev 双端队列)
+// task_group          : 一组可以等待的任务，等待时当前线程会帮忙执行任务
+// parallel_invoke     : 并行执行若干个函数对象，全部完成后返回
+// parallel_for        : 把下标区间递归二分，直到不超过 grain，再并行执行
+// default_thread_pool : 进程内共享的线程池，并行算法默认使用它
+//
+// 工作线程产生的任务压入自己队列的底部，也从底部取出(后进先出，缓存友好)；
+// 空闲的线程随机挑选一个其他线程，从其队列顶部窃取任务(先进先出，窃取到的通常是较大的任务)；
+// 非工作线程提交的任务进入一个加锁的公共队列
+// 找不到任务的线程自旋一段时间后在条件变量上休眠，只有存在休眠线程时提交方才会去加锁唤醒，
+// 在 task_group::wait 中休眠的线程同样会被新任务唤醒，醒来后帮忙执行
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "concurrency.h"
+#include "queue.h"
+#include "vector.h"
+#include "ws_deque.h"
+#include "utils.h"
+
+namespace mystl
+{
+
+// 线程池中任务的基类
+struct pool_task
+{
+  virtual ~pool_task() {}
+  virtual void run() = 0;
+};
+
+template <class F>
+struct pool_task_impl : public pool_task
+{
+  F f;
+
+  template <class G>
+  explicit pool_task_impl(G&& g) :f(mystl::forward<G>(g)) {}
+
+  void run() override { f(); }
+};
+
+class thread_pool
+{
+  friend class task_group;
+
+private:
+  struct worker
+  {
+    ws_deque<pool_task*> tasks;
+    unsigned             seed;  // 选择窃取对象用的随机数状态
+    char                 pad[cache_line_size];
+  };
+
+  // 当前线程所属的线程池与编号，非工作线程为 nullptr
+  struct worker_slot
+  {
+    thread_pool* pool;
+    size_t       index;
+  };
+
+  static worker_slot& current() noexcept
+  {
+    static thread_local worker_slot slot = { nullptr, 0 };
+    return slot;
+  }
+
+  // 找不到任务时自旋多少轮后休眠
+  enum { spin_rounds = 64 };
+
+private:
+  mystl::vector<worker*>      workers_;
+  mystl::vector<std::thread>  threads_;
+
+  // 非工作线程提交的任务
+  std::mutex                  inject_mutex_;
+  mystl::queue<pool_task*>    injected_;
+  std::atomic<size_t>         injected_size_;
+
+  // 空闲的工作线程在此休眠
+  std::mutex                  sleep_mutex_;
+  std::condition_variable     sleep_cv_;
+  std::atomic<size_t>         sleepers_;
+  bool                        stop_;
+
+  // task_group::wait 在没有任务可帮忙时在此等待
+  std::mutex                  done_mutex_;
+  std::condition_variable     done_cv_;
+  std::atomic<size_t>         done_waiters_;
+
+public:
+  // 构造、析构函数，threads 为 0 时使用硬件线程数
+  explicit thread_pool(size_t threads = 0)
+    :injected_size_(0), sleepers_(0), stop_(false), done_waiters_(0)
+  {
+    if (threads == 0)
+      threads = std::thread::hardware_concurrency();
+    if (threads == 0)
+      threads = 1;
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+    {
+      workers_.push_back(new worker());
+      workers_[i]->seed = static_cast<unsigned>(i * 2654435761u + 1);
+    }
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+      threads_.push_back(std::thread(&thread_pool::worker_loop, this, i));
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  // 等待所有已提交的任务完成后退出
+  ~thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lk(sleep_mutex_);
+      stop_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (size_t i = 0; i < threads_.size(); ++i)
+      threads_[i].join();
+    for (size_t i = 0; i < workers_.size(); ++i)
+      delete workers_[i];
+  }
+
+public:
+  size_t size() const noexcept { return workers_.size(); }
+
+  // 当前线程是否为本线程池的工作线程
+  bool   in_worker() const noexcept { return current().pool == this; }
+
+  // 提交一个不需要等待的任务，任务抛出的异常会导致 std::terminate
+  template <class F>
+  void submit(F&& f)
+  {
+    typedef typename std::decay<F>::type func_type;
+    spawn(new pool_task_impl<func_type>(mystl::forward<F>(f)));
+  }
+
+private:
+  // 工作线程压入自己的队列，其他线程压入公共队列
+  void spawn(pool_task* t)
+  {
+    const worker_slot& self = current();
+    if (self.pool == this)
+    {
+      workers_[self.index]->tasks.push(t);
+    }
+    else
+    {
+      std::lock_guard<std::mutex> lk(inject_mutex_);
+      injected_.push(t);
+      injected_size_.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) != 0)
+    {
+      std::lock_guard<std::mutex> lk(sleep_mutex_);
+      sleep_cv_.notify_one();
+    }
+    if (done_waiters_.load(std::memory_order_relaxed) != 0)
+    {
+      std::lock_guard<std::mutex> lk(done_mutex_);
+      done_cv_.notify_one();
+    }
+  }
+
+  pool_task* pop_injected()
+  {
+    if (injected_size_.load(std::memory_order_relaxed) == 0)
+      return nullptr;
+    std::lock_guard<std::mutex> lk(inject_mutex_);
+    if (injected_.empty())
+      return nullptr;
+    pool_task* t = injected_.front();
+    injected_.pop();
+    injected_size_.fetch_sub(1, std::memory_order_relaxed);
+    return t;
+  }
+
+  // 从随机选择的其他线程窃取，最多尝试两轮
+  pool_task* steal_from_others(size_t self, unsigned& seed)
+  {
+    const size_t n = workers_.size();
+    for (size_t i = 0; i < 2 * n; ++i)
+    {
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      const size_t victim = seed % n;
+      if (victim == self)
+        continue;
+      pool_task* t = nullptr;
+      if (workers_[victim]->tasks.steal(t))
+        return t;
+    }
+    return nullptr;
+  }
+
+  // 依次尝试 : 自己的队列、公共队列、窃取
+  pool_task* find_task()
+  {
+    const worker_slot& self = current();
+    if (self.pool == this)
+    {
+      worker* w = workers_[self.index];
+      pool_task* t = nullptr;
+      if (!w->tasks.pop(t))
+        t = pop_injected();
+      if (t == nullptr)
+        t = steal_from_others(self.index, w->seed);
+      return t;
+    }
+    // 非工作线程只能窃取
+    pool_task* t = pop_injected();
+    if (t == nullptr)
+    {
+      static thread_local unsigned seed = 2463534242u;
+      t = steal_from_others(workers_.size(), seed);
+    }
+    return t;
+  }
+
+  bool has_work() const noexcept
+  {
+    if (injected_size_.load(std::memory_order_relaxed) != 0)
+      return true;
+    for (size_t i = 0; i < workers_.size(); ++i)
+    {
+      if (!workers_[i]->tasks.empty())
+        return true;
+    }
+    return false;
+  }
+
+  static void execute(pool_task* t)
+  {
+    t->run();
+    delete t;
+  }
+
+  void worker_loop(size_t index)
+  {
+    current().pool = this;
+    current().index = index;
+    size_t idle = 0;
+    for (;;)
+    {
+      pool_task* t = find_task();
+      if (t != nullptr)
+      {
+        execute(t);
+        idle = 0;
+        continue;
+      }
+      if (++idle < spin_rounds)
+      {
+        cpu_relax();
+        continue;
+      }
+      idle = 0;
+      std::unique_lock<std::mutex> lk(sleep_mutex_);
+      sleepers_.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      while (!stop_ && !has_work())
+        sleep_cv_.wait(lk);
+      sleepers_.fetch_sub(1, std::memory_order_relaxed);
+      if (stop_ && !has_work())
+        return;
+    }
+  }
+
+  // 帮忙执行任务直到 done() 为真
+  template <class Pred>
+  void help_until(Pred done)
+  {
+    size_t idle = 0;
+    while (!done())
+    {
+      pool_task* t = find_task();
+      if (t != nullptr)
+      {
+        execute(t);
+        idle = 0;
+        continue;
+      }
+      if (++idle < spin_rounds)
+      {
+        cpu_relax();
+        continue;
+      }
+      idle = 0;
+      std::unique_lock<std::mutex> lk(done_mutex_);
+      done_waiters_.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!done() && !has_work())
+        done_cv_.wait(lk);
+      done_waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  // 某个 task_group 的任务全部完成时唤醒等待者，新任务由 spawn 唤醒
+  void notify_done()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (done_waiters_.load(std::memory_order_relaxed) != 0)
+    {
+      std::lock_guard<std::mutex> lk(done_mutex_);
+      done_cv_.notify_all();
+    }
+  }
+};
+
+// 进程内共享的线程池
+inline thread_pool& default_thread_pool()
+{
+  static thread_pool pool;
+  return pool;
+}
+
+/*****************************************************************************************/
+// task_group
+// run 提交的任务全部完成后 wait 返回，第一个抛出的异常在 wait 中重新抛出
+/*****************************************************************************************/
+class task_group
+{
+private:
+  template <class F>
+  struct group_task : public pool_task
+  {
+    F           f;
+    task_group* group;
+
+    template <class G>
+    group_task(G&& g, task_group* tg) :f(mystl::forward<G>(g)), group(tg) {}
+
+    void run() override
+    {
+      try
+      {
+        f();
+      }
+      catch (...)
+      {
+        group->set_error(std::current_exception());
+      }
+      // 计数减为 0 之后 group 可能已被销毁，只能再访问线程池
+      thread_pool* pool = group->pool_;
+      if (group->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        pool->notify_done();
+    }
+  };
+
+private:
+  thread_pool*        pool_;
+  std::atomic<size_t> pending_;
+  std::atomic<bool>   has_error_;
+  std::exception_ptr  error_;
+
+public:
+  explicit task_group(thread_pool& pool = default_thread_pool())
+    :pool_(&pool), pending_(0), has_error_(false) {}
+
+  task_group(const task_group&) = delete;
+  task_group& operator=(const task_group&) = delete;
+
+  // 析构前必须调用 wait，这里只做兜底等待
+  ~task_group()
+  {
+    pool_->help_until([this] { return pending_.load(std::memory_order_acquire) == 0; });
+  }
+
+  template <class F>
+  void run(F&& f)
+  {
+    typedef typename std::decay<F>::type func_type;
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    pool_->spawn(new group_task<func_type>(mystl::forward<F>(f), this));
+  }
+
+  void wait()
+  {
+    pool_->help_until([this] { return pending_.load(std::memory_order_acquire) == 0; });
+    if (has_error_.load(std::memory_order_acquire))
+    {
+      std::exception_ptr e = error_;
+      error_ = nullptr;
+      has_error_.store(false, std::memory_order_relaxed);
+      std::rethrow_exception(e);
+    }
+  }
+
+private:
+  void set_error(std::exception_ptr e)
+  {
+    bool expected = false;
+    if (has_error_.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+      error_ = e;
+  }
+};
+
+/*****************************************************************************************/
+// parallel_invoke
+// 当前线程执行第一个函数对象，其余的提交给线程池，全部完成后返回
+/*****************************************************************************************/
+inline void parallel_invoke_spawn(task_group&) {}
+
+template <class F, class ...Fs>
+void parallel_invoke_spawn(task_group& g, F&& f, Fs&& ...fs)
+{
+  g.run(mystl::forward<F>(f));
+  parallel_invoke_spawn(g, mystl::forward<Fs>(fs)...);
+}
+
+template <class F, class ...Fs>
+void parallel_invoke(thread_pool& pool, F&& f, Fs&& ...fs)
+{
+  task_group g(pool);
+  parallel_invoke_spawn(g, mystl::forward<Fs>(fs)...);
+  try
+  {
+    f();
+  }
+  catch (...)
+  {
+    try { g.wait(); } catch (...) {}
+    throw;
+  }
+  g.wait();
+}
+
+template <class F, class ...Fs>
+typename std::enable_if<!std::is_same<typename std::decay<F>::type, thread_pool>::value>::type
+parallel_invoke(F&& f, Fs&& ...fs)
+{
+  parallel_invoke(default_thread_pool(), mystl::forward<F>(f), mystl::forward<Fs>(fs)...);
+}
+
+/*****************************************************************************************/
+// parallel_for
+// 对 [first, last) 递归二分，区间长度不超过 grain 时调用 body(first, last)
+/*****************************************************************************************/
+template <class Body>
+void parallel_for(thread_pool& pool, size_t first, size_t last, size_t grain, const Body& body)
+{
+  if (grain == 0)
+    grain = 1;
+  if (last - first <= grain)
+  {
+    if (first < last)
+      body(first, last);
+    return;
+  }
+  const size_t mid = first + (last - first) / 2;
+  task_group g(pool);
+  g.run([&pool, mid, last, grain, &body] { parallel_for(pool, mid, last, grain, body); });
+  try
+  {
+    parallel_for(pool, first, mid, grain, body);
+  }
+  catch (...)
+  {
+    try { g.wait(); } catch (...) {}
+    throw;
+  }
+  g.wait();
+}
+
+template <class Body>
+void parallel_for(size_t first, size_t last, size_t grain, const Body& body)
+{
+  parallel_for(default_thread_pool(), first, last, grain, body);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_THREAD_POOL_H_
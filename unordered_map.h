@@ -0,0 +1,306 @@
+#ifndef TINYSTL_UNORDERED_MAP_H_
+#define TINYSTL_UNORDERED_MAP_H_
+
+// 这个头文件包含了一个模板类 unordered_map
+// unordered_map : 键值不重复的无序映射，底层实现为分离链接法的 hashtable，
+// 元素存放在单独的节点上，删除之前引用保持有效，节点可以 extract 后插入到另一个 unordered_map
+// 不需要引用稳定时 flat_hash_map 更快，也更省内存
+
+// 异常保证：
+// mystl::unordered_map<Key, T> 满足基本异常保证，对 insert / emplace / try_emplace 做强异常安全保证
+
+#include "hashtable.h"
+
+namespace mystl
+{
+
+// 模板类 unordered_map
+// 参数一代表键值类型，参数二代表实值类型，参数三代表哈希函数，参数四代表键值的相等比较
+template <class Key, class T, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+class unordered_map
+{
+private:
+  typedef hashtable<mystl::pair<const Key, T>, Key, mystl::selectfirst<mystl::pair<const Key, T>>,
+                    Hash, KeyEqual> base_type;
+  base_type ht_;
+
+public:
+  // unordered_map 的型别定义
+  typedef typename base_type::key_type             key_type;
+  typedef T                                        mapped_type;
+  typedef typename base_type::value_type           value_type;
+  typedef typename base_type::hasher               hasher;
+  typedef typename base_type::key_equal            key_equal;
+
+  typedef typename base_type::allocator_type       allocator_type;
+  typedef typename base_type::pointer              pointer;
+  typedef typename base_type::const_pointer        const_pointer;
+  typedef typename base_type::reference            reference;
+  typedef typename base_type::const_reference      const_reference;
+  typedef typename base_type::size_type            size_type;
+  typedef typename base_type::difference_type      difference_type;
+
+  typedef typename base_type::iterator             iterator;
+  typedef typename base_type::const_iterator       const_iterator;
+  typedef typename base_type::local_iterator       local_iterator;
+  typedef typename base_type::const_local_iterator const_local_iterator;
+
+  typedef typename base_type::node_type            node_type;
+  typedef typename base_type::insert_return_type   insert_return_type;
+
+  allocator_type get_allocator() const { return ht_.get_allocator(); }
+
+public:
+  // 构造、复制、移动函数
+  unordered_map()
+    :ht_(0)
+  {
+  }
+
+  explicit unordered_map(size_type bucket_count,
+                         const hasher& hash = hasher(),
+                         const key_equal& equal = key_equal())
+    :ht_(bucket_count, hash, equal)
+  {
+  }
+
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  unordered_map(InputIter first, InputIter last, size_type bucket_count = 0,
+                const hasher& hash = hasher(), const key_equal& equal = key_equal())
+    :ht_(bucket_count, hash, equal)
+  {
+    ht_.insert_unique(first, last);
+  }
+
+  unordered_map(std::initializer_list<value_type> ilist, size_type bucket_count = 0,
+                const hasher& hash = hasher(), const key_equal& equal = key_equal())
+    :ht_(bucket_count, hash, equal)
+  {
+    ht_.insert_unique(ilist.begin(), ilist.end());
+  }
+
+  unordered_map(const unordered_map& rhs)
+    :ht_(rhs.ht_)
+  {
+  }
+  unordered_map(unordered_map&& rhs) noexcept
+    :ht_(mystl::move(rhs.ht_))
+  {
+  }
+
+  unordered_map& operator=(const unordered_map& rhs)
+  {
+    ht_ = rhs.ht_;
+    return *this;
+  }
+  unordered_map& operator=(unordered_map&& rhs) noexcept
+  {
+    ht_ = mystl::move(rhs.ht_);
+    return *this;
+  }
+
+  unordered_map& operator=(std::initializer_list<value_type> ilist)
+  {
+    unordered_map tmp(ilist, 0, ht_.hash_function(), ht_.key_eq());
+    swap(tmp);
+    return *this;
+  }
+
+  ~unordered_map() = default;
+
+  // 迭代器相关
+  iterator       begin()        noexcept
+  { return ht_.begin(); }
+  const_iterator begin()  const noexcept
+  { return ht_.begin(); }
+  iterator       end()          noexcept
+  { return ht_.end(); }
+  const_iterator end()    const noexcept
+  { return ht_.end(); }
+
+  const_iterator cbegin() const noexcept
+  { return ht_.cbegin(); }
+  const_iterator cend()   const noexcept
+  { return ht_.cend(); }
+
+  // 容量相关
+  bool      empty()    const noexcept { return ht_.empty(); }
+  size_type size()     const noexcept { return ht_.size(); }
+  size_type max_size() const noexcept { return ht_.max_size(); }
+
+  // 修改容器操作
+
+  // emplace / emplace_hint
+  template <class ...Args>
+  mystl::pair<iterator, bool> emplace(Args&& ...args)
+  { return ht_.emplace_unique(mystl::forward<Args>(args)...); }
+
+  template <class ...Args>
+  iterator emplace_hint(const_iterator /*hint*/, Args&& ...args)
+  { return ht_.emplace_unique(mystl::forward<Args>(args)...).first; }
+
+  // try_emplace，键不存在时才用 args 构造实值
+  template <class ...Args>
+  mystl::pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+  { return ht_.try_emplace_unique(key, mystl::forward<Args>(args)...); }
+  template <class ...Args>
+  mystl::pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args)
+  { return ht_.try_emplace_unique(mystl::move(key), mystl::forward<Args>(args)...); }
+
+  // insert
+  mystl::pair<iterator, bool> insert(const value_type& value)
+  { return ht_.insert_unique(value); }
+  mystl::pair<iterator, bool> insert(value_type&& value)
+  { return ht_.insert_unique(mystl::move(value)); }
+
+  iterator insert(const_iterator /*hint*/, const value_type& value)
+  { return ht_.insert_unique(value).first; }
+  iterator insert(const_iterator /*hint*/, value_type&& value)
+  { return ht_.insert_unique(mystl::move(value)).first; }
+
+  // 前向迭代器的区间先按区间长度预留桶
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  void insert(InputIter first, InputIter last)
+  { ht_.insert_unique(first, last); }
+  void insert(std::initializer_list<value_type> ilist)
+  { ht_.insert_unique(ilist.begin(), ilist.end()); }
+
+  // 插入节点句柄，键已存在时节点留在返回值的 node 中
+  insert_return_type insert(node_type&& nh)
+  { return ht_.insert_unique(mystl::move(nh)); }
+  iterator insert(const_iterator /*hint*/, node_type&& nh)
+  { return ht_.insert_unique(mystl::move(nh)).position; }
+
+  // insert_or_assign
+  template <class M>
+  mystl::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+  {
+    auto r = ht_.try_emplace_unique(key, mystl::forward<M>(obj));
+    if (!r.second)
+      r.first->second = mystl::forward<M>(obj);
+    return r;
+  }
+  template <class M>
+  mystl::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+  {
+    auto r = ht_.try_emplace_unique(mystl::move(key), mystl::forward<M>(obj));
+    if (!r.second)
+      r.first->second = mystl::forward<M>(obj);
+    return r;
+  }
+
+  // erase / extract / clear
+  iterator  erase(iterator it)
+  { return ht_.erase(it); }
+  iterator  erase(const_iterator it)
+  { return ht_.erase(it); }
+  iterator  erase(const_iterator first, const_iterator last)
+  { return ht_.erase(first, last); }
+  size_type erase(const key_type& key)
+  { return ht_.erase(key); }
+
+  node_type extract(const_iterator it)
+  { return ht_.extract(it); }
+  node_type extract(const key_type& key)
+  { return ht_.extract(key); }
+
+  void      clear() noexcept
+  { ht_.clear(); }
+
+  void      swap(unordered_map& other) noexcept
+  { ht_.swap(other.ht_); }
+
+  // 查找相关
+  mapped_type&       at(const key_type& key)
+  {
+    iterator it = ht_.find(key);
+    THROW_OUT_OF_RANGE_IF(it == end(), "unordered_map<Key, T> no such element exists");
+    return it->second;
+  }
+  const mapped_type& at(const key_type& key) const
+  {
+    const_iterator it = ht_.find(key);
+    THROW_OUT_OF_RANGE_IF(it == end(), "unordered_map<Key, T> no such element exists");
+    return it->second;
+  }
+
+  mapped_type& operator[](const key_type& key)
+  { return ht_.try_emplace_unique(key).first->second; }
+  mapped_type& operator[](key_type&& key)
+  { return ht_.try_emplace_unique(mystl::move(key)).first->second; }
+
+  size_type      count(const key_type& key) const
+  { return ht_.count(key); }
+  bool           contains(const key_type& key) const
+  { return ht_.contains(key); }
+
+  iterator       find(const key_type& key)
+  { return ht_.find(key); }
+  const_iterator find(const key_type& key) const
+  { return ht_.find(key); }
+
+  mystl::pair<iterator, iterator> equal_range(const key_type& key)
+  { return ht_.equal_range(key); }
+  mystl::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+  { return ht_.equal_range(key); }
+
+  // bucket interface
+  local_iterator       begin(size_type n)        noexcept
+  { return ht_.begin(n); }
+  const_local_iterator begin(size_type n)  const noexcept
+  { return ht_.begin(n); }
+  const_local_iterator cbegin(size_type n) const noexcept
+  { return ht_.cbegin(n); }
+
+  local_iterator       end(size_type n)          noexcept
+  { return ht_.end(n); }
+  const_local_iterator end(size_type n)    const noexcept
+  { return ht_.end(n); }
+  const_local_iterator cend(size_type n)   const noexcept
+  { return ht_.cend(n); }
+
+  size_type bucket_count()                 const noexcept
+  { return ht_.bucket_count(); }
+  size_type max_bucket_count()             const noexcept
+  { return ht_.max_bucket_count(); }
+
+  size_type bucket_size(size_type n)       const noexcept
+  { return ht_.bucket_size(n); }
+  size_type bucket(const key_type& key)    const
+  { return ht_.bucket(key); }
+
+  // hash policy
+  float     load_factor()            const noexcept { return ht_.load_factor(); }
+
+  float     max_load_factor()        const noexcept { return ht_.max_load_factor(); }
+  void      max_load_factor(float ml)               { ht_.max_load_factor(ml); }
+
+  void      rehash(size_type count)                 { ht_.rehash(count); }
+  void      reserve(size_type count)                { ht_.reserve(count); }
+
+  hasher    hash_function()          const          { return ht_.hash_function(); }
+  key_equal key_eq()                 const          { return ht_.key_eq(); }
+
+public:
+  friend bool operator==(const unordered_map& lhs, const unordered_map& rhs)
+  {
+    return lhs.ht_.equal_to(rhs.ht_);
+  }
+  friend bool operator!=(const unordered_map& lhs, const unordered_map& rhs)
+  {
+    return !lhs.ht_.equal_to(rhs.ht_);
+  }
+};
+
+// 重载 mystl 的 swap
+template <class Key, class T, class Hash, class KeyEqual>
+void swap(unordered_map<Key, T, Hash, KeyEqual>& lhs,
+          unordered_map<Key, T, Hash, KeyEqual>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_UNORDERED_MAP_H_
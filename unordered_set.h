@@ -0,0 +1,255 @@
+#ifndef TINYSTL_UNORDERED_SET_H_
+#define TINYSTL_UNORDERED_SET_H_
+
+// 这个头文件包含了一个模板类 unordered_set
+// unordered_set : 键值不重复的无序集合，底层实现为分离链接法的 hashtable，
+// 元素存放在单独的节点上，删除之前引用保持有效，节点可以 extract 后插入到另一个 unordered_set
+
+// 异常保证：
+// mystl::unordered_set<Key> 满足基本异常保证，对 insert / emplace 做强异常安全保证
+
+#include "hashtable.h"
+
+namespace mystl
+{
+
+// 模板类 unordered_set
+// 参数一代表键值类型，参数二代表哈希函数，参数三代表键值的相等比较
+template <class Key, class Hash = mystl::hash<Key>, class KeyEqual = mystl::equal_to<Key>>
+class unordered_set
+{
+private:
+  typedef hashtable<Key, Key, mystl::identity<Key>, Hash, KeyEqual> base_type;
+  base_type ht_;
+
+public:
+  // unordered_set 的型别定义，元素不能修改，iterator 与 const_iterator 相同
+  typedef typename base_type::key_type             key_type;
+  typedef typename base_type::value_type           value_type;
+  typedef typename base_type::hasher               hasher;
+  typedef typename base_type::key_equal            key_equal;
+
+  typedef typename base_type::allocator_type       allocator_type;
+  typedef typename base_type::pointer              pointer;
+  typedef typename base_type::const_pointer        const_pointer;
+  typedef typename base_type::reference            reference;
+  typedef typename base_type::const_reference      const_reference;
+  typedef typename base_type::size_type            size_type;
+  typedef typename base_type::difference_type      difference_type;
+
+  typedef typename base_type::const_iterator       iterator;
+  typedef typename base_type::const_iterator       const_iterator;
+  typedef typename base_type::const_local_iterator local_iterator;
+  typedef typename base_type::const_local_iterator const_local_iterator;
+
+  typedef typename base_type::node_type            node_type;
+  typedef node_insert_return<iterator, node_type>  insert_return_type;
+
+  allocator_type get_allocator() const { return ht_.get_allocator(); }
+
+public:
+  // 构造、复制、移动函数
+  unordered_set()
+    :ht_(0)
+  {
+  }
+
+  explicit unordered_set(size_type bucket_count,
+                         const hasher& hash = hasher(),
+                         const key_equal& equal = key_equal())
+    :ht_(bucket_count, hash, equal)
+  {
+  }
+
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  unordered_set(InputIter first, InputIter last, size_type bucket_count = 0,
+                const hasher& hash = hasher(), const key_equal& equal = key_equal())
+    :ht_(bucket_count, hash, equal)
+  {
+    ht_.insert_unique(first, last);
+  }
+
+  unordered_set(std::initializer_list<value_type> ilist, size_type bucket_count = 0,
+                const hasher& hash = hasher(), const key_equal& equal = key_equal())
+    :ht_(bucket_count, hash, equal)
+  {
+    ht_.insert_unique(ilist.begin(), ilist.end());
+  }
+
+  unordered_set(const unordered_set& rhs)
+    :ht_(rhs.ht_)
+  {
+  }
+  unordered_set(unordered_set&& rhs) noexcept
+    :ht_(mystl::move(rhs.ht_))
+  {
+  }
+
+  unordered_set& operator=(const unordered_set& rhs)
+  {
+    ht_ = rhs.ht_;
+    return *this;
+  }
+  unordered_set& operator=(unordered_set&& rhs) noexcept
+  {
+    ht_ = mystl::move(rhs.ht_);
+    return *this;
+  }
+
+  unordered_set& operator=(std::initializer_list<value_type> ilist)
+  {
+    unordered_set tmp(ilist, 0, ht_.hash_function(), ht_.key_eq());
+    swap(tmp);
+    return *this;
+  }
+
+  ~unordered_set() = default;
+
+  // 迭代器相关
+  iterator begin()  const noexcept
+  { return ht_.begin(); }
+  iterator end()    const noexcept
+  { return ht_.end(); }
+  iterator cbegin() const noexcept
+  { return ht_.cbegin(); }
+  iterator cend()   const noexcept
+  { return ht_.cend(); }
+
+  // 容量相关
+  bool      empty()    const noexcept { return ht_.empty(); }
+  size_type size()     const noexcept { return ht_.size(); }
+  size_type max_size() const noexcept { return ht_.max_size(); }
+
+  // 修改容器操作
+
+  // emplace / emplace_hint
+  template <class ...Args>
+  mystl::pair<iterator, bool> emplace(Args&& ...args)
+  {
+    auto r = ht_.emplace_unique(mystl::forward<Args>(args)...);
+    return mystl::pair<iterator, bool>(r.first, r.second);
+  }
+
+  template <class ...Args>
+  iterator emplace_hint(const_iterator /*hint*/, Args&& ...args)
+  { return ht_.emplace_unique(mystl::forward<Args>(args)...).first; }
+
+  // insert
+  mystl::pair<iterator, bool> insert(const value_type& value)
+  {
+    auto r = ht_.insert_unique(value);
+    return mystl::pair<iterator, bool>(r.first, r.second);
+  }
+  mystl::pair<iterator, bool> insert(value_type&& value)
+  {
+    auto r = ht_.insert_unique(mystl::move(value));
+    return mystl::pair<iterator, bool>(r.first, r.second);
+  }
+
+  iterator insert(const_iterator /*hint*/, const value_type& value)
+  { return ht_.insert_unique(value).first; }
+  iterator insert(const_iterator /*hint*/, value_type&& value)
+  { return ht_.insert_unique(mystl::move(value)).first; }
+
+  // 前向迭代器的区间先按区间长度预留桶
+  template <class InputIter, typename std::enable_if<
+    mystl::is_input_iterator<InputIter>::value, int>::type = 0>
+  void insert(InputIter first, InputIter last)
+  { ht_.insert_unique(first, last); }
+  void insert(std::initializer_list<value_type> ilist)
+  { ht_.insert_unique(ilist.begin(), ilist.end()); }
+
+  // 插入节点句柄，键已存在时节点留在返回值的 node 中
+  insert_return_type insert(node_type&& nh)
+  {
+    auto r = ht_.insert_unique(mystl::move(nh));
+    return insert_return_type{ r.position, r.inserted, mystl::move(r.node) };
+  }
+  iterator insert(const_iterator /*hint*/, node_type&& nh)
+  { return ht_.insert_unique(mystl::move(nh)).position; }
+
+  // erase / extract / clear
+  iterator  erase(const_iterator it)
+  { return ht_.erase(it); }
+  iterator  erase(const_iterator first, const_iterator last)
+  { return ht_.erase(first, last); }
+  size_type erase(const key_type& key)
+  { return ht_.erase(key); }
+
+  node_type extract(const_iterator it)
+  { return ht_.extract(it); }
+  node_type extract(const key_type& key)
+  { return ht_.extract(key); }
+
+  void      clear() noexcept
+  { ht_.clear(); }
+
+  void      swap(unordered_set& other) noexcept
+  { ht_.swap(other.ht_); }
+
+  // 查找相关
+  size_type count(const key_type& key) const
+  { return ht_.count(key); }
+  bool      contains(const key_type& key) const
+  { return ht_.contains(key); }
+
+  iterator  find(const key_type& key) const
+  { return ht_.find(key); }
+
+  mystl::pair<iterator, iterator> equal_range(const key_type& key) const
+  { return ht_.equal_range(key); }
+
+  // bucket interface
+  local_iterator begin(size_type n)  const noexcept
+  { return ht_.begin(n); }
+  local_iterator cbegin(size_type n) const noexcept
+  { return ht_.cbegin(n); }
+  local_iterator end(size_type n)    const noexcept
+  { return ht_.end(n); }
+  local_iterator cend(size_type n)   const noexcept
+  { return ht_.cend(n); }
+
+  size_type bucket_count()                 const noexcept
+  { return ht_.bucket_count(); }
+  size_type max_bucket_count()             const noexcept
+  { return ht_.max_bucket_count(); }
+
+  size_type bucket_size(size_type n)       const noexcept
+  { return ht_.bucket_size(n); }
+  size_type bucket(const key_type& key)    const
+  { return ht_.bucket(key); }
+
+  // hash policy
+  float     load_factor()            const noexcept { return ht_.load_factor(); }
+
+  float     max_load_factor()        const noexcept { return ht_.max_load_factor(); }
+  void      max_load_factor(float ml)               { ht_.max_load_factor(ml); }
+
+  void      rehash(size_type count)                 { ht_.rehash(count); }
+  void      reserve(size_type count)                { ht_.reserve(count); }
+
+  hasher    hash_function()          const          { return ht_.hash_function(); }
+  key_equal key_eq()                 const          { return ht_.key_eq(); }
+
+public:
+  friend bool operator==(const unordered_set& lhs, const unordered_set& rhs)
+  {
+    return lhs.ht_.equal_to(rhs.ht_);
+  }
+  friend bool operator!=(const unordered_set& lhs, const unordered_set& rhs)
+  {
+    return !lhs.ht_.equal_to(rhs.ht_);
+  }
+};
+
+// 重载 mystl 的 swap
+template <class Key, class Hash, class KeyEqual>
+void swap(unordered_set<Key, Hash, KeyEqual>& lhs,
+          unordered_set<Key, Hash, KeyEqual>& rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+} // namespace mystl
+#endif // !MYTINYSTL_UNORDERED_SET_H_
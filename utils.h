@@ -38,7 +38,7 @@ template<class Tp>
 void swap(Tp &lhs,Tp &rhs){
     auto tmp(mystl::move(lhs));
     lhs=mystl::move(rhs);
-    rhs=mystl::move(lhs);
+    rhs=mystl::move(tmp);
 }
 
 //swap_range
@@ -162,25 +162,25 @@ struct pair
     //传入一个pair的右值引用
     template<class Other1=T1,class Other2=T2,
     typename std::enable_if<
-    std::is_constructible<T1,const Other1>::value&&
-    std::is_constructible<T2,const Other2>::value&&
-    std::is_convertible<const Other1,T1>::value&&
-    std::is_convertible<const Other2,T2>::value,int>::type=0>
+    std::is_constructible<T1,Other1>::value&&
+    std::is_constructible<T2,Other2>::value&&
+    std::is_convertible<Other1,T1>::value&&
+    std::is_convertible<Other2,T2>::value,int>::type=0>
     constexpr pair(pair<Other1,Other2>&& other)
-    :first(mystl::forward(other.first)),
-    second(mystl::forward(other.second))
+    :first(mystl::forward<Other1>(other.first)),
+    second(mystl::forward<Other2>(other.second))
     {}
 
     //显式构造版
     template<class Other1=T1,class Other2=T2,
     typename std::enable_if<
-    std::is_constructible<T1,const Other1>::value&&
-    std::is_constructible<T2,const Other2>::value&&
-    (!std::is_convertible<const Other1,T1>::value||
-    !std::is_convertible<const Other2,T2>::value),int>::type=0>
+    std::is_constructible<T1,Other1>::value&&
+    std::is_constructible<T2,Other2>::value&&
+    (!std::is_convertible<Other1,T1>::value||
+    !std::is_convertible<Other2,T2>::value),int>::type=0>
     explicit constexpr pair(pair<Other1,Other2>&& other)
-    :first(mystl::forward(other.first)),
-    second(mystl::forward(other.second))
+    :first(mystl::forward<Other1>(other.first)),
+    second(mystl::forward<Other2>(other.second))
     {}
 
 
@@ -189,7 +189,7 @@ struct pair
         this->first=rhs.first;
         this->second=rhs.second;
       }
-      return *rhs;
+      return *this;
     }
 
     //右值引用特化
@@ -212,7 +212,7 @@ struct pair
 
     //移动语义版本
     template<class Other1,class Other2>
-    pair& operator=(const pair<Other1,Other2> && rhs){
+    pair& operator=(pair<Other1,Other2> && rhs){
       this->first=mystl::forward<Other1>(rhs.first);
       this->second=mystl::forward<Other2>(rhs.second);
       return *this;
@@ -253,13 +253,13 @@ bool operator!=(const pair<T1,T2> &lhs,const pair<T1,T2> &rhs){
 
 template<class T1,class T2>
 bool operator>(const pair<T1,T2> &lhs,const pair<T1,T2> &rhs){
-  return rhs>lhs;
+  return rhs<lhs;
 }
 
 
 template<class T1,class T2>
 bool operator<=(const pair<T1,T2> &lhs,const pair<T1,T2> &rhs){
-  return !(rhs>lhs);
+  return !(rhs<lhs);
 }
 
 template<class T1,class T2>
@@ -274,11 +274,13 @@ void swap(pair<Ty1, Ty2>& lhs, pair<Ty1, Ty2>& rhs)
   lhs.swap(rhs);
 }
 
-// 全局函数，让两个数据成为一个 pair
+// 全局函数，让两个数据成为一个 pair，元素类型为退化后的参数类型
 template <class Ty1, class Ty2>
-pair<Ty1, Ty2> make_pair(Ty1&& first, Ty2&& second)
+pair<typename std::decay<Ty1>::type, typename std::decay<Ty2>::type>
+make_pair(Ty1&& first, Ty2&& second)
 {
-  return pair<Ty1, Ty2>(mystl::forward<Ty1>(first), mystl::forward<Ty2>(second));
+  return pair<typename std::decay<Ty1>::type, typename std::decay<Ty2>::type>(
+    mystl::forward<Ty1>(first), mystl::forward<Ty2>(second));
 }
 
 }
@@ -0,0 +1,212 @@
+#ifndef TINYSTL_WS_DEQUE_H_
+#define TINYSTL_WS_DEQUE_H_
+
+// 这个头文件包含了一个模板类 ws_deque
+// ws_deque : 无锁的工作窃取双端队列 (Chase-Lev)
+//
+// 只有所属线程(owner)可以在底部 push / pop，任意线程可以在顶部 steal
+// owner 的快速路径上只有普通的原子读写，没有读-改-写操作，只有取最后一个元素时才与窃取者竞争一次 CAS；
+// 窃取者之间通过对 top_ 的 CAS 竞争
+//
+// 底层是容量为 2 的幂的环形数组，满时由 owner 换成两倍大的新数组
+// 旧数组可能仍被窃取者读取，因此先放入待回收表，按 epoch 延迟释放：
+//   窃取者进入时登记在当前 epoch 奇偶对应的计数器上，离开时注销
+//   owner 在上一奇偶的计数器为 0 时把 epoch 加一
+//   在 epoch E 退休的数组，等 epoch 前进到 E + 2 后释放，此时两个计数器都在退休之后清零过一次
+//
+// 元素在 CAS 成功之前就会被窃取者读出，因此要求 T 可平凡复制，典型的元素是指针或下标
+
+#include <atomic>
+#include <type_traits>
+
+#include "concurrency.h"
+#include "vector.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+
+template <class T>
+class ws_deque
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+                "ws_deque<T> requires a trivially copyable T");
+
+public:
+  typedef T           value_type;
+  typedef size_t      size_type;
+
+private:
+  struct ring
+  {
+    ptrdiff_t       cap;
+    std::atomic<T>* slots;
+
+    explicit ring(ptrdiff_t n)
+      :cap(n), slots(new std::atomic<T>[static_cast<size_t>(n)]) {}
+    ~ring() { delete[] slots; }
+
+    T    get(ptrdiff_t i) const noexcept
+    { return slots[i & (cap - 1)].load(std::memory_order_relaxed); }
+    void put(ptrdiff_t i, const T& value) noexcept
+    { slots[i & (cap - 1)].store(value, std::memory_order_relaxed); }
+  };
+
+  struct retired_ring
+  {
+    ring*  r;
+    size_t epoch;
+  };
+
+private:
+  // ws_deque 常作为其他对象的成员放在堆上，C++11 的 new 不保证超对齐，因此用填充隔开缓存行
+
+  // 窃取者写
+  std::atomic<ptrdiff_t>        top_;
+  char                          pad0_[cache_line_size];
+  // owner 写
+  std::atomic<ptrdiff_t>        bottom_;
+  std::atomic<ring*>            ring_;
+  mystl::vector<retired_ring>   retired_;
+  char                          pad1_[cache_line_size];
+  // 延迟回收用的 epoch 与两个窃取者计数器
+  std::atomic<size_t>           epoch_;
+  std::atomic<size_t>           thieves_[2];
+  char                          pad2_[cache_line_size];
+
+public:
+  // 构造、析构函数，容量向上取整为 2 的幂
+  explicit ws_deque(size_type capacity = 64)
+    :top_(0), bottom_(0), epoch_(0)
+  {
+    THROW_LENGTH_ERROR_IF(capacity > (static_cast<size_type>(-1) >> 2) / sizeof(T),
+                          "ws_deque<T>'s capacity too big");
+    ring_.store(new ring(static_cast<ptrdiff_t>(round_up_pow2(capacity))),
+                std::memory_order_relaxed);
+    thieves_[0].store(0, std::memory_order_relaxed);
+    thieves_[1].store(0, std::memory_order_relaxed);
+  }
+
+  ws_deque(const ws_deque&) = delete;
+  ws_deque& operator=(const ws_deque&) = delete;
+
+  // 析构时不能再有窃取者
+  ~ws_deque()
+  {
+    delete ring_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < retired_.size(); ++i)
+      delete retired_[i].r;
+  }
+
+public:
+  // 容量相关操作，size 与 empty 只是某一时刻的近似值
+  size_type capacity() const noexcept
+  { return static_cast<size_type>(ring_.load(std::memory_order_relaxed)->cap); }
+
+  size_type size() const noexcept
+  {
+    const ptrdiff_t b = bottom_.load(std::memory_order_relaxed);
+    const ptrdiff_t t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_type>(b - t) : 0;
+  }
+  bool      empty() const noexcept { return size() == 0; }
+
+  // 以下两个函数只能由 owner 调用
+
+  void push(const value_type& value)
+  {
+    const ptrdiff_t b = bottom_.load(std::memory_order_relaxed);
+    const ptrdiff_t t = top_.load(std::memory_order_acquire);
+    ring* r = ring_.load(std::memory_order_relaxed);
+    if (b - t > r->cap - 1)
+      r = grow(r, b, t);
+    else if (!retired_.empty())
+      reclaim();
+    r->put(b, value);
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+
+  bool pop(value_type& value) noexcept
+  {
+    const ptrdiff_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    ring* r = ring_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    ptrdiff_t t = top_.load(std::memory_order_relaxed);
+    if (t > b)
+    {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+    value = r->get(b);
+    if (t == b)
+    {
+      // 最后一个元素，与窃取者竞争
+      const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed);
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  // 任意线程都可以调用，队列空或竞争失败时返回 false
+  bool steal(value_type& value) noexcept
+  {
+    const size_t e = epoch_.load(std::memory_order_seq_cst) & 1;
+    thieves_[e].fetch_add(1, std::memory_order_seq_cst);
+    bool ok = false;
+    ptrdiff_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const ptrdiff_t b = bottom_.load(std::memory_order_acquire);
+    if (t < b)
+    {
+      ring* r = ring_.load(std::memory_order_seq_cst);
+      const value_type v = r->get(t);
+      if (top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed))
+      {
+        value = v;
+        ok = true;
+      }
+    }
+    thieves_[e].fetch_sub(1, std::memory_order_release);
+    return ok;
+  }
+
+private:
+  // 换成两倍大的数组，旧数组放入待回收表
+  ring* grow(ring* old, ptrdiff_t b, ptrdiff_t t)
+  {
+    ring* bigger = new ring(old->cap * 2);
+    for (ptrdiff_t i = t; i < b; ++i)
+      bigger->put(i, old->get(i));
+    ring_.store(bigger, std::memory_order_seq_cst);
+    retired_.push_back(retired_ring{ old, epoch_.load(std::memory_order_relaxed) });
+    reclaim();
+    return bigger;
+  }
+
+  // 尝试推进 epoch，并释放已经没有窃取者能看到的旧数组
+  void reclaim()
+  {
+    size_t e = epoch_.load(std::memory_order_relaxed);
+    if (thieves_[(e + 1) & 1].load(std::memory_order_seq_cst) == 0)
+    {
+      ++e;
+      epoch_.store(e, std::memory_order_seq_cst);
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < retired_.size(); ++i)
+    {
+      if (retired_[i].epoch + 2 <= e)
+        delete retired_[i].r;
+      else
+        retired_[kept++] = retired_[i];
+    }
+    retired_.erase(retired_.begin() + kept, retired_.end());
+  }
+};
+
+} // namespace mystl
+#endif // !MYTINYSTL_WS_DEQUE_H_